@@ -0,0 +1,261 @@
+/****************************************************************************
+ * apps/benchmarks/chksumbench/chksumbench_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nuttx/net/netdev.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHKSUMBENCH_DEFAULT_TOTAL  (16 * 1024 * 1024)
+#define CHKSUMBENCH_MINSIZE        64
+#define CHKSUMBENCH_MAXSIZE        65535
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static volatile uint16_t g_chksumbench_sink;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void chksumbench_help(void)
+{
+  printf("Usage: chksumbench [-s total] [-o offset]\n");
+  printf("  -s: Bytes summed for each buffer size (default %d)\n",
+         CHKSUMBENCH_DEFAULT_TOTAL);
+  printf("  -o: Offset of the buffers from an aligned address "
+         "(default 0)\n");
+}
+
+static uint64_t chksumbench_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* The former chksum(): one big-endian byte pair per iteration */
+
+static uint16_t chksumbench_bytepair(uint16_t sum, FAR const uint8_t *data,
+                                     uint16_t len)
+{
+  FAR const uint8_t *last = data + len - 1;
+  uint16_t t;
+
+  for (; data < last; data += 2)
+    {
+      t = ((uint16_t)data[0] << 8) + data[1];
+      sum += t;
+      if (sum < t)
+        {
+          sum++;
+        }
+    }
+
+  if (data == last)
+    {
+      t = (uint16_t)data[0] << 8;
+      sum += t;
+      if (sum < t)
+        {
+          sum++;
+        }
+    }
+
+  return sum;
+}
+
+static unsigned long chksumbench_rate(size_t total, uint64_t elapsed)
+{
+  /* Bytes per microsecond, that is MB/s */
+
+  return elapsed ? (unsigned long)(total * 1000ull / elapsed) : 0;
+}
+
+static int chksumbench_run(FAR uint8_t *src, FAR uint8_t *dst,
+                           uint16_t size, size_t total)
+{
+  unsigned long count = total / size > 0 ? total / size : 1;
+  uint64_t bytepair_time;
+  uint64_t chksum_time;
+  uint64_t memcpy_time;
+  uint64_t copy_time;
+  uint64_t start;
+  unsigned long i;
+  uint16_t sum;
+  bool odd;
+
+  start = chksumbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      g_chksumbench_sink = chksumbench_bytepair(0, src, size);
+    }
+
+  bytepair_time = chksumbench_gettime() - start;
+
+  start = chksumbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      g_chksumbench_sink = chksum(0, src, size);
+    }
+
+  chksum_time = chksumbench_gettime() - start;
+
+  /* Copy into a packet buffer and sum it, in two passes and fused */
+
+  start = chksumbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      memcpy(dst, src, size);
+      g_chksumbench_sink = chksum(0, dst, size);
+    }
+
+  memcpy_time = chksumbench_gettime() - start;
+
+  start = chksumbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      odd = false;
+      g_chksumbench_sink = chksum_copy(0, dst, src, size, &odd);
+    }
+
+  copy_time = chksumbench_gettime() - start;
+
+  /* The new routines must agree with the byte-pair loop */
+
+  sum = chksumbench_bytepair(0, src, size);
+  odd = false;
+  if (chksum(0, src, size) != sum ||
+      chksum_copy(0, dst, src, size, &odd) != sum ||
+      memcmp(dst, src, size) != 0)
+    {
+      printf("Checksum mismatch for %u bytes\n", size);
+      return -1;
+    }
+
+  printf("%8u %12lu %12lu %14lu %14lu\n", size,
+         chksumbench_rate(count * size, bytepair_time),
+         chksumbench_rate(count * size, chksum_time),
+         chksumbench_rate(count * size, memcpy_time),
+         chksumbench_rate(count * size, copy_time));
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR uint8_t *src;
+  FAR uint8_t *dst;
+  size_t total = CHKSUMBENCH_DEFAULT_TOTAL;
+  unsigned int size;
+  int offset = 0;
+  int ret = EXIT_SUCCESS;
+  int opt;
+  int i;
+
+  while ((opt = getopt(argc, argv, "s:o:h")) != -1)
+    {
+      switch (opt)
+        {
+          case 's':
+            total = strtoul(optarg, NULL, 0);
+            break;
+          case 'o':
+            offset = atoi(optarg);
+            break;
+          case 'h':
+            chksumbench_help();
+            return EXIT_SUCCESS;
+          default:
+            chksumbench_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (total == 0 || offset < 0 || offset > 64)
+    {
+      chksumbench_help();
+      return EXIT_FAILURE;
+    }
+
+  src = malloc(CHKSUMBENCH_MAXSIZE + offset);
+  dst = malloc(CHKSUMBENCH_MAXSIZE + offset);
+  if (src == NULL || dst == NULL)
+    {
+      printf("Failed to allocate the buffers\n");
+      free(src);
+      free(dst);
+      return EXIT_FAILURE;
+    }
+
+  for (i = 0; i < CHKSUMBENCH_MAXSIZE + offset; i++)
+    {
+      src[i] = (uint8_t)random();
+    }
+
+  printf("%8s %12s %12s %14s %14s\n", "Size", "Bytes (MB/s)",
+         "chksum", "memcpy+chksum", "chksum_copy");
+
+  /* Double the buffer size from 64 bytes up to the 64 KiB limit of the
+   * 16-bit length.
+   */
+
+  for (size = CHKSUMBENCH_MINSIZE; ; size = size * 2 < CHKSUMBENCH_MAXSIZE ?
+                                            size * 2 : CHKSUMBENCH_MAXSIZE)
+    {
+      if (chksumbench_run(src + offset, dst + offset, size, total) < 0)
+        {
+          ret = EXIT_FAILURE;
+          break;
+        }
+
+      if (size >= CHKSUMBENCH_MAXSIZE)
+        {
+          break;
+        }
+    }
+
+  free(src);
+  free(dst);
+  return ret;
+}
@@ -0,0 +1,281 @@
+/****************************************************************************
+ * apps/benchmarks/epollbench/epollbench_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define EPOLLBENCH_DEFAULT_IDLE   1000
+#define EPOLLBENCH_DEFAULT_COUNT  1000
+#define EPOLLBENCH_MAXEVENTS      8
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void epollbench_help(void)
+{
+  printf("Usage: epollbench [-n idle] [-c count] [-e]\n");
+  printf("  -n: Number of idle fds registered (default %d)\n",
+         EPOLLBENCH_DEFAULT_IDLE);
+  printf("  -c: Wakeups measured at each step (default %d)\n",
+         EPOLLBENCH_DEFAULT_COUNT);
+  printf("  -e: Register the fds edge-triggered (EPOLLET)\n");
+}
+
+static uint64_t epollbench_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int epollbench_kick(int fd)
+{
+  return eventfd_write(fd, 1);
+}
+
+static int epollbench_epoll(int epfd, int active, int count,
+                            FAR uint64_t *elapsed)
+{
+  struct epoll_event evs[EPOLLBENCH_MAXEVENTS];
+  eventfd_t value;
+  uint64_t start;
+  int ret;
+  int i;
+
+  start = epollbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      if (epollbench_kick(active) < 0)
+        {
+          return -1;
+        }
+
+      ret = epoll_wait(epfd, evs, EPOLLBENCH_MAXEVENTS, -1);
+      if (ret != 1 || evs[0].data.fd != active ||
+          eventfd_read(active, &value) < 0)
+        {
+          printf("epoll_wait failed: %d %d\n", ret, errno);
+          return -1;
+        }
+    }
+
+  *elapsed = epollbench_gettime() - start;
+  return 0;
+}
+
+static int epollbench_poll(FAR struct pollfd *pfds, int nfds, int count,
+                           FAR uint64_t *elapsed)
+{
+  FAR struct pollfd *active = &pfds[nfds - 1];
+  eventfd_t value;
+  uint64_t start;
+  int ret;
+  int i;
+
+  start = epollbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      if (epollbench_kick(active->fd) < 0)
+        {
+          return -1;
+        }
+
+      ret = poll(pfds, nfds, -1);
+      if (ret != 1 || (active->revents & POLLIN) == 0 ||
+          eventfd_read(active->fd, &value) < 0)
+        {
+          printf("poll failed: %d %d\n", ret, errno);
+          return -1;
+        }
+    }
+
+  *elapsed = epollbench_gettime() - start;
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR struct pollfd *pfds;
+  struct epoll_event ev;
+  uint64_t epoll_time;
+  uint64_t poll_time;
+  bool edge = false;
+  int maxidle = EPOLLBENCH_DEFAULT_IDLE;
+  int count = EPOLLBENCH_DEFAULT_COUNT;
+  int ret = EXIT_FAILURE;
+  int nfds = 0;
+  int active;
+  int epfd;
+  int step;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:c:eh")) != -1)
+    {
+      switch (opt)
+        {
+          case 'n':
+            maxidle = atoi(optarg);
+            break;
+          case 'c':
+            count = atoi(optarg);
+            break;
+          case 'e':
+            edge = true;
+            break;
+          case 'h':
+            epollbench_help();
+            return EXIT_SUCCESS;
+          default:
+            epollbench_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (maxidle < 0 || count <= 0)
+    {
+      epollbench_help();
+      return EXIT_FAILURE;
+    }
+
+  /* The idle fds go first, the active fd is always kept last in pfds */
+
+  pfds = calloc(maxidle + 1, sizeof(struct pollfd));
+  if (pfds == NULL)
+    {
+      printf("Failed to allocate %d pollfds\n", maxidle + 1);
+      return EXIT_FAILURE;
+    }
+
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (epfd < 0)
+    {
+      printf("epoll_create1 failed: %d\n", errno);
+      goto errout_with_pfds;
+    }
+
+  active = eventfd(0, EFD_NONBLOCK);
+  if (active < 0)
+    {
+      printf("eventfd failed: %d\n", errno);
+      goto errout_with_epfd;
+    }
+
+  ev.events  = EPOLLIN | (edge ? EPOLLET : 0);
+  ev.data.fd = active;
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, active, &ev) < 0)
+    {
+      printf("epoll_ctl failed: %d\n", errno);
+      goto errout_with_active;
+    }
+
+  printf("%10s %14s %14s\n", "Idle fds", "epoll (ns)", "poll (ns)");
+
+  /* Grow the number of idle fds by decades (0, 10, 100, ...) and time one
+   * wakeup of the active fd at each step.
+   */
+
+  for (step = 0; ; step = step == 0 ? (maxidle < 10 ? maxidle : 10) :
+                          step < maxidle / 10 ? step * 10 : maxidle)
+    {
+      while (nfds < step)
+        {
+          pfds[nfds].fd     = eventfd(0, EFD_NONBLOCK);
+          pfds[nfds].events = POLLIN;
+          if (pfds[nfds].fd < 0)
+            {
+              printf("eventfd failed: %d\n", errno);
+              goto errout_with_fds;
+            }
+
+          ev.data.fd = pfds[nfds].fd;
+          if (epoll_ctl(epfd, EPOLL_CTL_ADD, pfds[nfds].fd, &ev) < 0)
+            {
+              printf("epoll_ctl failed: %d\n", errno);
+              close(pfds[nfds].fd);
+              goto errout_with_fds;
+            }
+
+          nfds++;
+        }
+
+      pfds[nfds].fd     = active;
+      pfds[nfds].events = POLLIN;
+
+      if (epollbench_epoll(epfd, active, count, &epoll_time) < 0 ||
+          epollbench_poll(pfds, nfds + 1, count, &poll_time) < 0)
+        {
+          goto errout_with_fds;
+        }
+
+      printf("%10d %14llu %14llu\n", nfds,
+             (unsigned long long)(epoll_time / count),
+             (unsigned long long)(poll_time / count));
+
+      if (nfds >= maxidle)
+        {
+          break;
+        }
+    }
+
+  ret = EXIT_SUCCESS;
+
+errout_with_fds:
+  while (nfds-- > 0)
+    {
+      close(pfds[nfds].fd);
+    }
+
+errout_with_active:
+  close(active);
+
+errout_with_epfd:
+  close(epfd);
+
+errout_with_pfds:
+  free(pfds);
+  return ret;
+}
@@ -0,0 +1,399 @@
+/****************************************************************************
+ * apps/benchmarks/localbench/localbench_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCALBENCH_DEFAULT_SIZE   64
+#define LOCALBENCH_DEFAULT_TIME   5
+#define LOCALBENCH_DEFAULT_ROUNDS 10000
+#define LOCALBENCH_MAXSIZE        4096
+
+#define LOCALBENCH_NTYPES \
+  (sizeof(g_localbench_types) / sizeof(g_localbench_types[0]))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct localbench_type_s
+{
+  int type;
+  FAR const char *name;
+};
+
+/* The thread on the other end of the socket pair */
+
+struct localbench_peer_s
+{
+  int sd;
+  size_t size;
+  bool echo;
+  uint64_t bytes;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct localbench_type_s g_localbench_types[] =
+{
+  { SOCK_STREAM,    "stream"    },
+  { SOCK_SEQPACKET, "seqpacket" },
+  { SOCK_DGRAM,     "dgram"     },
+};
+
+static char g_localbench_buffer[LOCALBENCH_MAXSIZE];
+static char g_localbench_peerbuf[LOCALBENCH_MAXSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void localbench_help(void)
+{
+  printf("Usage: localbench [-T type]... [-s size] [-t secs] [-n rounds]\n");
+  printf("  -T: Socket type: stream, seqpacket or dgram (default: all)\n");
+  printf("  -s: Bytes per message (default %d, at most %d)\n",
+         LOCALBENCH_DEFAULT_SIZE, LOCALBENCH_MAXSIZE);
+  printf("  -t: Seconds of the throughput test (default %d)\n",
+         LOCALBENCH_DEFAULT_TIME);
+  printf("  -n: Round trips of the latency test (default %d)\n",
+         LOCALBENCH_DEFAULT_ROUNDS);
+}
+
+static uint64_t localbench_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int localbench_sendall(int sd, FAR const char *buf, size_t len)
+{
+  ssize_t nsent;
+
+  while (len > 0)
+    {
+      nsent = send(sd, buf, len, 0);
+      if (nsent < 0)
+        {
+          return -1;
+        }
+
+      buf += nsent;
+      len -= nsent;
+    }
+
+  return 0;
+}
+
+static int localbench_recvall(int sd, FAR char *buf, size_t len)
+{
+  ssize_t nrecv;
+
+  /* A message of a record type arrives whole, a stream in pieces */
+
+  while (len > 0)
+    {
+      nrecv = recv(sd, buf, len, 0);
+      if (nrecv <= 0)
+        {
+          return -1;
+        }
+
+      buf += nrecv;
+      len -= nrecv;
+    }
+
+  return 0;
+}
+
+static FAR void *localbench_peer(FAR void *arg)
+{
+  FAR struct localbench_peer_s *peer = arg;
+  ssize_t nrecv;
+
+  while ((nrecv = recv(peer->sd, g_localbench_peerbuf, peer->size, 0)) > 0)
+    {
+      peer->bytes += nrecv;
+      if (peer->echo &&
+          localbench_sendall(peer->sd, g_localbench_peerbuf, nrecv) < 0)
+        {
+          break;
+        }
+    }
+
+  return NULL;
+}
+
+/* Create a socket pair and start the peer thread on one end of it, the
+ * other end is returned.
+ */
+
+static int localbench_start(int type, FAR struct localbench_peer_s *peer,
+                            FAR pthread_t *thread)
+{
+  int sv[2];
+  int ret;
+
+  if (socketpair(AF_LOCAL, type, 0, sv) < 0)
+    {
+      return -errno;
+    }
+
+  peer->sd    = sv[1];
+  peer->bytes = 0;
+
+  ret = pthread_create(thread, NULL, localbench_peer, peer);
+  if (ret != 0)
+    {
+      close(sv[0]);
+      close(sv[1]);
+      return -ret;
+    }
+
+  return sv[0];
+}
+
+/* Closing our end ends the peer thread once it drained the socket */
+
+static void localbench_stop(int sd, FAR struct localbench_peer_s *peer,
+                            pthread_t thread)
+{
+  close(sd);
+  pthread_join(thread, NULL);
+  close(peer->sd);
+}
+
+static int localbench_throughput(int type, size_t size, int seconds,
+                                 FAR unsigned long *kbps)
+{
+  struct localbench_peer_s peer;
+  uint64_t duration = seconds * 1000000000ull;
+  uint64_t elapsed;
+  uint64_t start;
+  pthread_t thread;
+  int sd;
+
+  peer.size = size;
+  peer.echo = false;
+
+  sd = localbench_start(type, &peer, &thread);
+  if (sd < 0)
+    {
+      return sd;
+    }
+
+  start = localbench_gettime();
+  do
+    {
+      if (localbench_sendall(sd, g_localbench_buffer, size) < 0)
+        {
+          printf("send failed: %d\n", errno);
+          localbench_stop(sd, &peer, thread);
+          return -EIO;
+        }
+    }
+  while (localbench_gettime() - start < duration);
+
+  /* The peer has received everything when it sees the end of the data */
+
+  localbench_stop(sd, &peer, thread);
+  elapsed = (localbench_gettime() - start) / 1000;
+
+  /* Bytes per millisecond, that is kB/s */
+
+  *kbps = elapsed ? (unsigned long)(peer.bytes * 1000ull / elapsed) : 0;
+  return 0;
+}
+
+static int localbench_latency(int type, size_t size, int rounds,
+                              FAR unsigned long *avg,
+                              FAR unsigned long *max)
+{
+  struct localbench_peer_s peer;
+  uint64_t elapsed;
+  uint64_t total = 0;
+  uint64_t start;
+  pthread_t thread;
+  int sd;
+  int i;
+
+  peer.size = size;
+  peer.echo = true;
+  *max      = 0;
+
+  sd = localbench_start(type, &peer, &thread);
+  if (sd < 0)
+    {
+      return sd;
+    }
+
+  for (i = 0; i < rounds; i++)
+    {
+      start = localbench_gettime();
+
+      if (localbench_sendall(sd, g_localbench_buffer, size) < 0 ||
+          localbench_recvall(sd, g_localbench_buffer, size) < 0)
+        {
+          printf("round trip failed: %d\n", errno);
+          localbench_stop(sd, &peer, thread);
+          return -EIO;
+        }
+
+      elapsed = (localbench_gettime() - start) / 1000;
+      total  += elapsed;
+      if (elapsed > *max)
+        {
+          *max = elapsed;
+        }
+    }
+
+  localbench_stop(sd, &peer, thread);
+
+  *avg = (unsigned long)(total / rounds);
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  bool selected[LOCALBENCH_NTYPES];
+  unsigned long kbps;
+  unsigned long avg;
+  unsigned long max;
+  size_t size = LOCALBENCH_DEFAULT_SIZE;
+  int seconds = LOCALBENCH_DEFAULT_TIME;
+  int rounds = LOCALBENCH_DEFAULT_ROUNDS;
+  bool any = false;
+  int ret;
+  int opt;
+  int i;
+
+  memset(selected, 0, sizeof(selected));
+
+  while ((opt = getopt(argc, argv, "T:s:t:n:h")) != -1)
+    {
+      switch (opt)
+        {
+          case 'T':
+            for (i = 0; i < LOCALBENCH_NTYPES; i++)
+              {
+                if (strcmp(optarg, g_localbench_types[i].name) == 0)
+                  {
+                    selected[i] = true;
+                    any = true;
+                    break;
+                  }
+              }
+
+            if (i == LOCALBENCH_NTYPES)
+              {
+                localbench_help();
+                return EXIT_FAILURE;
+              }
+            break;
+          case 's':
+            size = atoi(optarg);
+            break;
+          case 't':
+            seconds = atoi(optarg);
+            break;
+          case 'n':
+            rounds = atoi(optarg);
+            break;
+          case 'h':
+            localbench_help();
+            return EXIT_SUCCESS;
+          default:
+            localbench_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (size == 0 || size > LOCALBENCH_MAXSIZE || seconds <= 0 ||
+      rounds <= 0)
+    {
+      localbench_help();
+      return EXIT_FAILURE;
+    }
+
+  for (i = 0; i < LOCALBENCH_MAXSIZE; i++)
+    {
+      g_localbench_buffer[i] = (char)i;
+    }
+
+  printf("%-10s %6s %18s %14s %14s\n", "Type", "Size",
+         "Throughput (kB/s)", "RTT avg (us)", "RTT max (us)");
+
+  for (i = 0; i < LOCALBENCH_NTYPES; i++)
+    {
+      if (any && !selected[i])
+        {
+          continue;
+        }
+
+      ret = localbench_throughput(g_localbench_types[i].type, size,
+                                  seconds, &kbps);
+      if (ret == 0)
+        {
+          ret = localbench_latency(g_localbench_types[i].type, size,
+                                   rounds, &avg, &max);
+        }
+
+      if (ret < 0)
+        {
+          printf("%-10s %6zu not available: %d\n",
+                 g_localbench_types[i].name, size, ret);
+          continue;
+        }
+
+      printf("%-10s %6zu %18lu %14lu %14lu\n", g_localbench_types[i].name,
+             size, kbps, avg, max);
+    }
+
+  return EXIT_SUCCESS;
+}
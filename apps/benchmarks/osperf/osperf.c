@@ -69,6 +69,7 @@ struct performance_entry_s
 static size_t pthread_create_performance(void);
 static size_t pthread_switch_performance(void);
 static size_t context_switch_performance(void);
+static size_t context_switch_ready_performance(void);
 static size_t hpwork_performance(void);
 static size_t poll_performance(void);
 static size_t pipe_performance(void);
@@ -84,6 +85,7 @@ static const struct performance_entry_s g_entry_list[] =
   {"pthread-create", pthread_create_performance},
   {"pthread-switch", pthread_switch_performance},
   {"context-switch", context_switch_performance},
+  {"context-switch-ready", context_switch_ready_performance},
   {"hpwork", hpwork_performance},
   {"poll-write", poll_performance},
   {"pipe-rw", pipe_performance},
@@ -91,6 +93,8 @@ static const struct performance_entry_s g_entry_list[] =
   {"sempost", sempost_performance},
 };
 
+static volatile bool g_ready_done;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -215,6 +219,56 @@ static size_t context_switch_performance(void)
   return performance_gettime(&time);
 }
 
+/****************************************************************************
+ * Context switch with many ready tasks performance
+ ****************************************************************************/
+
+static FAR void *context_switch_ready_task(FAR void *arg)
+{
+  while (!g_ready_done)
+    {
+      sched_yield();
+    }
+
+  return NULL;
+}
+
+static size_t context_switch_ready_performance(void)
+{
+  pthread_t tid[CONFIG_BENCHMARK_OSPERF_READY_TASKS];
+  struct performance_time_s result;
+  struct sched_param param;
+  int i;
+
+  /* Start threads of the same priority as this one.  Each sched_yield()
+   * queues the yielding thread behind all the other ready ones, so one
+   * yield of this thread runs through every thread once.
+   */
+
+  sched_getparam(gettid(), &param);
+  g_ready_done = false;
+
+  for (i = 0; i < CONFIG_BENCHMARK_OSPERF_READY_TASKS; i++)
+    {
+      tid[i] = performance_thread_create(context_switch_ready_task, NULL,
+                                         param.sched_priority);
+    }
+
+  sched_yield();
+  performance_start(&result);
+  sched_yield();
+  performance_end(&result);
+
+  g_ready_done = true;
+  for (i = 0; i < CONFIG_BENCHMARK_OSPERF_READY_TASKS; i++)
+    {
+      pthread_join(tid[i], NULL);
+    }
+
+  return performance_gettime(&result) /
+         (CONFIG_BENCHMARK_OSPERF_READY_TASKS + 1);
+}
+
 /****************************************************************************
  * wdog performance
  ****************************************************************************/
@@ -0,0 +1,357 @@
+/****************************************************************************
+ * apps/benchmarks/tcpcc/tcpcc_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCPCC_DEFAULT_PORT   5471
+#define TCPCC_DEFAULT_TIME   10
+#define TCPCC_BUFSIZE        1460
+#define TCPCC_MAXALGOS       4
+#define TCPCC_NAMELEN        16
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_tcpcc_buffer[TCPCC_BUFSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void tcpcc_help(void)
+{
+  printf("Usage: tcpcc -c <ip> [-C algo]... [-t secs] [-p port]\n");
+  printf("       tcpcc -s [-p port]\n");
+  printf("  -c: Stream to the server at <ip>, once per algorithm\n");
+  printf("  -s: Run the server, which discards the data it receives\n");
+  printf("  -C: Congestion control algorithm (default: newreno, cubic)\n");
+  printf("  -t: Seconds of data streamed per algorithm (default %d)\n",
+         TCPCC_DEFAULT_TIME);
+  printf("  -p: Port of the server (default %d)\n", TCPCC_DEFAULT_PORT);
+}
+
+static uint64_t tcpcc_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static unsigned long tcpcc_kbps(uint64_t bytes, uint64_t elapsed)
+{
+  /* Bits per millisecond, that is kbit/s */
+
+  return elapsed ? (unsigned long)(bytes * 8000000ull / elapsed) : 0;
+}
+
+static int tcpcc_server(int port)
+{
+  struct sockaddr_in addr;
+  uint64_t elapsed;
+  uint64_t bytes;
+  uint64_t start;
+  char name[TCPCC_NAMELEN];
+  socklen_t len;
+  ssize_t nrecv;
+  int optval = 1;
+  int listener;
+  int sd;
+
+  listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if (bind(listener, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(listener, 1) < 0)
+    {
+      printf("bind/listen failed: %d\n", errno);
+      close(listener);
+      return -1;
+    }
+
+  printf("%-10s %12s %10s %14s\n", "Peer algo", "Bytes", "Time (ms)",
+         "Goodput (kb/s)");
+
+  for (; ; )
+    {
+      sd = accept(listener, NULL, NULL);
+      if (sd < 0)
+        {
+          printf("accept failed: %d\n", errno);
+          break;
+        }
+
+      /* The client sends the name of its algorithm first */
+
+      len = 0;
+      while (len < TCPCC_NAMELEN)
+        {
+          nrecv = recv(sd, name + len, TCPCC_NAMELEN - len, 0);
+          if (nrecv <= 0)
+            {
+              break;
+            }
+
+          len += nrecv;
+        }
+
+      if (len < TCPCC_NAMELEN)
+        {
+          close(sd);
+          continue;
+        }
+
+      name[TCPCC_NAMELEN - 1] = '\0';
+      bytes = 0;
+      start = tcpcc_gettime();
+
+      while ((nrecv = recv(sd, g_tcpcc_buffer, TCPCC_BUFSIZE, 0)) > 0)
+        {
+          bytes += nrecv;
+        }
+
+      elapsed = tcpcc_gettime() - start;
+      close(sd);
+
+      printf("%-10s %12llu %10llu %14lu\n", name,
+             (unsigned long long)bytes,
+             (unsigned long long)(elapsed / 1000000),
+             tcpcc_kbps(bytes, elapsed));
+    }
+
+  close(listener);
+  return -1;
+}
+
+static int tcpcc_client(FAR struct sockaddr_in *addr, FAR const char *algo,
+                        int seconds)
+{
+  char name[TCPCC_NAMELEN];
+  socklen_t len;
+  uint64_t duration = seconds * 1000000000ull;
+  uint64_t elapsed;
+  uint64_t bytes = 0;
+  uint64_t start;
+  ssize_t nsent;
+  int sd;
+
+  sd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sd < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  /* Select the algorithm before the connection, so that it also runs
+   * the slow start.
+   */
+
+  if (setsockopt(sd, IPPROTO_TCP, TCP_CONGESTION, algo,
+                 strlen(algo)) < 0)
+    {
+      printf("%-10s not available: %d\n", algo, errno);
+      close(sd);
+      return 0;
+    }
+
+  len = sizeof(name);
+  if (getsockopt(sd, IPPROTO_TCP, TCP_CONGESTION, name, &len) < 0 ||
+      strncmp(name, algo, sizeof(name)) != 0)
+    {
+      printf("%-10s not selected\n", algo);
+      close(sd);
+      return -1;
+    }
+
+  if (connect(sd, (FAR struct sockaddr *)addr, sizeof(*addr)) < 0)
+    {
+      printf("connect failed: %d\n", errno);
+      close(sd);
+      return -1;
+    }
+
+  memset(name, 0, sizeof(name));
+  strlcpy(name, algo, sizeof(name));
+  if (send(sd, name, sizeof(name), 0) != sizeof(name))
+    {
+      printf("send failed: %d\n", errno);
+      close(sd);
+      return -1;
+    }
+
+  start = tcpcc_gettime();
+  do
+    {
+      nsent = send(sd, g_tcpcc_buffer, TCPCC_BUFSIZE, 0);
+      if (nsent < 0)
+        {
+          printf("send failed: %d\n", errno);
+          close(sd);
+          return -1;
+        }
+
+      bytes += nsent;
+    }
+  while (tcpcc_gettime() - start < duration);
+
+  /* The data is only delivered once the server has read it all and
+   * closed its end of the connection.
+   */
+
+  shutdown(sd, SHUT_WR);
+  while (recv(sd, g_tcpcc_buffer, TCPCC_BUFSIZE, 0) > 0)
+    {
+    }
+
+  elapsed = tcpcc_gettime() - start;
+  close(sd);
+
+  printf("%-10s %12llu %10llu %14lu\n", algo, (unsigned long long)bytes,
+         (unsigned long long)(elapsed / 1000000),
+         tcpcc_kbps(bytes, elapsed));
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR const char *algos[TCPCC_MAXALGOS];
+  struct sockaddr_in addr;
+  FAR const char *host = NULL;
+  bool server = false;
+  int seconds = TCPCC_DEFAULT_TIME;
+  int port = TCPCC_DEFAULT_PORT;
+  int nalgos = 0;
+  int opt;
+  int i;
+
+  while ((opt = getopt(argc, argv, "c:sC:t:p:h")) != -1)
+    {
+      switch (opt)
+        {
+          case 'c':
+            host = optarg;
+            break;
+          case 's':
+            server = true;
+            break;
+          case 'C':
+            if (nalgos >= TCPCC_MAXALGOS)
+              {
+                tcpcc_help();
+                return EXIT_FAILURE;
+              }
+
+            algos[nalgos++] = optarg;
+            break;
+          case 't':
+            seconds = atoi(optarg);
+            break;
+          case 'p':
+            port = atoi(optarg);
+            break;
+          case 'h':
+            tcpcc_help();
+            return EXIT_SUCCESS;
+          default:
+            tcpcc_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (server)
+    {
+      return tcpcc_server(port) < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port   = htons(port);
+
+  if (host == NULL || seconds <= 0 ||
+      inet_pton(AF_INET, host, &addr.sin_addr) != 1)
+    {
+      tcpcc_help();
+      return EXIT_FAILURE;
+    }
+
+  if (nalgos == 0)
+    {
+      algos[nalgos++] = "newreno";
+      algos[nalgos++] = "cubic";
+    }
+
+  for (i = 0; i < TCPCC_BUFSIZE; i++)
+    {
+      g_tcpcc_buffer[i] = (char)i;
+    }
+
+  printf("%-10s %12s %10s %14s\n", "Algorithm", "Bytes", "Time (ms)",
+         "Goodput (kb/s)");
+
+  for (i = 0; i < nalgos; i++)
+    {
+      if (tcpcc_client(&addr, algos[i], seconds) < 0)
+        {
+          return EXIT_FAILURE;
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
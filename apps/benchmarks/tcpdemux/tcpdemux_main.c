@@ -0,0 +1,273 @@
+/****************************************************************************
+ * apps/benchmarks/tcpdemux/tcpdemux_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCPDEMUX_DEFAULT_PORT   5471
+#define TCPDEMUX_DEFAULT_CONNS  1000
+#define TCPDEMUX_DEFAULT_COUNT  1000
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct tcpdemux_pair_s
+{
+  int client;
+  int server;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void tcpdemux_help(void)
+{
+  printf("Usage: tcpdemux [-n conns] [-c count] [-p port]\n");
+  printf("  -n: Maximum number of connection pairs (default %d)\n",
+         TCPDEMUX_DEFAULT_CONNS);
+  printf("  -c: Round trips measured at each step (default %d)\n",
+         TCPDEMUX_DEFAULT_COUNT);
+  printf("  -p: Loopback port of the listener (default %d)\n",
+         TCPDEMUX_DEFAULT_PORT);
+}
+
+static uint64_t tcpdemux_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int tcpdemux_listen(FAR struct sockaddr_in *addr)
+{
+  int optval = 1;
+  int sd;
+
+  sd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sd < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  setsockopt(sd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+  if (bind(sd, (FAR struct sockaddr *)addr, sizeof(*addr)) < 0 ||
+      listen(sd, 8) < 0)
+    {
+      printf("bind/listen failed: %d\n", errno);
+      close(sd);
+      return -1;
+    }
+
+  return sd;
+}
+
+static int tcpdemux_open(int listener, FAR struct sockaddr_in *addr,
+                         FAR struct tcpdemux_pair_s *pair)
+{
+  pair->client = socket(AF_INET, SOCK_STREAM, 0);
+  if (pair->client < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  if (connect(pair->client, (FAR struct sockaddr *)addr,
+              sizeof(*addr)) < 0)
+    {
+      printf("connect failed: %d\n", errno);
+      close(pair->client);
+      return -1;
+    }
+
+  pair->server = accept(listener, NULL, NULL);
+  if (pair->server < 0)
+    {
+      printf("accept failed: %d\n", errno);
+      close(pair->client);
+      return -1;
+    }
+
+  return 0;
+}
+
+static int tcpdemux_pingpong(FAR struct tcpdemux_pair_s *pair, int count,
+                             FAR uint64_t *elapsed)
+{
+  uint64_t start;
+  char byte = 0;
+  int i;
+
+  start = tcpdemux_gettime();
+  for (i = 0; i < count; i++)
+    {
+      if (send(pair->client, &byte, 1, 0) != 1 ||
+          recv(pair->server, &byte, 1, 0) != 1 ||
+          send(pair->server, &byte, 1, 0) != 1 ||
+          recv(pair->client, &byte, 1, 0) != 1)
+        {
+          printf("ping-pong failed: %d\n", errno);
+          return -1;
+        }
+    }
+
+  *elapsed = tcpdemux_gettime() - start;
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR struct tcpdemux_pair_s *pairs;
+  struct sockaddr_in addr;
+  uint64_t elapsed;
+  int maxconns = TCPDEMUX_DEFAULT_CONNS;
+  int count = TCPDEMUX_DEFAULT_COUNT;
+  int port = TCPDEMUX_DEFAULT_PORT;
+  int listener;
+  int nconns = 0;
+  int step;
+  int ret = EXIT_FAILURE;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:c:p:h")) != -1)
+    {
+      switch (opt)
+        {
+          case 'n':
+            maxconns = atoi(optarg);
+            break;
+          case 'c':
+            count = atoi(optarg);
+            break;
+          case 'p':
+            port = atoi(optarg);
+            break;
+          case 'h':
+            tcpdemux_help();
+            return EXIT_SUCCESS;
+          default:
+            tcpdemux_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (maxconns <= 0 || count <= 0)
+    {
+      tcpdemux_help();
+      return EXIT_FAILURE;
+    }
+
+  pairs = calloc(maxconns, sizeof(struct tcpdemux_pair_s));
+  if (pairs == NULL)
+    {
+      printf("Failed to allocate %d pairs\n", maxconns);
+      return EXIT_FAILURE;
+    }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  listener = tcpdemux_listen(&addr);
+  if (listener < 0)
+    {
+      goto errout_with_pairs;
+    }
+
+  printf("%10s %12s %12s\n", "Conns", "RTT (ns)", "Segment (ns)");
+
+  /* Grow the number of open connections by decades (1, 10, 100, ...)
+   * and time the round trips on the most recently opened pair.  Each
+   * round trip sends two data segments through the TX poll of the loopback
+   * device and delivers them through tcp_input().
+   */
+
+  for (step = 1; ; step = step < maxconns / 10 ? step * 10 : maxconns)
+    {
+      while (nconns < step)
+        {
+          if (tcpdemux_open(listener, &addr, &pairs[nconns]) < 0)
+            {
+              goto errout_with_conns;
+            }
+
+          nconns++;
+        }
+
+      if (tcpdemux_pingpong(&pairs[nconns - 1], count, &elapsed) < 0)
+        {
+          goto errout_with_conns;
+        }
+
+      printf("%10d %12llu %12llu\n", nconns,
+             (unsigned long long)(elapsed / count),
+             (unsigned long long)(elapsed / count / 2));
+
+      if (nconns >= maxconns)
+        {
+          break;
+        }
+    }
+
+  ret = EXIT_SUCCESS;
+
+errout_with_conns:
+  while (nconns-- > 0)
+    {
+      close(pairs[nconns].client);
+      close(pairs[nconns].server);
+    }
+
+  close(listener);
+
+errout_with_pairs:
+  free(pairs);
+  return ret;
+}
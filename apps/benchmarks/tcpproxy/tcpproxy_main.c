@@ -0,0 +1,448 @@
+/****************************************************************************
+ * apps/benchmarks/tcpproxy/tcpproxy_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#ifdef CONFIG_NET_ZEROCOPY
+#  include <nuttx/mm/iob.h>
+#  include <nuttx/net/net.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCPPROXY_DEFAULT_PORT   5472
+#define TCPPROXY_DEFAULT_SIZE   (16 * 1024 * 1024)
+#define TCPPROXY_BUFSIZE        4096
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct tcpproxy_s
+{
+  struct sockaddr_in addr;      /* Address of the proxy listener */
+  size_t             total;     /* Number of bytes to stream */
+  int                sink;      /* Listener of the sink */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void tcpproxy_help(void)
+{
+  printf("Usage: tcpproxy [-s size] [-p port] [-a ipaddr] [-z]\n");
+  printf("  -s: Number of bytes streamed (default %d)\n",
+         TCPPROXY_DEFAULT_SIZE);
+  printf("  -p: First of the two ports used (default %d)\n",
+         TCPPROXY_DEFAULT_PORT);
+  printf("  -a: Forward between remote hosts instead of the local source\n"
+         "      and sink:  accept the source on the first port and connect\n"
+         "      to the sink at ipaddr on the second one\n");
+#ifdef CONFIG_NET_ZEROCOPY
+  printf("  -z: Forward with net_recviob()/net_sendiob()\n");
+#endif
+}
+
+static uint64_t tcpproxy_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int tcpproxy_listen(FAR struct sockaddr_in *addr)
+{
+  int optval = 1;
+  int sd;
+
+  sd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sd < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  setsockopt(sd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+  if (bind(sd, (FAR struct sockaddr *)addr, sizeof(*addr)) < 0 ||
+      listen(sd, 1) < 0)
+    {
+      printf("bind/listen failed: %d\n", errno);
+      close(sd);
+      return -1;
+    }
+
+  return sd;
+}
+
+static int tcpproxy_connect(FAR struct sockaddr_in *addr)
+{
+  int sd;
+
+  sd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sd < 0)
+    {
+      printf("socket failed: %d\n", errno);
+      return -1;
+    }
+
+  if (connect(sd, (FAR struct sockaddr *)addr, sizeof(*addr)) < 0)
+    {
+      printf("connect failed: %d\n", errno);
+      close(sd);
+      return -1;
+    }
+
+  return sd;
+}
+
+static FAR void *tcpproxy_source(FAR void *arg)
+{
+  FAR struct tcpproxy_s *proxy = arg;
+  FAR char *buf;
+  size_t total = 0;
+  ssize_t ret;
+  int sd;
+
+  buf = calloc(1, TCPPROXY_BUFSIZE);
+  sd = tcpproxy_connect(&proxy->addr);
+  if (buf == NULL || sd < 0)
+    {
+      free(buf);
+      return NULL;
+    }
+
+  while (total < proxy->total)
+    {
+      ret = send(sd, buf, TCPPROXY_BUFSIZE, 0);
+      if (ret <= 0)
+        {
+          printf("source send failed: %d\n", errno);
+          break;
+        }
+
+      total += ret;
+    }
+
+  close(sd);
+  free(buf);
+  return NULL;
+}
+
+static FAR void *tcpproxy_sink(FAR void *arg)
+{
+  FAR struct tcpproxy_s *proxy = arg;
+  FAR char *buf;
+  ssize_t ret;
+  int sd;
+
+  buf = malloc(TCPPROXY_BUFSIZE);
+  sd = accept(proxy->sink, NULL, NULL);
+  if (buf == NULL || sd < 0)
+    {
+      printf("sink accept failed: %d\n", errno);
+      free(buf);
+      return NULL;
+    }
+
+  do
+    {
+      ret = recv(sd, buf, TCPPROXY_BUFSIZE, 0);
+    }
+  while (ret > 0);
+
+  close(sd);
+  free(buf);
+  return NULL;
+}
+
+static ssize_t tcpproxy_copy(int in, int out, FAR char *buf)
+{
+  ssize_t nrecv;
+  ssize_t nsent;
+  ssize_t ret;
+
+  nrecv = recv(in, buf, TCPPROXY_BUFSIZE, 0);
+  for (nsent = 0; nsent < nrecv; nsent += ret)
+    {
+      ret = send(out, buf + nsent, nrecv - nsent, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return nrecv;
+}
+
+#ifdef CONFIG_NET_ZEROCOPY
+static ssize_t tcpproxy_zerocopy(int in, int out)
+{
+  FAR struct iob_s *iob;
+  ssize_t nrecv;
+  ssize_t ret;
+
+  nrecv = net_recviob(in, &iob, 0);
+  if (nrecv <= 0)
+    {
+      return nrecv;
+    }
+
+  /* The stack takes ownership of whatever part of the chain it queued,
+   * the remainder is handed back in 'iob'.
+   */
+
+  while (iob != NULL)
+    {
+      ret = net_sendiob(out, &iob, 0);
+      if (ret < 0)
+        {
+          iob_free_chain(iob);
+          return ret;
+        }
+    }
+
+  return nrecv;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  struct tcpproxy_s proxy;
+  struct sockaddr_in addr;
+  pthread_t source;
+  pthread_t sink;
+  FAR char *buf = NULL;
+  uint64_t elapsed;
+  uint64_t start;
+  size_t total = 0;
+  bool zerocopy = false;
+  bool remote = false;
+  ssize_t ret = -1;
+  int port = TCPPROXY_DEFAULT_PORT;
+  int listener;
+  int in = -1;
+  int out = -1;
+  int opt;
+
+  memset(&proxy, 0, sizeof(proxy));
+  proxy.total = TCPPROXY_DEFAULT_SIZE;
+
+  memset(&addr, 0, sizeof(addr));
+
+  while ((opt = getopt(argc, argv, "s:p:a:zh")) != -1)
+    {
+      switch (opt)
+        {
+          case 's':
+            proxy.total = strtoul(optarg, NULL, 0);
+            break;
+          case 'p':
+            port = atoi(optarg);
+            break;
+          case 'a':
+            if (inet_pton(AF_INET, optarg, &addr.sin_addr) != 1)
+              {
+                tcpproxy_help();
+                return EXIT_FAILURE;
+              }
+
+            remote = true;
+            break;
+#ifdef CONFIG_NET_ZEROCOPY
+          case 'z':
+            zerocopy = true;
+            break;
+#endif
+          case 'h':
+            tcpproxy_help();
+            return EXIT_SUCCESS;
+          default:
+            tcpproxy_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (proxy.total == 0)
+    {
+      tcpproxy_help();
+      return EXIT_FAILURE;
+    }
+
+  /* Without -a, the source and the sink are local threads, connected
+   * over loopback.  With it, both connections go through the network
+   * device, e.g. the TAP device of the simulator.
+   */
+
+  proxy.addr.sin_family      = AF_INET;
+  proxy.addr.sin_port        = htons(port);
+  proxy.addr.sin_addr.s_addr = htonl(remote ? INADDR_ANY : INADDR_LOOPBACK);
+  proxy.sink                 = -1;
+
+  if (!remote)
+    {
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+
+  addr.sin_family = AF_INET;
+  addr.sin_port   = htons(port + 1);
+
+  listener = tcpproxy_listen(&proxy.addr);
+  if (listener < 0)
+    {
+      return EXIT_FAILURE;
+    }
+
+  if (!remote)
+    {
+      proxy.sink = tcpproxy_listen(&addr);
+      if (proxy.sink < 0)
+        {
+          close(listener);
+          return EXIT_FAILURE;
+        }
+    }
+
+  if (!zerocopy)
+    {
+      buf = malloc(TCPPROXY_BUFSIZE);
+      if (buf == NULL)
+        {
+          printf("Failed to allocate the proxy buffer\n");
+          goto errout;
+        }
+    }
+
+  if (remote)
+    {
+      printf("Forwarding from port %d to %s:%d\n", port,
+             inet_ntoa(addr.sin_addr), port + 1);
+    }
+  else
+    {
+      pthread_create(&sink, NULL, tcpproxy_sink, &proxy);
+    }
+
+  out = tcpproxy_connect(&addr);
+  if (!remote)
+    {
+      pthread_create(&source, NULL, tcpproxy_source, &proxy);
+    }
+
+  in = accept(listener, NULL, NULL);
+
+  if (in < 0 || out < 0)
+    {
+      printf("Failed to set up the proxy connections: %d\n", errno);
+      goto errout_with_threads;
+    }
+
+  /* Forward until the source closes its connection */
+
+  start = tcpproxy_gettime();
+  for (; ; )
+    {
+#ifdef CONFIG_NET_ZEROCOPY
+      if (zerocopy)
+        {
+          ret = tcpproxy_zerocopy(in, out);
+        }
+      else
+#endif
+        {
+          ret = tcpproxy_copy(in, out, buf);
+        }
+
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      total += ret;
+    }
+
+  elapsed = tcpproxy_gettime() - start;
+
+  if (ret < 0)
+    {
+      printf("Forwarding failed: %d\n", errno);
+    }
+
+  printf("%s: %zu bytes in %llu us, %llu KiB/s\n",
+         zerocopy ? "zero-copy" : "copy", total,
+         (unsigned long long)(elapsed / 1000),
+         (unsigned long long)(elapsed ?
+                              total * 1000000000ull / elapsed / 1024 : 0));
+
+errout_with_threads:
+  if (in >= 0)
+    {
+      close(in);
+    }
+
+  if (out >= 0)
+    {
+      close(out);
+    }
+
+  if (!remote)
+    {
+      pthread_join(source, NULL);
+      pthread_join(sink, NULL);
+    }
+
+errout:
+  if (proxy.sink >= 0)
+    {
+      close(proxy.sink);
+    }
+
+  close(listener);
+  free(buf);
+  return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
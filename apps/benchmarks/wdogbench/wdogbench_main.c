@@ -0,0 +1,188 @@
+/****************************************************************************
+ * apps/benchmarks/wdogbench/wdogbench_main.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nuttx/wdog.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDOGBENCH_DEFAULT_COUNT  10000
+#define WDOGBENCH_DEFAULT_DELAY  100000
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void wdogbench_help(void)
+{
+  printf("Usage: wdogbench [-n count] [-d delay]\n");
+  printf("  -n: Maximum number of active watchdogs (default %d)\n",
+         WDOGBENCH_DEFAULT_COUNT);
+  printf("  -d: Upper bound of the random delays in ticks (default %d)\n",
+         WDOGBENCH_DEFAULT_DELAY);
+}
+
+static uint64_t wdogbench_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void wdogbench_callback(wdparm_t arg)
+{
+  /* The delays are long enough that this should never run */
+
+  (*(FAR unsigned int *)arg)++;
+}
+
+static void wdogbench_run(FAR struct wdog_s *wdogs, int count,
+                          unsigned int delay, FAR unsigned int *fired)
+{
+  uint64_t start_time;
+  uint64_t restart_time;
+  uint64_t cancel_time;
+  uint64_t start;
+  int i;
+
+  /* Start 'count' watchdogs with random delays, so that every insertion
+   * lands at a random place among the active ones.
+   */
+
+  start = wdogbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      wd_start(&wdogs[i], delay / 2 + random() % (delay / 2),
+               wdogbench_callback, (wdparm_t)fired);
+    }
+
+  start_time = wdogbench_gettime() - start;
+
+  /* Restart all of them, as a retransmission timer would be */
+
+  start = wdogbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      wd_start(&wdogs[i], delay / 2 + random() % (delay / 2),
+               wdogbench_callback, (wdparm_t)fired);
+    }
+
+  restart_time = wdogbench_gettime() - start;
+
+  /* Cancel them in start order */
+
+  start = wdogbench_gettime();
+  for (i = 0; i < count; i++)
+    {
+      wd_cancel(&wdogs[i]);
+    }
+
+  cancel_time = wdogbench_gettime() - start;
+
+  printf("%10d %12llu %12llu %12llu\n", count,
+         (unsigned long long)(start_time / count),
+         (unsigned long long)(restart_time / count),
+         (unsigned long long)(cancel_time / count));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR struct wdog_s *wdogs;
+  unsigned int delay = WDOGBENCH_DEFAULT_DELAY;
+  unsigned int fired = 0;
+  int maxcount = WDOGBENCH_DEFAULT_COUNT;
+  int count;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:d:h")) != -1)
+    {
+      switch (opt)
+        {
+          case 'n':
+            maxcount = atoi(optarg);
+            break;
+          case 'd':
+            delay = strtoul(optarg, NULL, 0);
+            break;
+          case 'h':
+            wdogbench_help();
+            return EXIT_SUCCESS;
+          default:
+            wdogbench_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+  if (maxcount <= 0 || delay < 2)
+    {
+      wdogbench_help();
+      return EXIT_FAILURE;
+    }
+
+  wdogs = calloc(maxcount, sizeof(struct wdog_s));
+  if (wdogs == NULL)
+    {
+      printf("Failed to allocate %d watchdogs\n", maxcount);
+      return EXIT_FAILURE;
+    }
+
+  printf("%10s %12s %12s %12s\n", "Watchdogs", "Start (ns)",
+         "Restart (ns)", "Cancel (ns)");
+
+  /* Grow the number of active watchdogs by decades (1, 10, 100, ...) */
+
+  for (count = 1; ; count = count < maxcount / 10 ? count * 10 : maxcount)
+    {
+      wdogbench_run(wdogs, count, delay, &fired);
+
+      if (count >= maxcount)
+        {
+          break;
+        }
+    }
+
+  if (fired > 0)
+    {
+      printf("WARNING: %u watchdogs expired, use a larger -d\n", fired);
+    }
+
+  free(wdogs);
+  return EXIT_SUCCESS;
+}
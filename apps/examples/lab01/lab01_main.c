@@ -17,10 +17,14 @@
 #include <nuttx/config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <arpa/inet.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <errno.h>
 
@@ -31,6 +35,25 @@
 /** @brief Tamaño del buffer para envío y recepción de mensajes. */
 #define BUFFER_SIZE 1024
 
+/** @brief Tamaño de los buffers de cada conexión y datagrama del servidor. */
+#define CONN_BUFSIZE 256
+
+/** @brief Espacio reservado en txbuf para una respuesta ("Error: ..."). */
+#define RESPONSE_MAX 32
+
+/** @brief Número máximo de clientes TCP simultáneos del servidor. */
+#define SERVER_MAXCONNS CONFIG_EXAMPLES_LAB01_MAXCONNS
+
+/** @brief Datagramas UDP procesados por cada despertar del servidor. */
+#define SERVER_UDP_BATCH CONFIG_EXAMPLES_LAB01_UDP_BATCH
+
+/** @brief Eventos de epoll: clientes más el listener TCP y el socket UDP. */
+#define SERVER_MAXEVENTS (SERVER_MAXCONNS + 2)
+
+/** @brief Valores de data.u32 en epoll: índice del pool o estos sockets. */
+#define SERVER_TCP_ID    SERVER_MAXCONNS
+#define SERVER_UDP_ID    (SERVER_MAXCONNS + 1)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -45,8 +68,58 @@ struct args_s
   char *server_ip; /**< Dirección IP del servidor al que conectarse (modo cliente). */
   int port;        /**< Puerto de conexión o escucha. */
   char *mode;      /**< Modo de operación: "client" o "server". */
+  bool quiet;      /**< El servidor no imprime cada mensaje. */
+};
+
+/**
+ * @struct conn_s
+ * @brief Conexión TCP del pool fijo del servidor.
+ *
+ * Si el cliente termina sus mensajes con '\n' se pueden encadenar varios
+ * en un mismo segmento y cada respuesta lleva también un '\n'.  Si no, cada
+ * recv() es un mensaje, igual que con lab01_pc.
+ */
+struct conn_s
+{
+  int fd;                        /**< Socket del cliente, -1 si está libre. */
+  uint32_t events;               /**< Eventos registrados en epoll. */
+  bool framed;                   /**< El cliente delimita con '\n'. */
+  size_t rxlen;                  /**< Bytes recibidos aún sin procesar. */
+  size_t txlen;                  /**< Bytes de respuesta aún sin enviar. */
+  char ip[INET_ADDRSTRLEN];      /**< IP del cliente para el log. */
+  char rxbuf[CONN_BUFSIZE];      /**< Mensajes recibidos. */
+  char txbuf[CONN_BUFSIZE];      /**< Respuestas pendientes. */
 };
 
+/**
+ * @struct server_s
+ * @brief Estado del servidor basado en eventos.
+ *
+ * Es estático: el servidor no reserva memoria por cliente ni por mensaje.
+ */
+struct server_s
+{
+  struct args_s *args;                         /**< Configuración. */
+  int epfd;                                    /**< Instancia de epoll. */
+  int tcp_sock;                                /**< Listener TCP o -1. */
+  int udp_sock;                                /**< Socket UDP o -1. */
+  bool should_exit;                            /**< Se recibió "EXIT". */
+  struct conn_s conns[SERVER_MAXCONNS];        /**< Pool de conexiones. */
+  struct mmsghdr rxmsgs[SERVER_UDP_BATCH];     /**< Lote de peticiones. */
+  struct mmsghdr txmsgs[SERVER_UDP_BATCH];     /**< Lote de respuestas. */
+  struct iovec rxiov[SERVER_UDP_BATCH];
+  struct iovec txiov[SERVER_UDP_BATCH];
+  struct sockaddr_in addrs[SERVER_UDP_BATCH];  /**< Remitentes del lote. */
+  char rxdata[SERVER_UDP_BATCH][CONN_BUFSIZE];
+  char txdata[SERVER_UDP_BATCH][RESPONSE_MAX];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct server_s g_server;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -102,6 +175,7 @@ static int parse_args(int argc, char *argv[], struct args_s *args)
   args->server_ip = "127.0.0.1";
   args->port = 3001;
   args->mode = NULL;
+  args->quiet = false;
 
   /* First argument is the mode (client/server) because we are running as 'lab01 client ...' */
   if (argc < 2)
@@ -125,6 +199,10 @@ static int parse_args(int argc, char *argv[], struct args_s *args)
         {
           args->port = atoi(argv[++i]);
         }
+      else if (strcmp(argv[i], "quiet") == 0)
+        {
+          args->quiet = true;
+        }
     }
   return 0;
 }
@@ -285,149 +363,507 @@ static int run_client(struct args_s *args)
 }
 
 /**
- * @brief Ejecuta la lógica del servidor en NuttX.
+ * @brief Procesa un mensaje recibido por el servidor.
  *
- * @param args Argumentos de configuración.
- * @return 0 en éxito, 1 en error.
+ * @param server Estado del servidor.
+ * @param host IP del cliente para el log.
+ * @param protocol Protocolo ("TCP" o "UDP").
+ * @param msg Mensaje terminado en '\0'.
+ * @param output Buffer de al menos RESPONSE_MAX bytes para la respuesta.
+ * @return Longitud de la respuesta.
  */
-static int run_server(struct args_s *args)
+static int server_message(struct server_s *server, const char *host,
+                          const char *protocol, const char *msg,
+                          char *output)
 {
-  int server_sock, client_sock;
-  struct sockaddr_in server_addr, client_addr;
-  socklen_t addr_len = sizeof(client_addr);
-  char *buffer;
-  char *response;
-  int is_tcp = (strcasecmp(args->protocol, "TCP") == 0);
-  int should_exit = 0;
+  if (!server->args->quiet)
+    {
+      log_msg(">", host, "client", protocol, msg);
+    }
 
-  buffer = (char *)malloc(BUFFER_SIZE);
-  response = (char *)malloc(BUFFER_SIZE);
+  if (strcasecmp(msg, "EXIT") == 0)
+    {
+      strcpy(output, "EXIT");
+      server->should_exit = true;
+    }
+  else
+    {
+      calculate(msg, output);
+    }
 
-  if (buffer == NULL || response == NULL)
+  if (!server->args->quiet)
     {
-      perror("malloc");
-      if (buffer) free(buffer);
-      if (response) free(response);
-      return 1;
+      log_msg("<", "server", "server", protocol, output);
     }
 
-  if (is_tcp)
+  return strlen(output);
+}
+
+/**
+ * @brief Cierra una conexión y la devuelve al pool.
+ *
+ * @param server Estado del servidor.
+ * @param conn Conexión.
+ */
+static void conn_close(struct server_s *server, struct conn_s *conn)
+{
+  epoll_ctl(server->epfd, EPOLL_CTL_DEL, conn->fd, NULL);
+  close(conn->fd);
+  conn->fd = -1;
+}
+
+/**
+ * @brief Procesa los mensajes completos de una conexión.
+ *
+ * Las respuestas se acumulan en txbuf para enviarlas todas juntas.  Si
+ * txbuf se llena, el resto de los mensajes espera en rxbuf.
+ *
+ * @param server Estado del servidor.
+ * @param conn Conexión.
+ */
+static void conn_process(struct server_s *server, struct conn_s *conn)
+{
+  char *msg = conn->rxbuf;
+  char *end = conn->rxbuf + conn->rxlen;
+  char *nl;
+  int len;
+
+  while (msg < end && !server->should_exit &&
+         conn->txlen + RESPONSE_MAX + 1 <= CONN_BUFSIZE)
+    {
+      nl = memchr(msg, '\n', end - msg);
+      if (nl != NULL)
+        {
+          conn->framed = true;
+        }
+      else if (conn->framed && (msg > conn->rxbuf ||
+                                conn->rxlen < CONN_BUFSIZE - 1))
+        {
+          /* Partial line, wait for the rest of it */
+
+          break;
+        }
+      else
+        {
+          /* One recv() is one message, or the line does not fit */
+
+          nl = end;
+        }
+
+      *nl = '\0';
+      if (nl > msg && nl[-1] == '\r')
+        {
+          nl[-1] = '\0';
+        }
+
+      if (*msg != '\0')
+        {
+          len = server_message(server, conn->ip, "TCP", msg,
+                               conn->txbuf + conn->txlen);
+          conn->txlen += len;
+          if (conn->framed)
+            {
+              conn->txbuf[conn->txlen++] = '\n';
+            }
+        }
+
+      msg = nl < end ? nl + 1 : end;
+    }
+
+  conn->rxlen = end - msg;
+  memmove(conn->rxbuf, msg, conn->rxlen);
+}
+
+/**
+ * @brief Atiende un evento de una conexión TCP.
+ *
+ * Lee lo disponible, procesa todos los mensajes completos y envía todas
+ * sus respuestas con un único send().
+ *
+ * @param server Estado del servidor.
+ * @param conn Conexión.
+ * @param events Eventos de epoll.
+ */
+static void conn_event(struct server_s *server, struct conn_s *conn,
+                       uint32_t events)
+{
+  struct epoll_event ev;
+  ssize_t len;
+
+  if ((events & EPOLLIN) != 0 && conn->rxlen < CONN_BUFSIZE - 1)
     {
-      server_sock = socket(AF_INET, SOCK_STREAM, 0);
+      len = recv(conn->fd, conn->rxbuf + conn->rxlen,
+                 CONN_BUFSIZE - 1 - conn->rxlen, 0);
+      if (len == 0 || (len < 0 && errno != EAGAIN && errno != EINTR))
+        {
+          conn_close(server, conn);
+          return;
+        }
+
+      if (len > 0)
+        {
+          conn->rxlen += len;
+        }
     }
-  else
+  else if ((events & (EPOLLERR | EPOLLHUP)) != 0 && conn->txlen == 0)
+    {
+      conn_close(server, conn);
+      return;
+    }
+
+  conn_process(server, conn);
+
+  /* Each send() that empties txbuf makes room for the responses of the
+   * pipelined messages still waiting in rxbuf.  Answer them now: no new
+   * event may ever arrive for data that is already buffered.
+   */
+
+  while (conn->txlen > 0)
     {
-      server_sock = socket(AF_INET, SOCK_DGRAM, 0);
+      len = send(conn->fd, conn->txbuf, conn->txlen, 0);
+      if (len < 0 && errno != EAGAIN && errno != EINTR)
+        {
+          conn_close(server, conn);
+          return;
+        }
+
+      if (len <= 0)
+        {
+          break;
+        }
+
+      conn->txlen -= len;
+      memmove(conn->txbuf, conn->txbuf + len, conn->txlen);
+      if (conn->txlen > 0 || conn->rxlen == 0)
+        {
+          break;
+        }
+
+      conn_process(server, conn);
     }
 
-  if (server_sock < 0)
+  /* Wait for room to send before reading more, so that a client that does
+   * not read its answers cannot make the server buffer without limit.
+   */
+
+  ev.events = conn->txlen > 0 ? EPOLLOUT : EPOLLIN;
+  if (ev.events != conn->events)
     {
-      perror("socket");
-      free(buffer);
-      free(response);
-      return 1;
+      ev.data.u32 = conn - server->conns;
+      epoll_ctl(server->epfd, EPOLL_CTL_MOD, conn->fd, &ev);
+      conn->events = ev.events;
+    }
+}
+
+/**
+ * @brief Acepta todas las conexiones pendientes del listener TCP.
+ *
+ * @param server Estado del servidor.
+ */
+static void server_accept(struct server_s *server)
+{
+  struct sockaddr_in client_addr;
+  struct epoll_event ev;
+  struct conn_s *conn;
+  socklen_t addr_len;
+  int fd;
+  int i;
+
+  for (; ; )
+    {
+      addr_len = sizeof(client_addr);
+      fd = accept4(server->tcp_sock, (struct sockaddr *)&client_addr,
+                   &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0)
+        {
+          if (errno != EAGAIN && errno != EINTR)
+            {
+              perror("accept");
+            }
+
+          return;
+        }
+
+      for (i = 0; i < SERVER_MAXCONNS; i++)
+        {
+          if (server->conns[i].fd < 0)
+            {
+              break;
+            }
+        }
+
+      if (i == SERVER_MAXCONNS)
+        {
+          printf("Too many clients, rejecting %s\n",
+                 inet_ntoa(client_addr.sin_addr));
+          close(fd);
+          continue;
+        }
+
+      conn = &server->conns[i];
+      conn->fd = fd;
+      conn->events = EPOLLIN;
+      conn->framed = false;
+      conn->rxlen = 0;
+      conn->txlen = 0;
+      inet_ntop(AF_INET, &client_addr.sin_addr, conn->ip, sizeof(conn->ip));
+
+      ev.events = EPOLLIN;
+      ev.data.u32 = i;
+      if (epoll_ctl(server->epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        {
+          perror("epoll_ctl");
+          close(fd);
+          conn->fd = -1;
+          continue;
+        }
+
+      if (!server->args->quiet)
+        {
+          printf("Accepted connection from %s\n", conn->ip);
+        }
+    }
+}
+
+/**
+ * @brief Atiende un lote de datagramas UDP.
+ *
+ * Recibe hasta SERVER_UDP_BATCH peticiones con un solo recvmmsg() y envía
+ * todas las respuestas con un solo sendmmsg().
+ *
+ * @param server Estado del servidor.
+ */
+static void server_udp(struct server_s *server)
+{
+  char host[INET_ADDRSTRLEN];
+  int count;
+  int i;
+
+  for (i = 0; i < SERVER_UDP_BATCH; i++)
+    {
+      server->rxiov[i].iov_base = server->rxdata[i];
+      server->rxiov[i].iov_len = CONN_BUFSIZE - 1;
+      memset(&server->rxmsgs[i], 0, sizeof(server->rxmsgs[i]));
+      server->rxmsgs[i].msg_hdr.msg_name = &server->addrs[i];
+      server->rxmsgs[i].msg_hdr.msg_namelen = sizeof(server->addrs[i]);
+      server->rxmsgs[i].msg_hdr.msg_iov = &server->rxiov[i];
+      server->rxmsgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+  count = recvmmsg(server->udp_sock, server->rxmsgs, SERVER_UDP_BATCH,
+                   MSG_DONTWAIT, NULL);
+  if (count <= 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      server->rxdata[i][server->rxmsgs[i].msg_len] = '\0';
+      inet_ntop(AF_INET, &server->addrs[i].sin_addr, host, sizeof(host));
+
+      server->txiov[i].iov_base = server->txdata[i];
+      server->txiov[i].iov_len = server_message(server, host, "UDP",
+                                                server->rxdata[i],
+                                                server->txdata[i]);
+
+      memset(&server->txmsgs[i], 0, sizeof(server->txmsgs[i]));
+      server->txmsgs[i].msg_hdr.msg_name = &server->addrs[i];
+      server->txmsgs[i].msg_hdr.msg_namelen =
+        server->rxmsgs[i].msg_hdr.msg_namelen;
+      server->txmsgs[i].msg_hdr.msg_iov = &server->txiov[i];
+      server->txmsgs[i].msg_hdr.msg_iovlen = 1;
     }
 
+  if (sendmmsg(server->udp_sock, server->txmsgs, count, 0) < 0)
+    {
+      perror("sendmmsg");
+    }
+}
+
+/**
+ * @brief Crea un socket no bloqueante del servidor y lo registra en epoll.
+ *
+ * @param server Estado del servidor.
+ * @param type SOCK_STREAM o SOCK_DGRAM.
+ * @param id Identificador del socket en epoll.
+ * @return El socket, o -1 en error.
+ */
+static int server_socket(struct server_s *server, int type, uint32_t id)
+{
+  struct sockaddr_in server_addr;
+  struct epoll_event ev;
   int opt = 1;
-  setsockopt(server_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+  int sock;
+
+  sock = socket(AF_INET, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (sock < 0)
+    {
+      perror("socket");
+      return -1;
+    }
 
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+  memset(&server_addr, 0, sizeof(server_addr));
   server_addr.sin_family = AF_INET;
-  server_addr.sin_port = htons(args->port);
+  server_addr.sin_port = htons(server->args->port);
   server_addr.sin_addr.s_addr = INADDR_ANY;
 
-  if (bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
+  if (bind(sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
     {
       perror("bind");
-      close(server_sock);
-      free(buffer);
-      free(response);
+      close(sock);
+      return -1;
+    }
+
+  if (type == SOCK_STREAM && listen(sock, SERVER_MAXCONNS) < 0)
+    {
+      perror("listen");
+      close(sock);
+      return -1;
+    }
+
+  ev.events = EPOLLIN;
+  ev.data.u32 = id;
+  if (epoll_ctl(server->epfd, EPOLL_CTL_ADD, sock, &ev) < 0)
+    {
+      perror("epoll_ctl");
+      close(sock);
+      return -1;
+    }
+
+  return sock;
+}
+
+/**
+ * @brief Ejecuta la lógica del servidor en NuttX.
+ *
+ * Un único bucle de epoll atiende el listener TCP, todos los clientes TCP
+ * del pool y el socket UDP, con sockets no bloqueantes.  Con "protocol ALL"
+ * se sirven TCP y UDP a la vez en el mismo puerto.
+ *
+ * @param args Argumentos de configuración.
+ * @return 0 en éxito, 1 en error.
+ */
+static int run_server(struct args_s *args)
+{
+  struct server_s *server = &g_server;
+  struct epoll_event events[SERVER_MAXEVENTS];
+  bool all = (strcasecmp(args->protocol, "ALL") == 0);
+  int ret = 1;
+  int nevents;
+  int i;
+
+  memset(server, 0, sizeof(*server));
+  server->args = args;
+  server->tcp_sock = -1;
+  server->udp_sock = -1;
+
+  for (i = 0; i < SERVER_MAXCONNS; i++)
+    {
+      server->conns[i].fd = -1;
+    }
+
+  server->epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (server->epfd < 0)
+    {
+      perror("epoll_create1");
       return 1;
     }
 
-  if (is_tcp)
+  if (all || strcasecmp(args->protocol, "TCP") == 0)
     {
-      if (listen(server_sock, 5) < 0)
+      server->tcp_sock = server_socket(server, SOCK_STREAM, SERVER_TCP_ID);
+      if (server->tcp_sock < 0)
         {
-          perror("listen");
-          close(server_sock);
-          free(buffer);
-          free(response);
-          return 1;
+          goto errout;
+        }
+    }
+
+  if (all || strcasecmp(args->protocol, "UDP") == 0)
+    {
+      server->udp_sock = server_socket(server, SOCK_DGRAM, SERVER_UDP_ID);
+      if (server->udp_sock < 0)
+        {
+          goto errout;
         }
     }
 
-  printf("Server listening on port %d (%s)\n", args->port, args->protocol);
+  if (server->tcp_sock < 0 && server->udp_sock < 0)
+    {
+      printf("Invalid protocol: %s\n", args->protocol);
+      goto errout;
+    }
+
+  printf("Server listening on port %d (%s, up to %d TCP clients)\n",
+         args->port, args->protocol, SERVER_MAXCONNS);
 
-  while (1)
+  while (!server->should_exit)
     {
-      if (is_tcp)
+      nevents = epoll_wait(server->epfd, events, SERVER_MAXEVENTS, -1);
+      if (nevents < 0)
         {
-          client_sock = accept(server_sock, (struct sockaddr *)&client_addr, &addr_len);
-          if (client_sock < 0)
+          if (errno == EINTR)
             {
-              perror("accept");
               continue;
             }
-          
-          char *client_ip = inet_ntoa(client_addr.sin_addr);
-          
-          while (1)
+
+          perror("epoll_wait");
+          goto errout;
+        }
+
+      for (i = 0; i < nevents && !server->should_exit; i++)
+        {
+          if (events[i].data.u32 == SERVER_TCP_ID)
             {
-              memset(buffer, 0, BUFFER_SIZE);
-              int len = recv(client_sock, buffer, BUFFER_SIZE - 1, 0);
-              if (len <= 0) break;
-              buffer[len] = 0;
-
-              log_msg(">", client_ip, "client", args->protocol, buffer);
-
-              if (strcasecmp(buffer, "EXIT") == 0)
-                {
-                  /* Echo EXIT and close */
-                  log_msg("<", "server", "server", args->protocol, "EXIT");
-                  send(client_sock, "EXIT", 4, 0);
-                  should_exit = 1;
-                  break;
-                }
-
-              calculate(buffer, response);
-              log_msg("<", "server", "server", args->protocol, response);
-              send(client_sock, response, strlen(response), 0);
+              server_accept(server);
+            }
+          else if (events[i].data.u32 == SERVER_UDP_ID)
+            {
+              server_udp(server);
+            }
+          else if (server->conns[events[i].data.u32].fd >= 0)
+            {
+              /* Skip the events of a connection closed in this batch */
+
+              conn_event(server, &server->conns[events[i].data.u32],
+                         events[i].events);
             }
-          close(client_sock);
-          if (should_exit) break;
         }
-      else /* UDP */
+    }
+
+  ret = 0;
+
+errout:
+  for (i = 0; i < SERVER_MAXCONNS; i++)
+    {
+      if (server->conns[i].fd >= 0)
         {
-          memset(buffer, 0, BUFFER_SIZE);
-          int len = recvfrom(server_sock, buffer, BUFFER_SIZE - 1, 0, (struct sockaddr *)&client_addr, &addr_len);
-          if (len > 0)
+          /* Deliver the last answers, "EXIT" included, before closing */
+
+          if (server->conns[i].txlen > 0)
             {
-              buffer[len] = 0;
-              char *client_ip = inet_ntoa(client_addr.sin_addr);
-              
-              log_msg(">", client_ip, "client", args->protocol, buffer);
-
-              if (strcasecmp(buffer, "EXIT") == 0)
-                {
-                   /* UDP doesn't maintain connection, but we can reply EXIT */
-                   log_msg("<", "server", "server", args->protocol, "EXIT");
-                   sendto(server_sock, "EXIT", 4, 0, (struct sockaddr *)&client_addr, addr_len);
-                   break;
-                }
-              else
-                {
-                  calculate(buffer, response);
-                  log_msg("<", "server", "server", args->protocol, response);
-                  sendto(server_sock, response, strlen(response), 0, (struct sockaddr *)&client_addr, addr_len);
-                }
+              send(server->conns[i].fd, server->conns[i].txbuf,
+                   server->conns[i].txlen, 0);
             }
+
+          conn_close(server, &server->conns[i]);
         }
     }
 
-  close(server_sock);
-  free(buffer);
-  free(response);
-  return 0;
+  if (server->tcp_sock >= 0)
+    {
+      close(server->tcp_sock);
+    }
+
+  if (server->udp_sock >= 0)
+    {
+      close(server->udp_sock);
+    }
+
+  close(server->epfd);
+  return ret;
 }
 
 /****************************************************************************
@@ -447,7 +883,7 @@ int main(int argc, FAR char *argv[])
 
   if (parse_args(argc, argv, &args) < 0)
     {
-      printf("Usage: lab01 <client|server> [protocol TCP|UDP] [server IP] [port N]\n");
+      printf("Usage: lab01 <client|server> [protocol TCP|UDP|ALL] [server IP] [port N] [quiet]\n");
       return 1;
     }
 
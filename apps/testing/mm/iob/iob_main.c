@@ -32,6 +32,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <time.h>
 
 #include <iob.h>
 
@@ -48,6 +49,22 @@
 
 #define TEST_COUNT 10000
 
+/* Throughput benchmark: each thread allocates and frees bursts of IOBs.
+ * The bursts of all threads together never exceed half of the IOBs that
+ * are available to throttled allocations, so iob_alloc() cannot deadlock.
+ */
+
+#ifdef CONFIG_SMP
+#  define BENCH_NTHREADS CONFIG_SMP_NCPUS
+#else
+#  define BENCH_NTHREADS 2
+#endif
+
+#define BENCH_COUNT    100000
+#define BENCH_NAVAIL   (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE)
+#define BENCH_BURST    (BENCH_NAVAIL / (2 * BENCH_NTHREADS) > 0 ? \
+                        BENCH_NAVAIL / (2 * BENCH_NTHREADS) : 1)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -155,6 +172,77 @@ FAR static void *thread_throttled(FAR void *arg)
   return NULL;
 }
 
+FAR static void *thread_bench(FAR void *arg)
+{
+  FAR struct iob_s *iobs[BENCH_BURST];
+  bool throttled = (bool)(uintptr_t)arg;
+  int i;
+  int j;
+
+  for (i = 0; i < BENCH_COUNT; i += BENCH_BURST)
+    {
+      for (j = 0; j < BENCH_BURST; j++)
+        {
+          iobs[j] = iob_alloc(throttled);
+        }
+
+      for (j = 0; j < BENCH_BURST; j++)
+        {
+          iob_free(iobs[j]);
+        }
+    }
+
+  return NULL;
+}
+
+static void iob_bench(int nthreads, bool throttled)
+{
+  pthread_t      thread[BENCH_NTHREADS];
+  struct timespec start;
+  struct timespec end;
+  uint64_t       elapsed;
+#ifdef CONFIG_SMP
+  cpu_set_t      cpuset;
+#endif
+  pthread_attr_t attr;
+  int            ret;
+  int            i;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < nthreads; i++)
+    {
+      pthread_attr_init(&attr);
+#ifdef CONFIG_SMP
+      CPU_ZERO(&cpuset);
+      CPU_SET(i, &cpuset);
+      pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpuset);
+#endif
+      ret = pthread_create(&thread[i], &attr, thread_bench,
+                           (FAR void *)(uintptr_t)throttled);
+      ASSERT(ret == 0);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      pthread_join(thread[i], NULL);
+    }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  elapsed = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ull +
+            end.tv_nsec - start.tv_nsec;
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  printf("%s bench: %d threads, burst %d, %llu alloc+free/s\n",
+         throttled ? "throttled" : "nothrottled", nthreads, BENCH_BURST,
+         (unsigned long long)((uint64_t)nthreads * BENCH_COUNT *
+                              1000000000ull / elapsed));
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -389,5 +477,13 @@ int main(int argc, FAR char *argv[])
   printf("throttled thread 1 statistc failed_count %d success_count %d\n",
           failed_count[1], success_count[1]);
 
+  /* Measure the alloc/free throughput with a growing number of threads */
+
+  for (i = 1; i <= BENCH_NTHREADS; i++)
+    {
+      iob_bench(i, false);
+      iob_bench(i, true);
+    }
+
   return 0;
 }
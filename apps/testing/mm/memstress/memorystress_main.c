@@ -27,12 +27,14 @@
 #include <nuttx/config.h>
 #include <stdlib.h>
 #include <debug.h>
+#include <malloc.h>
 #include <stdio.h>
 #include <stddef.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <assert.h>
+#include <time.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -41,6 +43,10 @@
 #define MEMSTRESS_PREFIX "MemoryStress:"
 #define DEBUG_MAGIC 0xaa
 
+/* Operations of a throughput thread between two looks at the clock */
+
+#define BENCH_BATCH 256
+
 #define OPTARG_TO_VALUE(value, type) \
   do \
   { \
@@ -105,6 +111,7 @@ struct memorystress_global_s
   size_t nthreads;
   size_t nodelen;
   uint32_t sleep_us;
+  uint32_t bench_sec;
   bool debug;
 };
 
@@ -120,7 +127,8 @@ static void show_usage(FAR const char *progname)
 {
   printf("\nUsage: %s -m [max allocsize Default:8192] "
          "-n [node length Default:1024] -t [sleep us Default:100]"
-         " -x [nthreads Default:1] -d [debuger mode]\n",
+         " -x [nthreads Default:1] -d [debuger mode]"
+         " -b [seconds]\n",
         progname);
   printf("\nWhere:\n");
   printf("  -m [max-allocsize] max alloc size.\n");
@@ -129,6 +137,8 @@ static void show_usage(FAR const char *progname)
   printf("  -x [nthreads] Enable multi-thread stress testing. \n");
   printf("  -d [debug mode] Helps to localize the problem situation,"
          "there is a lot of information output in this mode.\n");
+  printf("  -b [seconds] Measure the malloc/free throughput of the "
+         "threads for this long instead of checking the data.\n");
   exit(EXIT_FAILURE);
 }
 
@@ -393,10 +403,13 @@ static void global_init(FAR struct memorystress_global_s *global, int argc,
   global->max_allocsize = 8192;
   global->nodelen = 1024;
 
-  while ((ch = getopt(argc, argv, "dm:n:t:x::")) != ERROR)
+  while ((ch = getopt(argc, argv, "b:dm:n:t:x::")) != ERROR)
     {
       switch (ch)
         {
+          case 'b':
+            OPTARG_TO_VALUE(global->bench_sec, uint32_t);
+            break;
           case 'd':
             global->debug = true;
             break;
@@ -443,9 +456,10 @@ static void global_init(FAR struct memorystress_global_s *global, int argc,
 
     syslog(LOG_INFO, MEMSTRESS_PREFIX "\n max_allocsize: %zu\n"
            " nodelen: %zu\n sleep_us: %" PRIu32 "\n nthreads: %zu\n "
-           "debug: %s\n",
+           "debug: %s\n bench_sec: %" PRIu32 "\n",
            global->max_allocsize, global->nodelen, global->sleep_us,
-           global->nthreads, global->debug ? "true" : "false");
+           global->nthreads, global->debug ? "true" : "false",
+           global->bench_sec);
 
     srand(time(NULL));
 }
@@ -486,6 +500,114 @@ FAR void *memorystress_thread(FAR void *arg)
   return NULL;
 }
 
+/****************************************************************************
+ * Name: memorystress_bench_thread
+ *
+ * Description:
+ *   Allocate and free blocks of random size, at random slots of the node
+ *   array, as fast as possible for bench_sec seconds, so that the threads
+ *   contend for the allocator.  Returns the number of operations.
+ *
+ ****************************************************************************/
+
+FAR void *memorystress_bench_thread(FAR void *arg)
+{
+  FAR struct memorystress_global_s *global;
+  struct memorystress_thread_context_s context;
+  FAR struct memorystress_node_s *node;
+  struct timespec now;
+  struct timespec end;
+  uint32_t seed = (uint32_t)rand() | 1;
+  uintptr_t ops = 0;
+  size_t i;
+
+  global = (FAR struct memorystress_global_s *)arg;
+  thread_init(&context, global);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  end.tv_sec += global->bench_sec;
+
+  do
+    {
+      for (i = 0; i < BENCH_BATCH; i++)
+        {
+          node = &context.node_array[randnum(global->nodelen, &seed)];
+          if (node->buf == NULL)
+            {
+              node->size = randnum(global->max_allocsize, &seed) + 1;
+              node->buf = global->func.malloc(node->size);
+              if (node->buf != NULL)
+                {
+                  node->buf[0] = DEBUG_MAGIC;
+                }
+            }
+          else
+            {
+              global->func.freefunc(node->buf);
+              node->buf = NULL;
+            }
+        }
+
+      ops += BENCH_BATCH;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+    }
+  while (now.tv_sec < end.tv_sec ||
+         (now.tv_sec == end.tv_sec && now.tv_nsec < end.tv_nsec));
+
+  for (i = 0; i < global->nodelen; i++)
+    {
+      global->func.freefunc(context.node_array[i].buf);
+    }
+
+  free(context.node_array);
+  return (FAR void *)ops;
+}
+
+/****************************************************************************
+ * Name: memorystress_bench
+ *
+ * Description:
+ *   Run the throughput threads and report the operations per second.  The
+ *   heap usage before and after the run shows whether the accounting of
+ *   the allocator kept track of all blocks.
+ *
+ ****************************************************************************/
+
+static int memorystress_bench(FAR struct memorystress_global_s *global)
+{
+  struct mallinfo before;
+  struct mallinfo after;
+  FAR void *ops;
+  uintptr_t total = 0;
+  size_t i;
+
+  before = mallinfo();
+  for (i = 0; i < global->nthreads; i++)
+    {
+      if (pthread_create(&global->threads[i], NULL,
+                         memorystress_bench_thread, global) != 0)
+        {
+          syslog(LOG_ERR, "Failed to create thread\n");
+          global->nthreads = i;
+          break;
+        }
+    }
+
+  for (i = 0; i < global->nthreads; i++)
+    {
+      pthread_join(global->threads[i], &ops);
+      syslog(LOG_INFO, MEMSTRESS_PREFIX "thread %zu: %lu ops/s\n", i,
+             (unsigned long)((uintptr_t)ops / global->bench_sec));
+      total += (uintptr_t)ops;
+    }
+
+  after = mallinfo();
+  syslog(LOG_INFO, MEMSTRESS_PREFIX "total: %lu ops/s, %zu threads\n",
+         (unsigned long)(total / global->bench_sec), global->nthreads);
+  syslog(LOG_INFO, MEMSTRESS_PREFIX "in use before: %lu after: %lu\n",
+         (unsigned long)before.uordblks, (unsigned long)after.uordblks);
+  return 0;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -500,6 +622,11 @@ int main(int argc, FAR char *argv[])
   int i;
 
   global_init(&global, argc, argv);
+  if (global.bench_sec > 0)
+    {
+      return memorystress_bench(&global);
+    }
+
   syslog(LOG_INFO, MEMSTRESS_PREFIX "testing...\n");
   for (i = 0; i < global.nthreads; i++)
     {
@@ -0,0 +1,66 @@
+/****************************************************************************
+ * apps/testing/nettest/udp/test_udp.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "test_udp.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  const struct CMUnitTest udp_tests[] =
+    {
+      cmocka_unit_test_setup_teardown(test_udp_reuseport_bind,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_precedence,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_reuseport_spread,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_reuseport_throughput,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_mmsg_batch,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_mmsg_waitforone,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+      cmocka_unit_test_setup_teardown(test_udp_mmsg_timeout,
+                                      test_udp_common_setup,
+                                      test_udp_common_teardown),
+    };
+
+  return cmocka_run_group_tests(udp_tests, test_udp_group_setup,
+                                test_udp_group_teardown);
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * apps/testing/nettest/udp/test_udp.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_TESTING_NETTEST_UDP_TEST_UDP_H
+#define __APPS_TESTING_NETTEST_UDP_TEST_UDP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/compiler.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of sockets sharing the port in the SO_REUSEPORT tests */
+
+#define NETTEST_UDP_NSOCKS 4
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct nettest_udp_state_s
+{
+  int fds[NETTEST_UDP_NSOCKS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: test_udp_group_setup
+ ****************************************************************************/
+
+int test_udp_group_setup(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_group_teardown
+ ****************************************************************************/
+
+int test_udp_group_teardown(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_common_setup
+ ****************************************************************************/
+
+int test_udp_common_setup(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_common_teardown
+ ****************************************************************************/
+
+int test_udp_common_teardown(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_reuseport_bind
+ ****************************************************************************/
+
+void test_udp_reuseport_bind(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_precedence
+ ****************************************************************************/
+
+void test_udp_precedence(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_reuseport_spread
+ ****************************************************************************/
+
+void test_udp_reuseport_spread(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_reuseport_throughput
+ ****************************************************************************/
+
+void test_udp_reuseport_throughput(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_mmsg_batch
+ ****************************************************************************/
+
+void test_udp_mmsg_batch(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_mmsg_waitforone
+ ****************************************************************************/
+
+void test_udp_mmsg_waitforone(FAR void **state);
+
+/****************************************************************************
+ * Name: test_udp_mmsg_timeout
+ ****************************************************************************/
+
+void test_udp_mmsg_timeout(FAR void **state);
+
+#endif /* __APPS_TESTING_NETTEST_UDP_TEST_UDP_H */
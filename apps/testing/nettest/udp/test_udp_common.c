@@ -0,0 +1,98 @@
+/****************************************************************************
+ * apps/testing/nettest/udp/test_udp_common.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <cmocka.h>
+
+#include "test_udp.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: test_udp_group_setup
+ ****************************************************************************/
+
+int test_udp_group_setup(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = zalloc(sizeof(*udp_state));
+  assert_non_null(udp_state);
+
+  *state = udp_state;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: test_udp_group_teardown
+ ****************************************************************************/
+
+int test_udp_group_teardown(FAR void **state)
+{
+  free(*state);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: test_udp_common_setup
+ ****************************************************************************/
+
+int test_udp_common_setup(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  int i;
+
+  for (i = 0; i < NETTEST_UDP_NSOCKS; i++)
+    {
+      udp_state->fds[i] = -1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: test_udp_common_teardown
+ ****************************************************************************/
+
+int test_udp_common_teardown(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  int i;
+
+  for (i = 0; i < NETTEST_UDP_NSOCKS; i++)
+    {
+      if (udp_state->fds[i] >= 0)
+        {
+          close(udp_state->fds[i]);
+          udp_state->fds[i] = -1;
+        }
+    }
+
+  return 0;
+}
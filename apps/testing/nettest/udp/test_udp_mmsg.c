@@ -0,0 +1,298 @@
+/****************************************************************************
+ * apps/testing/nettest/udp/test_udp_mmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+
+#include "test_udp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_PORT        CONFIG_TESTING_NET_UDP_PORT
+#define TEST_VLEN        8
+#define TEST_NSEND       4
+#define TEST_RCVTIMEO_MS 200
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct test_udp_batch_s
+{
+  struct mmsghdr msgs[TEST_VLEN];
+  struct iovec   iovs[TEST_VLEN];
+  uint32_t       values[TEST_VLEN];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Point each message of the batch at its own 32-bit value, sent to 'addr'
+ * if not NULL.
+ */
+
+static void test_udp_batch_init(FAR struct test_udp_batch_s *batch,
+                                FAR struct sockaddr_in *addr)
+{
+  int i;
+
+  memset(batch, 0, sizeof(*batch));
+
+  for (i = 0; i < TEST_VLEN; i++)
+    {
+      batch->values[i]        = i;
+      batch->iovs[i].iov_base = &batch->values[i];
+      batch->iovs[i].iov_len  = sizeof(batch->values[i]);
+
+      batch->msgs[i].msg_hdr.msg_iov    = &batch->iovs[i];
+      batch->msgs[i].msg_hdr.msg_iovlen = 1;
+
+      if (addr != NULL)
+        {
+          batch->msgs[i].msg_hdr.msg_name    = addr;
+          batch->msgs[i].msg_hdr.msg_namelen = sizeof(*addr);
+        }
+    }
+}
+
+/* Bind the receiver with a receive timeout, so that a blocking call fails
+ * with EAGAIN instead of hanging the test, and create the sender.
+ */
+
+static void test_udp_mmsg_open(FAR struct nettest_udp_state_s *udp_state,
+                               FAR struct sockaddr_in *addr)
+{
+  struct timeval tv;
+  int ret;
+
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_family      = AF_INET;
+  addr->sin_port        = htons(TEST_PORT);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  udp_state->fds[0] = socket(PF_INET, SOCK_DGRAM, 0);
+  assert_return_code(udp_state->fds[0], errno);
+
+  ret = bind(udp_state->fds[0], (FAR struct sockaddr *)addr,
+             sizeof(*addr));
+  assert_return_code(ret, errno);
+
+  tv.tv_sec  = 0;
+  tv.tv_usec = TEST_RCVTIMEO_MS * 1000;
+  ret = setsockopt(udp_state->fds[0], SOL_SOCKET, SO_RCVTIMEO, &tv,
+                   sizeof(tv));
+  assert_return_code(ret, errno);
+
+  udp_state->fds[1] = socket(PF_INET, SOCK_DGRAM, 0);
+  assert_return_code(udp_state->fds[1], errno);
+}
+
+/* Send the first 'count' values of a batch and wait for them to arrive */
+
+static void test_udp_mmsg_send(FAR struct nettest_udp_state_s *udp_state,
+                               FAR struct sockaddr_in *addr, int count)
+{
+  struct test_udp_batch_s batch;
+  int ret;
+  int i;
+
+  test_udp_batch_init(&batch, addr);
+
+  ret = sendmmsg(udp_state->fds[1], batch.msgs, count, 0);
+  assert_int_equal(ret, count);
+
+  for (i = 0; i < count; i++)
+    {
+      assert_int_equal(batch.msgs[i].msg_len, sizeof(uint32_t));
+    }
+
+  usleep(TEST_RCVTIMEO_MS * 1000);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: test_udp_mmsg_batch
+ ****************************************************************************/
+
+void test_udp_mmsg_batch(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  struct test_udp_batch_s batch;
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(int);
+  int errcode = 0;
+  int ret;
+  int i;
+
+  test_udp_mmsg_open(udp_state, &addr);
+
+  /* A batch larger than what is queued returns the queued messages, in
+   * order, without waiting for the rest.
+   */
+
+  test_udp_mmsg_send(udp_state, &addr, TEST_NSEND);
+
+  test_udp_batch_init(&batch, NULL);
+  memset(batch.values, 0xff, sizeof(batch.values));
+
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, MSG_DONTWAIT,
+                 NULL);
+  assert_int_equal(ret, TEST_NSEND);
+
+  for (i = 0; i < TEST_NSEND; i++)
+    {
+      assert_int_equal(batch.msgs[i].msg_len, sizeof(uint32_t));
+      assert_int_equal(batch.values[i], i);
+    }
+
+  /* Nothing left: the whole call fails */
+
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, MSG_DONTWAIT,
+                 NULL);
+  assert_int_equal(ret, -1);
+  assert_int_equal(errno, EAGAIN);
+
+  /* A send batch stops at the first message that fails, here for lack of
+   * a destination, and reports the error of that message via SO_ERROR.
+   */
+
+  test_udp_batch_init(&batch, &addr);
+  batch.msgs[2].msg_hdr.msg_name    = NULL;
+  batch.msgs[2].msg_hdr.msg_namelen = 0;
+
+  ret = sendmmsg(udp_state->fds[1], batch.msgs, TEST_NSEND, 0);
+  assert_int_equal(ret, 2);
+
+  ret = getsockopt(udp_state->fds[1], SOL_SOCKET, SO_ERROR, &errcode,
+                   &len);
+  assert_return_code(ret, errno);
+  assert_int_not_equal(errcode, 0);
+}
+
+/****************************************************************************
+ * Name: test_udp_mmsg_waitforone
+ ****************************************************************************/
+
+void test_udp_mmsg_waitforone(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  struct test_udp_batch_s batch;
+  struct sockaddr_in addr;
+  struct timespec start;
+  struct timespec end;
+  long elapsed_ms;
+  int ret;
+
+  test_udp_mmsg_open(udp_state, &addr);
+  test_udp_mmsg_send(udp_state, &addr, 2);
+
+  /* The call blocks for the first message only, so it returns what is
+   * queued well before the receive timeout expires.
+   */
+
+  test_udp_batch_init(&batch, NULL);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, MSG_WAITFORONE,
+                 NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  assert_int_equal(ret, 2);
+
+  elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 +
+               (end.tv_nsec - start.tv_nsec) / 1000000;
+  assert_true(elapsed_ms < TEST_RCVTIMEO_MS);
+
+  /* With nothing queued it still waits for the first one */
+
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, MSG_WAITFORONE,
+                 NULL);
+  assert_int_equal(ret, -1);
+  assert_int_equal(errno, EAGAIN);
+}
+
+/****************************************************************************
+ * Name: test_udp_mmsg_timeout
+ ****************************************************************************/
+
+void test_udp_mmsg_timeout(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  struct test_udp_batch_s batch;
+  struct sockaddr_in addr;
+  struct timespec timeout;
+  int ret;
+
+  test_udp_mmsg_open(udp_state, &addr);
+  test_udp_mmsg_send(udp_state, &addr, TEST_NSEND);
+
+  /* The timeout is checked after each message, so an expired one ends the
+   * batch after the first message and reports no time left.
+   */
+
+  test_udp_batch_init(&batch, NULL);
+
+  timeout.tv_sec  = 0;
+  timeout.tv_nsec = 0;
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, 0, &timeout);
+  assert_int_equal(ret, 1);
+  assert_int_equal(timeout.tv_sec, 0);
+  assert_int_equal(timeout.tv_nsec, 0);
+
+  /* A timeout that does not expire lets the batch run until the queue is
+   * empty, where the receive timeout of the socket ends it, and the time
+   * spent waiting is taken from it.
+   */
+
+  timeout.tv_sec  = 10;
+  timeout.tv_nsec = 0;
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, 0, &timeout);
+  assert_int_equal(ret, TEST_NSEND - 1);
+  assert_true(timeout.tv_sec < 10);
+
+  /* An invalid timeout is rejected */
+
+  timeout.tv_nsec = 1000000000;
+  ret = recvmmsg(udp_state->fds[0], batch.msgs, TEST_VLEN, 0, &timeout);
+  assert_int_equal(ret, -1);
+  assert_int_equal(errno, EINVAL);
+}
@@ -0,0 +1,437 @@
+/****************************************************************************
+ * apps/testing/nettest/udp/test_udp_reuseport.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "test_udp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_PORT        CONFIG_TESTING_NET_UDP_PORT
+#define TEST_NFLOWS      32
+#define TEST_FLOW_COUNT  16
+#define TEST_TPUT_COUNT  64
+#define TEST_RCVTIMEO_MS 200
+#define TEST_PACE_MS     10
+#define TEST_LOSS_PCT    10
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct test_udp_receiver_s
+{
+  pthread_t tid;
+  int       fd;
+  int       total;
+  int       flows[TEST_NFLOWS];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void test_udp_addr(FAR struct sockaddr_in *addr, in_addr_t ipaddr,
+                          int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_family      = AF_INET;
+  addr->sin_port        = htons(port);
+  addr->sin_addr.s_addr = ipaddr;
+}
+
+/* Create a UDP socket with the socket option 'opt' set (if not zero) and
+ * bind it to the address.  Returns the socket or -1 with errno set.
+ */
+
+static int test_udp_bind(int opt, in_addr_t ipaddr, int port)
+{
+  struct sockaddr_in addr;
+  int optval = 1;
+  int errcode;
+  int fd;
+
+  fd = socket(PF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    {
+      return -1;
+    }
+
+  test_udp_addr(&addr, ipaddr, port);
+  if ((opt != 0 &&
+       setsockopt(fd, SOL_SOCKET, opt, &optval, sizeof(optval)) < 0) ||
+      bind(fd, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+      errcode = errno;
+      close(fd);
+      errno = errcode;
+      return -1;
+    }
+
+  return fd;
+}
+
+static uint64_t test_udp_gettime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* Count the datagrams of each flow received by one member of the group,
+ * until none arrives for TEST_RCVTIMEO_MS.
+ */
+
+static FAR void *test_udp_receiver(FAR void *arg)
+{
+  FAR struct test_udp_receiver_s *rcvr = arg;
+  uint32_t flow;
+
+  while (recv(rcvr->fd, &flow, sizeof(flow), 0) == sizeof(flow))
+    {
+      if (flow < TEST_NFLOWS)
+        {
+          rcvr->flows[flow]++;
+          rcvr->total++;
+        }
+    }
+
+  return NULL;
+}
+
+/* Bind 'nsocks' members of a SO_REUSEPORT group, each drained by its own
+ * thread, then send 'count' rounds of one datagram per flow, each flow from
+ * its own source port.  Sleep TEST_PACE_MS after each round if 'pace' is
+ * set, so that the receivers keep up.  Returns the number of datagrams
+ * sent, and the time until the last one was received in 'elapsed'.
+ */
+
+static int test_udp_group_run(FAR struct nettest_udp_state_s *udp_state,
+                              FAR struct test_udp_receiver_s *rcvrs,
+                              int nsocks, int count, bool pace,
+                              FAR uint64_t *elapsed)
+{
+  in_addr_t lo = htonl(INADDR_LOOPBACK);
+  int flowfds[TEST_NFLOWS];
+  struct sockaddr_in addr;
+  struct timeval tv;
+  uint64_t start;
+  uint32_t flow;
+  int nflows;
+  int nsent = 0;
+  int ret;
+  int i;
+  int j;
+
+  memset(rcvrs, 0, nsocks * sizeof(*rcvrs));
+
+  tv.tv_sec  = 0;
+  tv.tv_usec = TEST_RCVTIMEO_MS * 1000;
+
+  for (i = 0; i < nsocks; i++)
+    {
+      udp_state->fds[i] = test_udp_bind(SO_REUSEPORT, lo, TEST_PORT);
+      assert_return_code(udp_state->fds[i], errno);
+
+      ret = setsockopt(udp_state->fds[i], SOL_SOCKET, SO_RCVTIMEO, &tv,
+                       sizeof(tv));
+      assert_return_code(ret, errno);
+
+      rcvrs[i].fd = udp_state->fds[i];
+      ret = pthread_create(&rcvrs[i].tid, NULL, test_udp_receiver,
+                           &rcvrs[i]);
+      assert_int_equal(ret, 0);
+    }
+
+  for (nflows = 0; nflows < TEST_NFLOWS; nflows++)
+    {
+      flowfds[nflows] = test_udp_bind(0, lo, TEST_PORT + 1 + nflows);
+      if (flowfds[nflows] < 0)
+        {
+          break;
+        }
+    }
+
+  test_udp_addr(&addr, lo, TEST_PORT);
+  start = test_udp_gettime();
+
+  for (j = 0; j < count && nflows == TEST_NFLOWS; j++)
+    {
+      for (flow = 0; flow < TEST_NFLOWS; flow++)
+        {
+          ret = sendto(flowfds[flow], &flow, sizeof(flow), 0,
+                       (FAR struct sockaddr *)&addr, sizeof(addr));
+          if (ret == sizeof(flow))
+            {
+              nsent++;
+            }
+        }
+
+      if (pace)
+        {
+          usleep(TEST_PACE_MS * 1000);
+        }
+    }
+
+  for (i = 0; i < nflows; i++)
+    {
+      close(flowfds[i]);
+    }
+
+  for (i = 0; i < nsocks; i++)
+    {
+      pthread_join(rcvrs[i].tid, NULL);
+    }
+
+  *elapsed = test_udp_gettime() - start -
+             TEST_RCVTIMEO_MS * 1000000ull;
+
+  assert_int_equal(nflows, TEST_NFLOWS);
+  return nsent;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: test_udp_reuseport_bind
+ ****************************************************************************/
+
+void test_udp_reuseport_bind(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  in_addr_t lo = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(int);
+  int optval = 0;
+  int fd;
+  int ret;
+
+  /* Without SO_REUSEPORT the port can be bound only once */
+
+  udp_state->fds[0] = test_udp_bind(0, lo, TEST_PORT);
+  assert_return_code(udp_state->fds[0], errno);
+
+  fd = test_udp_bind(0, lo, TEST_PORT);
+  assert_int_equal(fd, -1);
+  assert_int_equal(errno, EADDRINUSE);
+
+  close(udp_state->fds[0]);
+  udp_state->fds[0] = -1;
+
+  /* With SO_REUSEPORT set on every socket it is shared */
+
+  udp_state->fds[0] = test_udp_bind(SO_REUSEPORT, lo, TEST_PORT);
+  assert_return_code(udp_state->fds[0], errno);
+
+  udp_state->fds[1] = test_udp_bind(SO_REUSEPORT, lo, TEST_PORT);
+  assert_return_code(udp_state->fds[1], errno);
+
+  ret = getsockopt(udp_state->fds[1], SOL_SOCKET, SO_REUSEPORT, &optval,
+                   &len);
+  assert_return_code(ret, errno);
+  assert_int_equal(optval, 1);
+
+  /* But not with a socket that did not set it */
+
+  fd = test_udp_bind(0, lo, TEST_PORT);
+  assert_int_equal(fd, -1);
+  assert_int_equal(errno, EADDRINUSE);
+}
+
+/****************************************************************************
+ * Name: test_udp_precedence
+ ****************************************************************************/
+
+void test_udp_precedence(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  in_addr_t lo = htonl(INADDR_LOOPBACK);
+  struct sockaddr_in addr;
+  uint32_t value = 0;
+  int order;
+  int ret;
+  int i;
+  int j;
+
+  test_udp_addr(&addr, lo, TEST_PORT);
+
+  /* fds[0] is bound to the wildcard address and fds[1] to the destination
+   * address, which receives the datagram whichever was bound first.
+   */
+
+  for (order = 0; order < 2; order++)
+    {
+      for (i = 0; i < 2; i++)
+        {
+          j = i ^ order;
+          udp_state->fds[j] = test_udp_bind(SO_REUSEADDR,
+                                            j == 0 ? INADDR_ANY : lo,
+                                            TEST_PORT);
+          assert_return_code(udp_state->fds[j], errno);
+        }
+
+      udp_state->fds[2] = socket(PF_INET, SOCK_DGRAM, 0);
+      assert_return_code(udp_state->fds[2], errno);
+
+      ret = sendto(udp_state->fds[2], &value, sizeof(value), 0,
+                   (FAR struct sockaddr *)&addr, sizeof(addr));
+      assert_int_equal(ret, sizeof(value));
+
+      usleep(TEST_RCVTIMEO_MS * 1000);
+
+      ret = recv(udp_state->fds[1], &value, sizeof(value), MSG_DONTWAIT);
+      assert_int_equal(ret, sizeof(value));
+
+      ret = recv(udp_state->fds[0], &value, sizeof(value), MSG_DONTWAIT);
+      assert_int_equal(ret, -1);
+
+      test_udp_common_teardown(state);
+    }
+}
+
+/****************************************************************************
+ * Name: test_udp_reuseport_spread
+ ****************************************************************************/
+
+void test_udp_reuseport_spread(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  struct test_udp_receiver_s rcvrs[NETTEST_UDP_NSOCKS];
+  uint64_t elapsed;
+  uint32_t flow;
+  int expected = TEST_NFLOWS * TEST_FLOW_COUNT;
+  int nmembers = 0;
+  int nsent;
+  int nrecv = 0;
+  int i;
+  int j;
+
+  nsent = test_udp_group_run(udp_state, rcvrs, NETTEST_UDP_NSOCKS,
+                             TEST_FLOW_COUNT, true, &elapsed);
+
+  /* Every datagram of a flow reaches the same member of the group, and
+   * the flows are spread over all of them.
+   */
+
+  for (i = 0; i < NETTEST_UDP_NSOCKS; i++)
+    {
+      for (flow = 0; flow < TEST_NFLOWS; flow++)
+        {
+          for (j = 0; j < NETTEST_UDP_NSOCKS; j++)
+            {
+              assert_false(j != i && rcvrs[i].flows[flow] > 0 &&
+                           rcvrs[j].flows[flow] > 0);
+            }
+        }
+
+      nrecv += rcvrs[i].total;
+      if (rcvrs[i].total > 0)
+        {
+          nmembers++;
+        }
+
+      printf("socket %d: %d datagrams\n", i, rcvrs[i].total);
+    }
+
+  assert_int_equal(nmembers, NETTEST_UDP_NSOCKS);
+
+  /* The sender is paced, but loopback may still drop a few datagrams when
+   * it runs out of buffers.
+   */
+
+  assert_true(nrecv <= nsent);
+  assert_true(nrecv >= expected - expected * TEST_LOSS_PCT / 100);
+
+  printf("%d of %d datagrams over %d sockets in %llu us\n", nrecv, nsent,
+         NETTEST_UDP_NSOCKS, (unsigned long long)(elapsed / 1000));
+}
+
+/****************************************************************************
+ * Name: test_udp_reuseport_throughput
+ ****************************************************************************/
+
+void test_udp_reuseport_throughput(FAR void **state)
+{
+  FAR struct nettest_udp_state_s *udp_state = *state;
+  struct test_udp_receiver_s rcvrs[NETTEST_UDP_NSOCKS];
+  uint64_t rate[2];
+  uint64_t elapsed;
+  int nsocks;
+  int nsent;
+  int nrecv;
+  int run;
+  int i;
+
+  /* Send the same flows as fast as possible, first to a single socket and
+   * then to a group that shares the port, and compare how many datagrams
+   * per second each one receives.
+   */
+
+  for (run = 0; run < 2; run++)
+    {
+      nsocks = run == 0 ? 1 : NETTEST_UDP_NSOCKS;
+      nsent  = test_udp_group_run(udp_state, rcvrs, nsocks,
+                                  TEST_TPUT_COUNT, false, &elapsed);
+
+      nrecv = 0;
+      for (i = 0; i < nsocks; i++)
+        {
+          assert_true(rcvrs[i].total > 0);
+          nrecv += rcvrs[i].total;
+        }
+
+      assert_true(nrecv <= nsent);
+
+      rate[run] = elapsed > 0 ? nrecv * 1000000000ull / elapsed : 0;
+      printf("%d socket(s): %d of %d datagrams, %llu datagrams/s\n",
+             nsocks, nrecv, nsent, (unsigned long long)rate[run]);
+
+      test_udp_common_teardown(state);
+    }
+
+  if (rate[0] > 0)
+    {
+      printf("%d sockets vs 1: %llu%%\n", NETTEST_UDP_NSOCKS,
+             (unsigned long long)(rate[1] * 100 / rate[0]));
+    }
+}
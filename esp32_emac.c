@@ -187,9 +187,10 @@ struct esp32_emac_s
 
   struct net_driver_s   dev;         /* Interface understood by the network */
 
-  uint8_t               ifup    : 1; /* true:ifup false:ifdown */
-  uint8_t               mbps100 : 1; /* 100MBps operation (vs 10 MBps) */
-  uint8_t               fduplex : 1; /* Full (vs. half) duplex */
+  uint8_t               ifup     : 1; /* true:ifup false:ifdown */
+  uint8_t               mbps100  : 1; /* 100MBps operation (vs 10 MBps) */
+  uint8_t               fduplex  : 1; /* Full (vs. half) duplex */
+  uint8_t               txqueued : 1; /* TX frames queued since last kick */
 
   struct wdog_s         txtimeout;   /* TX timeout timer */
 
@@ -799,8 +800,9 @@ static void emac_deinit_dma(struct esp32_emac_s *priv)
  * Function: emac_transmit
  *
  * Description:
- *   Start hardware transmission.  Called either from the txdone interrupt
- *   handling or from watchdog based polling.
+ *   Hand the frame in d_buf over to the TX DMA.  The DMA is not kicked
+ *   here, emac_txkick() must be called once the current burst of frames
+ *   has been queued.
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
@@ -815,7 +817,6 @@ static void emac_deinit_dma(struct esp32_emac_s *priv)
 
 static int emac_transmit(struct esp32_emac_s *priv)
 {
-  int ret;
   struct emac_txdesc_s *txcur = priv->txcur;
 
   if (txcur->ctrl & EMAC_TXDMA_OWN)
@@ -834,14 +835,45 @@ static int emac_transmit(struct esp32_emac_s *priv)
   txcur->ext_ctrl = priv->dev.d_len;
 
   priv->txcur = txcur->next;
-
-  emac_set_reg(EMAC_DMA_STR_OFFSET, 0);
+  priv->txqueued = 1;
 
   ninfo("d_buf=%p d_len=%d\n", priv->dev.d_buf, priv->dev.d_len);
 
   priv->dev.d_buf = NULL;
   priv->dev.d_len = 0;
 
+  return 0;
+}
+
+/****************************************************************************
+ * Function: emac_txkick
+ *
+ * Description:
+ *   Start hardware transmission of the frames queued by emac_transmit().
+ *   The TX DMA poll demand register is written and the TX timeout
+ *   watchdog is restarted once per burst rather than once per frame.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void emac_txkick(struct esp32_emac_s *priv)
+{
+  int ret;
+
+  if (!priv->txqueued)
+    {
+      return;
+    }
+
+  priv->txqueued = 0;
+
+  emac_set_reg(EMAC_DMA_STR_OFFSET, 0);
+
   /* Setup the TX timeout watchdog (perhaps restarting the timer) */
 
   ret = wd_start(&priv->txtimeout, EMAC_TX_TO,
@@ -849,10 +881,7 @@ static int emac_transmit(struct esp32_emac_s *priv)
   if (ret)
     {
       nerr("ERROR: Failed to start TX timeout timer");
-      return ret;
     }
-
-  return 0;
 }
 
 /****************************************************************************
@@ -1364,16 +1393,31 @@ static void emac_rx_interrupt_work(void *arg)
 {
   struct esp32_emac_s *priv = (struct esp32_emac_s *)arg;
   struct net_driver_s *dev = &priv->dev;
-
-  net_lock();
+  struct eth_hdr_s *eth_hdr;
 
   /* Loop while while emac_recvframe() successfully retrieves valid
-   * Ethernet frames.
+   * Ethernet frames.  The network is locked for one frame at a time
+   * rather than for the whole batch so that socket calls from other
+   * threads are not starved while a burst of frames is received.  The
+   * device lock serializes the use of d_buf with the TX poll.
    */
 
-  while (emac_recvframe(priv) == 0)
+  for (; ; )
     {
-      struct eth_hdr_s *eth_hdr = (struct eth_hdr_s *)dev->d_buf;
+      net_lock();
+      netdev_lock(dev);
+
+      if (emac_recvframe(priv) != 0)
+        {
+          /* Send the replies to the whole burst at once */
+
+          emac_txkick(priv);
+          netdev_unlock(dev);
+          net_unlock();
+          break;
+        }
+
+      eth_hdr = (struct eth_hdr_s *)dev->d_buf;
 
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the packet tap
@@ -1460,9 +1504,10 @@ static void emac_rx_interrupt_work(void *arg)
           dev->d_buf = NULL;
           dev->d_len = 0;
         }
-    }
 
-  net_unlock();
+      netdev_unlock(dev);
+      net_unlock();
+    }
 }
 
 /****************************************************************************
@@ -1631,6 +1676,7 @@ static void emac_dopoll(struct esp32_emac_s *priv)
 {
   struct net_driver_s *dev = &priv->dev;
 
+  netdev_lock(dev);
   if (!TX_IS_BUSY(priv))
     {
       DEBUGASSERT(dev->d_len == 0 && dev->d_buf == NULL);
@@ -1640,12 +1686,14 @@ static void emac_dopoll(struct esp32_emac_s *priv)
         {
           /* never reach */
 
+          netdev_unlock(dev);
           return;
         }
 
       dev->d_len = EMAC_BUF_LEN;
 
       devif_poll(dev, emac_txpoll);
+      emac_txkick(priv);
 
       if (dev->d_buf)
         {
@@ -1655,6 +1703,8 @@ static void emac_dopoll(struct esp32_emac_s *priv)
           dev->d_len = 0;
         }
     }
+
+  netdev_unlock(dev);
 }
 
 /****************************************************************************
@@ -11,8 +11,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <time.h>
@@ -25,6 +29,25 @@
 /** @brief Tamaño del buffer para envío y recepción de mensajes. */
 #define BUFFER_SIZE 1024
 
+/** @brief Número máximo de peticiones en vuelo por flujo en modo bench. */
+#define BENCH_MAX_DEPTH 64
+
+/** @brief Tiempo tras el cual una petición sin respuesta se da por perdida. */
+#define BENCH_TIMEOUT_NS 1000000000ull
+
+/** @brief Espera máxima de poll() cuando no hay envíos pendientes (ms). */
+#define BENCH_POLL_MS 10
+
+/**
+ * @brief Bits de sub-bucket del histograma (2^5 = 32 por potencia de dos).
+ *
+ * Con 32 sub-buckets por octava el error relativo de cada valor registrado
+ * es menor al 3.2%, igual que un histograma HDR con 2 dígitos significativos.
+ */
+#define BENCH_SUB_BITS  5
+#define BENCH_SUB_COUNT (1 << BENCH_SUB_BITS)
+#define BENCH_HIST_SIZE ((64 - BENCH_SUB_BITS + 1) * BENCH_SUB_COUNT)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -38,7 +61,65 @@ struct pc_args_s
   char *protocol;  /**< Protocolo a utilizar: "TCP" o "UDP". */
   char *server_ip; /**< Dirección IP del servidor al que conectarse (modo cliente). */
   int port;        /**< Puerto de conexión o escucha. */
-  char *mode;      /**< Modo de operación: "client" o "server". */
+  char *mode;      /**< Modo de operación: "client", "server" o "bench". */
+  int conns;       /**< Modo bench: número de conexiones TCP o flujos UDP. */
+  int rate;        /**< Modo bench: peticiones/s en total, 0 sin límite. */
+  int duration;    /**< Modo bench: duración de la prueba en segundos. */
+  int depth;       /**< Modo bench: peticiones en vuelo por flujo. */
+};
+
+/**
+ * @struct bench_hist_s
+ * @brief Histograma log-lineal (estilo HDR) de tiempos de ida y vuelta.
+ */
+struct bench_hist_s
+{
+  uint64_t counts[BENCH_HIST_SIZE]; /**< Muestras por bucket. */
+  uint64_t total;                   /**< Número total de muestras. */
+  uint64_t sum;                     /**< Suma de las muestras en ns. */
+  uint64_t min;                     /**< Muestra mínima en ns. */
+  uint64_t max;                     /**< Muestra máxima en ns. */
+};
+
+/**
+ * @struct bench_slot_s
+ * @brief Petición en vuelo de un flujo.
+ */
+struct bench_slot_s
+{
+  bool busy;         /**< La petición espera respuesta. */
+  unsigned int seq;  /**< Número de secuencia enviado en la petición. */
+  uint64_t sched;    /**< Instante de envío programado en ns. */
+};
+
+/**
+ * @struct bench_gate_s
+ * @brief Arranque simultáneo de todos los flujos del modo bench.
+ */
+struct bench_gate_s
+{
+  pthread_mutex_t lock;  /**< Protege los campos siguientes. */
+  pthread_cond_t cond;   /**< Señala cambios de 'ready' y 'go'. */
+  int ready;             /**< Flujos listos (conectados o fallidos). */
+  int go;                /**< Los flujos pueden empezar. */
+  uint64_t start;        /**< Instante de inicio común en ns. */
+  uint64_t duration;     /**< Duración de la prueba en ns, 0 para abortar. */
+};
+
+/**
+ * @struct bench_flow_s
+ * @brief Estado y resultados de un flujo (un hilo, un socket) en modo bench.
+ */
+struct bench_flow_s
+{
+  struct pc_args_s *args;      /**< Argumentos de configuración. */
+  struct bench_gate_s *gate;   /**< Arranque común de los flujos. */
+  pthread_t thread;            /**< Hilo que ejecuta el flujo. */
+  uint64_t sent;               /**< Peticiones enviadas. */
+  uint64_t received;           /**< Respuestas válidas recibidas. */
+  uint64_t lost;               /**< Peticiones sin respuesta (timeout). */
+  uint64_t errors;             /**< Errores de socket o respuestas inválidas. */
+  struct bench_hist_s hist;    /**< Histograma de RTT del flujo. */
 };
 
 /****************************************************************************
@@ -96,6 +177,10 @@ static int parse_args(int argc, char *argv[], struct pc_args_s *args)
   args->server_ip = "127.0.0.1";
   args->port = 3001;
   args->mode = NULL;
+  args->conns = 1;
+  args->rate = 0;
+  args->duration = 10;
+  args->depth = 1;
 
   /* First argument is the mode (client/server) because we are running as 'lab01 client ...' */
   if (argc < 2)
@@ -119,6 +204,22 @@ static int parse_args(int argc, char *argv[], struct pc_args_s *args)
         {
           args->port = atoi(argv[++i]);
         }
+      else if (strcmp(argv[i], "conns") == 0 && i + 1 < argc)
+        {
+          args->conns = atoi(argv[++i]);
+        }
+      else if (strcmp(argv[i], "rate") == 0 && i + 1 < argc)
+        {
+          args->rate = atoi(argv[++i]);
+        }
+      else if (strcmp(argv[i], "duration") == 0 && i + 1 < argc)
+        {
+          args->duration = atoi(argv[++i]);
+        }
+      else if (strcmp(argv[i], "depth") == 0 && i + 1 < argc)
+        {
+          args->depth = atoi(argv[++i]);
+        }
     }
   return 0;
 }
@@ -342,28 +443,85 @@ static int run_server(struct pc_args_s *args)
           
           char *client_ip = inet_ntoa(client_addr.sin_addr);
           printf("Accepted connection from %s\n", client_ip);
-          
-          while (1)
+
+          /* Requests ending in '\n' may be pipelined, and then each answer
+           * ends in '\n' too.  Otherwise one recv() is one message.
+           */
+
+          size_t rxlen = 0;
+          bool framed = false;
+
+          while (!should_exit)
             {
-              memset(buffer, 0, BUFFER_SIZE);
-              int len = recv(client_sock, buffer, BUFFER_SIZE - 1, 0);
+              int len = recv(client_sock, buffer + rxlen,
+                             BUFFER_SIZE - 1 - rxlen, 0);
               if (len <= 0) break;
-              buffer[len] = 0;
+              rxlen += len;
+              buffer[rxlen] = 0;
 
-              log_msg(">", client_ip, "client", args->protocol, buffer);
+              char *msg = buffer;
+              char *end = buffer + rxlen;
 
-              if (strcasecmp(buffer, "EXIT") == 0)
+              while (msg < end && !should_exit)
                 {
-                  /* Echo EXIT and close */
-                  log_msg("<", "server", "server", args->protocol, "EXIT");
-                  send(client_sock, "EXIT", 4, 0);
-                  should_exit = 1;
-                  break;
+                  char *nl = strchr(msg, '\n');
+
+                  if (nl != NULL)
+                    {
+                      framed = true;
+                    }
+                  else if (framed && (msg > buffer ||
+                                      rxlen < BUFFER_SIZE - 1))
+                    {
+                      /* Partial line, wait for the rest of it */
+
+                      break;
+                    }
+                  else
+                    {
+                      nl = end;
+                    }
+
+                  *nl = 0;
+                  if (nl > msg && nl[-1] == '\r')
+                    {
+                      nl[-1] = 0;
+                    }
+
+                  if (*msg != 0)
+                    {
+                      log_msg(">", client_ip, "client", args->protocol, msg);
+
+                      if (strcasecmp(msg, "EXIT") == 0)
+                        {
+                          /* Echo EXIT and close */
+
+                          strcpy(response, "EXIT");
+                          should_exit = 1;
+                        }
+                      else
+                        {
+                          calculate(msg, response);
+                        }
+
+                      log_msg("<", "server", "server", args->protocol,
+                              response);
+                      if (framed)
+                        {
+                          strcat(response, "\n");
+                        }
+
+                      /* A client may close with answers still in flight */
+
+                      send(client_sock, response, strlen(response),
+                           MSG_NOSIGNAL);
+                    }
+
+                  msg = nl < end ? nl + 1 : end;
                 }
 
-              calculate(buffer, response);
-              log_msg("<", "server", "server", args->protocol, response);
-              send(client_sock, response, strlen(response), 0);
+              rxlen = end - msg;
+              memmove(buffer, msg, rxlen);
             }
           close(client_sock);
           if (should_exit) break;
@@ -400,6 +558,535 @@ static int run_server(struct pc_args_s *args)
   return 0;
 }
 
+/**
+ * @brief Obtiene el tiempo monótono actual en nanosegundos.
+ *
+ * @return Tiempo en ns.
+ */
+static uint64_t bench_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Calcula el bucket del histograma para un valor.
+ *
+ * Los valores menores que 2 * BENCH_SUB_COUNT tienen un bucket propio, a
+ * partir de ahí cada potencia de dos se divide en BENCH_SUB_COUNT buckets.
+ *
+ * @param value Valor en ns.
+ * @return Índice del bucket.
+ */
+static int bench_hist_index(uint64_t value)
+{
+  int msb;
+  int shift;
+
+  if (value < BENCH_SUB_COUNT)
+    {
+      return (int)value;
+    }
+
+  msb = 63 - __builtin_clzll(value);
+  shift = msb - BENCH_SUB_BITS;
+  return (shift + 1) * BENCH_SUB_COUNT +
+         (int)((value >> shift) - BENCH_SUB_COUNT);
+}
+
+/**
+ * @brief Obtiene el mayor valor que cae en un bucket del histograma.
+ *
+ * @param index Índice del bucket.
+ * @return Valor en ns.
+ */
+static uint64_t bench_hist_value(int index)
+{
+  uint64_t sub;
+  int shift;
+
+  if (index < BENCH_SUB_COUNT)
+    {
+      return (uint64_t)index;
+    }
+
+  shift = index / BENCH_SUB_COUNT - 1;
+  sub = (uint64_t)(index % BENCH_SUB_COUNT + BENCH_SUB_COUNT);
+  return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Registra una muestra en el histograma.
+ *
+ * @param hist Histograma.
+ * @param value Valor en ns.
+ */
+static void bench_hist_record(struct bench_hist_s *hist, uint64_t value)
+{
+  hist->counts[bench_hist_index(value)]++;
+  hist->sum += value;
+
+  if (hist->total == 0 || value < hist->min)
+    {
+      hist->min = value;
+    }
+
+  if (value > hist->max)
+    {
+      hist->max = value;
+    }
+
+  hist->total++;
+}
+
+/**
+ * @brief Acumula un histograma en otro.
+ *
+ * @param dst Histograma destino.
+ * @param src Histograma origen.
+ */
+static void bench_hist_merge(struct bench_hist_s *dst,
+                             const struct bench_hist_s *src)
+{
+  int i;
+
+  if (src->total == 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < BENCH_HIST_SIZE; i++)
+    {
+      dst->counts[i] += src->counts[i];
+    }
+
+  if (dst->total == 0 || src->min < dst->min)
+    {
+      dst->min = src->min;
+    }
+
+  if (src->max > dst->max)
+    {
+      dst->max = src->max;
+    }
+
+  dst->sum += src->sum;
+  dst->total += src->total;
+}
+
+/**
+ * @brief Obtiene un percentil del histograma.
+ *
+ * @param hist Histograma.
+ * @param percentile Percentil entre 0 y 100.
+ * @return Valor en ns del percentil (cota superior de su bucket).
+ */
+static uint64_t bench_hist_percentile(const struct bench_hist_s *hist,
+                                      double percentile)
+{
+  uint64_t target;
+  uint64_t count = 0;
+  uint64_t value;
+  int i;
+
+  target = (uint64_t)(percentile / 100.0 * hist->total + 0.5);
+  if (target == 0)
+    {
+      target = 1;
+    }
+
+  for (i = 0; i < BENCH_HIST_SIZE; i++)
+    {
+      count += hist->counts[i];
+      if (count >= target)
+        {
+          value = bench_hist_value(i);
+          return value < hist->max ? value : hist->max;
+        }
+    }
+
+  return hist->max;
+}
+
+/**
+ * @brief Marca un flujo como listo y espera la señal de arranque.
+ *
+ * @param gate Arranque común de los flujos.
+ */
+static void bench_gate_wait(struct bench_gate_s *gate)
+{
+  pthread_mutex_lock(&gate->lock);
+  gate->ready++;
+  pthread_cond_broadcast(&gate->cond);
+
+  while (!gate->go)
+    {
+      pthread_cond_wait(&gate->cond, &gate->lock);
+    }
+
+  pthread_mutex_unlock(&gate->lock);
+}
+
+/**
+ * @brief Procesa una respuesta recibida por un flujo.
+ *
+ * La petición "<seq>+0" se responde con "<seq>", lo que permite asociar
+ * cada respuesta con su petición aunque lleguen desordenadas (UDP).
+ *
+ * @param flow Flujo.
+ * @param slots Peticiones en vuelo.
+ * @param depth Número de slots.
+ * @param buffer Respuesta terminada en '\0'.
+ * @param now Instante de recepción en ns.
+ * @return 1 si la respuesta completó una petición, 0 en caso contrario.
+ */
+static int bench_response(struct bench_flow_s *flow,
+                          struct bench_slot_s *slots, int depth,
+                          const char *buffer, uint64_t now)
+{
+  struct bench_slot_s *slot;
+  unsigned long seq;
+  char *end;
+
+  seq = strtoul(buffer, &end, 10);
+  slot = &slots[seq % depth];
+
+  if (end == buffer || !slot->busy || slot->seq != seq)
+    {
+      /* Invalid, or the answer to a request that already timed out */
+
+      flow->errors++;
+      return 0;
+    }
+
+  slot->busy = false;
+  bench_hist_record(&flow->hist, now - slot->sched);
+  flow->received++;
+  return 1;
+}
+
+/**
+ * @brief Hilo de un flujo del modo bench.
+ *
+ * Envía peticiones según una planificación fija (rate / conns por flujo)
+ * con hasta 'depth' peticiones en vuelo.  El RTT se mide desde el instante
+ * programado de envío y no desde el real, así los retrasos del propio
+ * generador cuando el servidor se satura cuentan en la latencia
+ * (corrección de "coordinated omission").
+ *
+ * @param arg Puntero a la estructura bench_flow_s del flujo.
+ * @return NULL.
+ */
+static void *bench_worker(void *arg)
+{
+  struct bench_flow_s *flow = (struct bench_flow_s *)arg;
+  struct pc_args_s *args = flow->args;
+  struct bench_slot_s slots[BENCH_MAX_DEPTH];
+  struct sockaddr_in server_addr;
+  struct pollfd pfd;
+  char buffer[BUFFER_SIZE];
+  char rxbuf[BUFFER_SIZE];
+  size_t rxlen = 0;
+  char *line;
+  char *nl;
+  int is_tcp = (strcasecmp(args->protocol, "TCP") == 0);
+  int depth = args->depth;
+  int outstanding = 0;
+  unsigned int seq = 0;
+  uint64_t interval = 0;
+  uint64_t next_send;
+  uint64_t end;
+  uint64_t now;
+  int timeout;
+  int sock;
+  int len;
+  int i;
+
+  memset(slots, 0, sizeof(slots));
+
+  sock = socket(AF_INET, is_tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+  if (sock < 0)
+    {
+      perror("socket");
+      flow->errors++;
+      bench_gate_wait(flow->gate);
+      return NULL;
+    }
+
+  memset(&server_addr, 0, sizeof(server_addr));
+  server_addr.sin_family = AF_INET;
+  server_addr.sin_port = htons(args->port);
+  server_addr.sin_addr.s_addr = inet_addr(args->server_ip);
+
+  /* UDP sockets are connected too, so each flow has its own source port
+   * and only receives the answers of the server.
+   */
+
+  if (connect(sock, (struct sockaddr *)&server_addr,
+              sizeof(server_addr)) < 0)
+    {
+      perror("connect");
+      flow->errors++;
+      close(sock);
+      bench_gate_wait(flow->gate);
+      return NULL;
+    }
+
+  if (args->rate > 0)
+    {
+      interval = 1000000000ull * args->conns / args->rate;
+    }
+
+  bench_gate_wait(flow->gate);
+
+  next_send = flow->gate->start;
+  end = flow->gate->start + flow->gate->duration;
+
+  pfd.fd = sock;
+  pfd.events = POLLIN;
+
+  for (; ; )
+    {
+      now = bench_now();
+
+      /* Send every request that is due, as long as there is a free slot */
+
+      while (now < end && outstanding < depth && now >= next_send &&
+             !slots[seq % depth].busy)
+        {
+          /* TCP requests end in '\n' so that the server can split the
+           * ones that a single segment carries.
+           */
+
+          len = snprintf(buffer, sizeof(buffer), is_tcp ? "%u+0\n" : "%u+0",
+                         seq);
+          if (send(sock, buffer, len, 0) != len)
+            {
+              flow->errors++;
+              goto out;
+            }
+
+          slots[seq % depth].busy = true;
+          slots[seq % depth].seq = seq;
+          slots[seq % depth].sched = interval > 0 ? next_send : now;
+
+          /* Sequence numbers must stay representable in the int answer */
+
+          seq = (seq + 1) & 0x7fffffff;
+          next_send = interval > 0 ? next_send + interval : now;
+          outstanding++;
+          flow->sent++;
+        }
+
+      if (now >= end && outstanding == 0)
+        {
+          break;
+        }
+
+      /* Expire the requests that will not be answered anymore */
+
+      for (i = 0; i < depth; i++)
+        {
+          if (slots[i].busy && now - slots[i].sched > BENCH_TIMEOUT_NS)
+            {
+              slots[i].busy = false;
+              outstanding--;
+              flow->lost++;
+            }
+        }
+
+      if (now >= end + BENCH_TIMEOUT_NS)
+        {
+          break;
+        }
+
+      /* Wait for an answer, or until the next request is due */
+
+      timeout = BENCH_POLL_MS;
+      if (now < end && outstanding < depth && next_send > now)
+        {
+          uint64_t wait = (next_send - now + 999999) / 1000000;
+
+          if (wait < (uint64_t)timeout)
+            {
+              timeout = (int)wait;
+            }
+        }
+      else if (now < end && outstanding < depth)
+        {
+          timeout = 0;
+        }
+
+      if (poll(&pfd, 1, timeout) <= 0 || (pfd.revents & POLLIN) == 0)
+        {
+          continue;
+        }
+
+      len = recv(sock, rxbuf + rxlen, sizeof(rxbuf) - 1 - rxlen, 0);
+      if (len <= 0)
+        {
+          if (len < 0 && errno == EINTR)
+            {
+              continue;
+            }
+
+          flow->errors++;
+          break;
+        }
+
+      rxlen += len;
+      rxbuf[rxlen] = 0;
+      now = bench_now();
+
+      if (!is_tcp)
+        {
+          outstanding -= bench_response(flow, slots, depth, rxbuf, now);
+          rxlen = 0;
+          continue;
+        }
+
+      /* TCP answers end in '\n' and may arrive merged or split */
+
+      line = rxbuf;
+      while ((nl = strchr(line, '\n')) != NULL)
+        {
+          *nl = 0;
+          outstanding -= bench_response(flow, slots, depth, line, now);
+          line = nl + 1;
+        }
+
+      rxlen -= line - rxbuf;
+      if (rxlen == sizeof(rxbuf) - 1)
+        {
+          /* No answer is that long */
+
+          flow->errors++;
+          break;
+        }
+
+      memmove(rxbuf, line, rxlen);
+    }
+
+out:
+  close(sock);
+  return NULL;
+}
+
+/**
+ * @brief Ejecuta el modo bench (generador de carga).
+ *
+ * Abre 'conns' conexiones TCP o flujos UDP, cada uno en su propio hilo,
+ * y envía peticiones al servidor durante 'duration' segundos.  Al final
+ * imprime el throughput y los percentiles del RTT de todas las peticiones.
+ *
+ * @param args Argumentos de configuración.
+ * @return 0 en éxito, 1 en error.
+ */
+static int run_bench(struct pc_args_s *args)
+{
+  struct bench_flow_s *flows;
+  struct bench_hist_s *hist;
+  struct bench_gate_s gate;
+  uint64_t sent = 0;
+  uint64_t lost = 0;
+  uint64_t errors = 0;
+  uint64_t elapsed;
+  int created;
+  int ret = 0;
+  int i;
+
+  if (args->conns <= 0 || args->duration <= 0 || args->rate < 0 ||
+      args->depth <= 0 || args->depth > BENCH_MAX_DEPTH)
+    {
+      printf("Invalid bench parameters (depth must be 1..%d)\n",
+             BENCH_MAX_DEPTH);
+      return 1;
+    }
+
+  flows = calloc(args->conns, sizeof(struct bench_flow_s));
+  hist = calloc(1, sizeof(struct bench_hist_s));
+  if (flows == NULL || hist == NULL)
+    {
+      perror("calloc");
+      free(flows);
+      free(hist);
+      return 1;
+    }
+
+  printf("Bench %s:%d via %s: %d flows, rate %d req/s, %d s, depth %d\n",
+         args->server_ip, args->port, args->protocol, args->conns,
+         args->rate, args->duration, args->depth);
+
+  memset(&gate, 0, sizeof(gate));
+  pthread_mutex_init(&gate.lock, NULL);
+  pthread_cond_init(&gate.cond, NULL);
+  gate.duration = (uint64_t)args->duration * 1000000000ull;
+
+  for (created = 0; created < args->conns; created++)
+    {
+      flows[created].args = args;
+      flows[created].gate = &gate;
+
+      if (pthread_create(&flows[created].thread, NULL, bench_worker,
+                         &flows[created]) != 0)
+        {
+          perror("pthread_create");
+          gate.duration = 0;
+          ret = 1;
+          break;
+        }
+    }
+
+  /* Start all flows at once, after every connection is established */
+
+  pthread_mutex_lock(&gate.lock);
+  while (gate.ready < created)
+    {
+      pthread_cond_wait(&gate.cond, &gate.lock);
+    }
+
+  gate.start = bench_now();
+  gate.go = 1;
+  pthread_cond_broadcast(&gate.cond);
+  pthread_mutex_unlock(&gate.lock);
+
+  for (i = 0; i < created; i++)
+    {
+      pthread_join(flows[i].thread, NULL);
+      bench_hist_merge(hist, &flows[i].hist);
+      sent += flows[i].sent;
+      lost += flows[i].lost;
+      errors += flows[i].errors;
+    }
+
+  elapsed = bench_now() - gate.start;
+  pthread_cond_destroy(&gate.cond);
+  pthread_mutex_destroy(&gate.lock);
+
+  printf("Sent %llu, received %llu, lost %llu, errors %llu\n",
+         (unsigned long long)sent, (unsigned long long)hist->total,
+         (unsigned long long)lost, (unsigned long long)errors);
+  printf("Throughput: %.1f req/s\n",
+         elapsed > 0 ? hist->total * 1e9 / elapsed : 0.0);
+
+  if (hist->total > 0)
+    {
+      printf("RTT (us): min %.1f mean %.1f p50 %.1f p99 %.1f "
+             "p99.9 %.1f max %.1f\n",
+             hist->min / 1e3, hist->sum / 1e3 / hist->total,
+             bench_hist_percentile(hist, 50.0) / 1e3,
+             bench_hist_percentile(hist, 99.0) / 1e3,
+             bench_hist_percentile(hist, 99.9) / 1e3,
+             hist->max / 1e3);
+    }
+
+  free(flows);
+  free(hist);
+  return ret;
+}
+
 /**
  * @brief Punto de entrada principal de la aplicación PC.
  *
@@ -414,6 +1101,8 @@ int main(int argc, char *argv[])
   if (parse_args(argc, argv, &args) < 0)
     {
       printf("Usage: ./lab01_pc <client|server> [protocol TCP|UDP] [server IP] [port N]\n");
+      printf("       ./lab01_pc bench [protocol TCP|UDP] [server IP] [port N] [conns N]\n"
+             "                  [rate REQ/S] [duration S] [depth N]\n");
       return 1;
     }
 
@@ -425,6 +1114,10 @@ int main(int argc, char *argv[])
     {
       return run_server(&args);
     }
+  else if (strcasecmp(args.mode, "bench") == 0)
+    {
+      return run_bench(&args);
+    }
   else
     {
       printf("Invalid mode: %s\n", args.mode);
@@ -0,0 +1,68 @@
+/****************************************************************************
+ * arch/arm64/src/common/arm64_chksum.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <arm_neon.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_chksum_block
+ *
+ * Description:
+ *   Sum a block of data as native-endian 16-bit words with NEON.  Each
+ *   UADALP adds two adjacent 16-bit words into a 32-bit lane, a lane takes
+ *   at most 4096 such additions for 64 KiB of data, so it cannot overflow.
+ *
+ ****************************************************************************/
+
+uint32_t up_chksum_block(FAR const void *data, size_t len)
+{
+  FAR const uint16_t *ptr = data;
+  uint32x4_t acc0 = vdupq_n_u32(0);
+  uint32x4_t acc1 = vdupq_n_u32(0);
+  uint64_t acc;
+
+  for (; len > 0; len -= 64, ptr += 32)
+    {
+      acc0 = vpadalq_u16(acc0, vld1q_u16(ptr));
+      acc1 = vpadalq_u16(acc1, vld1q_u16(ptr + 8));
+      acc0 = vpadalq_u16(acc0, vld1q_u16(ptr + 16));
+      acc1 = vpadalq_u16(acc1, vld1q_u16(ptr + 24));
+    }
+
+  acc = vaddlvq_u32(acc0) + vaddlvq_u32(acc1);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  return (uint32_t)acc;
+}
@@ -77,6 +77,9 @@
 #include <linux/sockios.h>
 #include <linux/if_tun.h>
 #include <linux/net.h>
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#  include <linux/virtio_net.h>
+#endif
 #include <netinet/in.h>
 
 #include "sim_internal.h"
@@ -87,6 +90,14 @@
 
 #define DEVTAP        "/dev/net/tun"
 
+/* Frames are written with one extra iovec for the virtio-net header, a TSO
+ * frame can span as many IOBs as 64KiB of payload.
+ */
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#  define TAPDEV_NIOV 1024  /* UIO_MAXIOV of Linux */
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -109,15 +120,24 @@ struct sel_arg_struct
 #ifdef TAPDEV_DEBUG
 static int  gdrop = 0;
 #endif
-static int  gtapdevfd[CONFIG_SIM_NETDEV_NUMBER] =
+static int  gtapdevfd[CONFIG_SIM_NETDEV_NUMBER][CONFIG_SIM_NETDEV_QUEUES] =
 {
-  [0 ... CONFIG_SIM_NETDEV_NUMBER - 1] = -1
+  [0 ... CONFIG_SIM_NETDEV_NUMBER - 1] =
+  {
+    [0 ... CONFIG_SIM_NETDEV_QUEUES - 1] = -1
+  }
 };
 static char gdevname[CONFIG_SIM_NETDEV_NUMBER][IFNAMSIZ];
 static void *g_priv[CONFIG_SIM_NETDEV_NUMBER];
 static void (*g_tx_done_intr_cb[CONFIG_SIM_NETDEV_NUMBER])(void *priv);
 static void (*g_rx_ready_intr_cb[CONFIG_SIM_NETDEV_NUMBER])(void *priv);
 
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+/* Too large for the stack of the NuttX task that sends */
+
+static struct iovec giov[CONFIG_SIM_NETDEV_NUMBER][TAPDEV_NIOV];
+#endif
+
 #ifdef CONFIG_SIM_NET_HOST_ROUTE
 #  ifdef CONFIG_NET_IPv4
 static struct rtentry ghostroute[CONFIG_SIM_NETDEV_NUMBER];
@@ -183,6 +203,19 @@ static void set_macaddr(int devidx)
   sim_netdriver_setmacaddr(devidx, mac);
 }
 
+static void tapdev_close(int *tapdevfd)
+{
+  int queue;
+
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+    {
+      if (tapdevfd[queue] >= 0)
+        {
+          close(tapdevfd[queue]);
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -192,16 +225,22 @@ void sim_tapdev_init(int devidx, void *priv,
                  void (*rx_ready_intr_cb)(void *priv))
 {
   struct ifreq ifr;
-  int tapdevfd;
+  int tapdevfd[CONFIG_SIM_NETDEV_QUEUES];
+  int queue;
   int ret;
   int sockfd;
 
-  /* Open the tap device */
+  /* Open the tap device, each queue has its own file descriptor */
 
-  tapdevfd = open(DEVTAP, O_RDWR, 0644);
-  if (tapdevfd < 0)
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
     {
-      syslog(LOG_ERR, "TAPDEV: open failed: %d\n", -tapdevfd);
+      tapdevfd[queue] = -1;
+    }
+
+  tapdevfd[0] = open(DEVTAP, O_RDWR, 0644);
+  if (tapdevfd[0] < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: open failed: %d\n", -tapdevfd[0]);
       return;
     }
 
@@ -209,14 +248,49 @@ void sim_tapdev_init(int devidx, void *priv,
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
-  ret = ioctl(tapdevfd, TUNSETIFF, (unsigned long) &ifr);
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  ifr.ifr_flags |= IFF_VNET_HDR;
+#endif
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  ifr.ifr_flags |= IFF_MULTI_QUEUE;
+#endif
+  ret = ioctl(tapdevfd[0], TUNSETIFF, (unsigned long) &ifr);
   if (ret < 0)
     {
       syslog(LOG_ERR, "TAPDEV: ioctl failed: %d\n", -ret);
-      close(tapdevfd);
+      tapdev_close(tapdevfd);
       return;
     }
 
+  /* The other queues attach to the interface created by the first one */
+
+  for (queue = 1; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+    {
+      tapdevfd[queue] = open(DEVTAP, O_RDWR, 0644);
+      if (tapdevfd[queue] < 0 ||
+          ioctl(tapdevfd[queue], TUNSETIFF, (unsigned long) &ifr) < 0)
+        {
+          syslog(LOG_ERR, "TAPDEV: can't open queue %d of %s\n",
+                 queue, ifr.ifr_name);
+          tapdev_close(tapdevfd);
+          return;
+        }
+    }
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  /* Let the host hand over frames with a partial checksum.  Frames larger
+   * than the MTU (TUN_F_TSO*) are not accepted, they don't fit the receive
+   * buffer.  The frames we send may use TSO in any case.
+   */
+
+  ret = ioctl(tapdevfd[0], TUNSETOFFLOAD, TUN_F_CSUM);
+  if (ret < 0)
+    {
+      syslog(LOG_WARNING, "TAPDEV: can't enable the RX offload: %d\n",
+             -ret);
+    }
+#endif
+
   /* Save the tap device name */
 
   strncpy(gdevname[devidx], ifr.ifr_name, IFNAMSIZ);
@@ -229,7 +303,7 @@ void sim_tapdev_init(int devidx, void *priv,
   if (sockfd < 0)
     {
       syslog(LOG_ERR, "TAPDEV: Can't open socket: %d\n", -sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd);
       return;
     }
 
@@ -247,7 +321,7 @@ void sim_tapdev_init(int devidx, void *priv,
              "bridge %s): %d\n",
              gdevname[devidx], CONFIG_SIM_NET_BRIDGE_DEVICE, -ret);
       close(sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd);
       return;
     }
 #endif
@@ -261,7 +335,7 @@ void sim_tapdev_init(int devidx, void *priv,
       syslog(LOG_ERR, "TAPDEV: ioctl failed (can't set MTU "
                       "for %s): %d\n", gdevname[devidx], -ret);
       close(sockfd);
-      close(tapdevfd);
+      tapdev_close(tapdevfd);
       return;
     }
 
@@ -271,7 +345,7 @@ void sim_tapdev_init(int devidx, void *priv,
     {
       syslog(LOG_ERR, "TAPDEV: ioctl failed (can't get MTU "
              "from %s): %d\n", gdevname[devidx], -ret);
-      close(tapdevfd);
+      tapdev_close(tapdevfd);
       return;
     }
   else
@@ -279,7 +353,7 @@ void sim_tapdev_init(int devidx, void *priv,
       sim_netdriver_setmtu(devidx, ifr.ifr_mtu);
     }
 
-  gtapdevfd[devidx] = tapdevfd;
+  memcpy(gtapdevfd[devidx], tapdevfd, sizeof(tapdevfd));
   g_priv[devidx] = priv;
 
   /* Register the emulated TX done interrupt callback */
@@ -295,14 +369,15 @@ void sim_tapdev_init(int devidx, void *priv,
   set_macaddr(devidx);
 }
 
-int sim_tapdev_avail(int devidx)
+int sim_tapdev_avail(int devidx, int queue)
 {
+  int tapdevfd = gtapdevfd[devidx][queue];
   struct timeval tv;
   fd_set fdset;
 
   /* We can't do anything if we failed to open the tap device */
 
-  if (gtapdevfd[devidx] < 0)
+  if (tapdevfd < 0)
     {
       return 0;
     }
@@ -313,22 +388,27 @@ int sim_tapdev_avail(int devidx)
   tv.tv_usec = 0;
 
   FD_ZERO(&fdset);
-  FD_SET(gtapdevfd[devidx], &fdset);
+  FD_SET(tapdevfd, &fdset);
 
-  return select(gtapdevfd[devidx] + 1, &fdset, NULL, NULL, &tv) > 0;
+  return select(tapdevfd + 1, &fdset, NULL, NULL, &tv) > 0;
 }
 
-unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
+unsigned int sim_tapdev_read(int devidx, int queue, unsigned char *buf,
                              unsigned int buflen)
 {
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  struct sim_netdev_offload_s hdr;
+
+  return sim_tapdev_readhdr(devidx, queue, &hdr, buf, buflen);
+#else
   int ret;
 
-  if (!sim_tapdev_avail(devidx))
+  if (!sim_tapdev_avail(devidx, queue))
     {
       return 0;
     }
 
-  ret = read(gtapdevfd[devidx], buf, buflen);
+  ret = read(gtapdevfd[devidx][queue], buf, buflen);
   if (ret < 0)
     {
       syslog(LOG_ERR, "TAPDEV: read failed: %d\n", -ret);
@@ -337,13 +417,19 @@ unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
 
   dump_ethhdr("read", buf, ret);
   return ret;
+#endif
 }
 
-void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
+void sim_tapdev_send(int devidx, int queue, unsigned char *buf,
+                     unsigned int buflen)
 {
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  struct iovec iov;
+#else
   int ret;
+#endif
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][queue] < 0)
     {
       return;
     }
@@ -359,7 +445,12 @@ void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
     }
 #endif
 
-  ret = write(gtapdevfd[devidx], buf, buflen);
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  iov.iov_base = buf;
+  iov.iov_len  = buflen;
+  sim_tapdev_sendhdr(devidx, queue, NULL, &iov, 1);
+#else
+  ret = write(gtapdevfd[devidx][queue], buf, buflen);
   if (ret < 0)
     {
       syslog(LOG_ERR, "TAPDEV: write failed: %d\n", -ret);
@@ -367,6 +458,129 @@ void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
     }
 
   dump_ethhdr("write", buf, buflen);
+#endif
+  sim_tapdev_commit(devidx);
+}
+
+void sim_tapdev_sendv(int devidx, int queue, const struct iovec *iov,
+                      int iovcnt)
+{
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  sim_tapdev_sendhdr(devidx, queue, NULL, iov, iovcnt);
+#else
+  int ret;
+
+  if (gtapdevfd[devidx][queue] < 0)
+    {
+      return;
+    }
+
+  /* The TAP device takes one frame per write, gather it from the IOBs */
+
+  ret = writev(gtapdevfd[devidx][queue], iov, iovcnt);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: writev failed: %d\n", -ret);
+      exit(1);
+    }
+
+  dump_ethhdr("write", iov[0].iov_base, iov[0].iov_len);
+#endif
+}
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+unsigned int sim_tapdev_readhdr(int devidx, int queue,
+                                struct sim_netdev_offload_s *hdr,
+                                unsigned char *buf, unsigned int buflen)
+{
+  struct virtio_net_hdr vnet;
+  struct iovec iov[2];
+  int ret;
+
+  memset(hdr, 0, sizeof(*hdr));
+  if (!sim_tapdev_avail(devidx, queue))
+    {
+      return 0;
+    }
+
+  /* Each frame is preceded by the virtio-net header */
+
+  iov[0].iov_base = &vnet;
+  iov[0].iov_len  = sizeof(vnet);
+  iov[1].iov_base = buf;
+  iov[1].iov_len  = buflen;
+
+  ret = readv(gtapdevfd[devidx][queue], iov, 2);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: readv failed: %d\n", -ret);
+      return 0;
+    }
+  else if (ret <= sizeof(vnet))
+    {
+      return 0;
+    }
+
+  hdr->flags      = vnet.flags;
+  hdr->gsotype    = vnet.gso_type;
+  hdr->hdrlen     = vnet.hdr_len;
+  hdr->gsosize    = vnet.gso_size;
+  hdr->csumstart  = vnet.csum_start;
+  hdr->csumoffset = vnet.csum_offset;
+
+  ret -= sizeof(vnet);
+  dump_ethhdr("read", buf, ret);
+  return ret;
+}
+
+void sim_tapdev_sendhdr(int devidx, int queue,
+                        const struct sim_netdev_offload_s *hdr,
+                        const struct iovec *iov, int iovcnt)
+{
+  struct iovec *vec = giov[devidx];
+  struct virtio_net_hdr vnet;
+  int ret;
+
+  if (gtapdevfd[devidx][queue] < 0)
+    {
+      return;
+    }
+
+  if (iovcnt >= TAPDEV_NIOV)
+    {
+      syslog(LOG_ERR, "TAPDEV: too many iovecs: %d\n", iovcnt);
+      return;
+    }
+
+  memset(&vnet, 0, sizeof(vnet));
+  if (hdr != NULL)
+    {
+      vnet.flags       = hdr->flags;
+      vnet.gso_type    = hdr->gsotype;
+      vnet.hdr_len     = hdr->hdrlen;
+      vnet.gso_size    = hdr->gsosize;
+      vnet.csum_start  = hdr->csumstart;
+      vnet.csum_offset = hdr->csumoffset;
+    }
+
+  vec[0].iov_base = &vnet;
+  vec[0].iov_len  = sizeof(vnet);
+  memcpy(&vec[1], iov, iovcnt * sizeof(struct iovec));
+
+  ret = writev(gtapdevfd[devidx][queue], vec, iovcnt + 1);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "TAPDEV: writev failed: %d\n", -ret);
+      exit(1);
+    }
+
+  dump_ethhdr("write", iov[0].iov_base, iov[0].iov_len);
+}
+#endif
+
+void sim_tapdev_commit(int devidx)
+{
+  int queue;
 
   /* Emulate TX done interrupt */
 
@@ -375,11 +589,16 @@ void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen)
       g_tx_done_intr_cb[devidx](g_priv[devidx]);
     }
 
-  /* Emulate RX ready interrupt */
+  /* Emulate RX ready interrupt, the driver looks for the queues ready */
 
-  if (g_rx_ready_intr_cb[devidx] != NULL && sim_tapdev_avail(devidx))
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
     {
-      g_rx_ready_intr_cb[devidx](g_priv[devidx]);
+      if (g_rx_ready_intr_cb[devidx] != NULL &&
+          sim_tapdev_avail(devidx, queue))
+        {
+          g_rx_ready_intr_cb[devidx](g_priv[devidx]);
+          break;
+        }
     }
 }
 
@@ -395,7 +614,7 @@ void sim_tapdev_ifup(int devidx, void *ifaddr)
 #  endif
 #endif
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][0] < 0)
     {
       return;
     }
@@ -480,7 +699,7 @@ void sim_tapdev_ifdown(int devidx)
   int sockfd;
   int ret;
 
-  if (gtapdevfd[devidx] < 0)
+  if (gtapdevfd[devidx][0] < 0)
     {
       return;
     }
@@ -0,0 +1,106 @@
+/****************************************************************************
+ * arch/sim/src/sim/sim_chksum.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The vectors are SSE2 registers, which every x86-64 host has, or AVX2
+ * registers when the simulator is built for such a host (-mavx2).
+ */
+
+#ifdef __AVX2__
+#  define CHKSUM_VEC_SIZE  32
+#else
+#  define CHKSUM_VEC_SIZE  16
+#endif
+
+#define CHKSUM_VEC_LANES   (CHKSUM_VEC_SIZE / 4)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef uint32_t chksum_vec_t __attribute__((vector_size(CHKSUM_VEC_SIZE)));
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_chksum_block
+ *
+ * Description:
+ *   Sum a block of data as native-endian 16-bit words.  The low and high
+ *   halves of each 32-bit lane are accumulated separately, a lane takes
+ *   at most 4096 additions of 16-bit values for 64 KiB of data, so it
+ *   cannot overflow.
+ *
+ ****************************************************************************/
+
+uint32_t up_chksum_block(FAR const void *data, size_t len)
+{
+  FAR const uint8_t *ptr = data;
+  chksum_vec_t lo =
+    {
+      0
+    };
+
+  chksum_vec_t hi =
+    {
+      0
+    };
+
+  chksum_vec_t v;
+  uint64_t acc = 0;
+  int i;
+
+  for (; len > 0; len -= 64, ptr += 64)
+    {
+      for (i = 0; i < 64; i += CHKSUM_VEC_SIZE)
+        {
+          memcpy(&v, ptr + i, CHKSUM_VEC_SIZE);
+          lo += v & 0xffff;
+          hi += v >> 16;
+        }
+    }
+
+  for (i = 0; i < CHKSUM_VEC_LANES; i++)
+    {
+      acc += (uint64_t)lo[i] + hi[i];
+    }
+
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  return (uint32_t)acc;
+}
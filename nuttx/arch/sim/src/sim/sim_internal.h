@@ -66,6 +66,23 @@
 #  define CONFIG_SIM_WIFIDEV_NUMBER 0
 #endif
 
+#ifndef CONFIG_SIM_NETDEV_QUEUES
+#  define CONFIG_SIM_NETDEV_QUEUES 1
+#endif
+
+/* Offload flags and GSO types of sim_netdev_offload_s, the same values as
+ * the virtio-net header that carries them on the TAP device.
+ */
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#  define SIM_NETDEV_NEEDS_CSUM  1  /* Checksum from csumstart is partial */
+#  define SIM_NETDEV_CSUM_VALID  2  /* Checksum is already verified */
+
+#  define SIM_NETDEV_GSO_NONE    0
+#  define SIM_NETDEV_GSO_TCPV4   1
+#  define SIM_NETDEV_GSO_TCPV6   4
+#endif
+
 /* Determine which (if any) console driver to use */
 
 #ifndef CONFIG_DEV_CONSOLE
@@ -204,6 +221,21 @@ typedef size_t xcpt_reg_t;
 
 struct tcb_s;
 struct i2c_master_s;
+struct iovec;
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+/* Offload request passed along with a frame to or from the host */
+
+struct sim_netdev_offload_s
+{
+  uint8_t  flags;      /* SIM_NETDEV_NEEDS_CSUM or SIM_NETDEV_CSUM_VALID */
+  uint8_t  gsotype;    /* SIM_NETDEV_GSO_* */
+  uint16_t hdrlen;     /* Length of the headers to replicate */
+  uint16_t gsosize;    /* Payload bytes per segment */
+  uint16_t csumstart;  /* Offset of the TCP/UDP header */
+  uint16_t csumoffset; /* Offset of the checksum from csumstart */
+};
+#endif
 
 /****************************************************************************
  * Public Data
@@ -368,19 +400,53 @@ int sim_ajoy_initialize(void);
 void sim_tapdev_init(int devidx, void *priv,
                      void (*tx_done_intr_cb)(void *priv),
                      void (*rx_ready_intr_cb)(void *priv));
-int sim_tapdev_avail(int devidx);
-unsigned int sim_tapdev_read(int devidx, unsigned char *buf,
+int sim_tapdev_avail(int devidx, int queue);
+unsigned int sim_tapdev_read(int devidx, int queue, unsigned char *buf,
                              unsigned int buflen);
-void sim_tapdev_send(int devidx, unsigned char *buf, unsigned int buflen);
+void sim_tapdev_send(int devidx, int queue, unsigned char *buf,
+                     unsigned int buflen);
+void sim_tapdev_sendv(int devidx, int queue, const struct iovec *iov,
+                      int iovcnt);
+void sim_tapdev_commit(int devidx);
 void sim_tapdev_ifup(int devidx, void *ifaddr);
 void sim_tapdev_ifdown(int devidx);
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+unsigned int sim_tapdev_readhdr(int devidx, int queue,
+                                struct sim_netdev_offload_s *hdr,
+                                unsigned char *buf, unsigned int buflen);
+void sim_tapdev_sendhdr(int devidx, int queue,
+                        const struct sim_netdev_offload_s *hdr,
+                        const struct iovec *iov, int iovcnt);
+#endif
 
 #  define sim_netdev_init(idx,priv,txcb,rxcb) sim_tapdev_init(idx,priv,txcb,rxcb)
-#  define sim_netdev_avail(idx)               sim_tapdev_avail(idx)
-#  define sim_netdev_read(idx,buf,buflen)     sim_tapdev_read(idx,buf,buflen)
-#  define sim_netdev_send(idx,buf,buflen)     sim_tapdev_send(idx,buf,buflen)
+#  define sim_netdev_avail(idx)               sim_tapdev_avail(idx,0)
+#  define sim_netdev_read(idx,buf,buflen)     sim_tapdev_read(idx,0,buf,buflen)
+#  define sim_netdev_send(idx,buf,buflen)     sim_tapdev_send(idx,0,buf,buflen)
+#  define sim_netdev_sendv(idx,iov,iovcnt)    sim_tapdev_sendv(idx,0,iov,iovcnt)
+#  define sim_netdev_commit(idx)              sim_tapdev_commit(idx)
 #  define sim_netdev_ifup(idx,ifaddr)         sim_tapdev_ifup(idx,ifaddr)
 #  define sim_netdev_ifdown(idx)              sim_tapdev_ifdown(idx)
+#  ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#    define sim_netdev_readhdr(idx,hdr,buf,buflen) \
+              sim_tapdev_readhdr(idx,0,hdr,buf,buflen)
+#    define sim_netdev_sendhdr(idx,hdr,iov,iovcnt) \
+              sim_tapdev_sendhdr(idx,0,hdr,iov,iovcnt)
+#  endif
+
+/* The same on a queue of the device */
+
+#  define sim_netdev_availq(idx,q)            sim_tapdev_avail(idx,q)
+#  define sim_netdev_readq(idx,q,buf,buflen)  sim_tapdev_read(idx,q,buf,buflen)
+#  define sim_netdev_sendq(idx,q,buf,buflen)  sim_tapdev_send(idx,q,buf,buflen)
+#  define sim_netdev_sendvq(idx,q,iov,iovcnt) \
+            sim_tapdev_sendv(idx,q,iov,iovcnt)
+#  ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#    define sim_netdev_readhdrq(idx,q,hdr,buf,buflen) \
+              sim_tapdev_readhdr(idx,q,hdr,buf,buflen)
+#    define sim_netdev_sendhdrq(idx,q,hdr,iov,iovcnt) \
+              sim_tapdev_sendhdr(idx,q,hdr,iov,iovcnt)
+#  endif
 #endif
 
 /* sim_wpcap.c **************************************************************/
@@ -63,6 +63,7 @@
 
 #include <debug.h>
 #include <string.h>
+#include <sys/uio.h>
 
 #include <nuttx/compiler.h>
 #include <nuttx/kmalloc.h>
@@ -84,6 +85,24 @@
 #  define SIM_NETDEV_RECV_OFFLOAD
 #endif
 
+/* Frames are handed to the host as an iovec of the IOB chain when the
+ * host side supports it, the chain is only linearized if it is longer.
+ */
+
+#if defined(sim_netdev_sendhdr)
+#  define SIM_NETDEV_NIOV (65536 / CONFIG_IOB_BUFSIZE + 2)
+#elif defined(sim_netdev_sendv)
+#  define SIM_NETDEV_NIOV (SIM_NETDEV_BUFSIZE / CONFIG_IOB_BUFSIZE + 2)
+#endif
+
+/* The backends without queues */
+
+#ifndef sim_netdev_availq
+#  define sim_netdev_availq(idx,q)            sim_netdev_avail(idx)
+#  define sim_netdev_readq(idx,q,buf,buflen)  sim_netdev_read(idx,buf,buflen)
+#  define sim_netdev_sendq(idx,q,buf,buflen)  sim_netdev_send(idx,buf,buflen)
+#endif
+
 /* Get index / buffer from dev pointer. */
 
 #define DEVIDX(p) ((struct sim_netdev_s *)(p) - g_sim_dev)
@@ -109,8 +128,17 @@ struct sim_netdev_s
 
 static int netdriver_send(struct netdev_lowerhalf_s *dev, netpkt_t *pkt);
 static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev);
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+static int netdriver_sendq(struct netdev_lowerhalf_s *dev, netpkt_t *pkt,
+                           int queue);
+static netpkt_t *netdriver_recvq(struct netdev_lowerhalf_s *dev,
+                                 int queue);
+#endif
 static int netdriver_ifup(struct netdev_lowerhalf_s *dev);
 static int netdriver_ifdown(struct netdev_lowerhalf_s *dev);
+#ifdef sim_netdev_sendv
+static void netdriver_commit(struct netdev_lowerhalf_s *dev);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -119,42 +147,131 @@ static int netdriver_ifdown(struct netdev_lowerhalf_s *dev);
 /* Ethernet peripheral state */
 
 static struct sim_netdev_s g_sim_dev[CONFIG_SIM_NETDEV_NUMBER];
+
+#ifdef sim_netdev_sendhdr
+/* A TSO frame spans too many IOBs for the iovec to live on the stack */
+
+static struct iovec g_sim_iov[CONFIG_SIM_NETDEV_NUMBER][SIM_NETDEV_NIOV];
+#endif
 static const struct netdev_ops_s g_ops =
 {
-  netdriver_ifup,   /* ifup */
-  netdriver_ifdown, /* ifdown */
-  netdriver_send,   /* transmit */
-  netdriver_recv    /* receive */
+  .ifup     = netdriver_ifup,
+  .ifdown   = netdriver_ifdown,
+  .transmit = netdriver_send,
+  .receive  = netdriver_recv,
+#ifdef sim_netdev_sendv
+  .commit   = netdriver_commit,
+#endif
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  .transmitq = netdriver_sendq,
+  .receiveq  = netdriver_recvq,
+#endif
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static int netdriver_send(struct netdev_lowerhalf_s *dev, netpkt_t *pkt)
+#ifdef sim_netdev_sendhdr
+static void netdriver_offload(struct netdev_lowerhalf_s *dev, netpkt_t *pkt,
+                              struct sim_netdev_offload_s *hdr)
+{
+  struct netdev_offload_s info;
+
+  /* Pass the checksum and TSO requests on to the host kernel */
+
+  memset(hdr, 0, sizeof(*hdr));
+  if (netpkt_getoffload(dev, pkt, &info) < 0 || info.flags == 0)
+    {
+      return;
+    }
+
+  hdr->flags      = SIM_NETDEV_NEEDS_CSUM;
+  hdr->csumstart  = info.csumstart;
+  hdr->csumoffset = info.csumoffset;
+
+  if ((info.flags & NETDEV_OFFLOAD_TSO) != 0)
+    {
+      hdr->gsotype = info.ipv6 ? SIM_NETDEV_GSO_TCPV6 : SIM_NETDEV_GSO_TCPV4;
+      hdr->gsosize = info.gsosize;
+      hdr->hdrlen  = info.hdrlen;
+    }
+}
+#endif
+
+static int netdriver_sendq(struct netdev_lowerhalf_s *dev, netpkt_t *pkt,
+                           int queue)
 {
   unsigned int len  = netpkt_getdatalen(dev, pkt);
+#ifdef sim_netdev_sendv
+#  ifdef sim_netdev_sendhdr
+  struct sim_netdev_offload_s hdr;
+  struct iovec *iov = g_sim_iov[DEVIDX(dev)];
+#  else
+  struct iovec iov[SIM_NETDEV_NIOV];
+#  endif
+  unsigned int total = 0;
+  int iovcnt;
+  int i;
+
+  /* Write the IOB chain without copying it.  The TX done and RX ready
+   * interrupts are emulated once per burst by netdriver_commit().
+   */
+
+  iovcnt = netpkt_to_iov(dev, pkt, iov, SIM_NETDEV_NIOV);
+  for (i = 0; i < iovcnt; i++)
+    {
+      total += iov[i].iov_len;
+    }
+
+  if (total == len)
+    {
+#ifdef sim_netdev_sendhdr
+      netdriver_offload(dev, pkt, &hdr);
+      sim_netdev_sendhdrq(DEVIDX(dev), queue, &hdr, iov, iovcnt);
+#else
+      sim_netdev_sendvq(DEVIDX(dev), queue, iov, iovcnt);
+#endif
+      netpkt_free(dev, pkt, NETPKT_TX);
+      return OK;
+    }
+#endif
 
   if (netpkt_is_fragmented(pkt))
     {
       netpkt_copyout(dev, DEVBUF(dev), pkt, len, 0);
-      sim_netdev_send(DEVIDX(dev), DEVBUF(dev), len);
+      sim_netdev_sendq(DEVIDX(dev), queue, DEVBUF(dev), len);
     }
   else
     {
-      sim_netdev_send(DEVIDX(dev), netpkt_getdata(dev, pkt), len);
+      sim_netdev_sendq(DEVIDX(dev), queue, netpkt_getdata(dev, pkt), len);
     }
 
   netpkt_free(dev, pkt, NETPKT_TX);
   return OK;
 }
 
-static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev)
+static int netdriver_send(struct netdev_lowerhalf_s *dev, netpkt_t *pkt)
 {
+  return netdriver_sendq(dev, pkt, 0);
+}
+
+#ifdef sim_netdev_sendv
+static void netdriver_commit(struct netdev_lowerhalf_s *dev)
+{
+  sim_netdev_commit(DEVIDX(dev));
+}
+#endif
+
+static netpkt_t *netdriver_recvq(struct netdev_lowerhalf_s *dev, int queue)
+{
+#ifdef sim_netdev_readhdr
+  struct sim_netdev_offload_s hdr;
+#endif
   netpkt_t *pkt = NULL;
   unsigned int len;
 
-  if (sim_netdev_avail(DEVIDX(dev)))
+  if (sim_netdev_availq(DEVIDX(dev), queue))
     {
       pkt = netpkt_alloc(dev, NETPKT_RX);
       if (pkt == NULL)
@@ -166,11 +283,19 @@ static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev)
        * on a data received event
        */
 
-#ifdef SIM_NETDEV_RECV_OFFLOAD
-      len = sim_netdev_read(DEVIDX(dev), netpkt_getdata(dev, pkt),
-                            SIM_NETDEV_BUFSIZE);
+#if defined(sim_netdev_readhdr) && defined(SIM_NETDEV_RECV_OFFLOAD)
+      len = sim_netdev_readhdrq(DEVIDX(dev), queue, &hdr,
+                                netpkt_getdata(dev, pkt),
+                                SIM_NETDEV_BUFSIZE);
+#elif defined(sim_netdev_readhdr)
+      len = sim_netdev_readhdrq(DEVIDX(dev), queue, &hdr, DEVBUF(dev),
+                                SIM_NETDEV_BUFSIZE);
+#elif defined(SIM_NETDEV_RECV_OFFLOAD)
+      len = sim_netdev_readq(DEVIDX(dev), queue, netpkt_getdata(dev, pkt),
+                             SIM_NETDEV_BUFSIZE);
 #else
-      len = sim_netdev_read(DEVIDX(dev), DEVBUF(dev), SIM_NETDEV_BUFSIZE);
+      len = sim_netdev_readq(DEVIDX(dev), queue, DEVBUF(dev),
+                             SIM_NETDEV_BUFSIZE);
 #endif
       if (len == 0)
         {
@@ -183,11 +308,27 @@ static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev)
 #else
       netpkt_copyin(dev, pkt, DEVBUF(dev), len, 0);
 #endif
+
+#ifdef sim_netdev_readhdr
+      /* Frames of the host itself come with a partial checksum, that is
+       * left to complete and need not be verified.
+       */
+
+      if ((hdr.flags & (SIM_NETDEV_NEEDS_CSUM | SIM_NETDEV_CSUM_VALID)) != 0)
+        {
+          netpkt_setoffload(dev, pkt, NETDEV_OFFLOAD_CSUMOK);
+        }
+#endif
     }
 
   return pkt;
 }
 
+static netpkt_t *netdriver_recv(struct netdev_lowerhalf_s *dev)
+{
+  return netdriver_recvq(dev, 0);
+}
+
 static int netdriver_ifup(struct netdev_lowerhalf_s *dev)
 {
 #ifdef CONFIG_NET_IPv4
@@ -229,7 +370,19 @@ static void netdriver_txdone_interrupt(void *priv)
 static void netdriver_rxready_interrupt(void *priv)
 {
   struct netdev_lowerhalf_s *dev = (struct netdev_lowerhalf_s *)priv;
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  int queue;
+
+  for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+    {
+      if (sim_netdev_availq(DEVIDX(dev), queue))
+        {
+          netdev_lower_rxready_queue(dev, queue);
+        }
+    }
+#else
   netdev_lower_rxready(dev);
+#endif
 }
 
 /****************************************************************************
@@ -256,6 +409,13 @@ int sim_netdriver_init(void)
       dev->quota[NETPKT_TX] = 1;
       dev->quota[NETPKT_RX] = 1;
       dev->ops              = &g_ops;
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+      dev->nqueues          = CONFIG_SIM_NETDEV_QUEUES;
+#endif
+#ifdef sim_netdev_sendhdr
+      dev->features         = NETDEV_FEATURE_TXCSUM | NETDEV_FEATURE_RXCSUM |
+                              NETDEV_FEATURE_SG | NETDEV_FEATURE_TSO;
+#endif
 
 #if CONFIG_SIM_WIFIDEV_NUMBER != 0
       if (devidx < CONFIG_SIM_WIFIDEV_NUMBER)
@@ -290,6 +450,20 @@ void sim_netdriver_setmtu(int devidx, int mtu)
 void sim_netdriver_loop(void)
 {
   int devidx;
+#if CONFIG_SIM_NETDEV_QUEUES > 1
+  int queue;
+
+  for (devidx = 0; devidx < CONFIG_SIM_NETDEV_NUMBER; devidx++)
+    {
+      for (queue = 0; queue < CONFIG_SIM_NETDEV_QUEUES; queue++)
+        {
+          if (sim_netdev_availq(devidx, queue))
+            {
+              netdev_lower_rxready_queue(&g_sim_dev[devidx].dev, queue);
+            }
+        }
+    }
+#else
   for (devidx = 0; devidx < CONFIG_SIM_NETDEV_NUMBER; devidx++)
     {
       if (sim_netdev_avail(devidx))
@@ -297,4 +471,5 @@ void sim_netdriver_loop(void)
           netdev_lower_rxready(&g_sim_dev[devidx].dev);
         }
     }
+#endif
 }
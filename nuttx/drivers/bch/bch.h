@@ -42,6 +42,19 @@
 
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#ifndef CONFIG_BCH_CACHE_SECTORS
+#  define CONFIG_BCH_CACHE_SECTORS 1
+#endif
+
+#ifndef CONFIG_BCH_CACHE_FLUSH_DIRTY
+#  define CONFIG_BCH_CACHE_FLUSH_DIRTY 0
+#endif
+
+/* The buffer of a sector that bchlib_readsector() brought into the cache */
+
+#define bchlib_sectorbuf(bch, sect) \
+  (&(bch)->buffer[((sect) - (bch)->sector) * (bch)->sectsize])
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -51,13 +64,14 @@ struct bchlib_s
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
+  size_t sector;           /* The first sector in the buffer */
+  size_t count;            /* The number of sectors in the buffer */
+  uint32_t dirty;          /* Bit n set: Sector + n has been written to */
   mutex_t lock;            /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  FAR uint8_t *buffer;     /* CONFIG_BCH_CACHE_SECTORS sector buffer */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -85,6 +99,7 @@ EXTERN const struct file_operations g_bch_fops;
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_dirtysector(FAR struct bchlib_s *bch, size_t sector);
 
 #undef EXTERN
 #if defined(__cplusplus)
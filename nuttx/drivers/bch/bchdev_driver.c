@@ -437,9 +437,11 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
       case BIOC_DISCARD:
         {
-          /* Invalidate the sector so next read is from the device- */
+          /* Invalidate the sectors so next read is from the device- */
 
           bch->sector = (size_t)-1;
+          bch->count  = 0;
+          bch->dirty  = 0;
           goto ioctl_default;
         }
 
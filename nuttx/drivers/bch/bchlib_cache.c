@@ -29,6 +29,8 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <strings.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -62,10 +64,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, size_t sector,
+                      int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)bchlib_sectorbuf(bch, sector);
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -73,7 +76,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -91,6 +94,89 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 }
 #endif
 
+/****************************************************************************
+ * Name: bchlib_writeback
+ *
+ * Description:
+ *   Write a run of consecutive cached sectors to the media
+ *
+ ****************************************************************************/
+
+static int bchlib_writeback(FAR struct bchlib_s *bch, size_t first,
+                            size_t count)
+{
+  FAR struct inode *inode = bch->inode;
+  ssize_t ret;
+#if defined(CONFIG_BCH_ENCRYPTION)
+  size_t i;
+
+  /* Encrypt data as necessary */
+
+  for (i = first; i < first + count; i++)
+    {
+      bch_cypher(bch, i, CYPHER_ENCRYPT);
+    }
+#endif
+
+  ret = inode->u.i_bops->write(inode, bchlib_sectorbuf(bch, first),
+                               first, count);
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  /* Computation overhead to save memory for extra sector buffer
+   * TODO: Add configuration switch for extra sector buffer
+   */
+
+  for (i = first; i < first + count; i++)
+    {
+      bch_cypher(bch, i, CYPHER_DECRYPT);
+    }
+#endif
+
+  if (ret < 0)
+    {
+      ferr("Write failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_fill
+ *
+ * Description:
+ *   Read sectors from the media to the end of the cached ones
+ *
+ ****************************************************************************/
+
+static int bchlib_fill(FAR struct bchlib_s *bch, size_t count)
+{
+  FAR struct inode *inode = bch->inode;
+  size_t first = bch->sector + bch->count;
+  ssize_t ret;
+#if defined(CONFIG_BCH_ENCRYPTION)
+  size_t i;
+#endif
+
+  ret = inode->u.i_bops->read(inode, bchlib_sectorbuf(bch, first),
+                              first, count);
+  if (ret < 0)
+    {
+      ferr("Read failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+  for (i = first; i < first + count; i++)
+    {
+      bch_cypher(bch, i, CYPHER_DECRYPT);
+    }
+#endif
+
+  bch->count += count;
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -108,51 +194,51 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 
 int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  size_t first;
+  size_t last;
+  int ret = OK;
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
+  /* Write each run of consecutive sectors that have been modified and are
+   * out of synch with the media with one request.
    */
 
-  if (bch->dirty && bch->buffer != NULL)
+  if (bch->dirty != 0 && bch->buffer != NULL)
     {
-      inode = bch->inode;
-
-#if defined(CONFIG_BCH_ENCRYPTION)
-      /* Encrypt data as necessary */
-
-      bch_cypher(bch, CYPHER_ENCRYPT);
-#endif
-
-      /* Write the sector to the media */
-
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
+      for (first = 0; first < bch->count; first = last)
         {
-          ferr("Write failed: %zd\n", ret);
-          return (int)ret;
+          if ((bch->dirty & (UINT32_C(1) << first)) == 0)
+            {
+              last = first + 1;
+              continue;
+            }
+
+          for (last = first + 1; last < bch->count; last++)
+            {
+              if ((bch->dirty & (UINT32_C(1) << last)) == 0)
+                {
+                  break;
+                }
+            }
+
+          ret = bchlib_writeback(bch, bch->sector + first, last - first);
+          if (ret < 0)
+            {
+              return ret;
+            }
         }
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-      /* Computation overhead to save memory for extra sector buffer
-       * TODO: Add configuration switch for extra sector buffer
-       */
-
-      bch_cypher(bch, CYPHER_DECRYPT);
-#endif
-
-      /* The sector is now in sync with the media */
+      /* The sectors are now in sync with the media */
 
-      bch->dirty = false;
+      bch->dirty = 0;
     }
 
   if (discard)
     {
       bch->sector = (size_t)-1;
+      bch->count  = 0;
     }
 
-  return (int)ret;
+  return ret;
 }
 
 /****************************************************************************
@@ -168,15 +254,16 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  size_t count = 1;
+  int ret;
 
   if (bch->buffer == NULL)
     {
 #if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-      bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
+      bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT,
+                                 CONFIG_BCH_CACHE_SECTORS * bch->sectsize);
 #else
-      bch->buffer = kmm_malloc(bch->sectsize);
+      bch->buffer = kmm_malloc(CONFIG_BCH_CACHE_SECTORS * bch->sectsize);
 #endif
       if (bch->buffer == NULL)
         {
@@ -185,29 +272,76 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
         }
     }
 
-  if (bch->sector != sector)
+  if (bch->count > 0 && sector >= bch->sector &&
+      sector < bch->sector + bch->count)
     {
-      inode = bch->inode;
+      return OK;
+    }
 
-      ret = bchlib_flushsector(bch, true);
-      if (ret < 0)
+  /* An access right after the cached sectors is sequential: read ahead to
+   * fill the cache, or a whole new cache of sectors if it is full.
+   */
+
+#ifdef CONFIG_BCH_CACHE_READAHEAD
+  if (bch->count > 0 && sector == bch->sector + bch->count)
+    {
+      count = CONFIG_BCH_CACHE_SECTORS - bch->count;
+      if (count == 0)
         {
-          ferr("Flush failed: %zd\n", ret);
-          return (int)ret;
+          count = CONFIG_BCH_CACHE_SECTORS;
         }
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      if (count > bch->nsectors - sector)
+        {
+          count = bch->nsectors - sector;
+        }
+    }
+#endif
+
+  /* Append the sectors if there is room left, else replace the cached
+   * ones.
+   */
+
+  if (bch->count == 0 || sector != bch->sector + bch->count ||
+      bch->count + count > CONFIG_BCH_CACHE_SECTORS)
+    {
+      ret = bchlib_flushsector(bch, true);
       if (ret < 0)
         {
-          ferr("Read failed: %zd\n", ret);
-          return (int)ret;
+          ferr("Flush failed: %d\n", ret);
+          return ret;
         }
 
       bch->sector = sector;
-#if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
-#endif
     }
 
-  return (int)ret;
+  return bchlib_fill(bch, count);
+}
+
+/****************************************************************************
+ * Name: bchlib_dirtysector
+ *
+ * Description:
+ *   Mark a cached sector as modified, and write back the cached sectors if
+ *   there are CONFIG_BCH_CACHE_FLUSH_DIRTY dirty ones now.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_dirtysector(FAR struct bchlib_s *bch, size_t sector)
+{
+  DEBUGASSERT(sector >= bch->sector && sector < bch->sector + bch->count);
+
+  bch->dirty |= UINT32_C(1) << (sector - bch->sector);
+
+#if CONFIG_BCH_CACHE_FLUSH_DIRTY > 0
+  if (popcount(bch->dirty) >= CONFIG_BCH_CACHE_FLUSH_DIRTY)
+    {
+      return bchlib_flushsector(bch, false);
+    }
+#endif
+
+  return OK;
 }
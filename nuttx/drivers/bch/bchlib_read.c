@@ -120,7 +120,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      memcpy(buffer, bchlib_sectorbuf(bch, sector) + sectoffset, nbytes);
 
       /* Adjust pointers and counts */
 
@@ -148,6 +148,19 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
+      /* Write back cached sectors in the range, the media is read directly */
+
+      if (bch->count > 0 && bch->sector < sector + nsectors &&
+          sector < bch->sector + bch->count)
+        {
+          ret = bchlib_flushsector(bch, false);
+          if (ret < 0)
+            {
+              ferr("ERROR: Flush failed: %d\n", ret);
+              return ret;
+            }
+        }
+
       ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
                                        sector, nsectors);
       if (ret < 0)
@@ -185,7 +198,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
 
       /* Copy the head end of the sector to the user buffer */
 
-      memcpy(buffer, bch->buffer, len);
+      memcpy(buffer, bchlib_sectorbuf(bch, sector), len);
 
       /* Adjust counts */
 
@@ -106,8 +106,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      memcpy(bchlib_sectorbuf(bch, sector) + sectoffset, buffer, nbytes);
+      ret = bchlib_dirtysector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust pointers and counts */
 
@@ -143,15 +147,15 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
       /* Copy the data from the user buffer to the sector buffer */
 
       nbytes = len > bch->sectsize ? bch->sectsize : len;
-      memcpy(bch->buffer, buffer, nbytes);
-      bch->dirty = true;
+      memcpy(bchlib_sectorbuf(bch, sector), buffer, nbytes);
 
-      /* Write the sector back to the block device */
+      /* The sector is written back to the block device with the following
+       * ones that are cached, or now if there are enough dirty sectors.
+       */
 
-      ret = bchlib_flushsector(bch, false);
+      ret = bchlib_dirtysector(bch, sector);
       if (ret < 0)
         {
-          ferr("ERROR: Flush failed: %d\n", ret);
           return ret;
         }
 
@@ -175,10 +179,13 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Flush the dirty sector to keep the sector sequence */
+      /* Flush the dirty sectors to keep the sector sequence, and drop the
+       * cached ones if they are overwritten.
+       */
 
-      ret = bchlib_flushsector(bch, sector <= bch->sector &&
-                               bch->sector < (sector + nsectors));
+      ret = bchlib_flushsector(bch, bch->count > 0 &&
+                               bch->sector < sector + nsectors &&
+                               sector < bch->sector + bch->count);
       if (ret < 0)
         {
           ferr("ERROR: Flush failed: %d\n", ret);
@@ -224,8 +231,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
       /* Copy the head end of the sector from the user buffer */
 
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      memcpy(bchlib_sectorbuf(bch, sector), buffer, len);
+      ret = bchlib_dirtysector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust counts */
 
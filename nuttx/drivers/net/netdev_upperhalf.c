@@ -35,10 +35,12 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mutex.h>
 #include <nuttx/net/can.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 
@@ -49,6 +51,7 @@
 #define NETDEV_TX_CONTINUE 1 /* Return value for devif_poll */
 
 #define NETDEV_THREAD_NAME_FMT "netdev-%s"
+#define NETDEV_QUEUE_NAME_FMT  "netdev-%s-%d"
 
 #ifdef CONFIG_NETDEV_HPWORK_THREAD
 #  define NETDEV_WORK HPWORK
@@ -58,10 +61,35 @@
 
 #ifdef CONFIG_NETDEV_RSS
 #  define NETDEV_THREAD_COUNT CONFIG_SMP_NCPUS
+#elif defined(CONFIG_NETDEV_MULTIQUEUE)
+#  define NETDEV_THREAD_COUNT CONFIG_NETDEV_MAX_QUEUES
 #else
 #  define NETDEV_THREAD_COUNT 1
 #endif
 
+/* The threads created for a device, one per queue with multi-queue */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  define NETDEV_THREADS(upper) ((upper)->nqueues)
+#else
+#  define NETDEV_THREADS(upper) NETDEV_THREAD_COUNT
+#endif
+
+#if defined(CONFIG_NETDEV_GSO) && CONFIG_IOB_NCHAINS == 0
+#  error "CONFIG_NETDEV_GSO requires CONFIG_IOB_NCHAINS > 0"
+#endif
+
+#if defined(CONFIG_NETDEV_RPS) && CONFIG_IOB_NCHAINS == 0
+#  error "CONFIG_NETDEV_RPS requires CONFIG_IOB_NCHAINS > 0"
+#endif
+
+/* FNV-1a, to hash the flow of a packet */
+
+#define NETDEV_FLOWHASH_INIT  2166136261u
+#define NETDEV_FLOWHASH_PRIME 16777619u
+
+#define NETDEV_OFFLOAD_TX  (NETDEV_OFFLOAD_CSUM | NETDEV_OFFLOAD_TSO)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,12 +110,70 @@ struct netdev_upperhalf_s
   struct work_s work;
 #endif
 
+  /* The queues, each one polled by its thread */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  int     cpu[NETDEV_THREAD_COUNT]; /* CPU of the thread, -1 for any */
+  uint8_t nqueues;                  /* Number of queues and threads */
+#endif
+
+  /* Packets steered to each queue by the thread of queue 0 */
+
+#ifdef CONFIG_NETDEV_RPS
+  bool    rps;                      /* Queues are steered in software */
+  struct iob_queue_s rpsq[NETDEV_THREAD_COUNT];
+#endif
+
+  /* RX interrupts masked by netdev_lower_rxready() until drained */
+
+#ifdef CONFIG_NETDEV_NAPI
+  spinlock_t rxlock;
+  bool       rxmasked[NETDEV_THREAD_COUNT];
+#endif
+
+  /* Held while a queue is received from, so that a busy poll does not run
+   * concurrently with the thread of the queue, each with a GRO packet of
+   * its own, and reorder the packets.  Taken before the network lock.
+   */
+
+#ifdef CONFIG_NET_BUSY_POLL
+  mutex_t rxpoll[NETDEV_THREAD_COUNT];
+#endif
+
   /* TX queue for re-queueing replies */
 
 #if CONFIG_IOB_NCHAINS > 0
   struct iob_queue_s txq;
 #endif
+
+  /* Number of packets transmitted since the last commit */
+
+  unsigned int txpending;
+
+  /* Offloads done by the lower half, the others are done here */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  uint8_t features;
+#endif
+};
+
+/* A TCP packet that GRO holds back to append the next segments of its
+ * flow.  Packets are held within one receive poll only.
+ */
+
+#ifdef CONFIG_NETDEV_GRO
+struct netdev_gro_s
+{
+  FAR struct iob_s *iob;   /* The packet, NULL if none */
+  FAR struct iob_s *tail;  /* The last IOB of the packet */
+  uint32_t seqno;          /* Sequence number of the next segment */
+  uint16_t mss;            /* Payload length of the first segment */
+  uint8_t  l4off;          /* Offset of the TCP header */
+  uint8_t  hdrlen;         /* Length of the IP and TCP headers */
+  uint8_t  nsegs;          /* Number of segments merged */
+  bool     ipv6;           /* IPv6 packet */
 };
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -207,6 +293,9 @@ netdev_upper_alloc(FAR struct netdev_lowerhalf_s *dev)
   /* Allocate the upper-half data structure */
 
   FAR struct netdev_upperhalf_s *upper;
+#ifdef CONFIG_NET_BUSY_POLL
+  int i;
+#endif
 
   DEBUGASSERT(dev != NULL && dev->netdev.d_private == NULL);
 
@@ -219,6 +308,15 @@ netdev_upper_alloc(FAR struct netdev_lowerhalf_s *dev)
 
   upper->lower = dev;
   dev->netdev.d_private = upper;
+#ifdef CONFIG_NETDEV_NAPI
+  spin_lock_init(&upper->rxlock);
+#endif
+#ifdef CONFIG_NET_BUSY_POLL
+  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+    {
+      nxmutex_init(&upper->rxpoll[i]);
+    }
+#endif
 
   return upper;
 }
@@ -248,6 +346,316 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   return quota > 0;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_flowhash
+ *
+ * Description:
+ *   Hash the addresses and the TCP/UDP ports of a packet, so that all the
+ *   packets of a flow go to the same queue.  The fragments of an IPv4
+ *   packet are hashed by their addresses only.
+ *
+ * Input Parameters:
+ *   pkt - The packet, starting with the IP header
+ *
+ * Returned Value:
+ *   The hash of the flow, 0 for the packets that are not IP.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static uint32_t netdev_upper_flowhash(FAR netpkt_t *pkt)
+{
+  FAR uint8_t *ipbuf = IOB_DATA(pkt);
+  FAR const uint8_t *addr;
+  unsigned int addrlen;
+  unsigned int l4off;
+  unsigned int i;
+  uint32_t hash = NETDEV_FLOWHASH_INIT;
+  uint8_t proto;
+
+#ifdef CONFIG_NET_IPv4
+  if (pkt->io_len >= IPv4_HDRLEN &&
+      (ipbuf[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ipbuf;
+
+      addr    = (FAR const uint8_t *)ipv4->srcipaddr;
+      addrlen = 2 * sizeof(in_addr_t);
+      l4off   = (ipv4->vhl & IPv4_HLMASK) << 2;
+      proto   = ipv4->proto;
+
+      if ((ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0)
+        {
+          proto = 0;
+        }
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (pkt->io_len >= IPv6_HDRLEN &&
+      (ipbuf[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ipbuf;
+
+      addr    = (FAR const uint8_t *)ipv6->srcipaddr;
+      addrlen = 2 * sizeof(net_ipv6addr_t);
+      l4off   = IPv6_HDRLEN;
+      proto   = ipv6->proto;
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  for (i = 0; i < addrlen; i++)
+    {
+      hash = (hash ^ addr[i]) * NETDEV_FLOWHASH_PRIME;
+    }
+
+  /* The source and destination ports lead both the TCP and UDP headers */
+
+  if ((proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) &&
+      pkt->io_len >= l4off + 4)
+    {
+      for (i = l4off; i < l4off + 4; i++)
+        {
+          hash = (hash ^ ipbuf[i]) * NETDEV_FLOWHASH_PRIME;
+        }
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_pseudo_adjust
+ *
+ * Description:
+ *   Replace the length summed into the pseudo-header sum of a TCP/UDP
+ *   checksum, in one's complement arithmetic.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_OFFLOAD) && CONFIG_IOB_NCHAINS > 0
+static uint16_t netdev_upper_pseudo_adjust(uint16_t sum, uint16_t oldlen,
+                                           uint16_t newlen)
+{
+  uint32_t tmp = (uint32_t)sum + (uint16_t)~oldlen + newlen;
+
+  tmp = (tmp & 0xffff) + (tmp >> 16);
+  tmp = (tmp & 0xffff) + (tmp >> 16);
+  return (uint16_t)tmp;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gso
+ *
+ * Description:
+ *   Cut the TCP super-segment in d_iob into segments of info->gsosize bytes
+ *   of payload, with the checksums done in software, and queue them to be
+ *   sent before anything else.  The super-segment is released.
+ *
+ * Input Parameters:
+ *   dev  - Reference to the NuttX driver state structure
+ *   info - The offload request of the super-segment
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gso(FAR struct net_driver_s *dev,
+                             FAR const struct netdev_offload_s *info)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR struct iob_s *super = dev->d_iob;
+  FAR struct iob_s *seg;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int hdrlen   = info->hdrlen - llhdrlen;
+  unsigned int l4off    = info->csumstart - llhdrlen;
+  unsigned int paylen   = super->io_pktlen - hdrlen;
+  unsigned int offset;
+  unsigned int len;
+  uint32_t seqno;
+  uint16_t pseudo;
+  uint16_t sum;
+#ifdef CONFIG_NET_IPv4
+  uint16_t ipid = 0;
+#endif
+  uint8_t flags;
+
+  DEBUGASSERT(info->gsosize > 0 && paylen > 0);
+
+  tcp    = (FAR struct tcp_hdr_s *)(IOB_DATA(super) + l4off);
+  seqno  = ((uint32_t)tcp->seqno[0] << 24) |
+           ((uint32_t)tcp->seqno[1] << 16) |
+           ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3];
+  sum    = NTOHS(tcp->tcpchksum);
+  flags  = tcp->flags;
+
+#ifdef CONFIG_NET_IPv4
+  if (!info->ipv6)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(super);
+
+      ipid = ((uint16_t)ipv4->ipid[0] << 8) | ipv4->ipid[1];
+    }
+#endif
+
+  for (offset = 0; offset < paylen; offset += len)
+    {
+      len = MIN(paylen - offset, info->gsosize);
+
+      /* Copy the headers, including the link layer header that is already
+       * in front of the IP header, then the payload of this segment.
+       */
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          goto errout;
+        }
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      memcpy(IOB_DATA(seg) - llhdrlen, IOB_DATA(super) - llhdrlen,
+             info->hdrlen);
+      seg->io_len = hdrlen;
+
+      if (iob_clone_partial(super, len, hdrlen + offset, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          goto errout;
+        }
+
+      /* Fix up the IP header */
+
+#ifdef CONFIG_NET_IPv4
+      if (!info->ipv6)
+        {
+          FAR struct ipv4_hdr_s *ipv4 =
+            (FAR struct ipv4_hdr_s *)IOB_DATA(seg);
+          uint16_t id = ipid + offset / info->gsosize;
+
+          ipv4->len[0]   = (hdrlen + len) >> 8;
+          ipv4->len[1]   = (hdrlen + len) & 0xff;
+          ipv4->ipid[0]  = id >> 8;
+          ipv4->ipid[1]  = id & 0xff;
+          ipv4->ipchksum = 0;
+          ipv4->ipchksum = ~ipv4_chksum(ipv4);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (info->ipv6)
+        {
+          FAR struct ipv6_hdr_s *ipv6 =
+            (FAR struct ipv6_hdr_s *)IOB_DATA(seg);
+
+          ipv6->len[0] = (hdrlen - IPv6_HDRLEN + len) >> 8;
+          ipv6->len[1] = (hdrlen - IPv6_HDRLEN + len) & 0xff;
+        }
+#endif
+
+      /* Then the TCP header: only the last segment keeps FIN and PSH */
+
+      tcp = (FAR struct tcp_hdr_s *)(IOB_DATA(seg) + l4off);
+      tcp->seqno[0] = (seqno + offset) >> 24;
+      tcp->seqno[1] = (seqno + offset) >> 16;
+      tcp->seqno[2] = (seqno + offset) >> 8;
+      tcp->seqno[3] = (seqno + offset);
+
+      if (offset + len < paylen)
+        {
+          tcp->flags = flags & ~(TCP_FIN | TCP_PSH);
+        }
+
+      /* The TCP length in the pseudo-header sum is the one of the
+       * super-segment, replace it before summing up the segment.
+       */
+
+      pseudo = netdev_upper_pseudo_adjust(sum, hdrlen - l4off + paylen,
+                                          hdrlen - l4off + len);
+      tcp->tcpchksum = HTONS(pseudo);
+      netdev_offload_chksum(dev, seg, info);
+
+      if (iob_tryadd_queue(seg, &upper->txq) < 0)
+        {
+          iob_free_chain(seg);
+          goto errout;
+        }
+    }
+
+  netdev_iob_release(dev);
+  dev->d_len = 0;
+  return;
+
+errout:
+  nwarn("WARNING: Failed to segment TCP packet, dropping\n");
+  NETDEV_TXERRORS(dev);
+  netdev_iob_release(dev);
+  dev->d_len = 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_offload
+ *
+ * Description:
+ *   Do in software the offloads requested for the packet in d_iob that the
+ *   lower half cannot do.
+ *
+ * Input Parameters:
+ *   dev      - Reference to the NuttX driver state structure
+ *   features - The offloads (NETDEV_FEATURE_*) that are left to the lower
+ *              half
+ *
+ * Returned Value:
+ *   OK if the packet is ready to be passed to the lower half, -ENODATA if
+ *   it has been cut into segments that are queued in the TX queue.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+static int netdev_upper_offload(FAR struct net_driver_s *dev,
+                                uint8_t features)
+{
+  struct netdev_offload_s info;
+
+  if (netdev_offload_parse(dev, dev->d_iob, &info) < 0)
+    {
+      /* Not something the stack marks for offload, send it as is */
+
+      dev->d_offload &= ~NETDEV_OFFLOAD_TX;
+      return OK;
+    }
+
+  if ((info.flags & NETDEV_OFFLOAD_TSO) != 0 &&
+      (features & NETDEV_FEATURE_TSO) == 0)
+    {
+#if CONFIG_IOB_NCHAINS > 0
+      netdev_upper_gso(dev, &info);
+      dev->d_offload &= ~NETDEV_OFFLOAD_TX;
+      return -ENODATA;
+#endif
+    }
+
+  if ((info.flags & NETDEV_OFFLOAD_CSUM) != 0 &&
+      (features & NETDEV_FEATURE_TXCSUM) == 0)
+    {
+      netdev_offload_chksum(dev, dev->d_iob, &info);
+      dev->d_offload &= ~NETDEV_OFFLOAD_TX;
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -282,6 +690,16 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   DEBUGASSERT(dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if ((dev->d_offload & NETDEV_OFFLOAD_TX) != 0 &&
+      netdev_upper_offload(dev, upper->features) < 0)
+    {
+      /* Cut into segments, which are sent from the TX queue */
+
+      return NETDEV_TX_CONTINUE;
+    }
+#endif
+
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -292,17 +710,37 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev)
+#ifdef CONFIG_NETDEV_OFFLOAD
+      && (dev->d_offload & NETDEV_OFFLOAD_TSO) == 0
+#endif
+     )
     {
       nerr("ERROR: Packet too long to send!\n");
       ret = -EMSGSIZE;
     }
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  else if (lower->nqueues > 1)
+    {
+      ret = lower->ops->transmitq(lower, pkt,
+                                  netdev_upper_flowhash(pkt) %
+                                  lower->nqueues);
+    }
+#endif
   else
     {
       ret = lower->ops->transmit(lower, pkt);
     }
 
-  if (ret != OK)
+#ifdef CONFIG_NETDEV_OFFLOAD
+  dev->d_offload = 0;
+#endif
+
+  if (ret == OK)
+    {
+      upper->txpending++;
+    }
+  else
     {
       /* Stop polling on any error
        * REVISIT: maybe store the pkt in upper half and retry later?
@@ -316,6 +754,35 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
   return NETDEV_TX_CONTINUE;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_txcommit
+ *
+ * Description:
+ *   Let the lower half start the transmission of the packets handed over
+ *   since the last commit.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_txcommit(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+
+  if (upper->txpending > 0)
+    {
+      upper->txpending = 0;
+      if (lower->ops->commit != NULL)
+        {
+          lower->ops->commit(lower);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: netdev_upper_tx
  *
@@ -342,9 +809,12 @@ static int netdev_upper_tx(FAR struct net_driver_s *dev)
 
   if (!IOB_QEMPTY(&upper->txq))
     {
-      /* Put the packet back to the device */
+      /* Put the packet back to the device, with any offload already done */
 
       netdev_iob_replace(dev, iob_remove_queue(&upper->txq));
+#ifdef CONFIG_NETDEV_OFFLOAD
+      dev->d_offload = 0;
+#endif
       return netdev_upper_txpoll(dev);
     }
 #endif
@@ -379,49 +849,118 @@ static void netdev_upper_txavail_work(FAR struct netdev_upperhalf_s *upper)
       DEBUGASSERT(dev->d_buf == NULL); /* Make sure: IOB only. */
       while (netdev_upper_can_tx(upper) &&
              netdev_upper_tx(dev) == NETDEV_TX_CONTINUE);
+
+      netdev_upper_txcommit(upper);
     }
 }
 
 /****************************************************************************
- * Name: netdev_upper_queue_tx
+ * Name: netdev_upper_txdrain
  *
  * Description:
- *   Queue a TX packet to the upper half for sending later.
+ *   Hand the packets already queued in the upper half to the lower half.
+ *   The TX queue belongs to the device, so only the device lock is needed
+ *   and the network stack keeps running meanwhile.
  *
  * Input Parameters:
- *   dev - Reference to the NuttX driver state structure
+ *   upper - Reference to the upper half driver structure
  *
  * Assumptions:
- *   Called with the network locked.
+ *   Called with the network unlocked.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211) || defined(CONFIG_NET_MBIM)
-static void netdev_upper_queue_tx(FAR struct net_driver_s *dev)
-{
 #if CONFIG_IOB_NCHAINS > 0
-  FAR struct netdev_upperhalf_s *upper = dev->d_private;
-  int ret;
+static void netdev_upper_txdrain(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
 
-  if ((ret = iob_tryadd_queue(dev->d_iob, &upper->txq)) >= 0)
-    {
-      netdev_iob_clear(dev);
-    }
-  else
-    {
-      nwarn("WARNING: Failed to queue TX packet, dropping: %d\n", ret);
-    }
-#else
-  /* Fall back to send the packet directly if we don't have IOB queue. */
+#ifdef CONFIG_NET_PKT
+  /* The frames are fed into the packet sockets, which need the network */
 
-  netdev_upper_txpoll(dev);
-#endif
-}
+  net_lock();
 #endif
 
-/****************************************************************************
- * Name: eth_input
+  netdev_lock(dev);
+
+  if (IFF_IS_UP(dev->d_flags))
+    {
+      while (!IOB_QEMPTY(&upper->txq) && netdev_upper_can_tx(upper) &&
+             netdev_upper_tx(dev) == NETDEV_TX_CONTINUE);
+
+      netdev_upper_txcommit(upper);
+    }
+
+  netdev_unlock(dev);
+
+#ifdef CONFIG_NET_PKT
+  net_unlock();
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_queue_tx
+ *
+ * Description:
+ *   Queue a TX packet to the upper half for sending later.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211) || defined(CONFIG_NET_MBIM)
+static void netdev_upper_queue_tx(FAR struct net_driver_s *dev)
+{
+#if CONFIG_IOB_NCHAINS > 0
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  int ret;
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if ((dev->d_offload & NETDEV_OFFLOAD_TX) != 0)
+    {
+      /* The offload request cannot be queued along with the packet: send
+       * it right away if nothing is queued before it, else do the offload
+       * in software.
+       */
+
+      if (IOB_QEMPTY(&upper->txq) && netdev_upper_can_tx(upper))
+        {
+          netdev_upper_txpoll(dev);
+          return;
+        }
+
+      if (netdev_upper_offload(dev, 0) < 0)
+        {
+          return;
+        }
+    }
+#endif
+
+  if ((ret = iob_tryadd_queue(dev->d_iob, &upper->txq)) >= 0)
+    {
+      netdev_iob_clear(dev);
+    }
+  else
+    {
+      nwarn("WARNING: Failed to queue TX packet, dropping: %d\n", ret);
+    }
+#else
+  /* Fall back to send the packet directly if we don't have IOB queue. */
+
+  netdev_upper_txpoll(dev);
+  netdev_upper_txcommit(dev->d_private);
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: eth_input
  *
  * Description:
  *   Handle L2 packet input.
@@ -583,6 +1122,593 @@ static void ip_input(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_upper_gro_parse
+ *
+ * Description:
+ *   Check whether the frame in d_iob is a TCP segment that GRO can merge,
+ *   and describe it in seg.  The checksums are verified here, the stack
+ *   does not see the segments once they are merged.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *   seg - Returns the description of the segment
+ *
+ * Returned Value:
+ *   true if the segment can be merged.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GRO
+static bool netdev_upper_gro_parse(FAR struct net_driver_s *dev,
+                                   FAR struct netdev_gro_s *seg)
+{
+  FAR struct eth_hdr_s *eth_hdr = (FAR struct eth_hdr_s *)NETLLBUF;
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int iplen;
+  uint16_t sum = 0;
+
+  memset(seg, 0, sizeof(*seg));
+
+#ifdef CONFIG_NET_IPv4
+  if (eth_hdr->type == HTONS(ETHTYPE_IP))
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      /* No options and no fragments, addressed to this device, as the
+       * merged packet could not be forwarded.
+       */
+
+      if (iob->io_len < IPv4_HDRLEN + TCP_HDRLEN ||
+          ipv4->vhl != (IPv4_VERSION | (IPv4_HDRLEN >> 2)) ||
+          ipv4->proto != IP_PROTO_TCP ||
+          (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+          !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                            dev->d_ipaddr))
+        {
+          return false;
+        }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      if (ipv4_chksum(ipv4) != 0xffff)
+        {
+          return false;
+        }
+#endif
+
+      iplen      = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+      seg->l4off = IPv4_HDRLEN;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (eth_hdr->type == HTONS(ETHTYPE_IP6))
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      if (iob->io_len < IPv6_HDRLEN + TCP_HDRLEN ||
+          ipv6->proto != IP_PROTO_TCP ||
+          !NETDEV_IS_MY_V6ADDR(dev, ipv6->destipaddr))
+        {
+          return false;
+        }
+
+      iplen      = IPv6_HDRLEN + ((uint16_t)ipv6->len[0] << 8) +
+                   ipv6->len[1];
+      seg->l4off = IPv6_HDRLEN;
+      seg->ipv6  = true;
+    }
+  else
+#endif
+    {
+      return false;
+    }
+
+  /* Only ACK segments with data, PSH being allowed on the last one.  The
+   * headers must be in the first IOB and the frame must not be padded.
+   */
+
+  tcp         = (FAR struct tcp_hdr_s *)IPBUF(seg->l4off);
+  seg->hdrlen = seg->l4off + ((tcp->tcpoffset >> 4) << 2);
+
+  if ((tcp->flags & ~TCP_PSH) != TCP_ACK ||
+      seg->hdrlen < seg->l4off + TCP_HDRLEN || iob->io_len < seg->hdrlen ||
+      iplen != iob->io_pktlen || iplen <= seg->hdrlen)
+    {
+      return false;
+    }
+
+  if (!NETDEV_CSUM_VERIFIED(dev))
+    {
+#ifdef CONFIG_NET_IPv4
+      if (!seg->ipv6)
+        {
+          sum = ipv4_upperlayer_chksum(dev, IP_PROTO_TCP);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (seg->ipv6)
+        {
+          sum = ipv6_upperlayer_chksum(dev, IP_PROTO_TCP, IPv6_HDRLEN);
+        }
+#endif
+
+      if (sum != 0xffff)
+        {
+          return false;
+        }
+
+      /* Don't verify it again if the segment is not merged */
+
+      dev->d_offload |= NETDEV_OFFLOAD_CSUMOK;
+    }
+
+  seg->iob   = iob;
+  seg->mss   = iplen - seg->hdrlen;
+  seg->seqno = (((uint32_t)tcp->seqno[0] << 24) |
+                ((uint32_t)tcp->seqno[1] << 16) |
+                ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3]) + seg->mss;
+  seg->nsegs = 1;
+  return true;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_match
+ *
+ * Description:
+ *   Check whether seg continues the packet held in gro: the same flow with
+ *   the same headers, the next sequence number and no more payload than
+ *   the first segment.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_match(FAR struct netdev_gro_s *gro,
+                                   FAR struct netdev_gro_s *seg)
+{
+  FAR uint8_t *hold = IOB_DATA(gro->iob);
+  FAR uint8_t *cur  = IOB_DATA(seg->iob);
+  FAR struct tcp_hdr_s *htcp;
+  FAR struct tcp_hdr_s *ctcp;
+
+  if (gro->ipv6 != seg->ipv6 || gro->hdrlen != seg->hdrlen)
+    {
+      return false;
+    }
+
+  /* Everything but the lengths, the IPv4 ID and the IPv4 checksum */
+
+#ifdef CONFIG_NET_IPv6
+  if (seg->ipv6)
+    {
+      if (memcmp(hold, cur, offsetof(struct ipv6_hdr_s, len)) != 0 ||
+          memcmp(hold + offsetof(struct ipv6_hdr_s, proto),
+                 cur + offsetof(struct ipv6_hdr_s, proto),
+                 IPv6_HDRLEN - offsetof(struct ipv6_hdr_s, proto)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+  if (!seg->ipv6)
+    {
+      if (memcmp(hold, cur, offsetof(struct ipv4_hdr_s, len)) != 0 ||
+          memcmp(hold + offsetof(struct ipv4_hdr_s, ttl),
+                 cur + offsetof(struct ipv4_hdr_s, ttl), 2) != 0 ||
+          memcmp(hold + offsetof(struct ipv4_hdr_s, srcipaddr),
+                 cur + offsetof(struct ipv4_hdr_s, srcipaddr),
+                 2 * sizeof(in_addr_t)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+  /* The ports, the acknowledgment and the options, the window is taken
+   * from the last segment.
+   */
+
+  htcp = (FAR struct tcp_hdr_s *)(hold + gro->l4off);
+  ctcp = (FAR struct tcp_hdr_s *)(cur + seg->l4off);
+
+  if (htcp->srcport != ctcp->srcport || htcp->destport != ctcp->destport ||
+      memcmp(htcp->ackno, ctcp->ackno, sizeof(htcp->ackno)) != 0 ||
+      memcmp(htcp->optdata, ctcp->optdata,
+             seg->hdrlen - seg->l4off - TCP_HDRLEN) != 0)
+    {
+      return false;
+    }
+
+  return seg->seqno - seg->mss == gro->seqno && seg->mss <= gro->mss &&
+         gro->nsegs < CONFIG_NETDEV_GRO_MAXSEGS &&
+         gro->iob->io_pktlen + seg->mss <= UINT16_MAX;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Pass the packet held in gro, if any, to the stack.  The frame in d_iob
+ *   is set aside meanwhile.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *   gro - The GRO state of the receive poll
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct net_driver_s *dev,
+                                   FAR struct netdev_gro_s *gro)
+{
+  FAR struct iob_s *iob = gro->iob;
+  FAR struct iob_s *cur;
+  uint8_t offload;
+
+  if (iob == NULL)
+    {
+      return;
+    }
+
+  gro->iob = NULL;
+
+  cur     = dev->d_iob;
+  offload = dev->d_offload;
+  netdev_iob_clear(dev);
+
+  dev->d_iob     = iob;
+  dev->d_len     = iob->io_pktlen + NET_LL_HDRLEN(dev);
+  dev->d_offload = NETDEV_OFFLOAD_CSUMOK;
+
+  /* The IP header still has the length of the first segment */
+
+  if (gro->nsegs > 1)
+    {
+#ifdef CONFIG_NET_IPv4
+      if (!gro->ipv6)
+        {
+          FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+          ipv4->len[0]   = iob->io_pktlen >> 8;
+          ipv4->len[1]   = iob->io_pktlen & 0xff;
+          ipv4->ipchksum = 0;
+          ipv4->ipchksum = ~ipv4_chksum(ipv4);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (gro->ipv6)
+        {
+          FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+          ipv6->len[0] = (iob->io_pktlen - IPv6_HDRLEN) >> 8;
+          ipv6->len[1] = (iob->io_pktlen - IPv6_HDRLEN) & 0xff;
+        }
+#endif
+
+      NETDEV_RXGRO(dev);
+    }
+
+  eth_input(dev);
+  netdev_iob_release(dev);
+
+  dev->d_iob     = cur;
+  dev->d_len     = cur != NULL ? cur->io_pktlen + NET_LL_HDRLEN(dev) : 0;
+  dev->d_offload = offload;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_receive
+ *
+ * Description:
+ *   Merge the frame in d_iob into the packet held in gro, or hold it to
+ *   merge the next segments into it.  Anything else flushes the held
+ *   packet first, so that the order of the frames is kept.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *   gro - The GRO state of the receive poll
+ *
+ * Returned Value:
+ *   true if the frame has been taken from d_iob, false if it is left for
+ *   the caller to pass to the stack.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_receive(FAR struct net_driver_s *dev,
+                                     FAR struct netdev_gro_s *gro)
+{
+  struct netdev_gro_s seg;
+  FAR struct tcp_hdr_s *tcp;
+  FAR struct tcp_hdr_s *htcp;
+  FAR struct iob_s *iob;
+  uint8_t flags;
+
+  if (!netdev_upper_gro_parse(dev, &seg))
+    {
+      netdev_upper_gro_flush(dev, gro);
+      return false;
+    }
+
+  tcp   = (FAR struct tcp_hdr_s *)IPBUF(seg.l4off);
+  flags = tcp->flags;
+
+  if (gro->iob != NULL && netdev_upper_gro_match(gro, &seg))
+    {
+      /* Append the payload, take over the window and PSH */
+
+      htcp = (FAR struct tcp_hdr_s *)(IOB_DATA(gro->iob) + gro->l4off);
+      memcpy(htcp->wnd, tcp->wnd, sizeof(htcp->wnd));
+      htcp->flags |= flags & TCP_PSH;
+
+      netdev_iob_clear(dev);
+      iob = iob_trimhead(seg.iob, seg.hdrlen);
+      gro->iob->io_pktlen += iob->io_pktlen;
+      gro->tail->io_flink  = iob;
+
+      while (iob->io_flink != NULL)
+        {
+          iob = iob->io_flink;
+        }
+
+      gro->tail  = iob;
+      gro->seqno = seg.seqno;
+      gro->nsegs++;
+      NETDEV_RXGROMERGED(dev);
+
+      /* A short segment or PSH ends the burst of the sender */
+
+      if ((flags & TCP_PSH) != 0 || seg.mss < gro->mss)
+        {
+          netdev_upper_gro_flush(dev, gro);
+        }
+
+      return true;
+    }
+
+  netdev_upper_gro_flush(dev, gro);
+
+  /* Nothing is merged into a segment with PSH, pass it on */
+
+  if ((flags & TCP_PSH) != 0)
+    {
+      return false;
+    }
+
+  netdev_iob_clear(dev);
+  *gro = seg;
+
+  iob = seg.iob;
+  while (iob->io_flink != NULL)
+    {
+      iob = iob->io_flink;
+    }
+
+  gro->tail = iob;
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_wake
+ *
+ * Description:
+ *   Wake up a work thread of the device.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   index - The thread, that is the queue with multi-queue
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+static void netdev_upper_wake(FAR struct netdev_upperhalf_s *upper,
+                              int index)
+{
+  int semcount;
+
+  if (nxsem_get_value(&upper->sem[index], &semcount) == OK &&
+      semcount <= 0)
+    {
+      nxsem_post(&upper->sem[index]);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_rxmask
+ *
+ * Description:
+ *   Mask the RX interrupt of a queue until the queue is drained.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   queue - The queue
+ *
+ * Assumptions:
+ *   May be called from the interrupt handler of the lower half.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static void netdev_upper_rxmask(FAR struct netdev_upperhalf_s *upper,
+                                int queue)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  irqstate_t flags;
+
+  if (lower->ops->rxint == NULL)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&upper->rxlock);
+  if (!upper->rxmasked[queue])
+    {
+      upper->rxmasked[queue] = true;
+      lower->ops->rxint(lower, queue, false);
+    }
+
+  spin_unlock_irqrestore(&upper->rxlock, flags);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_rxunmask
+ *
+ * Description:
+ *   Enable again the RX interrupt of a drained queue.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   queue - The queue
+ *
+ * Returned Value:
+ *   True if the interrupt was masked.  A packet received after the last
+ *   receive but before the interrupt is enabled may then be left in the
+ *   queue, so the caller has to check the queue once more.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_rxunmask(FAR struct netdev_upperhalf_s *upper,
+                                  int queue)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  irqstate_t flags;
+  bool masked;
+
+  flags  = spin_lock_irqsave(&upper->rxlock);
+  masked = upper->rxmasked[queue];
+  if (masked)
+    {
+      upper->rxmasked[queue] = false;
+      lower->ops->rxint(lower, queue, true);
+    }
+
+  spin_unlock_irqrestore(&upper->rxlock, flags);
+  return masked;
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_receive
+ *
+ * Description:
+ *   Receive a packet from a queue of the lower half.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   queue - The queue
+ *
+ * Returned Value:
+ *   The packet, NULL if there is none.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR netpkt_t *
+netdev_upper_receive(FAR struct netdev_upperhalf_s *upper, int queue)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (lower->nqueues > 1)
+    {
+      return lower->ops->receiveq(lower, queue);
+    }
+
+  if (queue > 0)
+    {
+      /* The other queues only get the packets steered by queue 0 */
+
+      return NULL;
+    }
+#else
+  UNUSED(queue);
+#endif
+
+  return lower->ops->receive(lower);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_rps_steer
+ *
+ * Description:
+ *   Pass a packet received on queue 0 to the thread of the queue of its
+ *   flow.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The packet received
+ *
+ * Returned Value:
+ *   True if the packet is passed to another thread, false if it is for
+ *   queue 0.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RPS
+static bool netdev_upper_rps_steer(FAR struct netdev_upperhalf_s *upper,
+                                   FAR netpkt_t *pkt)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR struct net_driver_s       *dev   = &lower->netdev;
+  int                            queue;
+
+#if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_DRIVERS_IEEE80211)
+  if (dev->d_lltype == NET_LL_ETHERNET ||
+      dev->d_lltype == NET_LL_IEEE80211)
+    {
+      FAR struct eth_hdr_s *eth_hdr =
+        (FAR struct eth_hdr_s *)(IOB_DATA(pkt) - NET_LL_HDRLEN(dev));
+
+      /* ARP, VLAN tagged frames, ... are left to queue 0 */
+
+      if (eth_hdr->type != HTONS(ETHTYPE_IP) &&
+          eth_hdr->type != HTONS(ETHTYPE_IP6))
+        {
+          return false;
+        }
+    }
+#endif
+
+  queue = netdev_upper_flowhash(pkt) % upper->nqueues;
+  if (queue == 0)
+    {
+      return false;
+    }
+
+  /* The packet is no longer held by the lower half */
+
+  atomic_fetch_add(&lower->quota[NETPKT_RX], 1);
+
+  if (iob_tryadd_queue(pkt, &upper->rpsq[queue]) < 0)
+    {
+      NETDEV_RXDROPPED(dev);
+      iob_free_chain(pkt);
+      return true;
+    }
+
+  netdev_upper_wake(upper, queue);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Function: netdev_upper_rxpoll_work
  *
@@ -592,32 +1718,147 @@ static void ip_input(FAR struct net_driver_s *dev)
  *
  * Input Parameters:
  *   upper - Reference to the upper half driver structure
+ *   queue - The queue to receive from
+ *
+ * Returned Value:
+ *   True if the queue is drained, false if the budget of the poll is
+ *   used up and the queue has to be polled again.
  *
  * Assumptions:
- *   Called with the network locked.
+ *   Called with the network unlocked.  The network and device locks are
+ *   taken for one packet at a time so that other threads can use the
+ *   network between packets of a receive burst.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static bool netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper,
+                                     int queue)
 {
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
   FAR netpkt_t                  *pkt;
+#ifdef CONFIG_NETDEV_NAPI
+  int                            budget = CONFIG_NETDEV_NAPI_WEIGHT;
+#endif
+#ifdef CONFIG_NETDEV_RPS
+  bool                           steered = false;
+#endif
+#ifdef CONFIG_NETDEV_GRO
+  struct netdev_gro_s            gro;
+
+  gro.iob = NULL;
+#endif
 
   /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
-  while ((pkt = lower->ops->receive(lower)) != NULL)
+  for (; ; )
     {
+      net_lock();
+      netdev_lock(dev);
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+      /* The lower half may report a verified checksum in receive() */
+
+      dev->d_offload = 0;
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+      if (budget-- <= 0)
+        {
+          /* Leave the rest of the queue to the next poll */
+
+          pkt = NULL;
+        }
+      else
+#endif
+#ifdef CONFIG_NETDEV_RPS
+      /* The packets steered here by queue 0 do not count in the quota of
+       * the lower half any more.
+       */
+
+      if ((pkt = iob_remove_queue(&upper->rpsq[queue])) != NULL)
+        {
+          steered = true;
+        }
+      else
+#endif
+        {
+#ifdef CONFIG_NETDEV_RPS
+          steered = false;
+#endif
+          pkt = netdev_upper_receive(upper, queue);
+#ifdef CONFIG_NETDEV_NAPI
+          if (pkt == NULL && netdev_upper_rxunmask(upper, queue))
+            {
+              /* Catch a packet that came before the interrupt was
+               * enabled, and keep polling if there is one.
+               */
+
+              pkt = netdev_upper_receive(upper, queue);
+              if (pkt != NULL)
+                {
+                  netdev_upper_rxmask(upper, queue);
+                }
+            }
+#endif
+        }
+
+      if (pkt == NULL)
+        {
+#ifdef CONFIG_NETDEV_GRO
+          /* Nothing is held back beyond the end of the poll */
+
+          netdev_upper_gro_flush(dev, &gro);
+#endif
+          netdev_unlock(dev);
+          net_unlock();
+          break;
+        }
+
       if (!IFF_IS_UP(dev->d_flags))
         {
           /* Interface down, drop frame */
 
           NETDEV_RXDROPPED(dev);
-          netpkt_free(lower, pkt, NETPKT_RX);
+#ifdef CONFIG_NETDEV_RPS
+          if (steered)
+            {
+              iob_free_chain(pkt);
+            }
+          else
+#endif
+            {
+              netpkt_free(lower, pkt, NETPKT_RX);
+            }
+
+          netdev_unlock(dev);
+          net_unlock();
+          continue;
+        }
+
+#ifdef CONFIG_NETDEV_RPS
+      if (steered)
+        {
+          /* A checksum verified by the lower half is not kept with the
+           * packet, so the stack verifies it again.
+           */
+
+          netdev_iob_release(dev);
+          dev->d_iob = pkt;
+          dev->d_len = netpkt_getdatalen(lower, pkt);
+        }
+      else if (upper->rps && netdev_upper_rps_steer(upper, pkt))
+        {
+          netdev_unlock(dev);
+          net_unlock();
           continue;
         }
+      else
+#endif
+        {
+          netpkt_put(dev, pkt, NETPKT_RX);
+        }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
       NETDEV_RXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -626,6 +1867,17 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
       pkt_input(dev);
 #endif
 
+#ifdef CONFIG_NETDEV_GRO
+      if ((dev->d_lltype == NET_LL_ETHERNET ||
+           dev->d_lltype == NET_LL_IEEE80211) &&
+          netdev_upper_gro_receive(dev, &gro))
+        {
+          netdev_unlock(dev);
+          net_unlock();
+          continue;
+        }
+#endif
+
       switch (dev->d_lltype)
         {
 #ifdef CONFIG_NET_LOOPBACK
@@ -657,7 +1909,66 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           nerr("Unknown link type %d\n", dev->d_lltype);
           break;
         }
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+      dev->d_offload = 0;
+#endif
+
+      netdev_unlock(dev);
+      net_unlock();
     }
+
+#ifdef CONFIG_NETDEV_NAPI
+  return budget >= 0;
+#else
+  return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_upper_poll
+ *
+ * Description:
+ *   Receive from a queue, then transmit what the stack has to send.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   queue - The queue to receive from
+ *
+ * Returned Value:
+ *   False if the queue is to be polled again, see
+ *   netdev_upper_rxpoll_work().
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_poll(FAR struct netdev_upperhalf_s *upper,
+                              int queue)
+{
+  bool drained;
+
+  /* RX may release quota and driver buffer, so do RX first. */
+
+#ifdef CONFIG_NET_BUSY_POLL
+  nxmutex_lock(&upper->rxpoll[queue]);
+  drained = netdev_upper_rxpoll_work(upper, queue);
+  nxmutex_unlock(&upper->rxpoll[queue]);
+#else
+  drained = netdev_upper_rxpoll_work(upper, queue);
+#endif
+
+#if CONFIG_IOB_NCHAINS > 0
+  /* Flush what is already queued before polling the stack for more */
+
+  netdev_upper_txdrain(upper);
+#endif
+
+  net_lock();
+  netdev_lock(&upper->lower->netdev);
+  netdev_upper_txavail_work(upper);
+  netdev_unlock(&upper->lower->netdev);
+  net_unlock();
+
+  return drained;
 }
 
 /****************************************************************************
@@ -673,14 +1984,18 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
 
 static void netdev_upper_work(FAR void *arg)
 {
+#if defined(CONFIG_NETDEV_NAPI) && !defined(CONFIG_NETDEV_WORK_THREAD)
   FAR struct netdev_upperhalf_s *upper = arg;
 
-  /* RX may release quota and driver buffer, so do RX first. */
+  if (!netdev_upper_poll(upper, 0))
+    {
+      /* Let the other work run before the rest of the burst */
 
-  net_lock();
-  netdev_upper_rxpoll_work(upper);
-  netdev_upper_txavail_work(upper);
-  net_unlock();
+      work_queue(NETDEV_WORK, &upper->work, netdev_upper_work, upper, 0);
+    }
+#else
+  netdev_upper_poll(arg, 0);
+#endif
 }
 
 /****************************************************************************
@@ -704,6 +2019,33 @@ static int netdev_upper_wait(FAR sem_t *sem)
 #endif
 }
 
+/****************************************************************************
+ * Name: netdev_upper_setaffinity
+ *
+ * Description:
+ *   Bind a work thread to a CPU, or let it run on any CPU if cpu < 0.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_MULTIQUEUE) && defined(CONFIG_SMP)
+static int netdev_upper_setaffinity(pid_t tid, int cpu)
+{
+  cpu_set_t cpuset;
+  int i;
+
+  CPU_ZERO(&cpuset);
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (cpu < 0 || cpu == i)
+        {
+          CPU_SET(i, &cpuset);
+        }
+    }
+
+  return nxsched_set_affinity(tid, sizeof(cpu_set_t), &cpuset);
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_loop
  *
@@ -724,12 +2066,27 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
   CPU_ZERO(&cpuset);
   CPU_SET(cpu, &cpuset);
   sched_setaffinity(upper->tid[cpu], sizeof(cpu_set_t), &cpuset);
+#elif defined(CONFIG_NETDEV_MULTIQUEUE) && defined(CONFIG_SMP)
+  /* The thread of each queue is bound to the CPU of the queue */
+
+  netdev_upper_setaffinity(0, upper->cpu[cpu]);
 #endif
 
   while (netdev_upper_wait(&upper->sem[cpu]) == OK &&
          upper->tid[cpu] != INVALID_PROCESS_ID)
     {
-      netdev_upper_work(upper);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+      if (!netdev_upper_poll(upper, cpu))
+#else
+      if (!netdev_upper_poll(upper, 0))
+#endif
+        {
+          /* Poll again without waiting for the interrupt, which stays
+           * masked until the queue is drained.
+           */
+
+          netdev_upper_wake(upper, cpu);
+        }
     }
 
   nwarn("WARNING: Netdev work thread quitting.");
@@ -756,16 +2113,13 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_WORK_THREAD
 #  ifdef CONFIG_NETDEV_RSS
   int cpu = this_cpu();
+#  elif defined(CONFIG_NETDEV_MULTIQUEUE)
+  int cpu = this_cpu() % upper->nqueues;
 #  else
   const int cpu = 0;
 #  endif
-  int semcount;
 
-  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
-      semcount <= 0)
-    {
-      nxsem_post(&upper->sem[cpu]);
-    }
+  netdev_upper_wake(upper, cpu);
 #else
   if (work_available(&upper->work))
     {
@@ -793,6 +2147,60 @@ static int netdev_upper_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_busypoll
+ *
+ * Description:
+ *   Receive from all the queues for a socket that busy polls (SO_BUSY_POLL).
+ *   A queue that its thread is receiving from is skipped, the thread
+ *   drains it anyway.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Assumptions:
+ *   Called with the network unlocked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+static void netdev_upper_busypoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  bool drained;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  int nqueues = upper->nqueues;
+#else
+  const int nqueues = 1;
+#endif
+  int i;
+
+  for (i = 0; i < nqueues; i++)
+    {
+      if (nxmutex_trylock(&upper->rxpoll[i]) < 0)
+        {
+          continue;
+        }
+
+      drained = netdev_upper_rxpoll_work(upper, i);
+      nxmutex_unlock(&upper->rxpoll[i]);
+
+      if (!drained)
+        {
+          /* The RX interrupt stays masked, so the thread of the queue has
+           * to receive the rest of the burst.
+           */
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+          netdev_upper_wake(upper, i);
+#else
+          netdev_upper_queue_work(dev);
+#endif
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wireless_ioctl
  *
@@ -1053,7 +2461,7 @@ static int netdev_upper_ifup(FAR struct net_driver_s *dev)
 
   /* Try to bring up a dedicated thread for work. */
 
-  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+  for (i = 0; i < NETDEV_THREADS(upper); i++)
     {
       if (upper->tid[i] <= 0)
         {
@@ -1069,8 +2477,13 @@ static int netdev_upper_ifup(FAR struct net_driver_s *dev)
           argv[1] = arg2;
           argv[2] = NULL;
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+          snprintf(name, sizeof(name), NETDEV_QUEUE_NAME_FMT,
+                   dev->d_ifname, i);
+#else
           snprintf(name, sizeof(name), NETDEV_THREAD_NAME_FMT,
                    dev->d_ifname);
+#endif
 
           upper->tid[i] = kthread_create(name,
                                          CONFIG_NETDEV_WORK_THREAD_PRIORITY,
@@ -1084,6 +2497,14 @@ static int netdev_upper_ifup(FAR struct net_driver_s *dev)
     }
 #endif
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* A poll cancelled by ifdown may have left the RX interrupts masked,
+   * the lower half enables them again in ifup.
+   */
+
+  memset(upper->rxmasked, 0, sizeof(upper->rxmasked));
+#endif
+
   if (upper->lower->ops->ifup)
     {
       return upper->lower->ops->ifup(upper->lower);
@@ -1201,6 +2622,16 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
       return -EINVAL;
     }
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (dev->nqueues > 1 &&
+      (dev->nqueues > CONFIG_NETDEV_MAX_QUEUES ||
+       dev->ops->transmitq == NULL || dev->ops->receiveq == NULL))
+    {
+      nerr("ERROR: Cannot drive %u queues\n", dev->nqueues);
+      return -EINVAL;
+    }
+#endif
+
   if ((upper = netdev_upper_alloc(dev)) == NULL)
     {
       return -ENOMEM;
@@ -1215,9 +2646,52 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
 #ifdef CONFIG_NETDEV_IOCTL
   dev->netdev.d_ioctl   = netdev_upper_ioctl;
+#endif
+#ifdef CONFIG_NET_BUSY_POLL
+  dev->netdev.d_busypoll = netdev_upper_busypoll;
 #endif
   dev->netdev.d_private = upper;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The lower half can only cut super-segments that it can checksum and
+   * that it can take as IOB chains.
+   */
+
+  upper->features = dev->features;
+  if ((upper->features & (NETDEV_FEATURE_TXCSUM | NETDEV_FEATURE_SG)) !=
+      (NETDEV_FEATURE_TXCSUM | NETDEV_FEATURE_SG))
+    {
+      upper->features &= ~NETDEV_FEATURE_TSO;
+    }
+
+  dev->netdev.d_features = upper->features;
+#  ifdef CONFIG_NETDEV_GSO
+  dev->netdev.d_features |= NETDEV_FEATURE_TXCSUM | NETDEV_FEATURE_TSO;
+#  endif
+#endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  upper->nqueues = dev->nqueues > 1 ? dev->nqueues : 1;
+#  ifdef CONFIG_NETDEV_RPS
+  if (upper->nqueues == 1)
+    {
+      /* Spread the single queue of the device in software */
+
+      upper->nqueues = CONFIG_NETDEV_RPS_QUEUES;
+      upper->rps     = true;
+    }
+#  endif
+
+  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+    {
+#  ifdef CONFIG_SMP
+      upper->cpu[i] = i % CONFIG_SMP_NCPUS;
+#  else
+      upper->cpu[i] = -1;
+#  endif
+    }
+#endif
+
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
     {
@@ -1255,7 +2729,7 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
 {
   FAR struct netdev_upperhalf_s *upper;
   int ret;
-#ifdef CONFIG_NETDEV_WORK_THREAD
+#if defined(CONFIG_NETDEV_WORK_THREAD) || defined(CONFIG_NET_BUSY_POLL)
   int i;
 #endif
 
@@ -1285,6 +2759,9 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
 
       nxsem_destroy(&upper->sem[i]);
       nxsem_destroy(&upper->sem_exit[i]);
+#  ifdef CONFIG_NETDEV_RPS
+      iob_free_queue(&upper->rpsq[i]);
+#  endif
     }
 #endif
 
@@ -1292,6 +2769,13 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
   iob_free_queue(&upper->txq);
 #endif
 
+#ifdef CONFIG_NET_BUSY_POLL
+  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+    {
+      nxmutex_destroy(&upper->rxpoll[i]);
+    }
+#endif
+
   kmm_free(upper);
   dev->netdev.d_private = NULL;
 
@@ -1345,7 +2829,12 @@ void netdev_lower_carrier_off(FAR struct netdev_lowerhalf_s *dev)
 
 void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev)
 {
-#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev_lower_rxready_queue(dev, 0);
+#elif CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+#  ifdef CONFIG_NETDEV_NAPI
+  netdev_upper_rxmask(dev->netdev.d_private, 0);
+#  endif
   netdev_upper_queue_work(&dev->netdev);
 #endif
 }
@@ -1363,11 +2852,123 @@ void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev)
 
 void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev)
 {
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev_lower_txdone_queue(dev, 0);
+#else
   NETDEV_TXDONE(&dev->netdev);
-#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+#  if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
   netdev_upper_queue_work(&dev->netdev);
+#  endif
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer about an RX packet is ready to read on
+ *   a queue.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue with the packet
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue)
+{
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  FAR struct netdev_upperhalf_s *upper = dev->netdev.d_private;
+
+  DEBUGASSERT(queue >= 0 && queue < upper->nqueues);
+#  ifdef CONFIG_NETDEV_NAPI
+  netdev_upper_rxmask(upper, queue);
+#  endif
+  netdev_upper_wake(upper, queue);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_lower_txdone_queue
+ *
+ * Description:
+ *   Notifies the networking layer about a TX packet is sent on a queue.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue of the packet
+ *
+ ****************************************************************************/
+
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               int queue)
+{
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  FAR struct netdev_upperhalf_s *upper = dev->netdev.d_private;
+
+  DEBUGASSERT(queue >= 0 && queue < upper->nqueues);
+#endif
+
+  NETDEV_TXDONE(&dev->netdev);
+
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  netdev_upper_wake(upper, queue);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_lower_queue_setcpu
+ *
+ * Description:
+ *   Bind the work thread of a queue to a CPU, typically the CPU that takes
+ *   the interrupt of the queue.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue
+ *   cpu   - The CPU, or -1 to let the thread run on any CPU
+ *
+ * Returned Value:
+ *   0:Success; negated errno on failure.
+ *
+ ****************************************************************************/
+
+int netdev_lower_queue_setcpu(FAR struct netdev_lowerhalf_s *dev,
+                              int queue, int cpu)
+{
+  FAR struct netdev_upperhalf_s *upper;
+
+  if (dev == NULL || dev->netdev.d_private == NULL)
+    {
+      return -EINVAL;
+    }
+
+  upper = dev->netdev.d_private;
+#ifdef CONFIG_SMP
+  if (queue < 0 || queue >= upper->nqueues || cpu >= CONFIG_SMP_NCPUS)
+#else
+  if (queue < 0 || queue >= upper->nqueues || cpu > 0)
+#endif
+    {
+      return -EINVAL;
+    }
+
+  upper->cpu[queue] = cpu < 0 ? -1 : cpu;
+
+#ifdef CONFIG_SMP
+  /* A thread not created yet binds itself when it starts */
+
+  if (upper->tid[queue] > 0)
+    {
+      return netdev_upper_setaffinity(upper->tid[queue], upper->cpu[queue]);
+    }
 #endif
+
+  return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: netpkt_alloc
@@ -1625,3 +3226,52 @@ int netpkt_to_iov(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
 
   return i;
 }
+
+/****************************************************************************
+ * Name: netpkt_getoffload
+ *
+ * Description:
+ *   Get the offloads requested for a packet, only valid in the transmit
+ *   callback.  Offloads are only requested if advertised in dev->features.
+ *   The offsets in info are from the start of the packet data.
+ *
+ * Input Parameters:
+ *   dev  - The lower half device driver structure
+ *   pkt  - The net packet
+ *   info - Returns the offloads, info->flags is 0 for none
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the headers of a packet marked for offload
+ *   cannot be parsed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+int netpkt_getoffload(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                      FAR struct netdev_offload_s *info)
+{
+  return netdev_offload_parse(&dev->netdev, pkt, info);
+}
+
+/****************************************************************************
+ * Name: netpkt_setoffload
+ *
+ * Description:
+ *   Tell the stack that the device has verified the TCP/UDP checksum of a
+ *   received packet (NETDEV_OFFLOAD_CSUMOK), only valid in the receive
+ *   callback.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   pkt   - The net packet
+ *   flags - NETDEV_OFFLOAD_CSUMOK
+ *
+ ****************************************************************************/
+
+void netpkt_setoffload(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                       uint8_t flags)
+{
+  UNUSED(pkt);
+  dev->netdev.d_offload |= flags & NETDEV_OFFLOAD_CSUMOK;
+}
+#endif
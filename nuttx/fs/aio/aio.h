@@ -28,6 +28,8 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <aio.h>
 
@@ -48,6 +50,27 @@
 #  define CONFIG_FS_NAIOC 8
 #endif
 
+/* Number of threads of the dedicated work queue, 0 for LPWORK */
+
+#ifndef CONFIG_FS_AIO_NTHREADS
+#  define CONFIG_FS_AIO_NTHREADS 0
+#endif
+
+/* Maximum number of requests performed with one transfer */
+
+#ifndef CONFIG_FS_AIO_MERGE
+#  define CONFIG_FS_AIO_MERGE 1
+#endif
+
+/* The state of an AIO container.  A container is queued to a worker thread
+ * only when no earlier I/O of the same file is pending, else it is deferred
+ * until that I/O completes.  Only deferred I/O can be canceled.
+ */
+
+#define AIOC_QUEUED    0           /* Queued, or about to be queued */
+#define AIOC_DEFERRED  1           /* Waits for earlier I/O of the file */
+#define AIOC_ACTIVE    2           /* Performed along with earlier I/O */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -64,7 +87,9 @@ struct aio_container_s
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  worker_t aioc_worker;            /* Performs the I/O on the work thread */
   pid_t aioc_pid;                  /* ID of the waiting task */
+  uint8_t aioc_state;              /* See AIOC_* definitions */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
 #endif
@@ -206,11 +231,12 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the AIO work queue, or defer it until
+ *   the earlier I/O of the same file completes.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO container of the I/O
+ *   worker - The function that performs the I/O on the worker thread
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -220,6 +246,43 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Set the result of asynchronous I/O, free its container and signal the
+ *   client.  The next I/O of the same file is queued then.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container of the I/O
+ *   result - The result of the I/O, a negated errno value on failure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_complete(FAR struct aio_container_s *aioc, ssize_t result);
+
+/****************************************************************************
+ * Name: aio_transfer
+ *
+ * Description:
+ *   Perform an asynchronous read or write on the worker thread, together
+ *   with the deferred ones of the same file that continue where it ends,
+ *   and complete them all.
+ *
+ * Input Parameters:
+ *   aioc  - The AIO container of the read or write
+ *   write - true for a write, false for a read
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_transfer(FAR struct aio_container_s *aioc, bool write);
+
 /****************************************************************************
  * Name: aio_signal
  *
@@ -91,14 +91,10 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 
   FAR struct aio_container_s *aioc;
   FAR struct aio_container_s *next;
-  pid_t pid;
-  int status;
   int ret;
 
-  /* Check if a non-NULL aiocbp was provided */
-
-  /* Lock the scheduler so that no I/O events can complete on the worker
-   * thread until we set complete this operation.
+  /* Hold the AIO lock so that no I/O can be started or completed on the
+   * worker thread until we complete this operation.
    */
 
   ret = AIO_ALLDONE;
@@ -123,30 +119,17 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 
           if (aioc)
             {
-              /* Yes... attempt to cancel the I/O.  There are two
-               * possibilities:* (1) the work has already been started and
-               * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+              /* Yes... attempt to cancel the I/O.  Only I/O that waits for
+               * earlier I/O of the file can be canceled, the I/O that has
+               * been queued to the worker thread(s) may already run.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
-              if (status >= 0)
+              if (aioc->aioc_state == AIOC_DEFERRED)
                 {
-                  /* Remove the container from the list of pending
-                   * transfers
-                   */
-
-                  pid = aioc->aioc_pid;
-                  aioc_decant(aioc);
+                  /* Complete it as canceled and signal the client */
 
-                  aiocbp->aio_result = -ECANCELED;
+                  aio_complete(aioc, -ECANCELED);
                   ret = AIO_CANCELED;
-
-                  /* Signal the client */
-
-                  aio_signal(pid, aiocbp);
                 }
               else
                 {
@@ -165,59 +148,30 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
     {
       /* No aiocbp.. cancel all outstanding I/O for the fildes */
 
-      next = (FAR struct aio_container_s *)g_aio_pending.head;
-      do
+      for (aioc = (FAR struct aio_container_s *)g_aio_pending.head;
+           aioc != NULL; aioc = next)
         {
-          /* Find the next container with this AIO control block */
-
-          for (aioc = next;
-               aioc && aioc->aioc_aiocbp->aio_fildes != fildes;
-               aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink);
-
-          /* Did we find the container?  We should; the aio_result says
-           * that the transfer is pending.  If not we return AIO_ALLDONE.
-           */
-
-          if (aioc)
+          next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+          if (aioc->aioc_aiocbp->aio_fildes != fildes)
             {
-              /* Yes... attempt to cancel the I/O.  There are two
-               * possibilities:* (1) the work has already been started and
-               * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
-               */
-
-              status = work_cancel(LPWORK, &aioc->aioc_work);
-              if (status >= 0)
-                {
-                  /* Remove the container from the list of pending
-                   * transfers
-                   */
-
-                  next   =
-                    (FAR struct aio_container_s *)aioc->aioc_link.flink;
-                  pid    = aioc->aioc_pid;
-                  aiocbp = aioc_decant(aioc);
-                  DEBUGASSERT(aiocbp);
-
-                  aiocbp->aio_result = -ECANCELED;
-                  if (ret != AIO_NOTCANCELED)
-                    {
-                      ret = AIO_CANCELED;
-                    }
+              continue;
+            }
 
-                  /* Signal the client */
+          /* Attempt to cancel the I/O, see above */
 
-                  aio_signal(pid, aiocbp);
-                }
-              else
+          if (aioc->aioc_state == AIOC_DEFERRED)
+            {
+              aio_complete(aioc, -ECANCELED);
+              if (ret != AIO_NOTCANCELED)
                 {
-                  ret = AIO_NOTCANCELED;
+                  ret = AIO_CANCELED;
                 }
             }
+          else
+            {
+              ret = AIO_NOTCANCELED;
+            }
         }
-      while (aioc);
     }
 
   aio_unlock();
@@ -62,47 +62,21 @@
 static void aio_fsync_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
   int ret;
 
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
+  /* Perform the fsync using aioc_filep.  The earlier I/O of the file has
+   * completed, that of other files may still be in progress.
    */
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
-  /* Perform the fsync using aioc_filep */
 
   ret = file_fsync(aioc->aioc_filep);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
-      aiocbp->aio_result = ret;
-    }
-  else
-    {
-      aiocbp->aio_result = OK;
     }
 
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  aio_complete(aioc, ret < 0 ? ret : OK);
 }
 
 /****************************************************************************
@@ -38,19 +38,74 @@
 
 #ifdef CONFIG_FS_AIO
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if CONFIG_FS_AIO_NTHREADS > 0
+/* The work queue dedicated to asynchronous I/O, created on first use */
+
+static FAR struct kwork_wqueue_s *g_aio_wqueue;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_first
+ *
+ * Description:
+ *   Return the first pending AIO container of a file, if any.  The caller
+ *   holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static FAR struct aio_container_s *aio_first(FAR struct file *filep)
+{
+  FAR struct aio_container_s *aioc;
+
+  for (aioc = (FAR struct aio_container_s *)g_aio_pending.head;
+       aioc && aioc->aioc_filep != filep;
+       aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink);
+
+  return aioc;
+}
+
+/****************************************************************************
+ * Name: aio_dispatch
+ *
+ * Description:
+ *   Queue the I/O of an AIO container on the AIO work queue
+ *
+ ****************************************************************************/
+
+static int aio_dispatch(FAR struct aio_container_s *aioc)
+{
+  aioc->aioc_state = AIOC_QUEUED;
+
+#if CONFIG_FS_AIO_NTHREADS > 0
+  return work_queue_wq(g_aio_wqueue, &aioc->aioc_work, aioc->aioc_worker,
+                       aioc, 0);
+#else
+  return work_queue(LPWORK, &aioc->aioc_work, aioc->aioc_worker, aioc, 0);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the AIO work queue, or defer it until
+ *   the earlier I/O of the same file completes.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO container of the I/O
+ *   worker - The function that performs the I/O on the worker thread
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -62,7 +117,30 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
   int ret;
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+#if CONFIG_FS_AIO_NTHREADS > 0
+  /* Create the AIO worker threads on first use */
+
+  if (g_aio_wqueue == NULL)
+    {
+      g_aio_wqueue = work_queue_create("aio", CONFIG_FS_AIO_PRIORITY, NULL,
+                                       CONFIG_FS_AIO_STACKSIZE,
+                                       CONFIG_FS_AIO_NTHREADS);
+      if (g_aio_wqueue == NULL)
+        {
+          ferr("ERROR: Failed to create the AIO work queue\n");
+          aio_unlock();
+          ret = -ENOMEM;
+          goto errout;
+        }
+    }
+
+#elif defined(CONFIG_PRIORITY_INHERITANCE)
   /* Prohibit context switches until we complete the queuing */
 
   sched_lock();
@@ -74,28 +152,98 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   lpwork_boostpriority(aioc->aioc_prio);
 #endif
 
-  /* Schedule the work on the low priority worker thread */
+  /* Only the first pending I/O of a file is queued, the later I/O of it is
+   * queued when the I/O before completes.  The I/O of one file is thus
+   * performed in order, even by several worker threads.
+   */
 
-  ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
-  if (ret < 0)
+  aioc->aioc_worker = worker;
+  if (aio_first(aioc->aioc_filep) != aioc)
+    {
+      aioc->aioc_state = AIOC_DEFERRED;
+    }
+  else
     {
-      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-      DEBUGASSERT(aiocbp);
+      ret = aio_dispatch(aioc);
+    }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if CONFIG_FS_AIO_NTHREADS == 0 && defined(CONFIG_PRIORITY_INHERITANCE)
+  if (ret < 0)
+    {
       lpwork_restorepriority(aioc->aioc_prio);
-#endif
-      aiocbp->aio_result = ret;
-      set_errno(-ret);
-      ret = ERROR;
     }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
   /* Now the low-priority work queue might run at its new priority */
 
   sched_unlock();
 #endif
-  return ret;
+
+  aio_unlock();
+  if (ret >= 0)
+    {
+      return OK;
+    }
+
+errout:
+  aioc->aioc_aiocbp->aio_result = ret;
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Set the result of asynchronous I/O, free its container and signal the
+ *   client.  The next I/O of the same file is queued then.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container of the I/O
+ *   result - The result of the I/O, a negated errno value on failure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_complete(FAR struct aio_container_s *aioc, ssize_t result)
+{
+  FAR struct file *filep = aioc->aioc_filep;
+  FAR struct aio_container_s *next;
+  FAR struct aiocb *aiocbp;
+  pid_t pid = aioc->aioc_pid;
+#if CONFIG_FS_AIO_NTHREADS == 0 && defined(CONFIG_PRIORITY_INHERITANCE)
+  uint8_t prio = aioc->aioc_prio;
+#endif
+
+  aio_lock();
+
+  aiocbp = aioc_decant(aioc);
+  DEBUGASSERT(aiocbp);
+
+  aiocbp->aio_result = result;
+
+  /* Queue the next I/O of the file, unless it is performed along with this
+   * one or earlier I/O of the file is still pending.
+   */
+
+  next = aio_first(filep);
+  if (next != NULL && next->aioc_state == AIOC_DEFERRED)
+    {
+      DEBUGVERIFY(aio_dispatch(next));
+    }
+
+  aio_unlock();
+
+  /* Signal the client */
+
+  aio_signal(pid, aiocbp);
+
+#if CONFIG_FS_AIO_NTHREADS == 0 && defined(CONFIG_PRIORITY_INHERITANCE)
+  /* Restore the low priority worker thread default priority */
+
+  lpwork_restorepriority(prio);
+#endif
 }
 
 #endif /* CONFIG_FS_AIO */
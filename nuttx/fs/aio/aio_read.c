@@ -61,57 +61,7 @@
 
 static void aio_read_worker(FAR void *arg)
 {
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
-  ssize_t nread = 0;
-
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
-  /* Perform the file read using:
-   *
-   *   aioc_filep   - File structure pointer
-   *   aio_buf      - Location of buffer
-   *   aio_nbytes   - Length of transfer
-   *   aio_offset   - File offset
-   */
-
-  nread = file_pread(aioc->aioc_filep, (FAR void *)aiocbp->aio_buf,
-                     aiocbp->aio_nbytes, aiocbp->aio_offset);
-
-  /* Set the result of the read operation. */
-
-#ifdef CONFIG_DEBUG_FS_ERROR
-  if (nread < 0)
-    {
-      ferr("ERROR: read failed: %d\n", (int)nread);
-    }
-#endif
-
-  aiocbp->aio_result = nread;
-
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  aio_transfer((FAR struct aio_container_s *)arg, false);
 }
 
 /****************************************************************************
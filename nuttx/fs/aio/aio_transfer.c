@@ -0,0 +1,246 @@
+/****************************************************************************
+ * fs/aio/aio_transfer.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/uio.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <aio.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_merge
+ *
+ * Description:
+ *   Collect the I/O to perform with one transfer: the I/O of an AIO
+ *   container and the deferred I/O of the same kind that follows it on the
+ *   file, as long as each one continues where the one before ends.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container of the first I/O
+ *   append - true if the file is written at its end, whatever the offsets
+ *   list   - The AIO containers of the I/O to perform
+ *   iov    - The buffers of the I/O to perform
+ *
+ * Returned Value:
+ *   The number of AIO containers collected
+ *
+ ****************************************************************************/
+
+static int aio_merge(FAR struct aio_container_s *aioc, bool append,
+                     FAR struct aio_container_s **list,
+                     FAR struct iovec *iov)
+{
+  FAR struct aio_container_s *next = aioc;
+  FAR struct aiocb *aiocbp;
+  off_t offset = aioc->aioc_aiocbp->aio_offset;
+  int n = 0;
+
+  aio_lock();
+
+  do
+    {
+      if (next->aioc_filep == aioc->aioc_filep)
+        {
+          /* Stop at the first I/O of the file that cannot be merged, the
+           * I/O of a file is performed in order.
+           */
+
+          aiocbp = next->aioc_aiocbp;
+          if (next != aioc && (next->aioc_worker != aioc->aioc_worker ||
+                               (!append && aiocbp->aio_offset != offset)))
+            {
+              break;
+            }
+
+          DEBUGASSERT(next == aioc || next->aioc_state == AIOC_DEFERRED);
+
+          next->aioc_state = AIOC_ACTIVE;
+          list[n]          = next;
+          iov[n].iov_base  = (FAR void *)aiocbp->aio_buf;
+          iov[n].iov_len   = aiocbp->aio_nbytes;
+          offset          += aiocbp->aio_nbytes;
+          n++;
+        }
+
+      next = (FAR struct aio_container_s *)next->aioc_link.flink;
+    }
+  while (next != NULL && n < CONFIG_FS_AIO_MERGE);
+
+  aio_unlock();
+  return n;
+}
+
+/****************************************************************************
+ * Name: aio_prw
+ *
+ * Description:
+ *   Read or write a file at an offset without changing the file position,
+ *   like file_pread() and file_pwrite() but with several buffers.
+ *
+ ****************************************************************************/
+
+static ssize_t aio_prw(FAR struct file *filep, FAR const struct iovec *iov,
+                       int iovcnt, off_t offset, bool write)
+{
+  off_t savepos;
+  off_t pos;
+  ssize_t ret;
+
+  /* Get the current file position and seek to the offset */
+
+  savepos = file_seek(filep, 0, SEEK_CUR);
+  if (savepos < 0)
+    {
+      return (ssize_t)savepos;
+    }
+
+  pos = file_seek(filep, offset, SEEK_SET);
+  if (pos < 0)
+    {
+      return (ssize_t)pos;
+    }
+
+  if (write)
+    {
+      ret = file_writev(filep, iov, iovcnt);
+    }
+  else
+    {
+      ret = file_readv(filep, iov, iovcnt);
+    }
+
+  /* Restore the file position */
+
+  pos = file_seek(filep, savepos, SEEK_SET);
+  if (pos < 0 && ret >= 0)
+    {
+      ret = (ssize_t)pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_transfer
+ *
+ * Description:
+ *   Perform an asynchronous read or write on the worker thread, together
+ *   with the deferred ones of the same file that continue where it ends,
+ *   and complete them all.
+ *
+ * Input Parameters:
+ *   aioc  - The AIO container of the read or write
+ *   write - true for a write, false for a read
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_transfer(FAR struct aio_container_s *aioc, bool write)
+{
+  FAR struct aio_container_s *list[CONFIG_FS_AIO_MERGE];
+  struct iovec iov[CONFIG_FS_AIO_MERGE];
+  FAR struct file *filep;
+  bool append = false;
+  ssize_t nbytes;
+  ssize_t result;
+  int oflags;
+  int n;
+  int i;
+
+  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
+  filep = aioc->aioc_filep;
+
+  if (write)
+    {
+      /* Call fcntl(F_GETFL) to get the file open mode. */
+
+      oflags = file_fcntl(filep, F_GETFL);
+      if (oflags < 0)
+        {
+          ferr("ERROR: file_fcntl failed: %d\n", oflags);
+          aio_complete(aioc, oflags);
+          return;
+        }
+
+      /* If O_APPEND is set, append to the current file position */
+
+      append = (oflags & O_APPEND) != 0;
+    }
+
+  n = aio_merge(aioc, append, list, iov);
+  if (append)
+    {
+      nbytes = file_writev(filep, iov, n);
+    }
+  else
+    {
+      nbytes = aio_prw(filep, iov, n, aioc->aioc_aiocbp->aio_offset, write);
+    }
+
+  if (nbytes < 0)
+    {
+      ferr("ERROR: %s failed: %zd\n", write ? "write" : "read", nbytes);
+    }
+
+  /* Split the result up among the requests in order: a short transfer
+   * ends in one of them, the ones after transferred nothing.
+   */
+
+  for (i = 0; i < n; i++)
+    {
+      result = nbytes;
+      if (nbytes >= 0)
+        {
+          result  = (size_t)nbytes < iov[i].iov_len ?
+                    nbytes : (ssize_t)iov[i].iov_len;
+          nbytes -= result;
+        }
+
+      aio_complete(list[i], result);
+    }
+}
+
+#endif /* CONFIG_FS_AIO */
@@ -113,6 +113,7 @@ static int     fat_stat_root(FAR struct fat_mountpt_s *fs,
                  FAR struct stat *buf);
 static int     fat_stat(struct inode *mountpt, const char *relpath,
                  FAR struct stat *buf);
+static int     fat_syncfs(FAR struct inode *mountpt);
 
 /****************************************************************************
  * Public Data
@@ -156,7 +157,8 @@ const struct mountpt_operations g_fat_operations =
   fat_rmdir,         /* rmdir */
   fat_rename,        /* rename */
   fat_stat,          /* stat */
-  NULL               /* chstat */
+  NULL,              /* chstat */
+  fat_syncfs         /* syncfs */
 };
 
 /****************************************************************************
@@ -2326,6 +2328,15 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Write back the sectors that are still cached */
+
+  if (fs->fs_mounted && fs->fs_buffer)
+    {
+      fat_fscacheflush(fs);
+    }
+#endif
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2355,6 +2366,9 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   if (fs->fs_buffer)
     {
+#ifdef CONFIG_FAT_SECTORCACHE
+      fat_cache_uninitialize(fs);
+#endif
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
@@ -3092,6 +3106,39 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_syncfs
+ *
+ * Description: Write back all sectors buffered for the volume and update
+ *   the FSINFO sector
+ *
+ ****************************************************************************/
+
+static int fat_syncfs(FAR struct inode *mountpt)
+{
+  FAR struct fat_mountpt_s *fs;
+  int ret;
+
+  DEBUGASSERT(mountpt && mountpt->i_private);
+
+  fs = mountpt->i_private;
+
+  ret = nxmutex_lock(&fs->fs_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = fat_checkmount(fs);
+  if (ret == OK)
+    {
+      ret = fat_updatefsinfo(fs);
+    }
+
+  nxmutex_unlock(&fs->fs_lock);
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
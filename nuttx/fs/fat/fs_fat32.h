@@ -857,6 +857,24 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* This structure describes one sector buffer of the sector cache.  The
+ * cache holds the sectors that were in fs_buffer before, the sector in
+ * fs_buffer itself is never in the cache.
+ */
+
+struct fat_cacheslot_s
+{
+  off_t    cs_sector;              /* The sector in the buffer, -1 if none */
+  uint32_t cs_stamp;               /* The time of the last use */
+  bool     cs_dirty;               /* true: The buffer must be written back */
+  uint8_t *cs_buffer;              /* The sector buffer */
+};
+
+#  define FAT_CACHE_NSLOTS (CONFIG_FAT_SECTORCACHE_FATSECTORS + \
+                            CONFIG_FAT_SECTORCACHE_DATASECTORS)
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
@@ -891,6 +909,15 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#ifdef CONFIG_FAT_SECTORCACHE
+  uint8_t *fs_cachebuf;            /* The buffers of all cache slots */
+  off_t    fs_cachemiss;           /* The sector of the last cache miss */
+  uint32_t fs_cachestamp;          /* The time of the last cache access */
+
+  /* The slots of the FAT table sectors, followed by those of the others */
+
+  struct fat_cacheslot_s fs_cache[FAT_CACHE_NSLOTS];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -1100,6 +1127,16 @@ EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(FAR struct fat_mountpt_s *fs,
                                     FAR struct fat_file_s *ff);
 
+#ifdef CONFIG_FAT_SECTORCACHE
+/* Multi-sector cache behind fs_buffer */
+
+EXTERN int    fat_cache_initialize(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_cache_uninitialize(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_cache_written(FAR struct fat_mountpt_s *fs,
+                                FAR const uint8_t *buffer, off_t sector,
+                                unsigned int nsectors);
+#endif
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(FAR struct fat_mountpt_s *fs);
@@ -0,0 +1,540 @@
+/****************************************************************************
+ * fs/fat/fs_fat32cache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "fs_heap.h"
+#include "fs_fat32.h"
+
+#ifdef CONFIG_FAT_SECTORCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FAT_CACHE_FATSLOTS   CONFIG_FAT_SECTORCACHE_FATSECTORS
+#define FAT_CACHE_DATASLOTS  CONFIG_FAT_SECTORCACHE_DATASECTORS
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cache_isfat
+ *
+ * Description:
+ *   Return true if the sector lies in the (first) FAT table.
+ *
+ ****************************************************************************/
+
+static bool fat_cache_isfat(FAR struct fat_mountpt_s *fs, off_t sector)
+{
+  return sector >= fs->fs_fatbase &&
+         sector < fs->fs_fatbase + fs->fs_nfatsects;
+}
+
+/****************************************************************************
+ * Name: fat_cache_writeback
+ *
+ * Description:
+ *   Write a cached sector to the device, and to the other copies of the
+ *   FAT table if it is a sector of the FAT table.
+ *
+ ****************************************************************************/
+
+static int fat_cache_writeback(FAR struct fat_mountpt_s *fs,
+                               FAR uint8_t *buffer, off_t sector)
+{
+  int ret;
+  int i;
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0 || !fat_cache_isfat(fs, sector))
+    {
+      return ret;
+    }
+
+  for (i = fs->fs_fatnumfats; i >= 2; i--)
+    {
+      sector += fs->fs_nfatsects;
+      ret = fat_hwwrite(fs, buffer, sector, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cache_lookup
+ *
+ * Description:
+ *   Find the slot that holds a sector.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cacheslot_s *
+fat_cache_lookup(FAR struct fat_mountpt_s *fs, off_t sector)
+{
+  int i;
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      if (fs->fs_cache[i].cs_sector == sector)
+        {
+          return &fs->fs_cache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: fat_cache_victim
+ *
+ * Description:
+ *   Return the least recently used of a range of slots, an empty slot if
+ *   there is one.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cacheslot_s *
+fat_cache_victim(FAR struct fat_mountpt_s *fs, int first, int nslots)
+{
+  FAR struct fat_cacheslot_s *victim = NULL;
+  FAR struct fat_cacheslot_s *slot;
+  uint32_t maxage = 0;
+  int i;
+
+  for (i = first; i < first + nslots; i++)
+    {
+      slot = &fs->fs_cache[i];
+      if (slot->cs_sector < 0)
+        {
+          return slot;
+        }
+
+      if (victim == NULL || fs->fs_cachestamp - slot->cs_stamp > maxage)
+        {
+          victim = slot;
+          maxage = fs->fs_cachestamp - slot->cs_stamp;
+        }
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: fat_cache_park
+ *
+ * Description:
+ *   Move the sector in fs_buffer to the cache, before another sector is
+ *   read into fs_buffer.  The least recently used sector of its area is
+ *   evicted, and written back if it is dirty.
+ *
+ ****************************************************************************/
+
+static int fat_cache_park(FAR struct fat_mountpt_s *fs)
+{
+  FAR struct fat_cacheslot_s *slot;
+  int ret;
+
+  if (fs->fs_currentsector < 0)
+    {
+      return OK;
+    }
+
+  /* Some callers fill fs_buffer and set fs_currentsector themselves, that
+   * may leave an older copy of the sector in the cache.  Replace it.
+   */
+
+  slot = fat_cache_lookup(fs, fs->fs_currentsector);
+  if (slot == NULL)
+    {
+      if (fat_cache_isfat(fs, fs->fs_currentsector))
+        {
+          slot = fat_cache_victim(fs, 0, FAT_CACHE_FATSLOTS);
+        }
+      else
+        {
+          slot = fat_cache_victim(fs, FAT_CACHE_FATSLOTS,
+                                  FAT_CACHE_DATASLOTS);
+        }
+
+      if (slot->cs_dirty)
+        {
+          ret = fat_cache_writeback(fs, slot->cs_buffer, slot->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  memcpy(slot->cs_buffer, fs->fs_buffer, fs->fs_hwsectorsize);
+  slot->cs_sector = fs->fs_currentsector;
+  slot->cs_dirty  = fs->fs_dirty;
+  slot->cs_stamp  = ++fs->fs_cachestamp;
+
+  fs->fs_currentsector = -1;
+  fs->fs_dirty         = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cache_take
+ *
+ * Description:
+ *   Move a sector from the cache to fs_buffer.
+ *
+ ****************************************************************************/
+
+static void fat_cache_take(FAR struct fat_mountpt_s *fs,
+                           FAR struct fat_cacheslot_s *slot)
+{
+  memcpy(fs->fs_buffer, slot->cs_buffer, fs->fs_hwsectorsize);
+  fs->fs_currentsector = slot->cs_sector;
+  fs->fs_dirty         = slot->cs_dirty;
+
+  slot->cs_sector = -1;
+  slot->cs_dirty  = false;
+}
+
+#if CONFIG_FAT_SECTORCACHE_READAHEAD > 1
+/****************************************************************************
+ * Name: fat_cache_readahead
+ *
+ * Description:
+ *   Read a sector and the sectors that follow it into consecutive slots of
+ *   the directory area, which have adjacent buffers, with one request.
+ *
+ * Returned Value:
+ *   The slot of the sector on success; NULL if read-ahead is not possible
+ *   now, or on an error, which is returned in ret.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cacheslot_s *
+fat_cache_readahead(FAR struct fat_mountpt_s *fs, off_t sector,
+                    FAR int *ret)
+{
+  FAR struct fat_cacheslot_s *slot;
+  uint32_t bestage = 0;
+  uint32_t age;
+  int nsectors;
+  int best = -1;
+  int i;
+  int j;
+
+  /* Do not read sectors that are cached already or in the FAT table */
+
+  for (nsectors = 1; nsectors < CONFIG_FAT_SECTORCACHE_READAHEAD &&
+                     sector + nsectors < fs->fs_hwnsectors; nsectors++)
+    {
+      if (fat_cache_isfat(fs, sector + nsectors) ||
+          fat_cache_lookup(fs, sector + nsectors) != NULL)
+        {
+          break;
+        }
+    }
+
+  if (nsectors < 2)
+    {
+      return NULL;
+    }
+
+  /* Find the clean run of slots whose most recent use is the oldest */
+
+  for (i = FAT_CACHE_FATSLOTS;
+       i + nsectors <= FAT_CACHE_FATSLOTS + FAT_CACHE_DATASLOTS; i++)
+    {
+      age = UINT32_MAX;
+      for (j = i; j < i + nsectors; j++)
+        {
+          slot = &fs->fs_cache[j];
+          if (slot->cs_dirty)
+            {
+              break;
+            }
+
+          if (slot->cs_sector >= 0 &&
+              fs->fs_cachestamp - slot->cs_stamp < age)
+            {
+              age = fs->fs_cachestamp - slot->cs_stamp;
+            }
+        }
+
+      if (j == i + nsectors && (best < 0 || age > bestage))
+        {
+          best    = i;
+          bestage = age;
+        }
+    }
+
+  if (best < 0)
+    {
+      return NULL;
+    }
+
+  for (j = best; j < best + nsectors; j++)
+    {
+      fs->fs_cache[j].cs_sector = -1;
+    }
+
+  *ret = fat_hwread(fs, fs->fs_cache[best].cs_buffer, sector, nsectors);
+  if (*ret < 0)
+    {
+      return NULL;
+    }
+
+  for (j = 0; j < nsectors; j++)
+    {
+      slot            = &fs->fs_cache[best + j];
+      slot->cs_sector = sector + j;
+      slot->cs_stamp  = fs->fs_cachestamp;
+    }
+
+  fs->fs_cachemiss = sector + nsectors - 1;
+  return &fs->fs_cache[best];
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fat_cache_initialize
+ *
+ * Description:
+ *   Allocate the sector buffers of the cache.  Whatever was read into
+ *   fs_buffer during the mount is not a cached sector.
+ *
+ ****************************************************************************/
+
+int fat_cache_initialize(FAR struct fat_mountpt_s *fs)
+{
+  int i;
+
+  fs->fs_cachebuf = (FAR uint8_t *)
+    fat_io_alloc(FAT_CACHE_NSLOTS * fs->fs_hwsectorsize);
+  if (fs->fs_cachebuf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      fs->fs_cache[i].cs_sector = -1;
+      fs->fs_cache[i].cs_stamp  = 0;
+      fs->fs_cache[i].cs_dirty  = false;
+      fs->fs_cache[i].cs_buffer = fs->fs_cachebuf +
+                                  i * fs->fs_hwsectorsize;
+    }
+
+  fs->fs_cachestamp    = 0;
+  fs->fs_cachemiss     = -1;
+  fs->fs_currentsector = -1;
+  fs->fs_dirty         = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cache_uninitialize
+ *
+ * Description:
+ *   Free the sector buffers of the cache, without writing anything back.
+ *
+ ****************************************************************************/
+
+void fat_cache_uninitialize(FAR struct fat_mountpt_s *fs)
+{
+  if (fs->fs_cachebuf != NULL)
+    {
+      fat_io_free(fs->fs_cachebuf, FAT_CACHE_NSLOTS * fs->fs_hwsectorsize);
+      fs->fs_cachebuf = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cache_written
+ *
+ * Description:
+ *   Sectors were written to the device from another buffer than their
+ *   slot: the slots that hold them are out of date, drop them.  The
+ *   sector in fs_buffer is left alone, as without the cache.
+ *
+ ****************************************************************************/
+
+void fat_cache_written(FAR struct fat_mountpt_s *fs,
+                       FAR const uint8_t *buffer, off_t sector,
+                       unsigned int nsectors)
+{
+  FAR struct fat_cacheslot_s *slot;
+  int i;
+
+  if (fs->fs_cachebuf == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      slot = &fs->fs_cache[i];
+      if (slot->cs_sector >= sector && slot->cs_sector < sector + nsectors &&
+          slot->cs_buffer != buffer + (slot->cs_sector - sector) *
+                                      fs->fs_hwsectorsize)
+        {
+          slot->cs_sector = -1;
+          slot->cs_dirty  = false;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_fscacheflush
+ *
+ * Description:
+ *   Write back all dirty sectors, in the cache and in fs_buffer
+ *
+ ****************************************************************************/
+
+int fat_fscacheflush(FAR struct fat_mountpt_s *fs)
+{
+  FAR struct fat_cacheslot_s *slot;
+  int ret;
+  int i;
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      slot = &fs->fs_cache[i];
+      if (!slot->cs_dirty)
+        {
+          continue;
+        }
+
+      /* An older copy of the sector in fs_buffer is dropped, not written */
+
+      if (slot->cs_sector != fs->fs_currentsector)
+        {
+          ret = fat_cache_writeback(fs, slot->cs_buffer, slot->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+      else
+        {
+          slot->cs_sector = -1;
+        }
+
+      slot->cs_dirty = false;
+    }
+
+  if (fs->fs_dirty)
+    {
+      ret = fat_cache_writeback(fs, fs->fs_buffer, fs->fs_currentsector);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      fs->fs_dirty = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscacheread
+ *
+ * Description:
+ *   Read the specified sector into fs_buffer, from the cache or else from
+ *   the device, after moving the sector in fs_buffer to the cache.
+ *
+ ****************************************************************************/
+
+int fat_fscacheread(FAR struct fat_mountpt_s *fs, off_t sector)
+{
+  FAR struct fat_cacheslot_s *slot;
+  int ret;
+
+  if (fs->fs_currentsector == sector)
+    {
+      return OK;
+    }
+
+  ret = fat_cache_park(fs);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  slot = fat_cache_lookup(fs, sector);
+
+#if CONFIG_FAT_SECTORCACHE_READAHEAD > 1
+  if (slot == NULL && sector == fs->fs_cachemiss + 1 &&
+      !fat_cache_isfat(fs, sector))
+    {
+      slot = fat_cache_readahead(fs, sector, &ret);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  if (slot != NULL)
+    {
+      fat_cache_take(fs, slot);
+      return OK;
+    }
+
+  ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (!fat_cache_isfat(fs, sector))
+    {
+      fs->fs_cachemiss = sector;
+    }
+
+  fs->fs_currentsector = sector;
+  return OK;
+}
+
+#endif /* CONFIG_FAT_SECTORCACHE */
@@ -613,6 +613,16 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
         }
     }
 
+#ifdef CONFIG_FAT_SECTORCACHE
+  /* Set up the sector cache before the first cached read */
+
+  ret = fat_cache_initialize(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+#endif
+
   /* We have what appears to be a valid FAT filesystem! Now read the
    * FSINFO sector (FAT32 only)
    */
@@ -658,6 +668,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#ifdef CONFIG_FAT_SECTORCACHE
+  fat_cache_uninitialize(fs);
+#endif
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = NULL;
 
@@ -766,6 +779,9 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
 
           if (nsectorswritten == nsectors)
             {
+#ifdef CONFIG_FAT_SECTORCACHE
+              fat_cache_written(fs, buffer, sector, nsectors);
+#endif
               ret = OK;
             }
           else if (nsectorswritten < 0)
@@ -1758,6 +1774,7 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
   return OK;
 }
 
+#ifndef CONFIG_FAT_SECTORCACHE
 /****************************************************************************
  * Name: fat_fscacheflush
  *
@@ -1857,6 +1874,7 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 
   return OK;
 }
+#endif /* !CONFIG_FAT_SECTORCACHE */
 
 /****************************************************************************
  * Name: fat_ffcacheflush
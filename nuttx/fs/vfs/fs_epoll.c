@@ -42,6 +42,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -53,8 +54,15 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rnode;    /* Node in the ready list */
   epoll_data_t             data;
-  bool                     notified;
+  bool                     notified; /* Queued in the ready list, or
+                                      * reported and not setuped again
+                                      */
+  pollevent_t              revents;  /* Events collected by the poll
+                                      * callback under rlock, consumed by
+                                      * epoll_teardown()
+                                      */
   struct pollfd            pfd;
   FAR struct file         *filep;
   FAR struct epoll_head_s *eph;
@@ -68,6 +76,14 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rlock;    /* Protects the ready list, which is
+                                   * updated from the poll callback.
+                                   */
+  struct list_node      ready;    /* The ready list, store the setuped epoll
+                                   * node whose poll callback reported
+                                   * events, so epoll_wait() only visits
+                                   * the ready fds.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
                                    * epoll node.
                                    */
@@ -239,11 +255,13 @@ static int epoll_do_create(int size, int flags)
   eph->size = size;
   nxmutex_init(&eph->lock);
   nxsem_init(&eph->sem, 0, 0);
+  spin_lock_init(&eph->rlock);
 
   /* List initialize */
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  list_initialize(&eph->ready);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -270,6 +288,38 @@ static int epoll_do_create(int size, int flags)
   return fd;
 }
 
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a setuped epoll node from the ready list after its poll has
+ *   been torn down, so no callback can queue it again.
+ *
+ * Input Parameters:
+ *   eph       - The epoll head pointer
+ *   epn       - The epoll node pointer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (list_in_list(&epn->rnode))
+    {
+      list_delete(&epn->rnode);
+    }
+
+  epn->notified = false;
+  epn->revents  = 0;
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
 /****************************************************************************
  * Name: epoll_setup
  *
@@ -303,6 +353,7 @@ static int epoll_setup(FAR epoll_head_t *eph)
        */
 
       epn->notified    = false;
+      epn->revents     = 0;
       epn->pfd.revents = 0;
       ret = file_poll(epn->filep, &epn->pfd, true);
       if (ret < 0)
@@ -324,8 +375,16 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notified fd and check the notified fd's event with user
- *   expected event.
+ *   Drain the ready list and report the notified fd's event.  Only the fds
+ *   queued by the poll callback are visited, so the cost is proportional
+ *   to the number of ready fds, not to the number of registered fds.
+ *
+ *   Level-triggered fds, and fds notified without any expected event, are
+ *   torn down and moved to the teardown list, so the next epoll_setup()
+ *   checks again whether they are ready.  Edge-triggered (EPOLLET) fds
+ *   stay setuped and are only queued again by a new notification.
+ *   EPOLLONESHOT fds are parked in the oneshot list until they are rearmed
+ *   by EPOLL_CTL_MOD.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -341,31 +400,52 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
+  bool edge;
+  int semcount = 0;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  while (i < maxevents)
     {
-      /* Only check the notified fd */
-
-      if (!epn->notified)
+      flags = spin_lock_irqsave(&eph->rlock);
+      if (list_is_empty(&eph->ready))
         {
-          continue;
+          spin_unlock_irqrestore(&eph->rlock, flags);
+          break;
         }
 
-      /* Teradown all the notified fd */
+      epn = container_of(list_remove_head(&eph->ready),
+                         epoll_node_t, rnode);
+      /* Consume the events collected by the callback.  The callback has
+       * already moved them out of pfd.revents.
+       */
 
-      file_poll(epn->filep, &epn->pfd, false);
-      list_delete(&epn->node);
+      revents      = epn->revents;
+      epn->revents = 0;
+      edge         = revents != 0 &&
+                     (epn->pfd.events & (EPOLLET | EPOLLONESHOT)) == EPOLLET;
+      if (edge)
+        {
+          /* Keep the poll setuped and rearm the node for the next edge */
+
+          epn->notified = false;
+        }
 
-      if (epn->pfd.revents != 0 && i < maxevents)
+      spin_unlock_irqrestore(&eph->rlock, flags);
+
+      if (!edge)
         {
-          evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
-          if ((epn->pfd.events & EPOLLONESHOT) != 0)
+          /* Teardown the notified fd, it stays marked as notified so that
+           * the callback can't queue it again before it is setuped.
+           */
+
+          file_poll(epn->filep, &epn->pfd, false);
+          list_delete(&epn->node);
+          if (revents != 0 && (epn->pfd.events & EPOLLONESHOT) != 0)
             {
               list_add_tail(&eph->oneshot, &epn->node);
             }
@@ -374,12 +454,29 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
               list_add_tail(&eph->teardown, &epn->node);
             }
         }
-      else
+
+      if (revents != 0)
         {
-          list_add_tail(&eph->teardown, &epn->node);
+          evs[i].data     = epn->data;
+          evs[i++].events = revents;
+        }
+    }
+
+  /* Wake up the next epoll_wait() at once if some ready fds didn't fit
+   * into the events array.
+   */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (!list_is_empty(&eph->ready))
+    {
+      nxsem_get_value(&eph->sem, &semcount);
+      if (semcount < 1)
+        {
+          nxsem_post(&eph->sem);
         }
     }
 
+  spin_unlock_irqrestore(&eph->rlock, flags);
   nxmutex_unlock(&eph->lock);
   return i;
 }
@@ -402,15 +499,42 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
+  bool wakeup;
   int semcount = 0;
 
-  epn->notified = true;
-  if (fds->revents != 0)
+  /* Queue the node to the ready list, this may be called from the
+   * interrupt context, so only the spinlock can be taken here.  A
+   * notification without any expected event (POLLALWAYS) is queued too:
+   * the driver's internal state changed and the fd must be setuped again
+   * by the next epoll_wait(), but nobody needs to be woken up for it.
+   *
+   * The events are accumulated into the node under the same lock, so an
+   * edge reported while the node is still queued is merged into the
+   * pending report instead of being lost.  They are consumed from the pfd
+   * at once: an EPOLLET node stays setuped, so nothing else resets its
+   * revents and every later notification would report them again.
+   */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  epn->revents |= fds->revents;
+  fds->revents  = 0;
+  if (!epn->notified)
+    {
+      epn->notified = true;
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  wakeup = epn->revents != 0;
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (wakeup)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
+      nxsem_get_value(&eph->sem, &semcount);
       if (semcount < 1)
         {
-          nxsem_post(&epn->eph->sem);
+          nxsem_post(&eph->sem);
         }
     }
 }
@@ -562,6 +686,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn->eph         = eph;
         epn->data        = ev->data;
         epn->notified    = false;
+        epn->revents     = 0;
         epn->pfd.events  = ev->events | POLLALWAYS;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
@@ -593,6 +718,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 file_poll(epn->filep, &epn->pfd, false);
+                epoll_unready(eph, epn);
                 file_put(epn->filep);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
@@ -633,8 +759,10 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
                     file_poll(epn->filep, &epn->pfd, false);
+                    epoll_unready(eph, epn);
 
                     epn->notified    = false;
+                    epn->revents     = 0;
                     epn->data        = ev->data;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.revents = 0;
@@ -657,6 +785,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
                     epn->notified    = false;
+                    epn->revents     = 0;
                     epn->data        = ev->data;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.revents = 0;
@@ -680,6 +809,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 epn->notified    = false;
+                epn->revents     = 0;
                 epn->data        = ev->data;
                 epn->pfd.events  = ev->events | POLLALWAYS;
                 epn->pfd.revents = 0;
@@ -2941,6 +2941,29 @@ bool up_fpucmp(FAR const void *saveregs1, FAR const void *saveregs2);
 #define up_fpucmp(r1, r2) (true)
 #endif
 
+/****************************************************************************
+ * Name: up_chksum_block
+ *
+ * Description:
+ *   Sum a block of data as native-endian 16-bit words, using the vector
+ *   unit of the CPU.  This is the inner loop of the Internet checksum of
+ *   the network stack.
+ *
+ * Input Parameters:
+ *   data - The data, aligned to 4 bytes.
+ *   len  - The length of the data, a multiple of 64 bytes and no more
+ *          than 64 KiB.
+ *
+ * Returned Value:
+ *   A value whose one's complement fold to 16 bits is the one's
+ *   complement sum of the native-endian 16-bit words of the block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARCH_CHKSUM_BLOCK
+uint32_t up_chksum_block(FAR const void *data, size_t len);
+#endif
+
 #ifdef CONFIG_ARCH_HAVE_DEBUG
 
 /****************************************************************************
@@ -49,6 +49,11 @@
 #  define MEMPOOL_REALBLOCKSIZE(pool) ((pool)->blocksize)
 #endif
 
+#if defined(CONFIG_MM_MEMPOOL_PERCPU_CACHE) && \
+    CONFIG_MM_MEMPOOL_PERCPU_CACHE > 0
+#  define MEMPOOL_HAVE_PERCPU_CACHE 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -87,6 +92,19 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+/* This structure describes the free blocks a CPU keeps for itself, so that
+ * most allocations and releases do not take the lock of the pool.
+ */
+
+struct mempool_cache_s
+{
+  FAR sq_entry_t *head;   /* The stack of free blocks in the cache */
+  size_t          count;  /* The number of blocks in the cache */
+  ssize_t         nalloc; /* Blocks allocated less blocks released here */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -110,6 +128,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  struct mempool_cache_s cache[CONFIG_SMP_NCPUS]; /* The per-CPU caches */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
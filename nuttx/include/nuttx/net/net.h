@@ -141,6 +141,7 @@ struct file;    /* Forward reference */
 struct stat;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
+struct iob_s;   /* Forward reference */
 
 struct sock_intf_s
 {
@@ -181,6 +182,12 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+#ifdef CONFIG_NET_ZEROCOPY
+  CODE ssize_t    (*si_recviob)(FAR struct socket *psock,
+                    FAR struct iob_s **iob, int flags);
+  CODE ssize_t    (*si_sendiob)(FAR struct socket *psock,
+                    FAR struct iob_s **iob, int flags);
+#endif
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -206,6 +213,12 @@ struct socket_conn_s
   FAR struct devif_callback_s *list;
   FAR struct devif_callback_s *list_tail;
 
+  /* Per-connection lock, see conn_lock().  Only initialized by the
+   * protocols that use it (TCP and UDP).
+   */
+
+  rmutex_t      s_lock;
+
   /* Socket options */
 
 #ifdef CONFIG_NET_SOCKOPTS
@@ -220,6 +233,9 @@ struct socket_conn_s
   uint8_t       s_boundto;   /* Index of the interface we are bound to.
                               * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #  endif
+#  ifdef CONFIG_NET_BUSY_POLL
+  uint16_t      s_busypoll;  /* Busy poll time before blocking (in usec) */
+#  endif
 #endif
 
   /* Definitions of 8-bit socket flags */
@@ -320,12 +336,48 @@ ssize_t net_ioctl_arglen(uint8_t domain, int cmd);
  *
  *   net_lock()        - Locks the network via a re-entrant mutex.
  *   net_unlock()      - Unlocks the network.
+ *   conn_lock()       - Locks the state of one TCP or UDP connection.
+ *   conn_unlock()     - Unlocks the connection.
+ *   netdev_lock()     - Locks the packet buffer and TX path of one device.
+ *   netdev_unlock()   - Unlocks the device.
  *   net_sem_wait()    - Like pthread_cond_wait() except releases the
  *                       network momentarily to wait on another semaphore.
  *   net_ioballoc()    - Like iob_alloc() except releases the network
  *                       momentarily to wait for an IOB to become
  *                       available.
  *
+ * The locks must be taken in this order, the routing table locks of
+ * net_lockroute_ipv4() and net_lockroute_ipv6() being leaves:
+ *
+ *   net_lock() -> netdev_lock() -> conn_lock() -> routing table lock
+ *
+ * net_lock() still protects the connection lists, the callback pool and
+ * the device list.  It is taken by the device input and poll paths, the
+ * timers and the socket calls that set up or tear down connections; these
+ * take the device lock and then the lock of the connection they work on.
+ *
+ * send(), recv() and the ioctl, poll and procfs readers of a connection
+ * take only its connection lock while they move data between the user and
+ * the read-ahead and write queues, so these queues must never be read with
+ * only net_lock() held.  A thread that holds a connection lock without
+ * net_lock() must release it before it blocks or takes net_lock();
+ * conn_net_lock() does that and retakes the connection lock afterwards.
+ *
+ * The device lock serializes the packet buffer and the TX queue of a
+ * device.  The upper half driver hands queued packets to the lower half
+ * with only the device lock held, so that it does not wait for the rest of
+ * the stack; such a thread never waits for another lock while it holds the
+ * device lock.
+ *
+ * With net_lock() held, a device lock may also be taken under a connection
+ * lock, e.g. by a driver that polls from its txavail method when a socket
+ * call notifies it.  Every thread that waits for a connection lock while
+ * holding a device lock holds net_lock() as well, so no cycle is formed.
+ *
+ * The routing table locks protect only the table: no other network lock
+ * may be taken while one is held, so a route handler that needs net_lock()
+ * runs with it taken before the routing table is locked.
+ *
  ****************************************************************************/
 
 /****************************************************************************
@@ -380,6 +432,60 @@ int net_trylock(void);
 
 void net_unlock(void);
 
+/****************************************************************************
+ * Name: conn_lock
+ *
+ * Description:
+ *   Take the lock of a TCP or UDP connection.  It protects the read-ahead
+ *   and write queues and the protocol state of the connection, so that
+ *   send() and recv() can run without the network lock while the stack
+ *   works on other connections.
+ *
+ * Input Parameters:
+ *   sconn - The connection to be locked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_lock(FAR struct socket_conn_s *sconn);
+
+/****************************************************************************
+ * Name: conn_unlock
+ *
+ * Description:
+ *   Release the lock of a TCP or UDP connection.
+ *
+ * Input Parameters:
+ *   sconn - The connection to be unlocked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_unlock(FAR struct socket_conn_s *sconn);
+
+/****************************************************************************
+ * Name: conn_net_lock
+ *
+ * Description:
+ *   Take the network lock while holding the lock of a connection.  The
+ *   connection lock is released and re-taken after the network lock to
+ *   respect the lock order, so the state of the connection may change in
+ *   between and has to be checked again.
+ *
+ * Input Parameters:
+ *   sconn - The connection locked by the caller
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_net_lock(FAR struct socket_conn_s *sconn);
+
 /****************************************************************************
  * Name: net_sem_timedwait
  *
@@ -928,6 +1034,61 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends several messages on a socket with a single
+ *   call.  This is an internal OS interface.  It is functionally
+ *   equivalent to sendmmsg() except that it is not a cancellation point,
+ *   it does not modify the errno variable and it accepts the internal
+ *   socket structure as an input.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Array of messages to send
+ *   vlen     Number of entries in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent; msg_len of each
+ *   message sent holds the number of bytes transmitted.  A negated errno
+ *   value is returned only if the first message could not be sent.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket with a
+ *   single call.  This is an internal OS interface.  It is functionally
+ *   equivalent to recvmmsg() except that it is not a cancellation point,
+ *   it does not modify the errno variable and it accepts the internal
+ *   socket structure as an input.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Array of message buffers
+ *   vlen     Number of entries in msgvec
+ *   flags    Receive flags; MSG_WAITFORONE turns on MSG_DONTWAIT after
+ *            the first message has been received
+ *   timeout  Optional timeout, updated with the time left on return
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received; msg_len of each
+ *   message received holds its length.  A negated errno value is returned
+ *   only if no message could be received.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
@@ -1429,6 +1590,83 @@ ssize_t psock_sendfile(FAR struct socket *psock, FAR struct file *infile,
                        FAR off_t *offset, size_t count);
 #endif
 
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Receive data from a connected stream socket or a datagram socket
+ *   without copying it:  The I/O buffer chain holding the queued data is
+ *   detached from the socket and loaned to the caller.  A datagram socket
+ *   returns one datagram, without its sender address.  The caller owns
+ *   the chain on return and must release it with iob_free_chain().
+ *
+ * Input Parameters:
+ *   psock   An instance of the internal socket structure.
+ *   iob     Location to return the I/O buffer chain.  Set to NULL if no
+ *           data is returned.
+ *   flags   Receive flags (only MSG_DONTWAIT is supported)
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the returned chain.  Zero
+ *   is returned if the peer has performed an orderly shutdown.  Otherwise
+ *   a negated errno value is returned (see recv()).  -EOPNOTSUPP is
+ *   returned if the socket does not support zero-copy receive.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      int flags);
+#endif
+
+/****************************************************************************
+ * Name: psock_sendiob
+ *
+ * Description:
+ *   Send a caller-filled I/O buffer chain on a connected socket without
+ *   copying it.  A stream socket splits the chain at IOB boundaries into
+ *   write buffers, a datagram socket sends it as one datagram.  The stack
+ *   takes ownership of every IOB it queues and frees it once it is no
+ *   longer needed, i.e. when it is acknowledged or transmitted.
+ *
+ *   An IOB from iob_alloc_with_data() loans a caller buffer to the stack:
+ *   its free callback is the notification that the buffer can be reused.
+ *
+ * Input Parameters:
+ *   psock   An instance of the internal socket structure.
+ *   iob     On entry, the I/O buffer chain to send.  On return, the part
+ *           of the chain that could not be queued or NULL if all of it
+ *           was.  The caller still owns anything returned here.
+ *   flags   Send flags (only MSG_DONTWAIT is supported)
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  Otherwise a negated
+ *   errno value is returned (see send()).  -EOPNOTSUPP is returned if the
+ *   socket does not support zero-copy send.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      int flags);
+#endif
+
+/****************************************************************************
+ * Name: net_recviob and net_sendiob
+ *
+ * Description:
+ *   Descriptor based versions of psock_recviob() and psock_sendiob().
+ *   The IOBs live in kernel memory, so these are for applications in the
+ *   FLAT build and for kernel code.  On failure, -1 is returned and errno
+ *   is set appropriately.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t net_recviob(int sockfd, FAR struct iob_s **iob, int flags);
+ssize_t net_sendiob(int sockfd, FAR struct iob_s **iob, int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_socketpair
  *
@@ -163,6 +163,13 @@
 #    define NETDEV_RXARP(dev)
 #  endif
 #  define NETDEV_RXDROPPED(dev)   _NETDEV_STATISTIC(dev,rx_dropped)
+#  ifdef CONFIG_NETDEV_GRO
+#    define NETDEV_RXGRO(dev)       _NETDEV_STATISTIC(dev,rx_gro)
+#    define NETDEV_RXGROMERGED(dev) _NETDEV_STATISTIC(dev,rx_gro_merged)
+#  else
+#    define NETDEV_RXGRO(dev)
+#    define NETDEV_RXGROMERGED(dev)
+#  endif
 
 #  define NETDEV_TXPACKETS(dev) \
     do { \
@@ -184,6 +191,8 @@
 #  define NETDEV_RXIPV6(dev)
 #  define NETDEV_RXARP(dev)
 #  define NETDEV_RXDROPPED(dev)
+#  define NETDEV_RXGRO(dev)
+#  define NETDEV_RXGROMERGED(dev)
 
 #  define NETDEV_TXPACKETS(dev)
 #  define NETDEV_TXDONE(dev)
@@ -217,6 +226,44 @@
      (netdev_ipv6_lookup(dev, addr, true) != NULL)
 #endif
 
+/* Checksum and segmentation offload.
+ *
+ * NETDEV_FEATURE_* are the offloads that a device takes over from the
+ * stack, they are advertised in d_features:
+ *
+ *   TXCSUM - Completes the TCP/UDP checksum of outgoing packets
+ *   RXCSUM - Verifies the TCP/UDP checksum of incoming packets
+ *   SG     - Transmits packets held in IOB chains without copying them
+ *   TSO    - Cuts outgoing TCP super-segments into MSS-sized segments
+ *
+ * NETDEV_OFFLOAD_* describe the packet in d_iob (d_offload):
+ *
+ *   CSUM   - Outgoing: the TCP/UDP checksum field only holds the sum of
+ *            the pseudo-header, the rest is left to the device.
+ *   TSO    - Outgoing: a TCP super-segment to be cut into segments of
+ *            d_gsosize bytes of payload.  Always set with CSUM.
+ *   CSUMOK - Incoming: the device has verified the TCP/UDP checksum, or
+ *            it is only partial because the packet never left the host.
+ */
+
+#define NETDEV_FEATURE_TXCSUM  (1 << 0)
+#define NETDEV_FEATURE_RXCSUM  (1 << 1)
+#define NETDEV_FEATURE_SG      (1 << 2)
+#define NETDEV_FEATURE_TSO     (1 << 3)
+
+#define NETDEV_OFFLOAD_CSUM    (1 << 0)
+#define NETDEV_OFFLOAD_TSO     (1 << 1)
+#define NETDEV_OFFLOAD_CSUMOK  (1 << 2)
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETDEV_HAS_FEATURE(dev,f) (((dev)->d_features & (f)) != 0)
+#  define NETDEV_CSUM_VERIFIED(dev) \
+     (((dev)->d_offload & (NETDEV_OFFLOAD_CSUM | NETDEV_OFFLOAD_CSUMOK)) != 0)
+#else
+#  define NETDEV_HAS_FEATURE(dev,f) false
+#  define NETDEV_CSUM_VERIFIED(dev) false
+#endif
+
 /* MDIO Manageable Device (MMD) support with SIOCxMIIREG ioctl commands */
 
 #define mdio_phy_id_is_c45(phy_id) \
@@ -255,6 +302,10 @@ struct netdev_statistics_s
   uint32_t rx_arp;         /* Number of Rx ARP packets received */
 #endif
   uint32_t rx_dropped;     /* Unsupported Rx packets received */
+#ifdef CONFIG_NETDEV_GRO
+  uint32_t rx_gro;         /* Number of merged packets passed to the stack */
+  uint32_t rx_gro_merged;  /* Number of Rx packets merged into another */
+#endif
   uint64_t rx_bytes;       /* Number of bytes received */
 
   /* Tx Status */
@@ -486,6 +537,17 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Offloads taken over by the device (NETDEV_FEATURE_*), and the offload
+   * state of the packet in d_iob (NETDEV_OFFLOAD_*).  d_gsosize is the TCP
+   * payload of each segment of an outgoing super-segment.
+   */
+
+  uint8_t d_features;
+  uint8_t d_offload;
+  uint16_t d_gsosize;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -495,6 +557,21 @@ struct net_driver_s
   struct mld_netdev_s d_mld;    /* MLD state information */
 #endif
 
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+  /* TCP connections bound to this device that have something to send.
+   * Only these are visited when the device polls for TX data.
+   */
+
+  dq_queue_t d_tcppending;
+#endif
+
+  /* Device lock, see netdev_lock().  It serializes the users of the packet
+   * buffer (d_buf, d_iob, d_len, d_sndlen) and of the TX path of the
+   * driver.
+   */
+
+  rmutex_t d_lock;
+
 #ifdef CONFIG_NETDEV_STATISTICS
   /* If CONFIG_NETDEV_STATISTICS is enabled and if the driver supports
    * statistics, then this structure holds the counts of network driver
@@ -553,6 +630,11 @@ struct net_driver_s
   CODE int (*d_ioctl)(FAR struct net_driver_s *dev, int cmd,
                       unsigned long arg);
 #endif
+#ifdef CONFIG_NET_BUSY_POLL
+  /* Optional, receive what is pending in the queues of the device */
+
+  CODE void (*d_busypoll)(FAR struct net_driver_s *dev);
+#endif
 
   /* Drivers may attached device-specific, private information */
 
@@ -560,6 +642,23 @@ struct net_driver_s
 };
 
 typedef CODE int (*devif_poll_callback_t)(FAR struct net_driver_s *dev);
+
+/* The offload request of an outgoing packet, see netdev_offload_parse().
+ * All offsets are from the start of the link layer header.
+ */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+struct netdev_offload_s
+{
+  uint8_t  flags;      /* NETDEV_OFFLOAD_CSUM and/or NETDEV_OFFLOAD_TSO */
+  uint8_t  proto;      /* IP_PROTO_TCP or IP_PROTO_UDP */
+  bool     ipv6;       /* IPv6 rather than IPv4 packet */
+  uint16_t csumstart;  /* Start of the TCP/UDP header, checksummed from */
+  uint16_t csumoffset; /* Offset of the checksum field from csumstart */
+  uint16_t hdrlen;     /* Length of all headers, up to the payload */
+  uint16_t gsosize;    /* TSO: TCP payload of each segment */
+};
+#endif
 typedef CODE int (*devif_ipv6_callback_t)(FAR struct net_driver_s *dev,
                                           FAR struct netdev_ifaddr6_s *addr,
                                           FAR void *arg);
@@ -787,6 +886,21 @@ void neighbor_out(FAR struct net_driver_s *dev);
 int netdev_ifup(FAR struct net_driver_s *dev);
 int netdev_ifdown(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lock / netdev_unlock
+ *
+ * Description:
+ *   Take or release the lock of a network device.  The device lock is taken
+ *   after net_lock() and before any connection lock, see conn_lock().
+ *   ipv4_input(), ipv6_input() and devif_poll() take it themselves.  A
+ *   driver may take it without net_lock() to reach its packet buffer and
+ *   TX queue, as long as it takes no other network lock meanwhile.
+ *
+ ****************************************************************************/
+
+void netdev_lock(FAR struct net_driver_s *dev);
+void netdev_unlock(FAR struct net_driver_s *dev);
+
 /****************************************************************************
  * Carrier detection
  *
@@ -822,6 +936,28 @@ void netdev_carrier_off(FAR struct net_driver_s *dev);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy a buffer and calculate its raw change sum in the same pass.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.
+ *   dst  - Destination of the copy.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data.
+ *   odd  - The odd byte state carried over from a previous call, false
+ *          on the first call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dst,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd);
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -1214,6 +1350,48 @@ void netdev_iob_release(FAR struct net_driver_s *dev);
 FAR struct iob_s *netdev_iob_clone(FAR struct net_driver_s *dev,
                                    bool throttled);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+/****************************************************************************
+ * Name: netdev_offload_parse
+ *
+ * Description:
+ *   Locate the headers of an outgoing packet marked for offload in
+ *   dev->d_offload.  The IP and TCP/UDP headers must be in the first IOB.
+ *
+ * Input Parameters:
+ *   dev  - The network device the packet is sent on
+ *   iob  - The packet, starting with the IP header
+ *   info - Returns the offload request, info->flags is 0 for none
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the packet is marked for offload but it is
+ *   not a TCP/UDP packet that can be offloaded.
+ *
+ ****************************************************************************/
+
+int netdev_offload_parse(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                         FAR struct netdev_offload_s *info);
+
+/****************************************************************************
+ * Name: netdev_offload_chksum
+ *
+ * Description:
+ *   Complete the TCP/UDP checksum of a packet marked for checksum offload,
+ *   in software.  On entry the checksum field holds the sum of the
+ *   pseudo-header.
+ *
+ * Input Parameters:
+ *   dev  - The network device the packet is sent on
+ *   iob  - The packet, starting with the IP header
+ *   info - The offload request returned by netdev_offload_parse()
+ *
+ ****************************************************************************/
+
+void netdev_offload_chksum(FAR struct net_driver_s *dev,
+                           FAR struct iob_s *iob,
+                           FAR const struct netdev_offload_s *info);
+#endif
+
 /****************************************************************************
  * Name: netdev_ipv6_add/del
  *
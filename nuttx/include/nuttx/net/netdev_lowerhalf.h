@@ -119,6 +119,24 @@ struct netdev_lowerhalf_s
 
   atomic_t quota[NETPKT_TYPENUM];
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Offloads supported by the driver (NETDEV_FEATURE_*), set before
+   * netdev_lower_register().  NETDEV_FEATURE_TSO is only taken into
+   * account together with NETDEV_FEATURE_TXCSUM and NETDEV_FEATURE_SG.
+   */
+
+  uint8_t features;
+#endif
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* Number of RX/TX queue pairs, set before netdev_lower_register().
+   * 0 or 1 for a single queue, which only needs receive and transmit.
+   * Otherwise receiveq and transmitq are required.
+   */
+
+  uint8_t nqueues;
+#endif
+
   /* The structure used by net stack.
    * Note: Do not change its fields unless you know what you are doing.
    *
@@ -172,6 +190,42 @@ struct netdev_ops_s
   /* reclaim - try to reclaim packets sent by netdev. */
 
   CODE void (*reclaim)(FAR struct netdev_lowerhalf_s *dev);
+
+  /* commit - Optional, called after a burst of transmit calls.  Drivers
+   *          may leave the hardware doorbell (DMA poll demand, TX timeout
+   *          timer, ...) out of transmit and do it here once per burst.
+   *          The netpkt passed to transmit may be a chain of IOBs, which
+   *          can be handed to scatter-gather DMA with netpkt_to_iov().
+   */
+
+  CODE void (*commit)(FAR struct netdev_lowerhalf_s *dev);
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* transmitq/receiveq - Same as transmit/receive, on the queue 'queue'
+   *   of a device with several queues.  The calls for different queues
+   *   may run on different CPUs, but they are serialized by the network
+   *   lock.  Notify the upper half with netdev_lower_rxready_queue() and
+   *   netdev_lower_txdone_queue().
+   */
+
+  CODE int (*transmitq)(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt, int queue);
+  CODE FAR netpkt_t *(*receiveq)(FAR struct netdev_lowerhalf_s *dev,
+                                 int queue);
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+  /* rxint - Optional, enable or disable the RX interrupt of a queue (0
+   *   without multiple queues).  The upper half disables it when the
+   *   driver calls netdev_lower_rxready() and enables it again once
+   *   receive returns NULL, so the driver may call rxready from the RX
+   *   interrupt unconditionally.  Called with the interrupts disabled,
+   *   possibly from the interrupt handler, so it must not block.
+   */
+
+  CODE void (*rxint)(FAR struct netdev_lowerhalf_s *dev, int queue,
+                     bool enable);
+#endif
 };
 
 /* This structure is a set of wireless handlers, leave unsupported operations
@@ -308,6 +362,60 @@ void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev);
 
 void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer about an RX packet is ready to read on
+ *   a queue.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue with the packet
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue);
+
+/****************************************************************************
+ * Name: netdev_lower_txdone_queue
+ *
+ * Description:
+ *   Notifies the networking layer about a TX packet is sent on a queue.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue of the packet
+ *
+ ****************************************************************************/
+
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               int queue);
+
+/****************************************************************************
+ * Name: netdev_lower_queue_setcpu
+ *
+ * Description:
+ *   Bind the work thread of a queue to a CPU, typically the CPU that takes
+ *   the interrupt of the queue.  By default, the thread of queue N runs on
+ *   CPU (N % CONFIG_SMP_NCPUS).
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The queue
+ *   cpu   - The CPU, or -1 to let the thread run on any CPU
+ *
+ * Returned Value:
+ *   0:Success; negated errno on failure.
+ *
+ ****************************************************************************/
+
+int netdev_lower_queue_setcpu(FAR struct netdev_lowerhalf_s *dev,
+                              int queue, int cpu);
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_quota_load
  *
@@ -509,6 +617,57 @@ bool netpkt_is_fragmented(FAR netpkt_t *pkt);
 int netpkt_to_iov(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
                   FAR struct iovec *iov, int iovcnt);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+/****************************************************************************
+ * Name: netpkt_getoffload
+ *
+ * Description:
+ *   Get the offloads requested for a packet, only valid in the transmit
+ *   callback.  Offloads are only requested if advertised in dev->features.
+ *   The offsets in info are from the start of the packet data.
+ *
+ *   NETDEV_OFFLOAD_CSUM: The 16-bit checksum field at csumstart +
+ *     csumoffset holds the sum of the pseudo-header.  The device shall
+ *     replace it with the one's complement of the sum of all data from
+ *     csumstart to the end of the packet.
+ *   NETDEV_OFFLOAD_TSO: The packet is a TCP super-segment, the device
+ *     shall send the payload after hdrlen in segments of gsosize bytes,
+ *     each with a copy of the headers with the lengths, the IPv4 ID, the
+ *     TCP sequence number and the checksums updated.
+ *
+ * Input Parameters:
+ *   dev  - The lower half device driver structure
+ *   pkt  - The net packet
+ *   info - Returns the offloads, info->flags is 0 for none
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the headers of a packet marked for offload
+ *   cannot be parsed.
+ *
+ ****************************************************************************/
+
+int netpkt_getoffload(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                      FAR struct netdev_offload_s *info);
+
+/****************************************************************************
+ * Name: netpkt_setoffload
+ *
+ * Description:
+ *   Tell the stack that the device has verified the TCP/UDP checksum of a
+ *   received packet (NETDEV_OFFLOAD_CSUMOK), only valid in the receive
+ *   callback.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   pkt   - The net packet
+ *   flags - NETDEV_OFFLOAD_CSUMOK
+ *
+ ****************************************************************************/
+
+void netpkt_setoffload(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                       uint8_t flags);
+#endif
+
 /****************************************************************************
  * Name: netpkt_tryadd_queue
  *
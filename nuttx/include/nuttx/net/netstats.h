@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 
 #include <nuttx/net/netconfig.h>
@@ -80,6 +81,20 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LOCK_STATISTICS
+/* Contention statistics of the global network lock.  All fields are
+ * updated while the lock is held.  Times are in perf_gettime() units.
+ */
+
+struct net_lock_stats_s
+{
+  uint32_t acquired;            /* Number of times net_lock() succeeded */
+  uint32_t contended;           /* Number of times net_lock() had to wait */
+  clock_t  waittime;            /* Accumulated time spent waiting */
+  clock_t  maxwait;             /* Longest single wait */
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -121,6 +136,10 @@ struct net_stats_s
 #ifdef CONFIG_NET_CAN
   struct can_stats_s  can;      /* CAN statistics */
 #endif
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+  struct net_lock_stats_s lock; /* Network lock statistics */
+#endif
 };
 
 /****************************************************************************
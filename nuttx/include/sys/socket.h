@@ -136,6 +136,7 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_WAITFORONE   0x010000 /* Wait for at least one message.  */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
@@ -220,6 +221,16 @@
 #define SO_PEERCRED     18 /* Return the credentials of the peer process
                             * connected to this socket.
                             */
+#define SO_REUSEPORT    19 /* Allow several sockets to bind to the same port
+                            * and share its incoming datagrams (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
+#define SO_BUSY_POLL    20 /* Poll the network device for up to this many
+                            * microseconds before a receive blocks
+                            * (get/set).
+                            * arg: pointer to integer containing the time
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -372,6 +383,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* For recvmmsg() and sendmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message header */
+  unsigned int msg_len;         /* Number of bytes transmitted */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -426,6 +445,8 @@ extern "C"
 #define EXTERN extern
 #endif
 
+struct timespec;
+
 int socket(int domain, int type, int protocol);
 int socketpair(int domain, int type, int protocol, int sv[2]);
 int bind(int sockfd, FAR const struct sockaddr *addr, socklen_t addrlen);
@@ -459,6 +480,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
@@ -51,6 +51,13 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Per-CPU free I/O buffer caches, refilled and flushed in batches */
+
+#if defined(CONFIG_IOB_PERCPU_CACHE) && CONFIG_IOB_PERCPU_CACHE > 0
+#  define IOB_PERCPU_CACHE  CONFIG_IOB_PERCPU_CACHE
+#  define IOB_PERCPU_BATCH  ((CONFIG_IOB_PERCPU_CACHE + 1) / 2)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -161,5 +168,64 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 void iob_notifier_signal(void);
 #endif
 
+#ifdef IOB_PERCPU_CACHE
+/****************************************************************************
+ * Name: iob_percpu_alloc
+ *
+ * Description:
+ *   Try to allocate an I/O buffer from the cache of the current CPU,
+ *   refilling the cache from the global pool in a batch if it is empty.
+ *
+ * Returned Value:
+ *   The I/O buffer in a known state, or NULL if the allocation has to go
+ *   through the global pool (no eligible IOBs left, or tasks waiting).
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_percpu_alloc(bool throttled);
+
+/****************************************************************************
+ * Name: iob_percpu_free
+ *
+ * Description:
+ *   Try to return an I/O buffer to the cache of the current CPU, flushing
+ *   a batch of the cache to the global pool if it is full.
+ *
+ * Returned Value:
+ *   True if the IOB was taken, false if there are tasks waiting for IOBs
+ *   and the IOB must be freed to the global pool.
+ *
+ ****************************************************************************/
+
+bool iob_percpu_free(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_percpu_navail
+ *
+ * Description:
+ *   Return the number of free IOBs held in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+int iob_percpu_navail(void);
+
+/****************************************************************************
+ * Name: iob_lock_all / iob_unlock_all
+ *
+ * Description:
+ *   Take the lock of every per-CPU cache and the global IOB lock, with
+ *   interrupts disabled, and move all cached IOBs back to the global free
+ *   list.  While held, g_iob_count is the exact number of free IOBs and no
+ *   IOB can enter a cache, so it is safe to register as a waiter.
+ *
+ ****************************************************************************/
+
+irqstate_t iob_lock_all(void);
+void iob_unlock_all(irqstate_t flags);
+#else
+#  define iob_lock_all()         spin_lock_irqsave(&g_iob_lock)
+#  define iob_unlock_all(flags)  spin_unlock_irqrestore(&g_iob_lock, flags)
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
@@ -167,13 +167,21 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
   sem = &g_iob_sem;
 #endif
 
+#ifdef IOB_PERCPU_CACHE
+  iob = iob_percpu_alloc(throttled);
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
   /* The following must be atomic; interrupt must be disabled so that there
    * is no conflict with interrupt level I/O buffer allocations.  This is
    * not as bad as it sounds because interrupts will be re-enabled while
    * we are waiting for I/O buffers to become free.
    */
 
-  flags = spin_lock_irqsave(&g_iob_lock);
+  flags = iob_lock_all();
 
   /* Try to get an I/O buffer */
 
@@ -191,7 +199,7 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
           g_iob_count--;
         }
 
-      spin_unlock_irqrestore(&g_iob_lock, flags);
+      iob_unlock_all(flags);
 
       if (timeout == UINT_MAX)
         {
@@ -217,7 +225,7 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
       return iob;
     }
 
-  spin_unlock_irqrestore(&g_iob_lock, flags);
+  iob_unlock_all(flags);
   return iob;
 }
 
@@ -300,13 +308,21 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   FAR struct iob_s *iob;
   irqstate_t flags;
 
+#ifdef IOB_PERCPU_CACHE
+  iob = iob_percpu_alloc(throttled);
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
   /* We don't know what context we are called from so we use extreme measures
    * to protect the free list:  We disable interrupts very briefly.
    */
 
-  flags = spin_lock_irqsave(&g_iob_lock);
+  flags = iob_lock_all();
   iob = iob_tryalloc_internal(throttled);
-  spin_unlock_irqrestore(&g_iob_lock, flags);
+  iob_unlock_all(flags);
   return iob;
 }
 
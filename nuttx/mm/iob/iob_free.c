@@ -126,6 +126,17 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
     }
 #endif
 
+#ifdef IOB_PERCPU_CACHE
+  /* Keep the I/O buffer in the cache of this CPU unless someone is waiting
+   * for it.
+   */
+
+  if (iob_percpu_free(iob))
+    {
+      goto out;
+    }
+#endif
+
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
@@ -169,6 +180,9 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 
   DEBUGASSERT(g_iob_count <= CONFIG_IOB_NBUFFERS);
 
+#ifdef IOB_PERCPU_CACHE
+out:
+#endif
 #ifdef CONFIG_IOB_NOTIFIER
   /* Check if the IOB was claimed by a thread that is blocked waiting
    * for an IOB.
@@ -0,0 +1,366 @@
+/****************************************************************************
+ * mm/iob/iob_percpu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef IOB_PERCPU_CACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The free I/O buffer cache of one CPU.  The lock is only ever contended
+ * by iob_lock_all(), the owning CPU accesses the cache with interrupts
+ * disabled so that it cannot migrate in between.
+ *
+ * Lock ordering: the per-CPU locks in ascending CPU order, then g_iob_lock.
+ */
+
+struct iob_percpu_s
+{
+  spinlock_t        lock;
+  int16_t           count;     /* Number of IOBs in the cache */
+  FAR struct iob_s *head;      /* Cached IOBs, linked through io_flink */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_percpu_s g_iob_percpu[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_percpu_waiters
+ *
+ * Description:
+ *   Return true if there are tasks waiting for an IOB.  Waiters register
+ *   under iob_lock_all(), so the answer is stable while any per-CPU lock is
+ *   held and no IOB may be cached while it is true.
+ *
+ ****************************************************************************/
+
+static inline_function bool iob_percpu_waiters(void)
+{
+#if CONFIG_IOB_THROTTLE > 0
+  return g_iob_count < 0 || g_throttle_wait > 0;
+#else
+  return g_iob_count < 0;
+#endif
+}
+
+/****************************************************************************
+ * Name: iob_percpu_refill
+ *
+ * Description:
+ *   Move a batch of IOBs from the global free list to the empty cache.
+ *   The IOBs reserved by the throttle never leave the global pool, except
+ *   for a single IOB taken by a non-throttled allocation.
+ *
+ * Assumptions:
+ *   Called with the lock of the cache held.
+ *
+ ****************************************************************************/
+
+static void iob_percpu_refill(FAR struct iob_percpu_s *pcpu, bool throttled)
+{
+  FAR struct iob_s *iob;
+  int16_t navail;
+
+  spin_lock(&g_iob_lock);
+
+#if CONFIG_IOB_THROTTLE > 0
+  navail = g_iob_count - CONFIG_IOB_THROTTLE;
+  if (navail <= 0 && !throttled && g_iob_count > 0)
+    {
+      navail = 1;
+    }
+#else
+  navail = g_iob_count;
+#endif
+
+  if (navail > IOB_PERCPU_BATCH)
+    {
+      navail = IOB_PERCPU_BATCH;
+    }
+
+  while (navail-- > 0 && (iob = g_iob_freelist) != NULL)
+    {
+      g_iob_freelist = iob->io_flink;
+      g_iob_count--;
+
+      iob->io_flink = pcpu->head;
+      pcpu->head    = iob;
+      pcpu->count++;
+    }
+
+  spin_unlock(&g_iob_lock);
+}
+
+/****************************************************************************
+ * Name: iob_percpu_flush
+ *
+ * Description:
+ *   Move a batch of IOBs from the full cache to the global free list.
+ *
+ * Assumptions:
+ *   Called with the lock of the cache held and no waiters, so the IOBs
+ *   need not be committed to anyone.
+ *
+ ****************************************************************************/
+
+static void iob_percpu_flush(FAR struct iob_percpu_s *pcpu)
+{
+  FAR struct iob_s *head = pcpu->head;
+  FAR struct iob_s *tail = head;
+  int16_t n;
+
+  for (n = 1; n < IOB_PERCPU_BATCH; n++)
+    {
+      tail = tail->io_flink;
+    }
+
+  pcpu->head   = tail->io_flink;
+  pcpu->count -= IOB_PERCPU_BATCH;
+
+  spin_lock(&g_iob_lock);
+  tail->io_flink = g_iob_freelist;
+  g_iob_freelist = head;
+  g_iob_count   += IOB_PERCPU_BATCH;
+  spin_unlock(&g_iob_lock);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_percpu_alloc
+ *
+ * Description:
+ *   Try to allocate an I/O buffer from the cache of the current CPU,
+ *   refilling the cache from the global pool in a batch if it is empty.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_percpu_alloc(bool throttled)
+{
+  FAR struct iob_percpu_s *pcpu;
+  FAR struct iob_s *iob = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  pcpu  = &g_iob_percpu[this_cpu()];
+  spin_lock(&pcpu->lock);
+
+  /* Leave the allocation to the global pool if anyone is waiting, so the
+   * waiters are served first.
+   */
+
+  if (iob_percpu_waiters())
+    {
+      goto out;
+    }
+
+  if (pcpu->head == NULL)
+    {
+      iob_percpu_refill(pcpu, throttled);
+    }
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* The global count plus this cache never exceed the number of free IOBs,
+   * so this check never grants an IOB of the throttle reserve.  If it is
+   * too pessimistic the global pool drains all caches and decides.
+   */
+
+  if (throttled && g_iob_count + pcpu->count <= CONFIG_IOB_THROTTLE)
+    {
+      goto out;
+    }
+#endif
+
+  iob = pcpu->head;
+  if (iob != NULL)
+    {
+      pcpu->head = iob->io_flink;
+      pcpu->count--;
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+out:
+  spin_unlock(&pcpu->lock);
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_free
+ *
+ * Description:
+ *   Try to return an I/O buffer to the cache of the current CPU, flushing
+ *   a batch of the cache to the global pool if it is full.
+ *
+ ****************************************************************************/
+
+bool iob_percpu_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_percpu_s *pcpu;
+  irqstate_t flags;
+  bool ret = false;
+
+  flags = up_irq_save();
+  pcpu  = &g_iob_percpu[this_cpu()];
+  spin_lock(&pcpu->lock);
+
+  if (!iob_percpu_waiters())
+    {
+      iob->io_flink = pcpu->head;
+      pcpu->head    = iob;
+      pcpu->count++;
+
+      if (pcpu->count >= IOB_PERCPU_CACHE)
+        {
+          iob_percpu_flush(pcpu);
+        }
+
+      ret = true;
+    }
+
+  spin_unlock(&pcpu->lock);
+  up_irq_restore(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_navail
+ *
+ * Description:
+ *   Return the number of free IOBs held in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+int iob_percpu_navail(void)
+{
+  int navail = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      navail += g_iob_percpu[cpu].count;
+    }
+
+  return navail;
+}
+
+/****************************************************************************
+ * Name: iob_lock_all
+ *
+ * Description:
+ *   Take the lock of every per-CPU cache and the global IOB lock, with
+ *   interrupts disabled, and move all cached IOBs back to the global free
+ *   list.
+ *
+ ****************************************************************************/
+
+irqstate_t iob_lock_all(void)
+{
+  FAR struct iob_percpu_s *pcpu;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int cpu;
+
+  flags = up_irq_save();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      spin_lock(&g_iob_percpu[cpu].lock);
+    }
+
+  spin_lock(&g_iob_lock);
+
+  /* The caches are always empty while there are waiters, so the IOBs go
+   * to the free list rather than to the committed list.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      pcpu = &g_iob_percpu[cpu];
+      while ((iob = pcpu->head) != NULL)
+        {
+          pcpu->head     = iob->io_flink;
+          iob->io_flink  = g_iob_freelist;
+          g_iob_freelist = iob;
+          g_iob_count++;
+        }
+
+      pcpu->count = 0;
+    }
+
+  DEBUGASSERT(g_iob_count <= CONFIG_IOB_NBUFFERS);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: iob_unlock_all
+ *
+ * Description:
+ *   Release the locks taken by iob_lock_all().
+ *
+ ****************************************************************************/
+
+void iob_unlock_all(irqstate_t flags)
+{
+  int cpu;
+
+  spin_unlock(&g_iob_lock);
+
+  for (cpu = CONFIG_SMP_NCPUS - 1; cpu >= 0; cpu--)
+    {
+      spin_unlock(&g_iob_percpu[cpu].lock);
+    }
+
+  up_irq_restore(flags);
+}
+
+#endif /* IOB_PERCPU_CACHE */
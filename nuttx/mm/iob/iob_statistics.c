@@ -57,6 +57,10 @@ void iob_getstats(FAR struct iob_stats_s *stats)
   stats->ntotal = CONFIG_IOB_NBUFFERS;
 
   stats->nfree = g_iob_count;
+#ifdef IOB_PERCPU_CACHE
+  stats->nfree += iob_percpu_navail();
+#endif
+
   if (stats->nfree < 0)
     {
       stats->nwait = -stats->nfree;
@@ -68,7 +72,7 @@ void iob_getstats(FAR struct iob_stats_s *stats)
     }
 
 #if CONFIG_IOB_THROTTLE > 0
-  stats->nthrottle = (g_iob_count - CONFIG_IOB_THROTTLE);
+  stats->nthrottle = (stats->nfree - CONFIG_IOB_THROTTLE);
   if (stats->nthrottle < 0)
 #endif
     {
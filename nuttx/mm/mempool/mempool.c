@@ -28,6 +28,7 @@
 #include <execinfo.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/kmalloc.h>
@@ -42,6 +43,10 @@
 
 #define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+#  define MEMPOOL_CACHE_BATCH ((CONFIG_MM_MEMPOOL_PERCPU_CACHE + 1) / 2)
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0x55555555
 #define MEMPOOL_MAGIC_ALLOC 0xAAAAAAAA
@@ -100,6 +105,222 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+/****************************************************************************
+ * Name: mempool_cache_refill
+ *
+ * Description:
+ *   Move a batch of free blocks from the pool to an empty cache.
+ *
+ ****************************************************************************/
+
+static void mempool_cache_refill(FAR struct mempool_s *pool,
+                                 FAR struct mempool_cache_s *cache)
+{
+  FAR sq_entry_t *tail;
+  size_t count;
+
+  spin_lock(&pool->lock);
+  tail = pool->queue.head;
+  if (tail != NULL)
+    {
+      for (count = 1; count < MEMPOOL_CACHE_BATCH && tail->flink != NULL;
+           count++)
+        {
+          tail = tail->flink;
+        }
+
+      cache->head      = pool->queue.head;
+      cache->count     = count;
+      pool->queue.head = tail->flink;
+      if (pool->queue.head == NULL)
+        {
+          pool->queue.tail = NULL;
+        }
+
+      tail->flink = NULL;
+    }
+
+  spin_unlock(&pool->lock);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_flush
+ *
+ * Description:
+ *   Move a batch of free blocks from a full cache back to the pool.
+ *
+ ****************************************************************************/
+
+static void mempool_cache_flush(FAR struct mempool_s *pool,
+                                FAR struct mempool_cache_s *cache)
+{
+  FAR sq_entry_t *head = cache->head;
+  FAR sq_entry_t *tail = head;
+  size_t count;
+
+  for (count = 1; count < MEMPOOL_CACHE_BATCH; count++)
+    {
+      tail = tail->flink;
+    }
+
+  cache->head   = tail->flink;
+  cache->count -= MEMPOOL_CACHE_BATCH;
+  tail->flink   = NULL;
+
+  spin_lock(&pool->lock);
+  if (pool->queue.tail != NULL)
+    {
+      pool->queue.tail->flink = head;
+    }
+  else
+    {
+      pool->queue.head = head;
+    }
+
+  pool->queue.tail = tail;
+  spin_unlock(&pool->lock);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_allocate
+ *
+ * Description:
+ *   Take a free block from the cache of this CPU, refilling the cache from
+ *   the pool if it is empty.  Only this CPU touches its cache, with
+ *   interrupts disabled, so it needs no lock.
+ *
+ * Returned Value:
+ *   The block, or NULL if the pool has no free blocks at hand.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_cache_allocate(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->head == NULL)
+    {
+      mempool_cache_refill(pool, cache);
+    }
+
+  blk = cache->head;
+  if (blk != NULL)
+    {
+      cache->head = blk->flink;
+      cache->count--;
+      cache->nalloc++;
+      if (cache->head != NULL)
+        {
+          pool->check(pool, cache->head);
+        }
+
+      blk->flink = NULL;
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_cache_release
+ *
+ * Description:
+ *   Put a free block in the cache of this CPU, flushing a batch of the
+ *   cache to the pool if it is full.
+ *
+ ****************************************************************************/
+
+static void mempool_cache_release(FAR struct mempool_s *pool,
+                                  FAR sq_entry_t *blk)
+{
+  FAR struct mempool_cache_s *cache;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  blk->flink  = cache->head;
+  cache->head = blk;
+  cache->nalloc--;
+  if (++cache->count >= CONFIG_MM_MEMPOOL_PERCPU_CACHE)
+    {
+      mempool_cache_flush(pool, cache);
+    }
+
+  kasan_poison(blk, pool->blocksize);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_usable
+ *
+ * Description:
+ *   Pools that wait for free blocks do not cache them, a released block
+ *   must be seen by the waiters at once.
+ *
+ ****************************************************************************/
+
+static inline bool mempool_cache_usable(FAR struct mempool_s *pool)
+{
+  return !pool->wait || pool->expandsize != 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: mempool_nalloc
+ *
+ * Description:
+ *   Return the number of allocated blocks, including those allocated and
+ *   released through the per-CPU caches.
+ *
+ ****************************************************************************/
+
+static size_t mempool_nalloc(FAR struct mempool_s *pool)
+{
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  ssize_t nalloc = pool->nalloc;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      nalloc += pool->cache[cpu].nalloc;
+    }
+
+  return nalloc > 0 ? nalloc : 0;
+#else
+  return pool->nalloc;
+#endif
+}
+
+/****************************************************************************
+ * Name: mempool_ncached
+ *
+ * Description:
+ *   Return the number of free blocks held in the per-CPU caches.
+ *
+ ****************************************************************************/
+
+static size_t mempool_ncached(FAR struct mempool_s *pool)
+{
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->cache[cpu].count;
+    }
+
+  return count;
+#else
+  return 0;
+#endif
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -262,6 +483,10 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
+
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -347,6 +572,17 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  if (mempool_cache_usable(pool))
+    {
+      blk = mempool_cache_allocate(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = mempool_remove_queue(pool, &pool->queue);
@@ -401,6 +637,9 @@ retry:
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+out:
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -427,8 +666,8 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -440,12 +679,26 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 
 #endif
 
-  pool->nalloc--;
-
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   memset(blk, MM_FREE_MAGIC, pool->blocksize);
 #endif
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  /* Blocks of the interrupt pool go back to the interrupt queue */
+
+  if (mempool_cache_usable(pool) &&
+      (pool->interruptsize <= blocksize ||
+       (FAR char *)blk < pool->ibase ||
+       (FAR char *)blk >= pool->ibase + pool->interruptsize - blocksize))
+    {
+      mempool_cache_release(pool, blk);
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+  pool->nalloc--;
+
   if (pool->interruptsize > blocksize)
     {
       if ((FAR char *)blk >= pool->ibase &&
@@ -498,10 +751,14 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
+  /* The caches of the other CPUs change under us, so the counts of a busy
+   * pool are a snapshot that may be off by the blocks moving meanwhile.
+   */
+
   flags = spin_lock_irqsave(&pool->lock);
-  info->ordblks = sq_count(&pool->queue);
+  info->ordblks = sq_count(&pool->queue) + mempool_ncached(pool);
   info->iordblks = sq_count(&pool->iqueue);
-  info->aordblks = pool->nalloc;
+  info->aordblks = mempool_nalloc(pool);
   info->arena = sq_count(&pool->equeue) * MEMPOOL_HEADER_SIZE +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
@@ -539,7 +796,7 @@ mempool_info_task(FAR struct mempool_s *pool,
     {
       irqstate_t flags = spin_lock_irqsave(&pool->lock);
       size_t count = sq_count(&pool->queue) +
-                     sq_count(&pool->iqueue);
+                     sq_count(&pool->iqueue) + mempool_ncached(pool);
 
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
@@ -547,8 +804,10 @@ mempool_info_task(FAR struct mempool_s *pool,
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t nalloc = mempool_nalloc(pool);
+
+      info.aordblks += nalloc;
+      info.uordblks += nalloc * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -618,11 +877,17 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
-  if (pool->nalloc != 0)
+  if (mempool_nalloc(pool) != 0)
     {
       return -EBUSY;
     }
 
+#ifdef MEMPOOL_HAVE_PERCPU_CACHE
+  /* The cached blocks are freed with the memory they were carved from */
+
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
+
   if (pool->initialsize >= blocksize + MEMPOOL_HEADER_SIZE)
     {
       count = (pool->initialsize - MEMPOOL_HEADER_SIZE) / blocksize;
@@ -273,6 +273,9 @@ void arp_out(FAR struct net_driver_s *dev)
 
       arp_format(dev, ipaddr);
       arp_dump(ARPBUF);
+#ifdef CONFIG_NETDEV_OFFLOAD
+      dev->d_offload = 0;
+#endif
       return;
     }
 
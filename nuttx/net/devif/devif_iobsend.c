@@ -74,7 +74,12 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
     }
 
 #ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+  /* Larger packets are only sent as TCP super-segments, which the device
+   * cuts into segments that fit.
+   */
+
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset &&
+      !NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TSO))
     {
       ret = -EMSGSIZE;
       goto errout;
@@ -622,7 +622,9 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
  * Name: devif_poll_tcp_connections
  *
  * Description:
- *   Poll all TCP connections for available packets to send.
+ *   Poll all TCP connections for available packets to send, or only those
+ *   in the pending TX queue of the device if CONFIG_NET_TCP_POLL_PENDING
+ *   is selected.
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
@@ -634,6 +636,64 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
                                              devif_poll_callback_t callback)
 {
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+  int bstop = 0;
+  int npending;
+
+  /* Visit only the connections queued in the pending TX queue of the
+   * device.  A connection that sends data queues itself again at the tail,
+   * so only those queued before this poll are visited now.
+   */
+
+  npending = dq_count(&dev->d_tcppending);
+  while (!bstop && npending-- > 0 &&
+         (entry = dq_remfirst(&dev->d_tcppending)) != NULL)
+    {
+      conn = container_of(entry, struct tcp_conn_s, txnode);
+      conn->txdev = NULL;
+
+      /* The connection may have been bound to another device since it was
+       * queued.
+       */
+
+      if (dev != conn->dev)
+        {
+          tcp_txpending(conn);
+          continue;
+        }
+
+      /* Perform the TCP TX poll */
+
+      tcp_poll(dev, conn);
+
+      /* Without a packet buffer nothing could be done, so try again with
+       * the connection at the next poll.
+       */
+
+      if (dev->d_iob == NULL)
+        {
+          if (conn->txdev == NULL)
+            {
+              dq_addfirst(&conn->txnode, &dev->d_tcppending);
+              conn->txdev = dev;
+            }
+
+          break;
+        }
+
+      /* Perform any necessary conversions on outgoing packets */
+
+      devif_packet_conversion(dev, DEVIF_TCP);
+
+      /* Call back into the driver */
+
+      bstop = devif_poll_local_out(dev, callback);
+    }
+
+  return bstop;
+#else
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
 
@@ -660,6 +720,7 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
     }
 
   return bstop;
+#endif /* CONFIG_NET_TCP_POLL_PENDING */
 }
 #else
 #  define devif_poll_tcp_connections(dev, callback) (0)
@@ -1026,7 +1087,7 @@ static int devif_poll_callback(FAR struct net_driver_s *dev)
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
- *   locked.
+ *   locked.  The device lock is taken here.
  *
  ****************************************************************************/
 
@@ -1037,9 +1098,13 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   FAR uint8_t *buf;
   int bstop;
 
+  netdev_lock(dev);
+
   if (dev->d_buf == NULL)
     {
-      return devif_iob_poll(dev, callback);
+      bstop = devif_iob_poll(dev, callback);
+      netdev_unlock(dev);
+      return bstop;
     }
 
   buf = dev->d_buf;
@@ -1095,6 +1160,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 
   dev->d_buf = buf;
 
+  netdev_unlock(dev);
   return bstop;
 }
 
@@ -1190,10 +1256,20 @@ int devif_poll_out(FAR struct net_driver_s *dev,
         }
 #endif
 
-      return callback(dev);
+      bstop = callback(dev);
+    }
+  else
+    {
+      bstop = 0;
     }
 
-  return 0;
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The offload state only applies to the packet just sent */
+
+  dev->d_offload = 0;
+#endif
+
+  return bstop;
 }
 
 /****************************************************************************
@@ -503,6 +503,10 @@ int ipv4_input(FAR struct net_driver_s *dev)
   FAR uint8_t *buf;
   int ret;
 
+  /* Serialize with the other users of the packet buffer of the device */
+
+  netdev_lock(dev);
+
   /* Store reception timestamp if enabled and not provided by hardware. */
 
 #if defined(CONFIG_NET_TIMESTAMP) && !defined(CONFIG_ARCH_HAVE_NETDEV_TIMESTAMP)
@@ -519,11 +523,14 @@ int ipv4_input(FAR struct net_driver_s *dev)
       ret = ipv4_in(dev);
 
       dev->d_buf = buf;
-
-      return ret;
+    }
+  else
+    {
+      ret = netdev_input(dev, ipv4_in, true);
     }
 
-  return netdev_input(dev, ipv4_in, true);
+  netdev_unlock(dev);
+  return ret;
 }
 
 #endif /* CONFIG_NET_IPv4 */
@@ -675,6 +675,10 @@ int ipv6_input(FAR struct net_driver_s *dev)
   FAR uint8_t *buf;
   int ret;
 
+  /* Serialize with the other users of the packet buffer of the device */
+
+  netdev_lock(dev);
+
   /* Store reception timestamp if enabled and not provided by hardware. */
 
 #if defined(CONFIG_NET_TIMESTAMP) && !defined(CONFIG_ARCH_HAVE_NETDEV_TIMESTAMP)
@@ -691,10 +695,13 @@ int ipv6_input(FAR struct net_driver_s *dev)
       ret = ipv6_in(dev);
 
       dev->d_buf = buf;
-
-      return ret;
+    }
+  else
+    {
+      ret = netdev_input(dev, ipv6_in, true);
     }
 
-  return netdev_input(dev, ipv6_in, true);
+  netdev_unlock(dev);
+  return ret;
 }
 #endif /* CONFIG_NET_IPv6 */
@@ -114,6 +114,12 @@ static ssize_t    inet_sendfile(FAR struct socket *psock,
                                 FAR struct file *infile, FAR off_t *offset,
                                 size_t count);
 #endif
+#ifdef CONFIG_NET_ZEROCOPY
+static ssize_t    inet_recviob(FAR struct socket *psock,
+                               FAR struct iob_s **iob, int flags);
+static ssize_t    inet_sendiob(FAR struct socket *psock,
+                               FAR struct iob_s **iob, int flags);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -144,6 +150,10 @@ static const struct sock_intf_s g_inet_sockif =
 #ifdef CONFIG_NET_SENDFILE
   , inet_sendfile   /* si_sendfile */
 #endif
+#ifdef CONFIG_NET_ZEROCOPY
+  , inet_recviob    /* si_recviob */
+  , inet_sendiob    /* si_sendiob */
+#endif
 };
 
 /****************************************************************************
@@ -2240,6 +2250,68 @@ static ssize_t inet_sendfile(FAR struct socket *psock,
 }
 #endif
 
+/****************************************************************************
+ * Name: inet_recviob and inet_sendiob
+ *
+ * Description:
+ *   Zero-copy receive and send for the case of the AF_INET and AF_INET6
+ *   address families.  The read-ahead and write buffers of TCP and UDP are
+ *   IOB chains that can be handed over as they are.  A SOCK_DGRAM socket
+ *   exchanges one datagram per call.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iob      The I/O buffer chain (see psock_recviob()/psock_sendiob())
+ *   flags    Receive or send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes received or queued.  On
+ *   error, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+static ssize_t inet_recviob(FAR struct socket *psock,
+                            FAR struct iob_s **iob, int flags)
+{
+#ifdef NET_TCP_HAVE_STACK
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return psock_tcp_recviob(psock, iob, flags);
+    }
+#endif
+
+#ifdef NET_UDP_HAVE_STACK
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      return psock_udp_recviob(psock, iob, flags);
+    }
+#endif
+
+  return -EOPNOTSUPP;
+}
+
+static ssize_t inet_sendiob(FAR struct socket *psock,
+                            FAR struct iob_s **iob, int flags)
+{
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_WRITE_BUFFERS)
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return psock_tcp_sendiob(psock, iob, flags);
+    }
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_WRITE_BUFFERS)
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      return psock_udp_sendiob(psock, iob, flags);
+    }
+#endif
+
+  return -EOPNOTSUPP;
+}
+#endif
+
 /****************************************************************************
  * Name: inet_recvmsg
  *
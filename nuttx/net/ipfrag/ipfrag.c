@@ -1251,6 +1251,28 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
       return OK;
     }
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* TCP super-segments are cut into segments by the device, but the device
+   * cannot checksum a packet split into fragments.
+   */
+
+  if ((dev->d_offload & NETDEV_OFFLOAD_TSO) != 0)
+    {
+      return OK;
+    }
+  else if ((dev->d_offload & NETDEV_OFFLOAD_CSUM) != 0)
+    {
+      struct netdev_offload_s info;
+
+      if (netdev_offload_parse(dev, dev->d_iob, &info) == OK)
+        {
+          netdev_offload_chksum(dev, dev->d_iob, &info);
+        }
+
+      dev->d_offload = 0;
+    }
+#endif
+
 #ifdef CONFIG_NET_6LOWPAN
   if (dev->d_lltype == NET_LL_IEEE802154 ||
       dev->d_lltype == NET_LL_PKTRADIO)
@@ -58,6 +58,14 @@ typedef uint16_t lc_size_t;  /* 16-bit index */
 typedef uint8_t lc_size_t;   /*  8-bit index */
 #endif
 
+/* Connection-mode socket types */
+
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+#  define LOCAL_ISCONNMODE(t) ((t) == SOCK_STREAM || (t) == SOCK_SEQPACKET)
+#else
+#  define LOCAL_ISCONNMODE(t) ((t) == SOCK_STREAM)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -109,6 +117,7 @@ enum local_state_s
  */
 
 struct devif_callback_s;       /* Forward reference */
+struct local_ring_s;           /* Forward reference */
 
 struct local_conn_s
 {
@@ -143,6 +152,15 @@ struct local_conn_s
   mutex_t lc_sendlock;           /* Make sending multi-thread safe */
   mutex_t lc_polllock;           /* Lock for net poll */
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Rings of a connection using the ring buffer transport, the receive
+   * ring of one side is the send ring of the other.
+   */
+
+  FAR struct local_ring_s *lc_rxring;
+  FAR struct local_ring_s *lc_txring;
+#endif
+
 #ifdef CONFIG_NET_LOCAL_STREAM
   /* SOCK_STREAM fields common to both client and server */
 
@@ -747,6 +765,109 @@ int local_set_pollthreshold(FAR struct local_conn_s *conn,
 
 int local_set_nonblocking(FAR struct local_conn_s *conn);
 
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Connect two connections through a pair of rings.  The receive ring of
+ *   each side is sized by its lc_rcvsize.  SOCK_STREAM connections carry a
+ *   byte stream, other types carry records.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_connect(FAR struct local_conn_s *conn0,
+                       FAR struct local_conn_s *conn1);
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Shut down both directions of a connection and drop its references to
+ *   the rings.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_conn_s *conn);
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Disable further receive (SHUT_RD) and/or send (SHUT_WR) operations on
+ *   a connection using the ring buffer transport.
+ *
+ ****************************************************************************/
+
+void local_ring_shutdown(FAR struct local_conn_s *conn, int how);
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send data through the send ring of a connection.
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *iov, int iovcnt,
+                        int flags);
+
+/****************************************************************************
+ * Name: local_ring_recvmsg
+ *
+ * Description:
+ *   Receive data from the receive ring of a connection.  MSG_PEEK,
+ *   MSG_WAITALL, MSG_DONTWAIT and MSG_TRUNC are supported.
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream; a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recvmsg(FAR struct local_conn_s *conn,
+                           FAR struct msghdr *msg, int flags);
+
+/****************************************************************************
+ * Name: local_ring_poll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of a connection using the ring buffer
+ *   transport.
+ *
+ ****************************************************************************/
+
+int local_ring_poll(FAR struct local_conn_s *conn, FAR struct pollfd *fds,
+                    bool setup);
+
+/****************************************************************************
+ * Name: local_ring_ioctl
+ *
+ * Description:
+ *   Handle FIONREAD, FIONWRITE and FIONSPACE for a connection using the
+ *   ring buffer transport.  Returns -ENOTTY for any other command.
+ *
+ ****************************************************************************/
+
+int local_ring_ioctl(FAR struct local_conn_s *conn, int cmd,
+                     unsigned long arg);
+
+/****************************************************************************
+ * Name: local_ring_resize
+ *
+ * Description:
+ *   Change the size of a ring.  The ring can not shrink below the data it
+ *   holds.
+ *
+ ****************************************************************************/
+
+int local_ring_resize(FAR struct local_ring_s *ring, size_t size);
+#endif /* CONFIG_NET_LOCAL_RING */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
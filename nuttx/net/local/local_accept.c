@@ -112,12 +112,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
   /* Is the socket a stream? */
 
-  if (psock->s_domain != PF_LOCAL || psock->s_type != SOCK_STREAM)
+  if (psock->s_domain != PF_LOCAL || !LOCAL_ISCONNMODE(psock->s_type))
     {
       return -EOPNOTSUPP;
     }
 
-  if (server->lc_proto != SOCK_STREAM ||
+  if (server->lc_proto != psock->s_type ||
       server->lc_state != LOCAL_STATE_LISTENING)
     {
       return -EOPNOTSUPP;
@@ -145,7 +145,7 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
           /* Setup the accept socket structure */
 
           newsock->s_domain = psock->s_domain;
-          newsock->s_type   = SOCK_STREAM;
+          newsock->s_type   = psock->s_type;
           newsock->s_sockif = psock->s_sockif;
           newsock->s_conn   = (FAR void *)conn;
 
@@ -214,7 +214,7 @@ int local_alloc_accept(FAR struct local_conn_s *server,
       return -ENOMEM;
     }
 
-  conn->lc_proto  = SOCK_STREAM;
+  conn->lc_proto  = server->lc_proto;
   conn->lc_type   = LOCAL_TYPE_PATHNAME;
   conn->lc_state  = LOCAL_STATE_CONNECTED;
   conn->lc_peer   = client;
@@ -223,6 +223,20 @@ int local_alloc_accept(FAR struct local_conn_s *server,
   strlcpy(conn->lc_path, server->lc_path, sizeof(conn->lc_path));
   conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connect the two sides through a pair of rings.  The accepted side
+   * takes the receive buffer size of the server.
+   */
+
+  conn->lc_rcvsize = server->lc_rcvsize;
+  ret = local_ring_connect(conn, client);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to create rings for %s: %d\n",
+           client->lc_path, ret);
+      goto err;
+    }
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conn, server->lc_rcvsize, client->lc_rcvsize);
@@ -265,11 +279,15 @@ int local_alloc_accept(FAR struct local_conn_s *server,
   /* Do we have a connection?  Are the FIFOs opened? */
 
   DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+#endif /* CONFIG_NET_LOCAL_RING */
+
   *accept = conn;
   return OK;
 
+#ifndef CONFIG_NET_LOCAL_RING
 errout_with_fifos:
   local_release_fifos(conn);
+#endif
 
 err:
   local_free(conn);
@@ -306,6 +324,12 @@ void local_free(FAR struct local_conn_s *conn)
       conn->lc_peer = NULL;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Detach from the rings, the peer sees the end of the connection */
+
+  local_ring_release(conn);
+#endif
+
   /* Make sure that the read-only FIFO is closed */
 
   if (conn->lc_infile.f_inode != NULL)
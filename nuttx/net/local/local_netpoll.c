@@ -159,6 +159,13 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_rxring != NULL)
+    {
+      return local_ring_poll(conn, fds, true);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return -ENOSYS;
@@ -308,6 +315,13 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_rxring != NULL)
+    {
+      return local_ring_poll(conn, fds, false);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return -ENOSYS;
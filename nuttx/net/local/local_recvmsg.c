@@ -544,17 +544,41 @@ ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   FAR void *buf = msg->msg_iov->iov_base;
   size_t len = msg->msg_iov->iov_len;
 
-  if (msg->msg_iovlen != 1)
+#ifdef CONFIG_NET_LOCAL_RING
+  FAR struct local_conn_s *conn = psock->s_conn;
+#endif
+
+  if (msg->msg_iovlen != 1
+#ifdef CONFIG_NET_LOCAL_RING
+      && conn->lc_rxring == NULL
+#endif
+     )
     {
       return -ENOTSUP;
     }
 
   DEBUGASSERT(buf);
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Check for a connection on the ring buffer transport, of any socket
+   * type.  It takes any number of I/O vectors.
+   */
+
+  if (conn->lc_rxring != NULL)
+    {
+      len = local_ring_recvmsg(conn, msg, flags);
+      if ((ssize_t)len >= 0 && from != NULL)
+        {
+          local_getaddr(conn, from, fromlen);
+        }
+    }
+  else
+#endif
+
   /* Check for a stream socket */
 
 #ifdef CONFIG_NET_LOCAL_STREAM
-  if (psock->s_type == SOCK_STREAM)
+  if (LOCAL_ISCONNMODE(psock->s_type))
     {
       len = psock_stream_recvfrom(psock, buf, len, flags, from, fromlen);
     }
@@ -577,7 +601,7 @@ ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 #ifdef CONFIG_NET_LOCAL_SCM
   /* Receive the control message */
 
-  if (len >= 0 && msg->msg_control &&
+  if ((ssize_t)len >= 0 && msg->msg_control &&
       msg->msg_controllen > sizeof(struct cmsghdr))
     {
       local_recvctl(psock->s_conn, msg, flags);
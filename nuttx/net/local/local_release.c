@@ -75,7 +75,7 @@ int local_release(FAR struct local_conn_s *conn)
       FAR dq_entry_t *waiter;
       FAR dq_entry_t *tmp;
 
-      DEBUGASSERT(conn->lc_proto == SOCK_STREAM);
+      DEBUGASSERT(LOCAL_ISCONNMODE(conn->lc_proto));
 
       /* Are there still clients waiting for a connection to the server? */
 
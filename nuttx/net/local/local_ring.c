@@ -0,0 +1,1018 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+
+#include <nuttx/circbuf.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCAL_RING_RDSHUT  (1 << 0)  /* The reader shut down or closed */
+#define LOCAL_RING_WRSHUT  (1 << 1)  /* The writer shut down or closed */
+#define LOCAL_RING_RECORD  (1 << 2)  /* Each send is a record */
+
+#define LOCAL_RING_SHUT    (LOCAL_RING_RDSHUT | LOCAL_RING_WRSHUT)
+
+/* Records are preceded by their length */
+
+#define LOCAL_RING_HDRLEN  sizeof(lc_size_t)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One direction of a connection.  The ring is shared by the connection
+ * that sends through it (lc_txring) and the one that receives from it
+ * (lc_rxring), it is freed when both have let go of it.
+ */
+
+struct local_ring_s
+{
+  mutex_t lr_lock;               /* Protects the fields below */
+  sem_t lr_rxsem;                /* Posted when data was added */
+  sem_t lr_txsem;                /* Posted when space was freed */
+  struct circbuf_s lr_buf;       /* The data in the ring */
+  size_t lr_txneed;              /* Space the last short send waits for */
+  uint8_t lr_crefs;              /* Number of connections attached */
+  uint8_t lr_flags;              /* See LOCAL_RING_* definitions */
+  uint8_t lr_nrxwait;            /* Number of receivers waiting */
+  uint8_t lr_ntxwait;            /* Number of senders waiting */
+
+  /* Poll structures of the receiver waiting for POLLIN and of the sender
+   * waiting for POLLOUT.
+   */
+
+  FAR struct pollfd *lr_rxfds[LOCAL_NPOLLWAITERS];
+  FAR struct pollfd *lr_txfds[LOCAL_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_alloc
+ ****************************************************************************/
+
+static FAR struct local_ring_s *local_ring_alloc(size_t size, uint8_t flags)
+{
+  FAR struct local_ring_s *ring;
+
+  ring = kmm_zalloc(sizeof(struct local_ring_s));
+  if (ring == NULL)
+    {
+      return NULL;
+    }
+
+  if (circbuf_init(&ring->lr_buf, NULL, size) < 0)
+    {
+      kmm_free(ring);
+      return NULL;
+    }
+
+  nxmutex_init(&ring->lr_lock);
+  nxsem_init(&ring->lr_rxsem, 0, 0);
+  nxsem_init(&ring->lr_txsem, 0, 0);
+
+  ring->lr_crefs = 2;
+  ring->lr_flags = flags;
+  return ring;
+}
+
+/****************************************************************************
+ * Name: local_ring_free
+ ****************************************************************************/
+
+static void local_ring_free(FAR struct local_ring_s *ring)
+{
+  circbuf_uninit(&ring->lr_buf);
+  nxsem_destroy(&ring->lr_txsem);
+  nxsem_destroy(&ring->lr_rxsem);
+  nxmutex_destroy(&ring->lr_lock);
+  kmm_free(ring);
+}
+
+/****************************************************************************
+ * Name: local_ring_put
+ *
+ * Description:
+ *   Drop a reference to a ring, free it with the last one.
+ *
+ ****************************************************************************/
+
+static void local_ring_put(FAR struct local_ring_s *ring)
+{
+  bool last;
+
+  if (ring == NULL)
+    {
+      return;
+    }
+
+  nxmutex_lock(&ring->lr_lock);
+  DEBUGASSERT(ring->lr_crefs > 0);
+  last = --ring->lr_crefs == 0;
+  nxmutex_unlock(&ring->lr_lock);
+
+  if (last)
+    {
+      local_ring_free(ring);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_iovlen
+ ****************************************************************************/
+
+static size_t local_ring_iovlen(FAR const struct iovec *iov, int iovcnt)
+{
+  size_t len = 0;
+
+  while (iovcnt-- > 0)
+    {
+      len += iov++->iov_len;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: local_ring_copyin
+ *
+ * Description:
+ *   Append len bytes of the I/O vector, starting skip bytes into it, to
+ *   the ring.  The space must have been checked.
+ *
+ ****************************************************************************/
+
+static void local_ring_copyin(FAR struct local_ring_s *ring,
+                              FAR const struct iovec *iov, int iovcnt,
+                              size_t skip, size_t len)
+{
+  size_t n;
+
+  for (; len > 0 && iovcnt > 0; iov++, iovcnt--)
+    {
+      if (skip >= iov->iov_len)
+        {
+          skip -= iov->iov_len;
+          continue;
+        }
+
+      n = MIN(len, iov->iov_len - skip);
+      circbuf_write(&ring->lr_buf,
+                    (FAR const uint8_t *)iov->iov_base + skip, n);
+
+      len -= n;
+      skip = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_copyout
+ *
+ * Description:
+ *   Copy len bytes of the ring, starting offset bytes after the oldest
+ *   byte, to the I/O vector starting skip bytes into it.  The data stays in
+ *   the ring.
+ *
+ ****************************************************************************/
+
+static void local_ring_copyout(FAR struct local_ring_s *ring, size_t offset,
+                               FAR const struct iovec *iov, int iovcnt,
+                               size_t skip, size_t len)
+{
+  size_t pos = ring->lr_buf.tail + offset;
+  size_t n;
+
+  for (; len > 0 && iovcnt > 0; iov++, iovcnt--)
+    {
+      if (skip >= iov->iov_len)
+        {
+          skip -= iov->iov_len;
+          continue;
+        }
+
+      n = MIN(len, iov->iov_len - skip);
+      circbuf_peekat(&ring->lr_buf, pos,
+                     (FAR uint8_t *)iov->iov_base + skip, n);
+
+      pos += n;
+      len -= n;
+      skip = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_txthresh
+ *
+ * Description:
+ *   Return the free space at which the sender is woken and POLLOUT is
+ *   reported: what the last short send asked for, otherwise room for one
+ *   byte (or one byte record).
+ *
+ ****************************************************************************/
+
+static size_t local_ring_txthresh(FAR struct local_ring_s *ring)
+{
+  size_t thresh = 1;
+
+  if ((ring->lr_flags & LOCAL_RING_RECORD) != 0)
+    {
+      thresh += LOCAL_RING_HDRLEN;
+    }
+
+  return MAX(thresh, ring->lr_txneed);
+}
+
+/****************************************************************************
+ * Name: local_ring_rxevents and local_ring_txevents
+ *
+ * Description:
+ *   Return the poll events of the receiving and of the sending side.
+ *
+ ****************************************************************************/
+
+static pollevent_t local_ring_rxevents(FAR struct local_ring_s *ring)
+{
+  pollevent_t eventset = 0;
+
+  if (!circbuf_is_empty(&ring->lr_buf) ||
+      (ring->lr_flags & LOCAL_RING_SHUT) != 0)
+    {
+      eventset |= POLLIN;
+    }
+
+  if ((ring->lr_flags & LOCAL_RING_WRSHUT) != 0)
+    {
+      eventset |= POLLHUP;
+    }
+
+  return eventset;
+}
+
+static pollevent_t local_ring_txevents(FAR struct local_ring_s *ring)
+{
+  if ((ring->lr_flags & LOCAL_RING_RDSHUT) != 0)
+    {
+      return POLLERR;
+    }
+  else if ((ring->lr_flags & LOCAL_RING_WRSHUT) == 0 &&
+           circbuf_space(&ring->lr_buf) >= local_ring_txthresh(ring))
+    {
+      return POLLOUT;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: local_ring_wake
+ *
+ * Description:
+ *   Wake one waiter, unless nobody waits or an earlier wakeup is still
+ *   pending.  A woken receiver wakes the next one if data is left, so one
+ *   post per batch of data is enough.
+ *
+ ****************************************************************************/
+
+static void local_ring_wake(FAR sem_t *sem, uint8_t nwait)
+{
+  int semcount;
+
+  if (nwait > 0 && nxsem_get_value(sem, &semcount) >= 0 && semcount <= 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_wait
+ *
+ * Description:
+ *   Wait on the semaphore with the ring unlocked.  The caller re-checks
+ *   the ring on return, wakeups may be spurious.
+ *
+ ****************************************************************************/
+
+static int local_ring_wait(FAR struct local_ring_s *ring, FAR sem_t *sem,
+                           FAR uint8_t *nwait, unsigned int timeout)
+{
+  int ret;
+
+  (*nwait)++;
+  nxmutex_unlock(&ring->lr_lock);
+
+  if (timeout == UINT_MAX)
+    {
+      ret = nxsem_wait(sem);
+    }
+  else
+    {
+      ret = nxsem_tickwait(sem, MSEC2TICK(timeout));
+      if (ret == -ETIMEDOUT)
+        {
+          ret = -EAGAIN;
+        }
+    }
+
+  nxmutex_lock(&ring->lr_lock);
+  (*nwait)--;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_added
+ *
+ * Description:
+ *   Notify the receiver that data was added to a ring which held used
+ *   bytes before.  POLLIN is only reported when the ring stops being empty.
+ *
+ ****************************************************************************/
+
+static void local_ring_added(FAR struct local_ring_s *ring, size_t used)
+{
+  if (used == 0)
+    {
+      poll_notify(ring->lr_rxfds, LOCAL_NPOLLWAITERS, POLLIN);
+    }
+
+  local_ring_wake(&ring->lr_rxsem, ring->lr_nrxwait);
+}
+
+/****************************************************************************
+ * Name: local_ring_removed
+ *
+ * Description:
+ *   Notify the sender that data was removed from a ring which had space
+ *   bytes free before.  POLLOUT is only reported when the free space
+ *   reaches the threshold.
+ *
+ ****************************************************************************/
+
+static void local_ring_removed(FAR struct local_ring_s *ring, size_t space)
+{
+  size_t thresh = local_ring_txthresh(ring);
+
+  if (circbuf_space(&ring->lr_buf) >= thresh)
+    {
+      if (space < thresh)
+        {
+          poll_notify(ring->lr_txfds, LOCAL_NPOLLWAITERS, POLLOUT);
+        }
+
+      local_ring_wake(&ring->lr_txsem, ring->lr_ntxwait);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_close
+ *
+ * Description:
+ *   Mark one end of a ring closed and wake up everyone on the ring.
+ *
+ ****************************************************************************/
+
+static void local_ring_close(FAR struct local_ring_s *ring, uint8_t flag)
+{
+  pollevent_t eventset;
+  int i;
+
+  nxmutex_lock(&ring->lr_lock);
+
+  if ((ring->lr_flags & flag) == 0)
+    {
+      ring->lr_flags |= flag;
+
+      poll_notify(ring->lr_rxfds, LOCAL_NPOLLWAITERS,
+                  local_ring_rxevents(ring));
+
+      eventset = local_ring_txevents(ring);
+      if (eventset != 0)
+        {
+          poll_notify(ring->lr_txfds, LOCAL_NPOLLWAITERS, eventset);
+        }
+
+      /* Waiters do not pass the wakeup on once the ring is closed */
+
+      for (i = 0; i < ring->lr_nrxwait; i++)
+        {
+          nxsem_post(&ring->lr_rxsem);
+        }
+
+      for (i = 0; i < ring->lr_ntxwait; i++)
+        {
+          nxsem_post(&ring->lr_txsem);
+        }
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+}
+
+/****************************************************************************
+ * Name: local_ring_pollslot
+ *
+ * Description:
+ *   Add the poll structure to, or remove it from, a list of poll waiters of
+ *   a ring.
+ *
+ ****************************************************************************/
+
+static int local_ring_pollslot(FAR struct local_ring_s *ring,
+                               FAR struct pollfd **slots,
+                               FAR struct pollfd *fds, bool setup)
+{
+  int ret = setup ? -EBUSY : OK;
+  int i;
+
+  nxmutex_lock(&ring->lr_lock);
+
+  for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
+    {
+      if (setup && slots[i] == NULL)
+        {
+          slots[i] = fds;
+          ret = OK;
+          break;
+        }
+      else if (!setup && slots[i] == fds)
+        {
+          slots[i] = NULL;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Connect two connections through a pair of rings.  The receive ring of
+ *   each side is sized by its lc_rcvsize.  SOCK_STREAM connections carry a
+ *   byte stream, other types carry records.
+ *
+ * Assumptions:
+ *   Neither connection is connected yet.
+ *
+ ****************************************************************************/
+
+int local_ring_connect(FAR struct local_conn_s *conn0,
+                       FAR struct local_conn_s *conn1)
+{
+  FAR struct local_ring_s *ring0;
+  FAR struct local_ring_s *ring1;
+  uint8_t flags = 0;
+
+  DEBUGASSERT(conn0->lc_rxring == NULL && conn1->lc_rxring == NULL);
+
+  if (conn0->lc_proto != SOCK_STREAM)
+    {
+      flags |= LOCAL_RING_RECORD;
+    }
+
+  ring0 = local_ring_alloc(conn0->lc_rcvsize, flags);
+  if (ring0 == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ring1 = local_ring_alloc(conn1->lc_rcvsize, flags);
+  if (ring1 == NULL)
+    {
+      local_ring_free(ring0);
+      return -ENOMEM;
+    }
+
+  conn0->lc_rxring = ring0;
+  conn0->lc_txring = ring1;
+  conn1->lc_rxring = ring1;
+  conn1->lc_txring = ring0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Shut down both directions of a connection and drop its references to
+ *   the rings.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_conn_s *conn)
+{
+  local_ring_shutdown(conn, SHUT_RDWR);
+
+  local_ring_put(conn->lc_rxring);
+  local_ring_put(conn->lc_txring);
+
+  conn->lc_rxring = NULL;
+  conn->lc_txring = NULL;
+}
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Disable further receive (SHUT_RD) and/or send (SHUT_WR) operations on
+ *   a connection using the ring buffer transport.  The rings stay attached
+ *   until the connection is freed.
+ *
+ ****************************************************************************/
+
+void local_ring_shutdown(FAR struct local_conn_s *conn, int how)
+{
+  if ((how & SHUT_RD) != 0 && conn->lc_rxring != NULL)
+    {
+      local_ring_close(conn->lc_rxring, LOCAL_RING_RDSHUT);
+    }
+
+  if ((how & SHUT_WR) != 0 && conn->lc_txring != NULL)
+    {
+      local_ring_close(conn->lc_txring, LOCAL_RING_WRSHUT);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send data through the send ring of a connection.  A stream is sent
+ *   piecewise as space frees up; a record is sent whole or not at all, and
+ *   one that can never fit fails with EMSGSIZE.
+ *
+ * Input Parameters:
+ *   conn   - The sending connection
+ *   iov    - The data to send
+ *   iovcnt - The number of entries in iov
+ *   flags  - Send flags, only MSG_DONTWAIT is used
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds lc_sendlock.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *iov, int iovcnt,
+                        int flags)
+{
+  FAR struct local_ring_s *ring = conn->lc_txring;
+  unsigned int timeout = _SO_TIMEOUT(conn->lc_conn.s_sndtimeo);
+  bool record = false;
+  bool nonblock;
+  size_t total;
+  size_t sent = 0;
+  size_t space;
+  size_t used;
+  size_t need;
+  ssize_t ret;
+
+  DEBUGASSERT(ring != NULL);
+
+  nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+  total    = local_ring_iovlen(iov, iovcnt);
+
+  ret = nxmutex_lock(&ring->lr_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((ring->lr_flags & LOCAL_RING_RECORD) != 0)
+    {
+      if (total + LOCAL_RING_HDRLEN > circbuf_size(&ring->lr_buf))
+        {
+          ret = -EMSGSIZE;
+          goto out;
+        }
+
+      record = true;
+    }
+
+  for (; ; )
+    {
+      if ((ring->lr_flags & LOCAL_RING_SHUT) != 0)
+        {
+          ret = sent > 0 ? sent : -EPIPE;
+          break;
+        }
+
+      used  = circbuf_used(&ring->lr_buf);
+      space = circbuf_size(&ring->lr_buf) - used;
+
+      if (record)
+        {
+          need = total + LOCAL_RING_HDRLEN;
+          if (space >= need)
+            {
+              lc_size_t pktlen = total;
+
+              circbuf_write(&ring->lr_buf, &pktlen, LOCAL_RING_HDRLEN);
+              local_ring_copyin(ring, iov, iovcnt, 0, total);
+              local_ring_added(ring, used);
+
+              ring->lr_txneed = 0;
+              ret = total;
+              break;
+            }
+        }
+      else
+        {
+          /* A blocked stream sender waits for room for the rest or for
+           * half of the ring, so it is not woken for every few bytes.
+           */
+
+          if (space > 0 && total > sent)
+            {
+              size_t n = MIN(space, total - sent);
+
+              local_ring_copyin(ring, iov, iovcnt, sent, n);
+              local_ring_added(ring, used);
+              sent += n;
+            }
+
+          if (sent == total)
+            {
+              ring->lr_txneed = 0;
+              ret = sent;
+              break;
+            }
+
+          need = MIN(total - sent, circbuf_size(&ring->lr_buf) / 2);
+        }
+
+      ring->lr_txneed = MAX(need, 1);
+
+      if (nonblock)
+        {
+          ret = sent > 0 ? sent : -EAGAIN;
+          break;
+        }
+
+      ret = local_ring_wait(ring, &ring->lr_txsem, &ring->lr_ntxwait,
+                            timeout);
+      if (ret < 0)
+        {
+          ret = sent > 0 ? sent : ret;
+          break;
+        }
+    }
+
+out:
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_recvmsg
+ *
+ * Description:
+ *   Receive data from the receive ring of a connection.  A stream receive
+ *   returns what is available, or waits for the whole buffer with
+ *   MSG_WAITALL; a record receive returns one record, setting MSG_TRUNC in
+ *   msg_flags if it did not fit.
+ *
+ * Input Parameters:
+ *   conn  - The receiving connection
+ *   msg   - The buffers to receive into
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   The number of bytes received (the full record length with MSG_TRUNC),
+ *   zero at the end of the stream; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recvmsg(FAR struct local_conn_s *conn,
+                           FAR struct msghdr *msg, int flags)
+{
+  FAR struct local_ring_s *ring = conn->lc_rxring;
+  unsigned int timeout = _SO_TIMEOUT(conn->lc_conn.s_rcvtimeo);
+  bool nonblock;
+  size_t total;
+  size_t recvd = 0;
+  size_t space;
+  size_t used;
+  size_t n;
+  ssize_t ret;
+
+  DEBUGASSERT(ring != NULL);
+
+  nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+  total    = local_ring_iovlen(msg->msg_iov, msg->msg_iovlen);
+
+  ret = nxmutex_lock(&ring->lr_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (; ; )
+    {
+      used  = circbuf_used(&ring->lr_buf);
+      space = circbuf_size(&ring->lr_buf) - used;
+
+      if (used > 0 && (ring->lr_flags & LOCAL_RING_RECORD) != 0)
+        {
+          lc_size_t pktlen;
+
+          circbuf_peek(&ring->lr_buf, &pktlen, LOCAL_RING_HDRLEN);
+
+          n = MIN(pktlen, total);
+          local_ring_copyout(ring, LOCAL_RING_HDRLEN, msg->msg_iov,
+                             msg->msg_iovlen, 0, n);
+          if (n < pktlen)
+            {
+              msg->msg_flags |= MSG_TRUNC;
+            }
+
+          if ((flags & MSG_PEEK) == 0)
+            {
+              circbuf_skip(&ring->lr_buf, LOCAL_RING_HDRLEN + pktlen);
+              local_ring_removed(ring, space);
+            }
+
+          ret = (flags & MSG_TRUNC) != 0 ? pktlen : n;
+          break;
+        }
+      else if (used > 0 && total > recvd)
+        {
+          n = MIN(used, total - recvd);
+          local_ring_copyout(ring, 0, msg->msg_iov, msg->msg_iovlen,
+                             recvd, n);
+
+          if ((flags & MSG_PEEK) != 0)
+            {
+              ret = n;
+              break;
+            }
+
+          circbuf_skip(&ring->lr_buf, n);
+          local_ring_removed(ring, space);
+
+          recvd += n;
+          if (recvd == total || (flags & MSG_WAITALL) == 0)
+            {
+              ret = recvd;
+              break;
+            }
+        }
+
+      /* The end of the stream, or nothing to wait for */
+
+      if ((ring->lr_flags & LOCAL_RING_SHUT) != 0 || total == 0)
+        {
+          ret = recvd;
+          break;
+        }
+
+      if (nonblock)
+        {
+          ret = recvd > 0 ? recvd : -EAGAIN;
+          break;
+        }
+
+      ret = local_ring_wait(ring, &ring->lr_rxsem, &ring->lr_nrxwait,
+                            timeout);
+      if (ret < 0)
+        {
+          ret = recvd > 0 ? recvd : ret;
+          break;
+        }
+    }
+
+  /* Pass the wakeup on to the next receiver if data is left */
+
+  if (!circbuf_is_empty(&ring->lr_buf))
+    {
+      local_ring_wake(&ring->lr_rxsem, ring->lr_nrxwait);
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_poll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of a connection using the ring buffer
+ *   transport.  POLLIN and POLLHUP come from the receive ring, POLLOUT and
+ *   POLLERR from the send ring.
+ *
+ ****************************************************************************/
+
+int local_ring_poll(FAR struct local_conn_s *conn, FAR struct pollfd *fds,
+                    bool setup)
+{
+  FAR struct local_ring_s *rxring = conn->lc_rxring;
+  FAR struct local_ring_s *txring = conn->lc_txring;
+  pollevent_t eventset;
+  int ret;
+
+  if (!setup)
+    {
+      if (fds->priv != NULL)
+        {
+          local_ring_pollslot(rxring, rxring->lr_rxfds, fds, false);
+          local_ring_pollslot(txring, txring->lr_txfds, fds, false);
+          fds->priv = NULL;
+        }
+
+      return OK;
+    }
+
+  ret = local_ring_pollslot(rxring, rxring->lr_rxfds, fds, true);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = local_ring_pollslot(txring, txring->lr_txfds, fds, true);
+  if (ret < 0)
+    {
+      local_ring_pollslot(rxring, rxring->lr_rxfds, fds, false);
+      return ret;
+    }
+
+  fds->priv = conn;
+
+  /* Report what is already there, after the slots are in place so that
+   * nothing is missed in between.
+   */
+
+  nxmutex_lock(&rxring->lr_lock);
+  eventset = local_ring_rxevents(rxring);
+  nxmutex_unlock(&rxring->lr_lock);
+
+  nxmutex_lock(&txring->lr_lock);
+  eventset |= local_ring_txevents(txring);
+  nxmutex_unlock(&txring->lr_lock);
+
+  poll_notify(&fds, 1, eventset);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_ioctl
+ *
+ * Description:
+ *   Handle FIONREAD, FIONWRITE and FIONSPACE for a connection using the
+ *   ring buffer transport.  FIONREAD returns the length of the next record
+ *   for record types.
+ *
+ ****************************************************************************/
+
+int local_ring_ioctl(FAR struct local_conn_s *conn, int cmd,
+                     unsigned long arg)
+{
+  FAR int *value = (FAR int *)((uintptr_t)arg);
+  FAR struct local_ring_s *ring;
+
+  switch (cmd)
+    {
+      case FIONREAD:
+        ring = conn->lc_rxring;
+        nxmutex_lock(&ring->lr_lock);
+
+        *value = circbuf_used(&ring->lr_buf);
+        if (*value > 0 && (ring->lr_flags & LOCAL_RING_RECORD) != 0)
+          {
+            lc_size_t pktlen;
+
+            circbuf_peek(&ring->lr_buf, &pktlen, LOCAL_RING_HDRLEN);
+            *value = pktlen;
+          }
+
+        nxmutex_unlock(&ring->lr_lock);
+        return OK;
+
+      case FIONWRITE:
+      case FIONSPACE:
+        ring = conn->lc_txring;
+        nxmutex_lock(&ring->lr_lock);
+
+        if (cmd == FIONWRITE)
+          {
+            *value = circbuf_used(&ring->lr_buf);
+          }
+        else
+          {
+            *value = circbuf_space(&ring->lr_buf);
+            if ((ring->lr_flags & LOCAL_RING_RECORD) != 0)
+              {
+                *value = MAX(*value - (int)LOCAL_RING_HDRLEN, 0);
+              }
+          }
+
+        nxmutex_unlock(&ring->lr_lock);
+        return OK;
+
+      default:
+        return -ENOTTY;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_resize
+ *
+ * Description:
+ *   Change the size of a ring.  The ring can not shrink below the data it
+ *   holds.
+ *
+ ****************************************************************************/
+
+int local_ring_resize(FAR struct local_ring_s *ring, size_t size)
+{
+  size_t space;
+  int ret;
+
+  if (size == 0)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&ring->lr_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (circbuf_used(&ring->lr_buf) > size)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      space = circbuf_space(&ring->lr_buf);
+      ret = circbuf_resize(&ring->lr_buf, size);
+      if (ret >= 0)
+        {
+          local_ring_removed(ring, space);
+        }
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+#endif /* CONFIG_NET_LOCAL_RING */
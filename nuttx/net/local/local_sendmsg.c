@@ -177,6 +177,9 @@ static ssize_t local_send(FAR struct socket *psock,
 #ifdef CONFIG_NET_LOCAL_STREAM
       case SOCK_STREAM:
 #endif /* CONFIG_NET_LOCAL_STREAM */
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+#endif /* CONFIG_NET_LOCAL_SEQPACKET */
 #ifdef CONFIG_NET_LOCAL_DGRAM
       case SOCK_DGRAM:
 #endif /* CONFIG_NET_LOCAL_DGRAM */
@@ -197,9 +200,13 @@ static ssize_t local_send(FAR struct socket *psock,
               return -ENOTCONN;
             }
 
-          /* Check shutdown state */
+          /* Check shutdown state, the rings keep their own */
 
-          if (conn->lc_outfile.f_inode == NULL)
+          if (conn->lc_outfile.f_inode == NULL
+#ifdef CONFIG_NET_LOCAL_RING
+              && conn->lc_txring == NULL
+#endif
+             )
             {
               return -EPIPE;
             }
@@ -214,7 +221,17 @@ static ssize_t local_send(FAR struct socket *psock,
               return ret;
             }
 
-          ret = local_send_packet(&conn->lc_outfile, buf, len);
+#ifdef CONFIG_NET_LOCAL_RING
+          if (conn->lc_txring != NULL)
+            {
+              ret = local_ring_send(conn, buf, len, flags);
+            }
+          else
+#endif
+            {
+              ret = local_send_packet(&conn->lc_outfile, buf, len);
+            }
+
           nxmutex_unlock(&conn->lc_sendlock);
         }
         break;
@@ -191,6 +191,18 @@ static int local_setup(FAR struct socket *psock)
         return local_sockif_alloc(psock);
 #endif /* CONFIG_NET_LOCAL_STREAM */
 
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+        if (psock->s_proto != 0)
+          {
+            return -EPROTONOSUPPORT;
+          }
+
+        /* Allocate and attach the local connection structure */
+
+        return local_sockif_alloc(psock);
+#endif /* CONFIG_NET_LOCAL_SEQPACKET */
+
 #ifdef CONFIG_NET_LOCAL_DGRAM
       case SOCK_DGRAM:
         if (psock->s_proto != 0 && psock->s_proto != IPPROTO_UDP)
@@ -303,6 +315,9 @@ static int local_bind(FAR struct socket *psock,
 #ifdef CONFIG_NET_LOCAL_STREAM
       case SOCK_STREAM:
 #endif
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+#endif
 #ifdef CONFIG_NET_LOCAL_DGRAM
       case SOCK_DGRAM:
 #endif
@@ -680,6 +695,12 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
                       ret = file_ioctl(&conn->lc_peer->lc_infile,
                                        PIPEIOC_SETSIZE, rcvsize);
                     }
+#ifdef CONFIG_NET_LOCAL_RING
+                  else if (conn->lc_txring != NULL)
+                    {
+                      ret = local_ring_resize(conn->lc_txring, rcvsize);
+                    }
+#endif
 
                   if (ret == OK)
                     {
@@ -687,7 +708,7 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
                     }
                 }
 #ifdef CONFIG_NET_LOCAL_STREAM
-              else if (psock->s_type == SOCK_STREAM)
+              else if (LOCAL_ISCONNMODE(psock->s_type))
                 {
                   ret = -ENOTCONN;
                 }
@@ -724,6 +745,12 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
                   ret = file_ioctl(&conn->lc_infile, PIPEIOC_SETSIZE,
                                    rcvsize);
                 }
+#ifdef CONFIG_NET_LOCAL_RING
+              else if (conn->lc_rxring != NULL)
+                {
+                  ret = local_ring_resize(conn->lc_rxring, rcvsize);
+                }
+#endif
 #ifdef CONFIG_NET_LOCAL_DGRAM
               else if (psock->s_type == SOCK_DGRAM &&
                        conn->lc_state == LOCAL_STATE_BOUND)
@@ -812,6 +839,9 @@ static int local_connect(FAR struct socket *psock,
     {
 #ifdef CONFIG_NET_LOCAL_STREAM
       case SOCK_STREAM:
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+#endif
         {
           FAR struct socket_conn_s *conn = psock->s_conn;
 
@@ -912,6 +942,9 @@ static int local_close(FAR struct socket *psock)
 #ifdef CONFIG_NET_LOCAL_STREAM
       case SOCK_STREAM:
 #endif
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+#endif
 #ifdef CONFIG_NET_LOCAL_DGRAM
       case SOCK_DGRAM:
 #endif
@@ -948,6 +981,19 @@ static int local_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_rxring != NULL)
+    {
+      ret = local_ring_ioctl(conn, cmd, arg);
+      if (ret != -ENOTTY)
+        {
+          return ret;
+        }
+
+      ret = OK;
+    }
+#endif
+
   switch (cmd)
     {
       case FIONBIO:
@@ -1031,7 +1077,9 @@ static int local_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
 static int local_socketpair(FAR struct socket *psocks[2])
 {
   FAR struct local_conn_s *conns[2];
+#ifndef CONFIG_NET_LOCAL_RING
   bool nonblock;
+#endif
   int ret;
   int i;
 
@@ -1053,6 +1101,22 @@ static int local_socketpair(FAR struct socket *psocks[2])
                            = -1;
 #endif
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connect the pair through a pair of rings */
+
+  ret = local_ring_connect(conns[0], conns[1]);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  conns[0]->lc_peer  = conns[1];
+  conns[1]->lc_peer  = conns[0];
+  conns[0]->lc_state = conns[1]->lc_state
+                     = LOCAL_STATE_CONNECTED;
+
+  return OK;
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conns[0], conns[0]->lc_rcvsize,
@@ -1118,6 +1182,7 @@ static int local_socketpair(FAR struct socket *psocks[2])
 errout:
   local_release_fifos(conns[0]);
   return ret;
+#endif /* CONFIG_NET_LOCAL_RING */
 }
 
 /****************************************************************************
@@ -1149,8 +1214,16 @@ static int local_shutdown(FAR struct socket *psock, int how)
     {
 #ifdef CONFIG_NET_LOCAL_STREAM
       case SOCK_STREAM:
+#ifdef CONFIG_NET_LOCAL_SEQPACKET
+      case SOCK_SEQPACKET:
+#endif
         {
           FAR struct local_conn_s *conn = psock->s_conn;
+
+#ifdef CONFIG_NET_LOCAL_RING
+          local_ring_shutdown(conn, how);
+#endif
+
           if (how & SHUT_RD)
             {
               if (conn->lc_infile.f_inode != NULL)
@@ -170,6 +170,9 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
            */
 
           icmpv6_solicit(dev, ipaddr);
+#ifdef CONFIG_NETDEV_OFFLOAD
+          dev->d_offload = 0;
+#endif
 #else
           /* What to do here? We need the laddr, but no way to get it. */
 
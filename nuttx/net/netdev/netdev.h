@@ -533,6 +533,28 @@ void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
                            FAR const void *dst_addr, uint16_t dst_port);
 #endif
 
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the receive queues of a device until the semaphore of a pending
+ *   receive is posted or the time is up (SO_BUSY_POLL).
+ *
+ * Input Parameters:
+ *   dev  - The device to poll, may be NULL
+ *   usec - The time to poll, in microseconds
+ *   sem  - The semaphore posted when the receive completes
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+void netdev_busypoll(FAR struct net_driver_s *dev, unsigned int usec,
+                     FAR sem_t *sem);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
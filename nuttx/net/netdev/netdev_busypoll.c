@@ -0,0 +1,100 @@
+/****************************************************************************
+ * net/netdev/netdev_busypoll.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_BUSY_POLL
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the receive queues of a device until the semaphore of a pending
+ *   receive is posted or the time is up, instead of waiting for the
+ *   interrupt of the device.  Called right before a receive blocks on the
+ *   semaphore, the receive then takes the semaphore without sleeping.
+ *
+ * Input Parameters:
+ *   dev  - The device to poll, may be NULL
+ *   usec - The time to poll, in microseconds
+ *   sem  - The semaphore posted when the receive completes
+ *
+ * Assumptions:
+ *   Called with the network locked.  The lock is released while the
+ *   device is polled.
+ *
+ ****************************************************************************/
+
+void netdev_busypoll(FAR struct net_driver_s *dev, unsigned int usec,
+                     FAR sem_t *sem)
+{
+  unsigned int count;
+  clock_t elapsed;
+  clock_t start;
+  int semcount;
+
+  if (dev == NULL || dev->d_busypoll == NULL || usec == 0 ||
+      !IFF_IS_UP(dev->d_flags))
+    {
+      return;
+    }
+
+  /* Without a performance counter the device is polled once */
+
+  elapsed = (clock_t)((uint64_t)usec * perf_getfreq() / USEC_PER_SEC);
+
+  net_breaklock(&count);
+
+  start = perf_gettime();
+  do
+    {
+      dev->d_busypoll(dev);
+
+      if (nxsem_get_value(sem, &semcount) == OK && semcount > 0)
+        {
+          break;
+        }
+    }
+  while (perf_gettime() - start < elapsed);
+
+  net_restorelock(count);
+}
+
+#endif /* CONFIG_NET_BUSY_POLL */
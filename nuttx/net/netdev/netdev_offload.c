@@ -0,0 +1,190 @@
+/****************************************************************************
+ * net/netdev/netdev_offload.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <debug.h>
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_offload_parse
+ *
+ * Description:
+ *   Locate the headers of an outgoing packet marked for offload in
+ *   dev->d_offload.  The IP and TCP/UDP headers must be in the first IOB.
+ *
+ * Input Parameters:
+ *   dev  - The network device the packet is sent on
+ *   iob  - The packet, starting with the IP header
+ *   info - Returns the offload request, info->flags is 0 for none
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the packet is marked for offload but it is
+ *   not a TCP/UDP packet that can be offloaded.
+ *
+ ****************************************************************************/
+
+int netdev_offload_parse(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                         FAR struct netdev_offload_s *info)
+{
+  FAR uint8_t *ipbuf = IOB_DATA(iob);
+  unsigned int iphdrlen;
+  unsigned int l4hdrlen;
+
+  memset(info, 0, sizeof(*info));
+  info->flags = dev->d_offload & (NETDEV_OFFLOAD_CSUM | NETDEV_OFFLOAD_TSO);
+  if (info->flags == 0)
+    {
+      return OK;
+    }
+
+  /* The stack does not emit IPv4 options or IPv6 extension headers with
+   * TCP or UDP, but parse what it gets anyway.
+   */
+
+#ifdef CONFIG_NET_IPv4
+  if (iob->io_len >= IPv4_HDRLEN &&
+      (ipbuf[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ipbuf;
+
+      iphdrlen    = (ipv4->vhl & IPv4_HLMASK) << 2;
+      info->proto = ipv4->proto;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (iob->io_len >= IPv6_HDRLEN &&
+      (ipbuf[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ipbuf;
+
+      iphdrlen    = IPv6_HDRLEN;
+      info->proto = ipv6->proto;
+      info->ipv6  = true;
+    }
+  else
+#endif
+    {
+      goto errout;
+    }
+
+  if (info->proto == IP_PROTO_TCP && iob->io_len >= iphdrlen + TCP_HDRLEN)
+    {
+      FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)&ipbuf[iphdrlen];
+
+      l4hdrlen         = (tcp->tcpoffset >> 4) << 2;
+      info->csumoffset = offsetof(struct tcp_hdr_s, tcpchksum);
+    }
+  else if (info->proto == IP_PROTO_UDP &&
+           (info->flags & NETDEV_OFFLOAD_TSO) == 0)
+    {
+      l4hdrlen         = UDP_HDRLEN;
+      info->csumoffset = offsetof(struct udp_hdr_s, udpchksum);
+    }
+  else
+    {
+      goto errout;
+    }
+
+  if (iob->io_len < iphdrlen + l4hdrlen)
+    {
+      goto errout;
+    }
+
+  info->csumstart = NET_LL_HDRLEN(dev) + iphdrlen;
+  info->hdrlen    = info->csumstart + l4hdrlen;
+
+  if ((info->flags & NETDEV_OFFLOAD_TSO) != 0)
+    {
+      info->gsosize = dev->d_gsosize;
+    }
+
+  return OK;
+
+errout:
+  nerr("ERROR: Cannot offload packet, flags %02x\n", dev->d_offload);
+  info->flags = 0;
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: netdev_offload_chksum
+ *
+ * Description:
+ *   Complete the TCP/UDP checksum of a packet marked for checksum offload,
+ *   in software.  On entry the checksum field holds the sum of the
+ *   pseudo-header.
+ *
+ * Input Parameters:
+ *   dev  - The network device the packet is sent on
+ *   iob  - The packet, starting with the IP header
+ *   info - The offload request returned by netdev_offload_parse()
+ *
+ ****************************************************************************/
+
+void netdev_offload_chksum(FAR struct net_driver_s *dev,
+                           FAR struct iob_s *iob,
+                           FAR const struct netdev_offload_s *info)
+{
+  unsigned int l4off = info->csumstart - NET_LL_HDRLEN(dev);
+  FAR uint16_t *chksum;
+  uint16_t sum;
+
+  DEBUGASSERT((info->flags & NETDEV_OFFLOAD_CSUM) != 0);
+
+  /* The pseudo-header sum in the checksum field is summed along with the
+   * rest of the TCP/UDP header and the payload.
+   */
+
+  chksum = (FAR uint16_t *)&IOB_DATA(iob)[l4off + info->csumoffset];
+  sum    = chksum_iob(0, iob, l4off);
+  sum    = (sum == 0) ? 0xffff : HTONS(sum);
+
+  *chksum = ~sum;
+  if (*chksum == 0 && info->proto == IP_PROTO_UDP)
+    {
+      /* A zero UDP checksum means that there is none */
+
+      *chksum = 0xffff;
+    }
+}
+
+#endif /* CONFIG_NETDEV_OFFLOAD */
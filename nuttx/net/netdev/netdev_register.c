@@ -392,6 +392,10 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
       dev->d_conncb_tail = NULL;
       dev->d_devcb = NULL;
 
+      /* The device lock serializes the users of the packet buffer */
+
+      nxrmutex_init(&dev->d_lock);
+
       /* We need exclusive access for the following operations */
 
       net_lock();
@@ -39,6 +39,7 @@
 
 #include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "tcp/tcp.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -147,11 +148,19 @@ int netdev_unregister(FAR struct net_driver_s *dev)
           curr->flink = NULL;
         }
 
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+      /* Forget the TCP connections that still wait for a TX poll */
+
+      tcp_txpending_flush(dev);
+#endif
+
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
       net_unlock();
 
+      nxrmutex_destroy(&dev->d_lock);
+
 #if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
       work_cancel_sync(NETDEV_STATISTICS_WORK, &dev->d_statistics.logwork);
 #endif
@@ -854,7 +854,13 @@ static int netlink_list_ipv4_route(NETLINK_HANDLE handle,
   info.handle = handle;
   info.req    = req;
 
+  /* The callback takes the network lock, which must not be taken with
+   * the routing table locked.  Take it first.
+   */
+
+  net_lock();
   ret = net_foreachroute_ipv4(netlink_ipv4route_callback, &info);
+  net_unlock();
   if (ret < 0)
     {
       return ret;
@@ -974,7 +980,13 @@ static int netlink_list_ipv6_route(NETLINK_HANDLE handle,
   info.handle = handle;
   info.req    = req;
 
+  /* The callback takes the network lock, which must not be taken with
+   * the routing table locked.  Take it first.
+   */
+
+  net_lock();
   ret = net_foreachroute_ipv6(netlink_ipv6route_callback, &info);
+  net_unlock();
   if (ret < 0)
     {
       return ret;
@@ -0,0 +1,157 @@
+/****************************************************************************
+ * net/procfs/net_lockstats.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   Acquired:  xxxxxxxx
+ *   Contended: xxxxxxxx
+ *   Wait (us): total xxxxxxxxxx max xxxxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netstats.h>
+
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && \
+    defined(CONFIG_NET_LOCK_STATISTICS)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_lock_count(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_lock_wait(FAR struct netprocfs_file_s *netfile);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static const linegen_t g_lock_linegen[] =
+{
+  netprocfs_lock_count,
+  netprocfs_lock_wait
+};
+
+#define NSTAT_LINES (sizeof(g_lock_linegen) / sizeof(linegen_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_lock_usec
+ ****************************************************************************/
+
+static uint64_t netprocfs_lock_usec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: netprocfs_lock_count
+ ****************************************************************************/
+
+static int netprocfs_lock_count(FAR struct netprocfs_file_s *netfile)
+{
+  int len;
+
+  len  = snprintf(netfile->line, NET_LINELEN, "Acquired:  %08" PRIx32 "\n",
+                  g_netstats.lock.acquired);
+  len += snprintf(&netfile->line[len], NET_LINELEN - len,
+                  "Contended: %08" PRIx32 "\n",
+                  g_netstats.lock.contended);
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_lock_wait
+ ****************************************************************************/
+
+static int netprocfs_lock_wait(FAR struct netprocfs_file_s *netfile)
+{
+  uint64_t waittime;
+  uint64_t maxwait;
+
+  /* Sample both values under the lock so that they are consistent */
+
+  net_lock();
+  waittime = netprocfs_lock_usec(g_netstats.lock.waittime);
+  maxwait  = netprocfs_lock_usec(g_netstats.lock.maxwait);
+  net_unlock();
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Wait (us): total %" PRIu64 " max %" PRIu64 "\n",
+                  waittime, maxwait);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format network lock contention statistics.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen,
+                                g_lock_linegen, NSTAT_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_LOCK_STATISTICS */
@@ -114,6 +114,14 @@ static const struct netprocfs_entry_s g_net_entries[] =
       netprocfs_read_netstats
     }
   },
+#  ifdef CONFIG_NET_LOCK_STATISTICS
+  {
+    DTYPE_FILE, "lock",
+    {
+      netprocfs_read_lockstats
+    }
+  },
+#  endif
 #  ifdef CONFIG_NET_MLD
   {
     DTYPE_FILE, "mld",
@@ -77,6 +77,9 @@ static int netprocfs_rxstatistics_header(
 static int netprocfs_rxstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NETDEV_GRO
+static int netprocfs_rxgro(FAR struct netprocfs_file_s *netfile);
+#endif
 static int netprocfs_txstatistics_header(
     FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
@@ -114,6 +117,9 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_rxstatistics,
   netprocfs_rxpackets_header,
   netprocfs_rxpackets,
+#ifdef CONFIG_NETDEV_GRO
+  netprocfs_rxgro,
+#endif
   netprocfs_txstatistics_header,
   netprocfs_txstatistics,
   netprocfs_errors
@@ -518,6 +524,27 @@ static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_rxgro
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_GRO)
+static int netprocfs_rxgro(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_statistics_s *stats;
+  FAR struct net_driver_s *dev;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  dev = netfile->dev;
+  stats = &dev->d_statistics;
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\t    GRO: %08lx Merged: %08lx\n",
+                  (unsigned long)stats->rx_gro,
+                  (unsigned long)stats->rx_gro_merged);
+}
+#endif
+
 /****************************************************************************
  * Name: netprocfs_txstatistics_header
  ****************************************************************************/
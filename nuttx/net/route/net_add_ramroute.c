@@ -80,15 +80,15 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   net_ipv4addr_copy(route->router, router);
   net_ipv4_dumproute("New route", route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv4();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
-  net_unlock();
+  net_unlockroute_ipv4();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
   return OK;
@@ -117,15 +117,15 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   net_ipv6addr_copy(route->router, router);
   net_ipv6_dumproute("New route", route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv6();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
-  net_unlock();
+  net_unlockroute_ipv6();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET6);
   return OK;
@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <assert.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/net/net.h>
 #include <arch/irq.h>
 
@@ -58,6 +59,16 @@ FAR struct net_route_ipv6_queue_s g_ipv6_routes;
  * Private Data
  ****************************************************************************/
 
+/* Used to lock a routing table and its free list */
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static rmutex_t g_ipv4_lock = NXRMUTEX_INITIALIZER;
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static rmutex_t g_ipv6_lock = NXRMUTEX_INITIALIZER;
+#endif
+
 /* These are lists of free routing table entries */
 
 #ifdef CONFIG_ROUTE_IPv4_RAMROUTE
@@ -152,15 +163,15 @@ FAR struct net_route_ipv4_s *net_allocroute_ipv4(void)
 {
   FAR struct net_route_ipv4_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv4();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv4_remfirst(&g_free_ipv4routes);
 
-  net_unlock();
+  net_unlockroute_ipv4();
   if (!route)
     {
       return NULL;
@@ -175,15 +186,15 @@ FAR struct net_route_ipv6_s *net_allocroute_ipv6(void)
 {
   FAR struct net_route_ipv6_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv6();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv6_remfirst(&g_free_ipv6routes);
 
-  net_unlock();
+  net_unlockroute_ipv6();
   if (!route)
     {
       return NULL;
@@ -212,15 +223,15 @@ void net_freeroute_ipv4(FAR struct net_route_ipv4_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv4();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_free_ipv4routes);
-  net_unlock();
+  net_unlockroute_ipv4();
 }
 #endif
 
@@ -229,15 +240,73 @@ void net_freeroute_ipv6(FAR struct net_route_ipv6_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive access to the routing table */
 
-  net_lock();
+  net_lockroute_ipv6();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_free_ipv6routes);
-  net_unlock();
+  net_unlockroute_ipv6();
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lockroute_ipv4/net_lockroute_ipv6
+ *
+ * Description:
+ *   Lock access to the routing table and its free list.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lockroute_ipv4(void)
+{
+  return nxrmutex_lock(&g_ipv4_lock);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lockroute_ipv6(void)
+{
+  return nxrmutex_lock(&g_ipv6_lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_unlockroute_ipv4/net_unlockroute_ipv6
+ *
+ * Description:
+ *   Release the routing table lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_unlockroute_ipv4(void)
+{
+  return nxrmutex_unlock(&g_ipv4_lock);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_unlockroute_ipv6(void)
+{
+  return nxrmutex_unlock(&g_ipv6_lock);
 }
 #endif
 
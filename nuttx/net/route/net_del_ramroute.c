@@ -50,6 +50,7 @@ struct route_match_ipv4_s
   FAR struct net_route_ipv4_s *prev;     /* Predecessor in the list */
   in_addr_t                    target;   /* The target IP address to match */
   in_addr_t                    netmask;  /* The network mask to match */
+  struct net_route_ipv4_s      route;    /* The deleted route */
 };
 #endif
 
@@ -59,6 +60,7 @@ struct route_match_ipv6_s
   FAR struct net_route_ipv6_s *prev;     /* Predecessor in the list */
   net_ipv6addr_t               target;   /* The target IP address to match */
   net_ipv6addr_t               netmask;  /* The network mask to match */
+  struct net_route_ipv6_s      route;    /* The deleted route */
 };
 #endif
 
@@ -113,7 +115,11 @@ static int net_del_ipv4route(FAR struct net_route_ipv4_s *route,
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
-      netlink_route_notify(route, RTM_DELROUTE, AF_INET);
+      /* Keep a copy for the notification, which takes the network lock
+       * and cannot be sent with the routing table locked.
+       */
+
+      match->route = *route;
 
       /* And free the routing table entry by adding it to the free list */
 
@@ -171,7 +177,11 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
-      netlink_route_notify(route, RTM_DELROUTE, AF_INET6);
+      /* Keep a copy for the notification, which takes the network lock
+       * and cannot be sent with the routing table locked.
+       */
+
+      match->route = *route;
 
       /* And free the routing table entry by adding it to the free list */
 
@@ -219,7 +229,13 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_del_ipv4route, &match) ? OK : -ENOENT;
+  if (net_foreachroute_ipv4(net_del_ipv4route, &match) == 0)
+    {
+      return -ENOENT;
+    }
+
+  netlink_route_notify(&match.route, RTM_DELROUTE, AF_INET);
+  return OK;
 }
 #endif
 
@@ -236,7 +252,13 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_del_ipv6route, &match) ? OK : -ENOENT;
+  if (net_foreachroute_ipv6(net_del_ipv6route, &match) == 0)
+    {
+      return -ENOENT;
+    }
+
+  netlink_route_notify(&match.route, RTM_DELROUTE, AF_INET6);
+  return OK;
 }
 #endif
 
@@ -66,9 +66,11 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
   FAR struct net_route_ipv4_entry_s *next;
   int ret = 0;
 
-  /* Prevent concurrent access to the routing table */
+  /* Prevent concurrent access to the routing table.  The handler must not
+   * take the network lock unless the caller holds it already.
+   */
 
-  net_lock();
+  net_lockroute_ipv4();
 
   /* Visit each entry in the routing table */
 
@@ -82,9 +84,9 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_unlockroute_ipv4();
   return ret;
 }
 #endif
@@ -96,9 +98,11 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
   FAR struct net_route_ipv6_entry_s *next;
   int ret = 0;
 
-  /* Prevent concurrent access to the routing table */
+  /* Prevent concurrent access to the routing table.  The handler must not
+   * take the network lock unless the caller holds it already.
+   */
 
-  net_lock();
+  net_lockroute_ipv6();
 
   /* Visit each entry in the routing table */
 
@@ -112,9 +116,9 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_unlockroute_ipv6();
   return ret;
 }
 #endif
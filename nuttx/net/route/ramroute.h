@@ -183,6 +183,55 @@ void net_freeroute_ipv4(FAR struct net_route_ipv4_s *route);
 void net_freeroute_ipv6(FAR struct net_route_ipv6_s *route);
 #endif
 
+/****************************************************************************
+ * Name: net_lockroute_ipv4/net_lockroute_ipv6
+ *
+ * Description:
+ *   Lock access to the routing table and its free list.  The routing table
+ *   does not depend on the network lock.  The lock may be taken with the
+ *   network, device or connection lock held, but no other network lock may
+ *   be taken while it is held.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lockroute_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lockroute_ipv6(void);
+#endif
+
+/****************************************************************************
+ * Name: net_unlockroute_ipv4/net_unlockroute_ipv6
+ *
+ * Description:
+ *   Release the routing table lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_unlockroute_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_unlockroute_ipv6(void);
+#endif
+
 /****************************************************************************
  * Name: (various low-level list operations)
  *
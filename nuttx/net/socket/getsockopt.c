@@ -147,6 +147,7 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
                            * periodic transmission of probes */
       case SO_OOBINLINE:  /* Leaves received out-of-band data inline */
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
+      case SO_REUSEPORT:  /* Allow several sockets to share a port */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
 #endif
@@ -204,6 +205,20 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Busy poll the device before blocking */
+        {
+          if (*value_len < sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          *(FAR int *)value = conn->s_busypoll;
+          *value_len        = sizeof(int);
+        }
+        break;
+#endif
+
       default:
         return -ENOPROTOOPT;
     }
@@ -0,0 +1,216 @@
+/****************************************************************************
+ * net/socket/net_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Receive data from a connected stream socket or a datagram socket
+ *   without copying it:  The I/O buffer chain holding the queued data is
+ *   detached from the socket and loaned to the caller.  The caller owns
+ *   the chain on return and must release it with iob_free_chain().
+ *
+ * Input Parameters:
+ *   psock   An instance of the internal socket structure.
+ *   iob     Location to return the I/O buffer chain.
+ *   flags   Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the returned chain.  Zero
+ *   is returned if the peer has performed an orderly shutdown.  Otherwise
+ *   a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      int flags)
+{
+  if (iob == NULL)
+    {
+      return -EINVAL;
+    }
+
+  *iob = NULL;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      nerr("ERROR: Invalid socket\n");
+      return -EBADF;
+    }
+
+  /* The address family indicates support with a non-NULL si_recviob()
+   * method in the socket interface.
+   */
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  if (psock->s_sockif->si_recviob == NULL)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  return psock->s_sockif->si_recviob(psock, iob, flags);
+}
+
+/****************************************************************************
+ * Name: psock_sendiob
+ *
+ * Description:
+ *   Send a caller-filled I/O buffer chain on a connected socket without
+ *   copying it.  The stack takes ownership of every IOB it queues.
+ *
+ * Input Parameters:
+ *   psock   An instance of the internal socket structure.
+ *   iob     On entry, the I/O buffer chain to send.  On return, the part
+ *           of the chain that could not be queued or NULL if all of it
+ *           was.
+ *   flags   Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  Otherwise a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      int flags)
+{
+  if (iob == NULL || *iob == NULL || (*iob)->io_pktlen == 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      nerr("ERROR: Invalid socket\n");
+      return -EBADF;
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  if (psock->s_sockif->si_sendiob == NULL)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  return psock->s_sockif->si_sendiob(psock, iob, flags);
+}
+
+/****************************************************************************
+ * Name: net_recviob
+ *
+ * Description:
+ *   Descriptor based version of psock_recviob().
+ *
+ ****************************************************************************/
+
+ssize_t net_recviob(int sockfd, FAR struct iob_s **iob, int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* net_recviob() is a cancellation point, like recv() */
+
+  enter_cancellation_point();
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+  if (ret == OK)
+    {
+      ret = psock_recviob(psock, iob, flags);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: net_sendiob
+ *
+ * Description:
+ *   Descriptor based version of psock_sendiob().
+ *
+ ****************************************************************************/
+
+ssize_t net_sendiob(int sockfd, FAR struct iob_s **iob, int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  ssize_t ret;
+
+  /* net_sendiob() is a cancellation point, like send() */
+
+  enter_cancellation_point();
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+  if (ret == OK)
+    {
+      ret = psock_sendiob(psock, iob, flags);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET_ZEROCOPY */
@@ -0,0 +1,243 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket with a
+ *   single call.  This is an internal OS interface.  It is functionally
+ *   equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Array of message buffers
+ *   vlen      Number of entries in msgvec
+ *   flags     Receive flags
+ *   timeout   Optional timeout, updated with the time left on return
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  A negated errno
+ *   value is returned if no message could be received (see comments with
+ *   recvmmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t start = 0;
+  clock_t ticks = 0;
+  clock_t elapsed;
+  unsigned int i;
+  bool locked;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      ticks = clock_time2ticks(timeout);
+      start = clock_systime_ticks();
+    }
+
+  if (vlen > IOV_MAX)
+    {
+      vlen = IOV_MAX;
+    }
+
+  /* Keep the network locked across the whole batch where that is safe.  The
+   * nested net_lock() calls in the protocol code then only bump the count
+   * of the recursive mutex instead of contending for it once per message.
+   */
+
+  locked = _SO_BATCH_LOCKABLE(psock);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      /* After the first message only take what is already queued */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* Like Linux, the timeout is only checked after each message */
+
+      if (timeout != NULL)
+        {
+          elapsed = clock_systime_ticks() - start;
+          if (elapsed >= ticks)
+            {
+              i++;
+              break;
+            }
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Report the time left back to the caller */
+
+  if (timeout != NULL)
+    {
+      elapsed = clock_systime_ticks() - start;
+      clock_ticks2time(timeout, elapsed < ticks ? ticks - elapsed : 0);
+    }
+
+  if (i > 0)
+    {
+      /* Some messages were received.  Keep a hard error for the next call
+       * to report through SO_ERROR, the batch itself succeeded.
+       */
+
+      if (ret < 0 && ret != -EAGAIN)
+        {
+          _SO_SETERRNO(psock, -ret);
+        }
+
+      return i;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() is an extension of recvmsg() that receives multiple
+ *   messages from a socket with a single call.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Array of message buffers
+ *   vlen     Number of entries in msgvec
+ *   flags    Receive flags.  In addition to the recvmsg() flags,
+ *            MSG_WAITFORONE turns on MSG_DONTWAIT after the first message
+ *            has been received.
+ *   timeout  Optional timeout.  As on Linux, it is only checked after each
+ *            message is received, so it does not bound a blocking wait.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received; msg_len of each
+ *   received message holds its length.  On error, -1 is returned, and
+ *   errno is set appropriately (see recvmsg()).  An error is reported only
+ *   if no message could be received.
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,192 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends several messages on a socket with a single
+ *   call.  This is an internal OS interface.  It is functionally
+ *   equivalent to sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Array of messages to send
+ *   vlen     Number of entries in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  A negated errno
+ *   value is returned if the first message could not be sent (see
+ *   comments with sendmmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  unsigned int i;
+  bool locked;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (vlen > IOV_MAX)
+    {
+      vlen = IOV_MAX;
+    }
+
+  /* Keep the network locked across the whole batch where that is safe, so
+   * that the messages are queued to the write buffers under one lock.
+   */
+
+  locked = _SO_BATCH_LOCKABLE(psock);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_sendmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  if (i > 0)
+    {
+      /* Some messages were sent.  Keep a hard error for the next call to
+       * report through SO_ERROR, the batch itself succeeded.
+       */
+
+      if (ret < 0 && ret != -EAGAIN)
+        {
+          _SO_SETERRNO(psock, -ret);
+        }
+
+      return i;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Function: sendmmsg
+ *
+ * Description:
+ *   sendmmsg() is an extension of sendmsg() that sends multiple messages
+ *   on a socket with a single call.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Array of messages to send
+ *   vlen     Number of entries in msgvec
+ *   flags    Send flags (see sendmsg())
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent; msg_len of each sent
+ *   message holds the number of bytes transmitted.  On error, -1 is
+ *   returned, and errno is set appropriately (see sendmsg()).  An error is
+ *   reported only if the first message could not be sent.
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_sendmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
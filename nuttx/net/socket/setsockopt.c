@@ -137,6 +137,7 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
                            * periodic transmission of probes */
       case SO_OOBINLINE:  /* Leaves received out-of-band data inline */
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
+      case SO_REUSEPORT:  /* Allow several sockets to share a port */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
 #endif
@@ -222,6 +223,27 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
 #endif
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Busy poll the device before blocking */
+        {
+          int usec;
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          usec = *(FAR int *)value;
+          if (usec < 0 || usec > UINT16_MAX)
+            {
+              return -EINVAL;
+            }
+
+          conn->s_busypoll = usec;
+          break;
+        }
+#endif
+
       /* There options are only valid when used with getopt */
 
       case SO_ACCEPTCONN: /* Reports whether socket listening is enabled */
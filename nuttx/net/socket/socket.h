@@ -66,10 +66,12 @@
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
 #define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
 #define _SO_BINDTODEVICE _SO_BIT(SO_BINDTODEVICE)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
+#define _SO_BUSY_POLL    _SO_BIT(SO_BUSY_POLL)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (18)
+#define _SO_MAXOPT       (20)
 
 /* Macros to set, test, clear options */
 
@@ -123,6 +125,14 @@
 #  define _SO_SETERRNO(s,e)
 #endif /* CONFIG_NET_SOCKOPTS */
 
+/* Sockets of the in-kernel IP stack (and usrsock) release the network lock
+ * whenever they block, so a batch of operations on them can keep the lock
+ * for the whole batch.  Other families may block with it held.
+ */
+
+#define _SO_BATCH_LOCKABLE(s) \
+  ((s)->s_domain == PF_INET || (s)->s_domain == PF_INET6)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
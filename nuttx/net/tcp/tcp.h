@@ -32,6 +32,7 @@
 #include <sys/types.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
@@ -114,6 +115,12 @@
 
 #endif
 
+#ifdef CONFIG_NET_TCP_CC_RTT
+/* The number of sent segments of which the RTT can be sampled at once */
+
+#define TCP_CC_RTT_SAMPLES    8
+#endif
+
 /* The Max Range count of TCP Selective ACKs */
 
 #define TCP_SACK_RANGES_MAX   4
@@ -135,6 +142,62 @@ struct file;      /* Forward reference */
 struct sockaddr;  /* Forward reference */
 struct socket;    /* Forward reference */
 struct pollfd;    /* Forward reference */
+struct tcp_conn_s;
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* A congestion control algorithm.  Fast retransmit and fast recovery are
+ * common to all algorithms, they only decide how the congestion window
+ * grows and how much it is reduced on a loss.
+ *
+ *   init       - Reset the state of the algorithm for a new connection.
+ *                Optional.
+ *   ssthresh   - Return the slow start threshold after a loss.
+ *   cong_avoid - Grow cwnd in congestion avoidance on the ACK of 'acked'
+ *                bytes.
+ *   rtt_sample - Take an RTT sample, in microseconds.  Optional, the RTT is
+ *                only sampled for the algorithms that provide it.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE void (*rtt_sample)(FAR struct tcp_conn_s *conn, uint32_t rtt);
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_RTT
+/* A sent segment of which the RTT is sampled */
+
+struct tcp_cc_rtt_s
+{
+  uint32_t seq;           /* Sequence number that ends the segment */
+  uint32_t time;          /* Time the segment was sent (us) */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* The state of the CUBIC congestion control of a connection */
+
+struct tcp_cubic_s
+{
+  uint32_t epoch;         /* Start of the congestion avoidance epoch (ms) */
+  uint32_t k;             /* Time from the epoch to reach w_max (ms) */
+  uint32_t w_max;         /* cwnd before the last reduction */
+  uint32_t w_est;         /* The Reno-friendly cwnd estimate */
+  uint32_t min_rtt;       /* Minimum RTT sampled (us), 0 if none yet */
+  bool     in_epoch;      /* The epoch has started */
+#ifdef CONFIG_NET_TCP_CC_HYSTART
+  bool     ss_exited;     /* HyStart has left slow start */
+  uint8_t  nsamples;      /* RTT samples taken in this round */
+  uint32_t round_end;     /* Sequence number that ends this round */
+  uint32_t last_rtt;      /* Minimum RTT of the last round (us) */
+  uint32_t cur_rtt;       /* Minimum RTT of this round so far (us) */
+#endif
+};
+#endif
 
 /* Representation of a TCP connection.
  *
@@ -208,6 +271,17 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  hash_node_t hnode;      /* Node in the active connection hashtable */
+  hash_node_t lnode;      /* Node in the listener hashtable */
+#endif
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+  dq_entry_t txnode;      /* Node in the pending TX queue of txdev */
+
+  /* The device whose pending TX queue holds txnode, or NULL */
+
+  FAR struct net_driver_s *txdev;
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -252,6 +326,18 @@ struct tcp_conn_s
   uint32_t cwnd;          /* The Congestion window */
   uint32_t max_cwnd;      /* The Congestion window maximum value */
   uint32_t ssthresh;      /* The Slow start threshold */
+
+  /* The congestion control algorithm and its state */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  struct tcp_cubic_s cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_RTT
+  struct tcp_cc_rtt_s rtt[TCP_CC_RTT_SAMPLES];
+  uint8_t  rtt_head;      /* The oldest segment sampled */
+  uint8_t  rtt_count;     /* The number of segments sampled */
+#endif
 #endif
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   uint32_t snd_wnd;       /* Sequence and acknowledgement numbers of last
@@ -451,8 +537,20 @@ struct tcp_callback_s
  ****************************************************************************/
 
 #ifdef __cplusplus
+#define EXTERN extern "C"
 extern "C"
 {
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* The congestion control algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
 #endif
 
 /****************************************************************************
@@ -939,6 +1037,78 @@ void tcp_nextsequence(void);
 
 void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Queue a TCP connection in the pending TX queue of its device, so that
+ *   the next TX poll of the device visits it.  Nothing is done if the
+ *   connection is already queued or is not bound to a device.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection with TX data, an ACK or a timer pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+void tcp_txpending(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_txpending(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_txpending_remove
+ *
+ * Description:
+ *   Remove a TCP connection from the pending TX queue that holds it, if
+ *   any.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+void tcp_txpending_remove(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_txpending_remove(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_txpending_flush
+ *
+ * Description:
+ *   Empty the pending TX queue of a network device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+void tcp_txpending_flush(FAR struct net_driver_s *dev);
+#else
+#  define tcp_txpending_flush(dev)
+#endif
+
 /****************************************************************************
  * Name: tcp_timer
  *
@@ -1579,6 +1749,30 @@ int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive on a TCP/IP SOCK_STREAM by detaching the whole read-ahead I/O
+ *   buffer chain and returning it to the caller, waiting for data first if
+ *   necessary.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   iob      Location to return the I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the returned chain.  On
+ *   error, -errno is returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_tcp_send
  *
@@ -1640,6 +1834,31 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len, int flags);
 
+/****************************************************************************
+ * Name: psock_tcp_sendiob
+ *
+ * Description:
+ *   Queue a caller-filled I/O buffer chain for transmission on a connected
+ *   TCP socket without copying it.  The chain is split at IOB boundaries
+ *   into write buffers of at most a few segments each.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iob      On entry, the chain to send.  On return, the part of the
+ *            chain that was not queued (NULL if all of it was).
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On error, a negated
+ *   errno value is returned (see psock_tcp_send()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_tcp_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: tcp_setsockopt
  *
@@ -1828,6 +2047,29 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void);
  ****************************************************************************/
 
 FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void);
+
+/****************************************************************************
+ * Name: tcp_wrbuffer_timedattach
+ *
+ * Description:
+ *   Allocate a TCP write buffer like tcp_wrbuffer_timedalloc(), but
+ *   attach the caller's I/O buffer chain to it instead of allocating the
+ *   first IOB.  No IOB is allocated, so this cannot wait for IOBs held by
+ *   the caller.
+ *
+ * Input Parameters:
+ *   iob       - The I/O buffer chain holding the data to send
+ *   timeout   - The relative time to wait until a timeout is declared.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+FAR struct tcp_wrbuffer_s *tcp_wrbuffer_timedattach(FAR struct iob_s *iob,
+                                                    unsigned int timeout);
+#endif
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
 /****************************************************************************
@@ -2308,8 +2550,93 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
  ****************************************************************************/
 
 void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables on a retransmission time-out,
+ *   restarting from slow start.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Note that new data up to (but not including) sequence number 'seq' was
+ *   sent, to sample the RTT when it is acknowledged.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   seq    - The sequence number that follows the data sent
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_RTT
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seq);
+#else
+#  define tcp_cc_sent(conn, seq)
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_setops
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, not necessarily NUL-terminated
+ *   len    - The length of the name
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no such algorithm.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_setops(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len);
+
+/****************************************************************************
+ * Name: tcp_cc_getops
+ *
+ * Description:
+ *   Return the congestion control algorithm of a connection, or the
+ *   default one if it is not connected yet.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   The algorithm.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cc_getops(FAR struct tcp_conn_s *conn);
 #endif
 
+#undef EXTERN
 #ifdef __cplusplus
 }
 #endif
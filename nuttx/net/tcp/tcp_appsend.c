@@ -216,6 +216,15 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
       DEBUGASSERT(dev->d_sndlen <= conn->mss);
 
+      /* More data may be left behind in the write queue, so have the next
+       * TX poll of the device visit the connection again.
+       */
+
+      if (dev->d_sndlen > 0)
+        {
+          tcp_txpending(conn);
+        }
+
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || defined(CONFIG_NET_SENDFILE)
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -253,7 +253,8 @@ int tcp_ofoseg_bufsize(FAR struct tcp_conn_s *conn)
  *   Inform the application holding the TCP socket of a change in state.
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   This function must be called with the network locked.  It takes the
+ *   connection lock around the handlers.
  *
  ****************************************************************************/
 
@@ -279,6 +280,13 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
 
   ninfo("flags: %04x\n", flags);
 
+  /* The handlers work on the read-ahead and write queues of the
+   * connection, which send() and recv() access under the connection lock
+   * only.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* Perform the data callback.  When a data callback is executed from
    * 'list', the input flags are normally returned, however, the
    * implementation may set one of the following:
@@ -343,6 +351,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
     }
 #endif
 
+  conn_unlock(&conn->sconn);
+
   /* Re-prepare the device buffer if d_iob is consumed by the stack */
 
   if (dev->d_iob == NULL)
@@ -24,7 +24,13 @@
  * Included Files
  ****************************************************************************/
 
+#include <sys/param.h>
+
 #include <debug.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
 
 #include "tcp/tcp.h"
 
@@ -74,10 +80,154 @@
     } \
  } while(0)
 
+/* The algorithm of the connections on which TCP_CONGESTION is not set */
+
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#  define CC_DEFAULT_OPS (&g_tcp_cc_cubic)
+#else
+#  define CC_DEFAULT_OPS (&g_tcp_cc_newreno)
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",                  /* name */
+  NULL,                       /* init */
+  tcp_newreno_ssthresh,       /* ssthresh */
+  tcp_newreno_cong_avoid,     /* cong_avoid */
+  NULL                        /* rtt_sample */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The algorithms that TCP_CONGESTION can select */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algos[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   cong avoid (RFC 5681):
+ *   Grow cwnd linearly by approximately maxseg per RTT using
+ *   maxseg^2 / cwnd per ACK as the increment.
+ *   If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
+ *   avoid capping cwnd.
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked)
+{
+  uint32_t increase;
+
+  increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+
+  CC_CWND_INC(conn->cwnd, increase);
+  conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
+}
+
+#ifdef CONFIG_NET_TCP_CC_RTT
+/****************************************************************************
+ * Name: tcp_cc_rtt_now
+ *
+ * Description:
+ *   Return the time to sample the RTT with, in microseconds.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cc_rtt_now(void)
+{
+  struct timespec ts;
+
+  clock_systime_timespec(&ts);
+  return (uint32_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rtt_ack
+ *
+ * Description:
+ *   Pass the RTT of the last of the sampled segments that 'ackno'
+ *   acknowledges to the algorithm.
+ *
+ ****************************************************************************/
+
+static void tcp_cc_rtt_ack(FAR struct tcp_conn_s *conn, uint32_t ackno)
+{
+  uint32_t sent = 0;
+  bool sampled = false;
+
+  while (conn->rtt_count > 0 &&
+         TCP_SEQ_LTE(conn->rtt[conn->rtt_head].seq, ackno))
+    {
+      sent    = conn->rtt[conn->rtt_head].time;
+      sampled = true;
+
+      conn->rtt_head = (conn->rtt_head + 1) % TCP_CC_RTT_SAMPLES;
+      conn->rtt_count--;
+    }
+
+  if (sampled)
+    {
+      conn->cc_ops->rtt_sample(conn, tcp_cc_rtt_now() - sent);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rtt_reset
+ *
+ * Description:
+ *   Drop the segments sampled on a retransmission: their ACK may be the
+ *   one of a retransmitted segment (Karn's algorithm).
+ *
+ ****************************************************************************/
+
+static inline void tcp_cc_rtt_reset(FAR struct tcp_conn_s *conn)
+{
+  conn->rtt_count = 0;
+}
+#else
+#  define tcp_cc_rtt_ack(conn, ackno)
+#  define tcp_cc_rtt_reset(conn)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -117,6 +267,19 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
   conn->ssthresh = 2 * TCP_IPV4_DEFAULT_MSS;
   conn->dupacks = 0;
+
+  /* Keep the algorithm selected with TCP_CONGESTION, if any */
+
+  if (conn->cc_ops == NULL)
+    {
+      conn->cc_ops = CC_DEFAULT_OPS;
+    }
+
+  tcp_cc_rtt_reset(conn);
+  if (conn->cc_ops->init != NULL)
+    {
+      conn->cc_ops->init(conn);
+    }
 }
 
 /****************************************************************************
@@ -140,19 +303,20 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
 void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 {
-  /* After Fast retransmitted, set ssthresh to the maximum of
-   * the unacked and the 2*SMSS, and enter to Fast Recovery.
-   * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+  /* After Fast retransmitted, set ssthresh as the algorithm decides (for
+   * NewReno the maximum of the unacked and the 2*SMSS), and enter to Fast
+   * Recovery.
    * cwnd=ssthresh + 3*SMSS  referring to rfc5681
    */
 
   if (conn->flags & TCP_INFT)
     {
-      conn->ssthresh = MAX(conn->tx_unacked / 2, 2 * conn->mss);
+      conn->ssthresh = conn->cc_ops->ssthresh(conn);
       conn->cwnd = conn->ssthresh + 3 * conn->mss;
 
       conn->flags &= ~TCP_INFT;
       conn->flags |= TCP_INFR;
+      tcp_cc_rtt_reset(conn);
     }
 
   /* Update the cc parameters in the TCP_SYN_RCVD and TCP_SYN_SENT states
@@ -243,6 +407,12 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
       conn->dupacks = 0;
       conn->last_ackno = ackno;
 
+      /* Sample the RTT before the algorithm grows cwnd, so that it can
+       * leave slow start on this ACK.
+       */
+
+      tcp_cc_rtt_ack(conn, ackno);
+
       /* When the ackno covers more than the fr_recover, exit the
        * fast recovery. Then, reset the "IN Fast Recovery" flags.
        * Also reset the congestion window to the slow start threshold.
@@ -284,19 +454,168 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
             }
           else
             {
-              /* cong avoid (RFC 5681):
-               * Grow cwnd linearly by approximately maxseg per RTT using
-               * maxseg^2 / cwnd per ACK as the increment.
-               * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
-               * avoid capping cwnd.
-               */
+              conn->cc_ops->cong_avoid(conn, acked);
+              ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables on a retransmission time-out,
+ *   restarting from slow start.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-              increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* If conn is TCP_INFR, it should enter to slow start */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
-              ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+  if (conn->flags & TCP_INFR)
+    {
+      conn->flags &= ~TCP_INFR;
+    }
+
+  /* update the max_cwnd */
+
+  conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
+
+  /* reset cwnd and ssthresh, refers to RFC5861. */
+
+  conn->ssthresh = conn->cc_ops->ssthresh(conn);
+  conn->cwnd = conn->mss;
+  tcp_cc_rtt_reset(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Note that new data up to (but not including) sequence number 'seq' was
+ *   sent, to sample the RTT when it is acknowledged.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   seq    - The sequence number that follows the data sent
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_RTT
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seq)
+{
+  int i;
+
+  /* A segment is not sampled while all slots are in use, the ACK of an
+   * earlier one samples about the same RTT.
+   */
+
+  if (conn->cc_ops == NULL || conn->cc_ops->rtt_sample == NULL ||
+      conn->rtt_count >= TCP_CC_RTT_SAMPLES)
+    {
+      return;
+    }
+
+  i = (conn->rtt_head + conn->rtt_count) % TCP_CC_RTT_SAMPLES;
+  conn->rtt[i].seq  = seq;
+  conn->rtt[i].time = tcp_cc_rtt_now();
+  conn->rtt_count++;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_setops
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, not necessarily NUL-terminated
+ *   len    - The length of the name
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no such algorithm.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_setops(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  unsigned int i;
+
+  len = strnlen(name, len);
+  for (i = 0; i < nitems(g_tcp_cc_algos); i++)
+    {
+      ops = g_tcp_cc_algos[i];
+      if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0)
+        {
+          break;
+        }
+    }
+
+  if (i >= nitems(g_tcp_cc_algos))
+    {
+      return -ENOENT;
+    }
+
+  /* The new algorithm starts from the current cwnd and ssthresh.  Before
+   * the connection, tcp_cc_init() will initialize it.
+   */
+
+  if (conn->cc_ops != ops)
+    {
+      conn->cc_ops = ops;
+      if (conn->tcpstateflags != TCP_ALLOCATED)
+        {
+          tcp_cc_rtt_reset(conn);
+          if (ops->init != NULL)
+            {
+              ops->init(conn);
             }
         }
     }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_getops
+ *
+ * Description:
+ *   Return the congestion control algorithm of a connection, or the
+ *   default one if it is not connected yet.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   The algorithm.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cc_getops(FAR struct tcp_conn_s *conn)
+{
+  return conn->cc_ops != NULL ? conn->cc_ops : CC_DEFAULT_OPS;
 }
@@ -0,0 +1,372 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC9438: C = 0.4 and beta = 0.7.  In congestion
+ * avoidance the Reno-friendly estimate grows by
+ * alpha = 3 * (1 - beta) / (1 + beta) = 0.529 segments per RTT.
+ */
+
+#define CUBIC_BETA_NUM        7
+#define CUBIC_BETA_DEN        10
+#define CUBIC_ALPHA_NUM       529
+#define CUBIC_ALPHA_DEN       1000
+
+/* Fast convergence releases bandwidth by reducing w_max further, to
+ * cwnd * (1 + beta) / 2.
+ */
+
+#define CUBIC_FC_NUM          17
+#define CUBIC_FC_DEN          20
+
+/* The time from K is clamped to keep its cube in 64 bits (about 17
+ * minutes, in ms).
+ */
+
+#define CUBIC_MAX_DELTA       (1 << 20)
+
+/* The window grows to at most 1.5 * cwnd in an RTT (RFC9438 4.2) */
+
+#define CUBIC_MAX_TARGET(cwnd) ((cwnd) + (cwnd) / 2)
+
+/* HyStart (RFC9406): the RTT samples of a round, the bounds of the RTT
+ * increase that ends slow start and the smallest window it applies to.
+ */
+
+#define HYSTART_MIN_SAMPLES   8
+#define HYSTART_MIN_ETA       4000   /* us */
+#define HYSTART_MAX_ETA       16000  /* us */
+#define HYSTART_LOW_WINDOW    16     /* segments */
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked);
+static void tcp_cubic_rtt_sample(FAR struct tcp_conn_s *conn,
+                                 uint32_t rtt);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                    /* name */
+  tcp_cubic_init,             /* init */
+  tcp_cubic_ssthresh,         /* ssthresh */
+  tcp_cubic_cong_avoid,       /* cong_avoid */
+  tcp_cubic_rtt_sample        /* rtt_sample */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_now
+ *
+ * Description:
+ *   Return the time of the epochs, in milliseconds.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_cubic_now(void)
+{
+  return (uint32_t)TICK2MSEC(clock_systime_ticks());
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of a 64-bit value, one bit at a time.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_epoch
+ *
+ * Description:
+ *   Start a congestion avoidance epoch.  The window grows back to w_max in
+ *   K = cbrt(w_max * (1 - beta) / C) seconds, with the windows counted in
+ *   segments.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_epoch(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+
+  ca->epoch    = tcp_cubic_now();
+  ca->in_epoch = true;
+  ca->w_est    = conn->cwnd;
+
+  if (ca->w_max > conn->cwnd)
+    {
+      /* K in ms = cbrt((w_max - cwnd) / mss / 0.4 * 10^9) */
+
+      ca->k = tcp_cubic_cbrt((uint64_t)(ca->w_max - conn->cwnd) *
+                             2500000000ull / conn->mss);
+    }
+  else
+    {
+      /* Above the last maximum: probe for bandwidth right away */
+
+      ca->w_max = conn->cwnd;
+      ca->k     = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_window
+ *
+ * Description:
+ *   Return W_cubic(t) = C * (t - K)^3 + w_max in bytes, for the time t from
+ *   the epoch in ms.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_window(FAR struct tcp_conn_s *conn, uint32_t t)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+  int64_t delta = (int64_t)t - ca->k;
+  int64_t w;
+
+  delta = MIN(MAX(delta, -CUBIC_MAX_DELTA), CUBIC_MAX_DELTA);
+
+  /* 0.4 * (delta / 1000)^3 segments of mss bytes */
+
+  w = delta * delta * delta / 1000000 * 2 * conn->mss / 5000 + ca->w_max;
+  return (uint32_t)MIN(MAX(w, 0), UINT32_MAX);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+
+  ca->in_epoch  = false;
+  ca->w_max     = 0;
+  ca->min_rtt   = 0;
+#ifdef CONFIG_NET_TCP_CC_HYSTART
+  ca->ss_exited = false;
+  ca->nsamples  = 0;
+  ca->round_end = tcp_getsequence(conn->sndseq);
+  ca->last_rtt  = UINT32_MAX;
+  ca->cur_rtt   = UINT32_MAX;
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Reduce the window by beta on a loss and remember it as w_max, lower if
+ *   it did not reach the last one (fast convergence).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+
+  if (cwnd < ca->w_max)
+    {
+      ca->w_max = (uint32_t)((uint64_t)cwnd * CUBIC_FC_NUM / CUBIC_FC_DEN);
+    }
+  else
+    {
+      ca->w_max = cwnd;
+    }
+
+  ca->in_epoch = false;
+  return MAX((uint32_t)((uint64_t)cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN),
+             2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd towards W_cubic one RTT ahead, or to the Reno-friendly
+ *   estimate when that one is larger (RFC9438 4.2, 4.3).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t acked)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t target;
+  uint32_t wcubic;
+  uint32_t t;
+
+  /* Do not grow a window that the receiver does not let us use */
+
+  if (cwnd >= conn->snd_wnd)
+    {
+      return;
+    }
+
+  if (!ca->in_epoch)
+    {
+      tcp_cubic_epoch(conn);
+    }
+
+  t      = tcp_cubic_now() - ca->epoch;
+  wcubic = tcp_cubic_window(conn, t);
+  target = tcp_cubic_window(conn, t + ca->min_rtt / USEC_PER_MSEC);
+  target = MIN(MAX(target, cwnd), CUBIC_MAX_TARGET(cwnd));
+
+  /* The window that NewReno would have reached in the epoch */
+
+  ca->w_est += (uint32_t)((uint64_t)acked * conn->mss * CUBIC_ALPHA_NUM /
+                          ((uint64_t)cwnd * CUBIC_ALPHA_DEN));
+
+  if (wcubic < ca->w_est)
+    {
+      /* Reno-friendly region */
+
+      conn->cwnd = MAX(cwnd, ca->w_est);
+    }
+  else if (target > cwnd)
+    {
+      /* Concave or convex region: (target - cwnd) / cwnd per segment */
+
+      conn->cwnd += MAX((uint32_t)((uint64_t)(target - cwnd) * acked /
+                                   cwnd), 1);
+    }
+
+  conn->cwnd = MIN(conn->cwnd, conn->snd_wnd);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_rtt_sample
+ *
+ * Description:
+ *   Track the minimum RTT and, in slow start, leave slow start when the
+ *   minimum RTT of this round exceeds the one of the last round by eta:
+ *   the queue of the bottleneck is building up (RFC9406).  Unlike RFC9406
+ *   this goes to congestion avoidance directly, without a conservative
+ *   slow start phase.
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  FAR struct tcp_cubic_s *ca = &conn->cubic;
+#ifdef CONFIG_NET_TCP_CC_HYSTART
+  uint32_t eta;
+#endif
+
+  if (ca->min_rtt == 0 || rtt < ca->min_rtt)
+    {
+      ca->min_rtt = MAX(rtt, 1);
+    }
+
+#ifdef CONFIG_NET_TCP_CC_HYSTART
+  if (ca->ss_exited || conn->cwnd >= conn->ssthresh)
+    {
+      return;
+    }
+
+  /* A round ends when the data sent at its start is acknowledged */
+
+  if (TCP_SEQ_GTE(conn->last_ackno, ca->round_end))
+    {
+      ca->round_end = tcp_getsequence(conn->sndseq);
+      ca->last_rtt  = ca->cur_rtt;
+      ca->cur_rtt   = UINT32_MAX;
+      ca->nsamples  = 0;
+    }
+
+  ca->cur_rtt = MIN(ca->cur_rtt, rtt);
+  if (ca->nsamples < HYSTART_MIN_SAMPLES)
+    {
+      ca->nsamples++;
+    }
+
+  if (ca->nsamples < HYSTART_MIN_SAMPLES || ca->last_rtt == UINT32_MAX ||
+      conn->cwnd < HYSTART_LOW_WINDOW * conn->mss)
+    {
+      return;
+    }
+
+  eta = MIN(MAX(ca->last_rtt / 8, HYSTART_MIN_ETA), HYSTART_MAX_ETA);
+  if (ca->cur_rtt >= ca->last_rtt + eta)
+    {
+      ninfo("HyStart: exit slow start at cwnd %" PRIu32 " rtt %" PRIu32
+            "/%" PRIu32 "\n", conn->cwnd, ca->cur_rtt, ca->last_rtt);
+
+      conn->ssthresh = conn->cwnd;
+      ca->ss_exited  = true;
+    }
+#endif
+}
@@ -95,6 +95,12 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The same connections, hashed by remote address and port pair */
+
+static DECLARE_HASHTABLE(g_tcp_conn_hash, CONFIG_NET_TCP_CONN_HASH_BITS);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -174,6 +180,182 @@ static FAR struct tcp_conn_s *
   return NULL;
 }
 
+/****************************************************************************
+ * Name: tcp_ipv4_key
+ *
+ * Description:
+ *   Create the hash key of an IPv4 connection from its remote address and
+ *   port pair (all in network byte order).  The local address is not part
+ *   of the key because a connection may be bound to INADDR_ANY.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_CONN_HASH) && defined(CONFIG_NET_IPv4)
+static inline uint32_t tcp_ipv4_key(in_addr_t raddr, uint16_t lport,
+                                    uint16_t rport)
+{
+  return NTOHL(raddr) ^ ((uint32_t)lport << 16) ^ rport;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_ipv6_key
+ *
+ * Description:
+ *   Create the hash key of an IPv6 connection from its remote address and
+ *   port pair (all in network byte order).
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_CONN_HASH) && defined(CONFIG_NET_IPv6)
+static inline uint32_t tcp_ipv6_key(FAR const uint16_t *raddr,
+                                    uint16_t lport, uint16_t rport)
+{
+  uint32_t key = ((uint32_t)lport << 16) ^ rport;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= ((uint32_t)raddr[i] << 16) | raddr[i + 1];
+    }
+
+  return key;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_key
+ *
+ * Description:
+ *   Return the hash key of an active connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+static uint32_t tcp_conn_key(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_ipv4_key(conn->u.ipv4.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_ipv6_key(conn->u.ipv6.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+/****************************************************************************
+ * Name: tcp_active_add
+ *
+ * Description:
+ *   Add a connection to the list of active connections (and to the
+ *   connection hashtable, if enabled).  The remote address and both ports
+ *   must already be set up.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_active_add(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  hashtable_add(g_tcp_conn_hash, &conn->hnode, tcp_conn_key(conn));
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_active_remove
+ *
+ * Description:
+ *   Remove a connection from the list of active connections.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_active_remove(FAR struct tcp_conn_s *conn)
+{
+  dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  hashtable_delete(g_tcp_conn_hash, &conn->hnode, tcp_conn_key(conn));
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_ipv4_match
+ *
+ * Description:
+ *   Return true if the connection is the one to be used with the provided
+ *   IPv4 addresses and TCP header.  The following checks are performed:
+ *
+ *   - The local port number is checked against the destination port
+ *     number in the received packet.
+ *   - The remote port number is checked if the connection is bound
+ *     to a remote port.
+ *   - Insist that the destination IP matches the bound address. If
+ *     a socket is bound to INADDRY_ANY, then it should receive all
+ *     packets directed to the port.
+ *   - Finally, if the connection is bound to a remote IP address,
+ *     the source IP address of the packet is checked.
+ *
+ *   If all of the above are true then the newly received TCP packet
+ *   is destined for this TCP connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static inline bool tcp_ipv4_match(FAR struct tcp_conn_s *conn,
+                                  FAR struct tcp_hdr_s *tcp,
+                                  in_addr_t srcipaddr, in_addr_t destipaddr)
+{
+  return conn->tcpstateflags != TCP_CLOSED &&
+         tcp->destport == conn->lport &&
+         tcp->srcport  == conn->rport &&
+         (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
+          net_ipv4addr_cmp(destipaddr, conn->u.ipv4.laddr)) &&
+         net_ipv4addr_cmp(srcipaddr, conn->u.ipv4.raddr);
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: tcp_ipv6_match
+ *
+ * Description:
+ *   Return true if the connection is the one to be used with the provided
+ *   IPv6 addresses and TCP header.  The checks are the same as for IPv4,
+ *   except that a socket bound to the IPv6 unspecified address receives
+ *   all packets directed to the port.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static inline bool tcp_ipv6_match(FAR struct tcp_conn_s *conn,
+                                  FAR struct tcp_hdr_s *tcp,
+                                  FAR net_ipv6addr_t *srcipaddr,
+                                  FAR net_ipv6addr_t *destipaddr)
+{
+  return conn->tcpstateflags != TCP_CLOSED &&
+         tcp->destport == conn->lport &&
+         tcp->srcport  == conn->rport &&
+         (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
+          net_ipv6addr_cmp(*destipaddr, conn->u.ipv6.laddr)) &&
+         net_ipv6addr_cmp(*srcipaddr, conn->u.ipv6.raddr);
+}
+#endif /* CONFIG_NET_IPv6 */
+
 /****************************************************************************
  * Name: tcp_ipv4_active
  *
@@ -194,36 +376,37 @@ static inline FAR struct tcp_conn_s *
   FAR struct tcp_conn_s *conn;
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR hash_node_t *node;
+#endif
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  /* Only the connections sharing the hash bucket of the packet's remote
+   * address and port pair need to be examined.
+   */
+
+  hashtable_for_every_possible(g_tcp_conn_hash, node,
+                               tcp_ipv4_key(srcipaddr, tcp->destport,
+                                            tcp->srcport))
+    {
+      conn = container_of(node, struct tcp_conn_s, hnode);
+      if (tcp_ipv4_match(conn, tcp, srcipaddr, destipaddr))
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   while (conn)
     {
-      /* Find an open connection matching the TCP input. The following
-       * checks are performed:
-       *
-       * - The local port number is checked against the destination port
-       *   number in the received packet.
-       * - The remote port number is checked if the connection is bound
-       *   to a remote port.
-       * - Insist that the destination IP matches the bound address. If
-       *   a socket is bound to INADDRY_ANY, then it should receive all
-       *   packets directed to the port.
-       * - Finally, if the connection is bound to a remote IP address,
-       *   the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received TCP packet
-       * is destined for this TCP connection.
-       */
+      /* Find an open connection matching the TCP input */
 
-      if (conn->tcpstateflags != TCP_CLOSED &&
-          tcp->destport == conn->lport &&
-          tcp->srcport  == conn->rport &&
-          (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_cmp(destipaddr, conn->u.ipv4.laddr)) &&
-          net_ipv4addr_cmp(srcipaddr, conn->u.ipv4.raddr))
+      if (tcp_ipv4_match(conn, tcp, srcipaddr, destipaddr))
         {
           /* Matching connection found.. break out of the loop and return a
            * reference to it.
@@ -238,6 +421,7 @@ static inline FAR struct tcp_conn_s *
     }
 
   return conn;
+#endif /* CONFIG_NET_TCP_CONN_HASH */
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -261,36 +445,33 @@ static inline FAR struct tcp_conn_s *
   FAR struct tcp_conn_s *conn;
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR hash_node_t *node;
+#endif
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  hashtable_for_every_possible(g_tcp_conn_hash, node,
+                               tcp_ipv6_key(*srcipaddr, tcp->destport,
+                                            tcp->srcport))
+    {
+      conn = container_of(node, struct tcp_conn_s, hnode);
+      if (tcp_ipv6_match(conn, tcp, srcipaddr, destipaddr))
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   while (conn)
     {
-      /* Find an open connection matching the TCP input. The following
-       * checks are performed:
-       *
-       * - The local port number is checked against the destination port
-       *   number in the received packet.
-       * - The remote port number is checked if the connection is bound
-       *   to a remote port.
-       * - Insist that the destination IP matches the bound address. If
-       *   a socket is bound to the IPv6 unspecified address, then it
-       *   should receive all packets directed to the port.
-       * - Finally, if the connection is bound to a remote IP address,
-       *   the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received TCP packet
-       * is destined for this TCP connection.
-       */
+      /* Find an open connection matching the TCP input */
 
-      if (conn->tcpstateflags != TCP_CLOSED &&
-          tcp->destport == conn->lport &&
-          tcp->srcport  == conn->rport &&
-          (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_cmp(*destipaddr, conn->u.ipv6.laddr)) &&
-          net_ipv6addr_cmp(*srcipaddr, conn->u.ipv6.raddr))
+      if (tcp_ipv6_match(conn, tcp, srcipaddr, destipaddr))
         {
           /* Matching connection found.. break out of the loop and return a
            * reference to it.
@@ -305,6 +486,7 @@ static inline FAR struct tcp_conn_s *
     }
 
   return conn;
+#endif /* CONFIG_NET_TCP_CONN_HASH */
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -721,6 +903,7 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       memset(conn, 0, sizeof(struct tcp_conn_s));
       conn->sconn.s_ttl   = IP_TTL_DEFAULT;
       conn->tcpstateflags = TCP_ALLOCATED;
+      nxrmutex_init(&conn->sconn.s_lock);
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
 #endif
@@ -774,6 +957,10 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
 void tcp_free_rx_buffers(FAR struct tcp_conn_s *conn)
 {
+  /* recv() consumes the read-ahead buffers under the connection lock */
+
+  conn_lock(&conn->sconn);
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_chain(conn->readahead);
@@ -794,6 +981,8 @@ void tcp_free_rx_buffers(FAR struct tcp_conn_s *conn)
       conn->nofosegs = 0;
     }
 #endif /* CONFIG_NET_TCP_OUT_OF_ORDER */
+
+  conn_unlock(&conn->sconn);
 }
 
 /****************************************************************************
@@ -837,6 +1026,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   tcp_stop_timer(conn);
 
+  /* Leave the pending TX queue of the device */
+
+  tcp_txpending_remove(conn);
+
   /* Make sure monitor is stopped. */
 
   tcp_stop_monitor(conn, TCP_CLOSE);
@@ -859,14 +1052,17 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_active_remove(conn);
     }
 
   tcp_free_rx_buffers(conn);
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
-  /* Release any write buffers attached to the connection */
+  /* Release any write buffers attached to the connection.  send() queues
+   * them under the connection lock.
+   */
 
+  conn_lock(&conn->sconn);
   while ((wrbuffer = (struct tcp_wrbuffer_s *)
                      sq_remfirst(&conn->write_q)) != NULL)
     {
@@ -879,6 +1075,8 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       tcp_wrbuffer_release(wrbuffer);
     }
 
+  conn_unlock(&conn->sconn);
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
 
@@ -911,6 +1109,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   /* Free the connection structure */
 
+  nxrmutex_destroy(&conn->sconn.s_lock);
   NET_BUFPOOL_FREE(g_tcp_connections, conn);
 
   net_unlock();
@@ -1106,6 +1305,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->snd_bufs         = listener->snd_bufs;
 #endif
       conn->mss              = listener->mss;
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      conn->cc_ops           = listener->cc_ops;
+#endif
 
       /* Fill in the necessary fields for the new connection. */
 
@@ -1156,7 +1358,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_active_add(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1467,7 +1669,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_active_add(conn);
   ret = OK;
 
 errout_with_lock:
@@ -116,6 +116,7 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
        * setup may not actually be used.
        */
 
+      conn_lock(&conn->sconn);
       tcp_ip_select(conn);
 
       /* Perform the callback */
@@ -125,7 +126,95 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
       /* Handle the callback response */
 
       tcp_appsend(dev, conn, result);
+      conn_unlock(&conn->sconn);
     }
 }
 
+#ifdef CONFIG_NET_TCP_POLL_PENDING
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Queue a TCP connection in the pending TX queue of its device, so that
+ *   the next TX poll of the device visits it.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection with TX data, an ACK or a timer pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_txpending(FAR struct tcp_conn_s *conn)
+{
+  FAR struct net_driver_s *dev = conn->dev;
+
+  if (conn->txdev == NULL && dev != NULL)
+    {
+      dq_addlast(&conn->txnode, &dev->d_tcppending);
+      conn->txdev = dev;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_txpending_remove
+ *
+ * Description:
+ *   Remove a TCP connection from the pending TX queue that holds it, if
+ *   any.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_txpending_remove(FAR struct tcp_conn_s *conn)
+{
+  if (conn->txdev != NULL)
+    {
+      dq_rem(&conn->txnode, &conn->txdev->d_tcppending);
+      conn->txdev = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_txpending_flush
+ *
+ * Description:
+ *   Empty the pending TX queue of a network device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_txpending_flush(FAR struct net_driver_s *dev)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+
+  while ((entry = dq_remfirst(&dev->d_tcppending)) != NULL)
+    {
+      conn = container_of(entry, struct tcp_conn_s, txnode);
+      conn->txdev = NULL;
+    }
+}
+#endif /* CONFIG_NET_TCP_POLL_PENDING */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
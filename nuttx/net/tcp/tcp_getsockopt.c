@@ -29,6 +29,7 @@
 #include <sys/time.h>
 #include <stdint.h>
 #include <errno.h>
+#include <string.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -239,6 +240,26 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      case TCP_CONGESTION: /* The congestion control algorithm */
+        {
+          FAR const char *name = tcp_cc_getops(conn)->name;
+          socklen_t len = strlen(name) + 1;
+
+          /* The name is truncated to the buffer, like on Linux */
+
+          if (len > *value_len)
+            {
+              len = *value_len;
+            }
+
+          memcpy(value, name, len);
+          *value_len = len;
+          ret        = OK;
+        }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
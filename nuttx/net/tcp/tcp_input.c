@@ -699,6 +699,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
+  bool     locked = false;
   int      len;
 
 #ifdef CONFIG_NET_STATISTICS
@@ -724,9 +725,11 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   tcpiplen = iplen + TCP_HDRLEN;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code, unless the device has
+   * verified the checksum already.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_CSUM_VERIFIED(dev) && tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -891,6 +894,14 @@ reset:
   return;
 
 found:
+  /* Hold the connection lock while the segment is processed, it also
+   * covers the sequence numbers and the out-of-order segments that recv()
+   * looks at without the network lock.
+   */
+
+  conn_lock(&conn->sconn);
+  locked = true;
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -917,6 +928,8 @@ found:
 
           DEBUGASSERT(conn->crefs == 1);
           conn->crefs = 0;
+          conn_unlock(&conn->sconn);
+          locked = false;
           tcp_free(conn);
         }
       else
@@ -983,7 +996,7 @@ found:
                 dev->d_len);
 
           dev->d_len = 0;
-          return;
+          goto done;
         }
     }
 #endif
@@ -1158,7 +1171,7 @@ found:
 
           tcp_update_retrantimer(conn, 1);
 
-          return;
+          goto done;
         }
 
       if (seq != rcvseq)
@@ -1177,7 +1190,7 @@ found:
                    */
 
                   tcp_send(dev, conn, TCP_ACK, tcpiplen);
-                  return;
+                  goto done;
                 }
             }
           else if ((conn->tcpstateflags & TCP_STATE_MASK) <= TCP_ESTABLISHED)
@@ -1190,7 +1203,7 @@ found:
               if ((conn->tcpstateflags & TCP_STATE_MASK) <= TCP_ESTABLISHED)
                 {
                   tcp_send(dev, conn, TCP_ACK, tcpiplen);
-                  return;
+                  goto done;
                 }
             }
         }
@@ -1256,6 +1269,8 @@ found:
                 /* Free the connection structure */
 
                 conn->crefs = 0;
+                conn_unlock(&conn->sconn);
+                locked = false;
                 tcp_free(conn);
                 conn = NULL;
 
@@ -1288,7 +1303,7 @@ found:
             dev->d_sndlen       = 0;
             result              = tcp_callback(dev, conn, flags);
             tcp_appsend(dev, conn, result);
-            return;
+            goto done;
           }
 
         /* We need to retransmit the SYNACK */
@@ -1301,7 +1316,7 @@ found:
             /* REVISIT for the buffered mode */
 #endif
             tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
-            return;
+            goto done;
           }
 
         goto drop;
@@ -1342,7 +1357,7 @@ found:
             ninfo("TCP state: TCP_ESTABLISHED\n");
             result = tcp_callback(dev, conn, TCP_CONNECTED | TCP_NEWDATA);
             tcp_appsend(dev, conn, result);
-            return;
+            goto done;
           }
 
         /* Inform the application that the connection failed */
@@ -1362,7 +1377,7 @@ found:
           }
 
         tcp_reset(dev, conn);
-        return;
+        goto done;
 
       case TCP_ESTABLISHED:
         /* In the ESTABLISHED state, we call upon the application to feed
@@ -1424,7 +1439,7 @@ found:
                 tcp_appsend(dev, conn, result);
               }
 
-            return;
+            goto done;
           }
 
 #ifdef CONFIG_NET_TCPURGDATA
@@ -1550,7 +1565,7 @@ found:
             /* Send the response, ACKing the data or not, as appropriate */
 
             tcp_appsend(dev, conn, result);
-            return;
+            goto done;
           }
 
         goto drop;
@@ -1598,7 +1613,7 @@ found:
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
             tcp_send(dev, conn, TCP_ACK, tcpiplen);
-            return;
+            goto done;
           }
         else if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
           {
@@ -1624,7 +1639,7 @@ found:
 
             tcp_callback(dev, conn, TCP_CLOSE);
             tcp_reset(dev, conn);
-            return;
+            goto done;
           }
 
         goto drop;
@@ -1645,7 +1660,7 @@ found:
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
             tcp_send(dev, conn, TCP_ACK, tcpiplen);
-            return;
+            goto done;
           }
 
         if (dev->d_len > 0)
@@ -1663,14 +1678,14 @@ found:
 
             tcp_callback(dev, conn, TCP_CLOSE);
             tcp_reset(dev, conn);
-            return;
+            goto done;
           }
 
         goto drop;
 
       case TCP_TIME_WAIT:
         tcp_send(dev, conn, TCP_ACK, tcpiplen);
-        return;
+        goto done;
 
       case TCP_CLOSING:
         if ((flags & TCP_ACKDATA) != 0)
@@ -1687,6 +1702,12 @@ found:
 
 drop:
   dev->d_len = 0;
+
+done:
+  if (locked)
+    {
+      conn_unlock(&conn->sconn);
+    }
 }
 
 /****************************************************************************
@@ -121,7 +121,9 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd, unsigned long arg)
 {
   int ret = OK;
 
-  net_lock();
+  /* The queues of the connection are protected by its lock */
+
+  conn_lock(&conn->sconn);
 
   switch (cmd)
     {
@@ -156,7 +158,7 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd, unsigned long arg)
         break;
     }
 
-  net_unlock();
+  conn_unlock(&conn->sconn);
 
   return ret;
 }
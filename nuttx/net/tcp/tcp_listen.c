@@ -61,14 +61,85 @@
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The tcp_listenhash holds all currently listening connections, hashed by
+ * their local port number.
+ */
+
+static DECLARE_HASHTABLE(tcp_listenhash, CONFIG_NET_TCP_LISTEN_HASH_BITS);
+#else
 /* The tcp_listenports list all currently listening ports. */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_listener_next
+ *
+ * Description:
+ *   Return the next listener after 'conn' (the first one if 'conn' is
+ *   NULL) that listens on the local port 'portno'.  Only the bucket of the
+ *   port is searched if the listeners are hashed.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *tcp_listener_next(FAR struct tcp_conn_s *conn,
+                                                uint16_t portno)
+{
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR hash_node_t *node;
+
+  if (conn == NULL)
+    {
+      node = dq_peek(&tcp_listenhash[HASH(portno,
+                                  hashtable_bits(tcp_listenhash))]);
+    }
+  else
+    {
+      node = dq_next(&conn->lnode);
+    }
+
+  for (; node != NULL; node = dq_next(node))
+    {
+      conn = container_of(node, struct tcp_conn_s, lnode);
+      if (conn->lport == portno)
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#else
+  int ndx = 0;
+
+  /* Continue with the slot after the one of 'conn' */
+
+  if (conn != NULL)
+    {
+      while (ndx < CONFIG_NET_MAX_LISTENPORTS &&
+             tcp_listenports[ndx++] != conn);
+    }
+
+  for (; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      conn = tcp_listenports[ndx];
+      if (conn != NULL && conn->lport == portno)
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_findlistener
  *
@@ -89,21 +160,14 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
-  int ndx;
+  FAR struct tcp_conn_s *conn = NULL;
 
-  /* Examine each connection structure in each slot of the listener list */
+  /* Examine each listener on this port */
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  while ((conn = tcp_listener_next(conn, portno)) != NULL)
     {
-      /* Is this slot assigned?  If so, does the connection have the same
-       * local port number?
-       */
-
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
-#else
-      if (conn && conn->lport == portno)
+      if (conn->domain == domain)
 #endif
         {
 #ifdef CONFIG_NET_IPv6
@@ -160,10 +224,25 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR hash_node_t *node;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  hashtable_for_every_possible(tcp_listenhash, node, conn->lport)
+    {
+      if (node == &conn->lnode)
+        {
+          hashtable_delete(tcp_listenhash, &conn->lnode, conn->lport);
+          ret = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -173,6 +252,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -191,7 +271,9 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+#ifndef CONFIG_NET_TCP_CONN_HASH
   int ndx;
+#endif
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -218,6 +300,10 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
        * "listener" list.
        */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      hashtable_add(tcp_listenhash, &conn->lnode, conn->lport);
+      ret = OK;
+#else
       ret = -ENOBUFS; /* Assume failure */
 
       /* Search all slots until an available slot is found */
@@ -235,6 +321,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
@@ -288,6 +288,12 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
   fds->priv = info;
 
+  /* The read-ahead and write queues are changed by recv() and send() under
+   * the connection lock only.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* Check for read data or backlogged connection availability now */
 
   if (conn->readahead != NULL || tcp_backlogpending(conn))
@@ -357,6 +363,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
+  conn_unlock(&conn->sconn);
 
 errout_with_lock:
   net_unlock();
@@ -73,15 +73,23 @@ int tcp_readahead_notifier_setup(worker_t worker,
                                  FAR void *arg)
 {
   struct work_notifier_s info;
+  int ret;
 
   DEBUGASSERT(worker != NULL);
 
+  /* The check and the setup are atomic with respect to the signal,
+   * which is raised with the connection locked.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* If there is already buffered read-ahead data, then return zero without
    * setting up the notification.
    */
 
   if (conn->readahead != NULL)
     {
+      conn_unlock(&conn->sconn);
       return 0;
     }
 
@@ -93,7 +101,9 @@ int tcp_readahead_notifier_setup(worker_t worker,
   info.arg       = arg;
   info.worker    = worker;
 
-  return work_notifier_setup(&info);
+  ret = work_notifier_setup(&info);
+  conn_unlock(&conn->sconn);
+  return ret;
 }
 
 /****************************************************************************
@@ -129,15 +139,23 @@ int tcp_writebuffer_notifier_setup(worker_t worker,
 {
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   struct work_notifier_s info;
+  int ret;
 
   DEBUGASSERT(worker != NULL);
 
+  /* The check and the setup are atomic with respect to the signal,
+   * which is raised with the connection locked.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* If the write buffers are already empty, then return zero without
    * setting up the notification.
    */
 
   if (sq_empty(&conn->write_q) && sq_empty(&conn->unacked_q))
     {
+      conn_unlock(&conn->sconn);
       return 0;
     }
 
@@ -149,7 +167,9 @@ int tcp_writebuffer_notifier_setup(worker_t worker,
   info.arg       = arg;
   info.worker    = worker;
 
-  return work_notifier_setup(&info);
+  ret = work_notifier_setup(&info);
+  conn_unlock(&conn->sconn);
+  return ret;
 #else
   return 0;
 #endif
@@ -528,6 +528,70 @@ static uint16_t tcp_recvhandler(FAR struct net_driver_s *dev,
   return flags;
 }
 
+/****************************************************************************
+ * Name: tcp_recviob_eventhandler
+ *
+ * Description:
+ *   This function is called with the network locked to perform the actual
+ *   TCP receive operation for psock_tcp_recviob().  Unlike
+ *   tcp_recvhandler(), the new data is not consumed here:  TCP_NEWDATA is
+ *   left set so that tcp_callback() queues the received IOBs in the
+ *   read-ahead buffer, from where they are handed over to the caller.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver that generated the event.
+ *   pvpriv   An instance of struct tcp_recvfrom_s cast to void*
+ *   flags    Set of events describing why the callback was invoked
+ *
+ * Returned Value:
+ *   The unmodified event flags
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+static uint16_t tcp_recviob_eventhandler(FAR struct net_driver_s *dev,
+                                         FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct tcp_recvfrom_s *pstate = pvpriv;
+
+  ninfo("flags: %04x\n", flags);
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  if ((flags & TCP_NEWDATA) != 0)
+    {
+      pstate->ir_cb->flags = 0;
+      pstate->ir_cb->priv  = NULL;
+      pstate->ir_cb->event = NULL;
+
+      nxsem_post(&pstate->ir_sem);
+    }
+  else if ((flags & TCP_DISCONN_EVENTS) != 0)
+    {
+      FAR struct tcp_conn_s *conn = pstate->ir_conn;
+
+      nwarn("WARNING: Lost connection\n");
+
+      DEBUGASSERT(conn != NULL);
+      if (_SS_ISCONNECTED(conn->sconn.s_flags))
+        {
+          tcp_lost_connection(conn, pstate->ir_cb, flags);
+        }
+
+      pstate->ir_result = (flags & TCP_CLOSE) != 0 ? 0 : -ENOTCONN;
+      nxsem_post(&pstate->ir_sem);
+    }
+
+  return flags;
+}
+#endif /* CONFIG_NET_ZEROCOPY */
+
 /****************************************************************************
  * Name: tcp_recvfrom_initialize
  *
@@ -626,7 +690,7 @@ static ssize_t tcp_recvfrom_result(int result, struct tcp_recvfrom_s *pstate)
  *   None
  *
  * Assumptions:
- *   conn is not NULL.
+ *   conn is not NULL and locked.
  *
  ****************************************************************************/
 
@@ -638,6 +702,7 @@ static void tcp_notify_recvcpu(FAR struct tcp_conn_s *conn)
   if (cpu != conn->rcvcpu)
     {
       conn->rcvcpu = cpu;
+      conn_net_lock(&conn->sconn);
 
       if (conn->domain == PF_INET)
         {
@@ -651,12 +716,48 @@ static void tcp_notify_recvcpu(FAR struct tcp_conn_s *conn)
                                 &(conn->u.ipv6.laddr), conn->lport,
                                 &(conn->u.ipv6.raddr), conn->rport);
         }
+
+      net_unlock();
     }
 }
 #else
 #  define tcp_notify_recvcpu(c)
 #endif /* CONFIG_NETDEV_RSS */
 
+/****************************************************************************
+ * Name: tcp_notify_recvwindow
+ *
+ * Description:
+ *   Schedule a window update if consuming read-ahead data has opened the
+ *   receive window enough.
+ *
+ *   Revisit: Because IOBs are system-wide resources, consuming the read
+ *   ahead buffer would update recv window of all connections in the
+ *   system, not only this particular connection.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   conn is not NULL and locked.  The network lock is only taken when an
+ *   update is due.
+ *
+ ****************************************************************************/
+
+static void tcp_notify_recvwindow(FAR struct tcp_conn_s *conn)
+{
+  if (tcp_should_send_recvwindow(conn))
+    {
+      conn_net_lock(&conn->sconn);
+      tcp_txpending(conn);
+      netdev_txnotify_dev(conn->dev);
+      net_unlock();
+    }
+}
+
 /****************************************************************************
  * Name: tcp_recvfrom_one
  *
@@ -693,9 +794,25 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
 {
   struct tcp_recvfrom_s state;
   struct tcp_callback_s info;
+  bool nonblock;
+  bool netlocked = false;
   ssize_t ret;
 
-  /* Initialize the state structure.  This is done with the network
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+
+  /* Data already in the read-ahead buffer is copied under the connection
+   * lock only.  A receive that may have to wait needs the network lock for
+   * the callback and the wait, take it before anything is read.
+   */
+
+  if (!nonblock && (conn->readahead == NULL || (flags & MSG_WAITALL) != 0))
+    {
+      conn_net_lock(&conn->sconn);
+      netlocked = true;
+    }
+
+  /* Initialize the state structure.  This is done with the connection
    * locked because we don't want anything to happen until we are ready.
    */
 
@@ -749,8 +866,7 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
    * buffers.
    */
 
-  else if (_SS_ISNONBLOCK(conn->sconn.s_flags) ||
-          (flags & MSG_DONTWAIT) != 0)
+  else if (nonblock)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -788,6 +904,8 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
   if (((flags & MSG_WAITALL) != 0 || state.ir_recvlen == 0) &&
       state.ir_buflen > 0)
     {
+      DEBUGASSERT(netlocked);
+
       /* Set up the callback in the connection */
 
       state.ir_cb = tcp_callback_alloc(conn);
@@ -807,6 +925,17 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
           info.tc_sem  = &state.ir_sem;
           tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
 
+          /* The handler runs under the connection lock */
+
+          conn_unlock(&conn->sconn);
+
+#ifdef CONFIG_NET_BUSY_POLL
+          /* Poll the device for a while before going to sleep */
+
+          netdev_busypoll(conn->dev, conn->sconn.s_busypoll,
+                          &state.ir_sem);
+#endif
+
           /* Wait for either the receive to complete or for an
            * error/timeout to occur.  net_sem_timedwait will also
            * terminate if a signal is received.
@@ -815,6 +944,7 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
           ret = net_sem_timedwait(&state.ir_sem,
                               _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
           tls_cleanup_pop(tls_get_info(), 0);
+          conn_lock(&conn->sconn);
           if (ret == -ETIMEDOUT)
             {
               ret = -EAGAIN;
@@ -831,18 +961,16 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
         }
     }
 
-  /* Receive additional data from read-ahead buffer, send the ACK timely.
-   * Revisit: Because IOBs are system-wide resources, consuming the read
-   * ahead buffer would update recv window of all connections in the
-   * system, not only this particular connection.
-   */
+  /* Receive additional data from read-ahead buffer, send the ACK timely */
 
-  if (tcp_should_send_recvwindow(conn))
+  tcp_notify_recvwindow(conn);
+  tcp_notify_recvcpu(conn);
+
+  if (netlocked)
     {
-      netdev_txnotify_dev(conn->dev);
+      net_unlock();
     }
 
-  tcp_notify_recvcpu(conn);
   tcp_recvfrom_uninitialize(&state);
   return ret;
 }
@@ -880,9 +1008,9 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
   ssize_t                ret     = 0;
   int                    i;
 
-  net_lock();
-
   conn = psock->s_conn;
+  conn_lock(&conn->sconn);
+
   for (i = 0; i < msg->msg_iovlen; i++)
     {
       FAR void *buf = msg->msg_iov[i].iov_base;
@@ -909,8 +1037,135 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
         }
     }
 
-  net_unlock();
+  conn_unlock(&conn->sconn);
   return nrecv ? nrecv : ret;
 }
 
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive the data queued on a TCP/IP SOCK_STREAM socket without copying
+ *   it:  the read-ahead I/O buffer chain is detached from the connection
+ *   and handed over to the caller.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   iob      Location to return the received I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes received (zero if the peer
+ *   has closed the connection).  On error, -errno is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_tcp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags)
+{
+  FAR struct tcp_conn_s *conn;
+  struct tcp_recvfrom_s state;
+  struct tcp_callback_s info;
+  bool nonblock;
+  bool netlocked = false;
+  ssize_t ret = 0;
+
+  conn = psock->s_conn;
+  conn_lock(&conn->sconn);
+
+  /* Only a receive that has to wait needs the network lock */
+
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+  if (!nonblock && conn->readahead == NULL)
+    {
+      conn_net_lock(&conn->sconn);
+      netlocked = true;
+    }
+
+  tcp_recvfrom_initialize(conn, NULL, 0, NULL, NULL, &state, flags);
+
+  /* Wait for data unless there is already some in the read-ahead buffer.
+   * Data may still be pending there after the socket was disconnected.
+   */
+
+  if (conn->readahead == NULL)
+    {
+      if (!_SS_ISCONNECTED(conn->sconn.s_flags))
+        {
+          ret = _SS_ISCLOSED(conn->sconn.s_flags) ? 0 : -ENOTCONN;
+        }
+      else if (nonblock)
+        {
+          ret = -EAGAIN;
+        }
+      else
+        {
+          DEBUGASSERT(netlocked);
+
+          state.ir_cb = tcp_callback_alloc(conn);
+          if (state.ir_cb != NULL)
+            {
+              state.ir_cb->flags = (TCP_NEWDATA | TCP_DISCONN_EVENTS);
+              state.ir_cb->priv  = (FAR void *)&state;
+              state.ir_cb->event = tcp_recviob_eventhandler;
+
+              info.tc_conn = conn;
+              info.tc_cb   = state.ir_cb;
+              info.tc_sem  = &state.ir_sem;
+              tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
+              conn_unlock(&conn->sconn);
+
+#ifdef CONFIG_NET_BUSY_POLL
+              netdev_busypoll(conn->dev, conn->sconn.s_busypoll,
+                              &state.ir_sem);
+#endif
+
+              ret = net_sem_timedwait(&state.ir_sem,
+                                      _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+              tls_cleanup_pop(tls_get_info(), 0);
+              conn_lock(&conn->sconn);
+              if (ret == -ETIMEDOUT)
+                {
+                  ret = -EAGAIN;
+                }
+
+              tcp_callback_free(conn, state.ir_cb);
+              if (ret >= 0)
+                {
+                  ret = state.ir_result;
+                }
+            }
+          else
+            {
+              ret = -EBUSY;
+            }
+        }
+    }
+
+  /* Hand the whole read-ahead chain over to the caller */
+
+  if (conn->readahead != NULL)
+    {
+      *iob = conn->readahead;
+      conn->readahead = NULL;
+      ret = (*iob)->io_pktlen;
+
+      tcp_notify_recvwindow(conn);
+    }
+
+  tcp_notify_recvcpu(conn);
+
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  tcp_recvfrom_uninitialize(&state);
+  conn_unlock(&conn->sconn);
+  return ret;
+}
+#endif /* CONFIG_NET_ZEROCOPY */
+
 #endif /* CONFIG_NET_TCP */
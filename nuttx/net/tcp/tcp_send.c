@@ -104,6 +104,103 @@ static inline FAR struct tcp_hdr_s *tcp_header(FAR struct net_driver_s *dev)
 #endif /* CONFIG_NET_IPv4 */
 }
 
+/****************************************************************************
+ * Name: tcp_setchksum
+ *
+ * Description:
+ *   Set the TCP checksum of the outgoing packet.  If the device can do it,
+ *   only the pseudo-header is summed here and the packet is marked for
+ *   checksum offload, and then also for segmentation offload if its
+ *   payload is larger than the MSS.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure to use in the send operation
+ *   tcp - The TCP header of the packet in d_iob
+ *   mss - The MSS of the connection, 0 if the packet may not be segmented
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_setchksum(FAR struct net_driver_s *dev,
+                          FAR struct tcp_hdr_s *tcp, uint16_t mss)
+{
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+#ifdef CONFIG_NETDEV_OFFLOAD
+  dev->d_offload = 0;
+
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+    {
+      unsigned int hdrlen = (tcp->tcpoffset >> 4) << 2;
+      uint16_t sum;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      if (IFF_IS_IPv6(dev->d_flags))
+#endif
+        {
+          sum     = ipv6_upperlayer_header_chksum(dev, IP_PROTO_TCP,
+                                                  IPv6_HDRLEN);
+          hdrlen += IPv6_HDRLEN;
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      else
+#endif
+        {
+          sum     = ipv4_upperlayer_header_chksum(dev, IP_PROTO_TCP);
+          hdrlen += IPv4_HDRLEN;
+        }
+#endif
+
+      tcp->tcpchksum = HTONS(sum);
+      dev->d_offload = NETDEV_OFFLOAD_CSUM;
+
+#ifdef CONFIG_NET_TCP_TSO
+      if (mss > 0 && dev->d_len > hdrlen + mss &&
+          NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TSO))
+        {
+          dev->d_offload |= NETDEV_OFFLOAD_TSO;
+          dev->d_gsosize  = mss;
+        }
+#else
+      UNUSED(hdrlen);
+#endif
+
+      return;
+    }
+#endif /* CONFIG_NETDEV_OFFLOAD */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
+#endif
+#endif /* CONFIG_NET_TCP_CHECKSUMS */
+
+  UNUSED(mss);
+}
+
 /****************************************************************************
  * Name: tcp_sendcommon
  *
@@ -197,11 +294,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 
       /* Calculate TCP checksum. */
 
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
-#endif
+      tcp_setchksum(dev, tcp, conn->mss);
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv6.sent++;
@@ -221,11 +314,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 
       /* Calculate TCP checksum. */
 
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
-#endif
+      tcp_setchksum(dev, tcp, conn->mss);
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv4.sent++;
@@ -500,11 +589,7 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                         ipv6->srcipaddr,
                         conn ? conn->sconn.s_ttl : IP_TTL_DEFAULT,
                         conn ? conn->sconn.s_tos : 0);
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
-#endif
+      tcp_setchksum(dev, tcp, 0);
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -520,11 +605,7 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                         conn ? conn->sconn.s_ttl : IP_TTL_DEFAULT,
                         conn ? conn->sconn.s_tos : 0, NULL);
 
-      tcp->tcpchksum = 0;
-
-#ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
-#endif
+      tcp_setchksum(dev, tcp, 0);
     }
 #endif /* CONFIG_NET_IPv4 */
 }
@@ -684,6 +765,10 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 void tcp_send_txnotify(FAR struct socket *psock,
                        FAR struct tcp_conn_s *conn)
 {
+  /* Have the next TX poll of the device visit the connection */
+
+  tcp_txpending(conn);
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   /* If both IPv4 and IPv6 support are enabled, then we will need to select
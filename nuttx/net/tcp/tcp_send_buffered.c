@@ -411,6 +411,44 @@ static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: tcp_max_sndlen
+ *
+ * Description:
+ *   Return the largest amount of new data to send in one packet: the MSS,
+ *   or a multiple of it if the device does the segmentation.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver used for sending
+ *   conn     The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   The maximum payload size
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_max_sndlen(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_TSO
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TSO) && conn->mss > 0)
+    {
+      uint32_t maxlen = CONFIG_NET_TCP_TSO_MAXSEGS * conn->mss;
+
+      /* The super-segment must still fit in the IP length field */
+
+      if (maxlen > UINT16_MAX - tcpip_hdrsize(conn))
+        {
+          maxlen = UINT16_MAX - tcpip_hdrsize(conn);
+        }
+
+      return maxlen - maxlen % conn->mss;
+    }
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -609,6 +647,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
                       TCP_WBNACK(wrb) = 0;
                       conn->timeout = true;
+                      tcp_txpending(conn);
                       netdev_txnotify_dev(conn->dev);
                       return flags;
                     }
@@ -1040,9 +1079,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > tcp_max_sndlen(dev, conn))
             {
-              sndlen = conn->mss;
+              sndlen = tcp_max_sndlen(dev, conn);
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1130,7 +1169,13 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
           if (TCP_SEQ_GT(predicted_seqno, conn->sndseq_max))
             {
-               conn->sndseq_max = predicted_seqno;
+              conn->sndseq_max = predicted_seqno;
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+
+              /* New data: sample its RTT */
+
+              tcp_cc_sent(conn, predicted_seqno);
+#endif
             }
 
           ninfo("SEND: wrb=%p nrtx=%u tx_unacked=%" PRIu32
@@ -1197,9 +1242,19 @@ static uint32_t tcp_max_wrb_size(FAR struct tcp_conn_s *conn)
   const uint32_t mss = conn->mss;
   uint32_t size;
 
-  /* a few segments should be fine */
+  /* a few segments should be fine, or a full super-segment if the device
+   * does the segmentation.
+   */
 
   size = 4 * mss;
+#ifdef CONFIG_NET_TCP_TSO
+  if (conn->dev != NULL &&
+      NETDEV_HAS_FEATURE(conn->dev, NETDEV_FEATURE_TSO) &&
+      size < CONFIG_NET_TCP_TSO_MAXSEGS * mss)
+    {
+      size = CONFIG_NET_TCP_TSO_MAXSEGS * mss;
+    }
+#endif
 
   /* but it should not hog too many IOB buffers */
 
@@ -1249,6 +1304,148 @@ static unsigned int tcp_send_gettimeout(clock_t start, unsigned int timeout)
   return timeout;
 }
 
+/****************************************************************************
+ * Name: tcp_send_prepare
+ *
+ * Description:
+ *   Set up the send callback of the connection and, if a send buffer limit
+ *   is configured, wait until the write queue drops below it.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The connection is locked, the network is not.  The connection lock is
+ *   released while waiting.
+ *
+ ****************************************************************************/
+
+static int tcp_send_prepare(FAR struct tcp_conn_s *conn, bool nonblock,
+                            clock_t start, unsigned int timeout)
+{
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  int ret;
+#endif
+
+  /* Allocate resources to receive a callback */
+
+  if (conn->sndcb == NULL)
+    {
+      /* The callback pool is protected by the network lock.  Another
+       * sender may get here first while the connection lock is dropped.
+       */
+
+      conn_net_lock(&conn->sconn);
+      if (conn->sndcb == NULL)
+        {
+          conn->sndcb = tcp_callback_alloc(conn);
+        }
+
+      net_unlock();
+
+      /* Test if the callback has been allocated */
+
+      if (conn->sndcb == NULL)
+        {
+          /* A buffer allocation error occurred */
+
+          nerr("ERROR: Failed to allocate callback\n");
+          return nonblock ? -EAGAIN : -ENOMEM;
+        }
+    }
+
+  /* Set up the callback in the connection */
+
+  conn->sndcb->flags = (TCP_ACKDATA | TCP_REXMIT | TCP_POLL |
+                        TCP_DISCONN_EVENTS);
+  conn->sndcb->priv  = (FAR void *)conn;
+  conn->sndcb->event = psock_send_eventhandler;
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  /* If the send buffer size exceeds the send limit,
+   * wait for the write buffer to be released
+   */
+
+  while (tcp_wrbuffer_inqueue_size(conn) >= conn->snd_bufs)
+    {
+      struct tcp_callback_s info;
+
+      if (nonblock)
+        {
+          return -EAGAIN;
+        }
+
+      /* Push a cancellation point onto the stack.  This will be
+       * called if the thread is canceled.
+       */
+
+      info.tc_conn = conn;
+      info.tc_cb   = conn->sndcb;
+      info.tc_sem  = &conn->snd_sem;
+      tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
+
+      conn_unlock(&conn->sconn);
+      ret = net_sem_timedwait_uninterruptible(&conn->snd_sem,
+        tcp_send_gettimeout(start, timeout));
+      conn_lock(&conn->sconn);
+
+      tls_cleanup_pop(tls_get_info(), 0);
+      if (ret < 0)
+        {
+          return ret == -ETIMEDOUT ? -EAGAIN : ret;
+        }
+    }
+#endif /* CONFIG_NET_SEND_BUFSIZE */
+
+  return OK;
+}
+
+#ifdef CONFIG_NET_ZEROCOPY
+/****************************************************************************
+ * Name: tcp_iob_split
+ *
+ * Description:
+ *   Detach the head of an I/O buffer chain holding at most 'maxlen' bytes
+ *   (but at least one IOB).  The chain is only cut at IOB boundaries so
+ *   that no data is copied.
+ *
+ * Input Parameters:
+ *   iob    - The chain to split.  On return, the remainder of the chain.
+ *   maxlen - The preferred maximum length of the head
+ *
+ * Returned Value:
+ *   The detached head of the chain.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *tcp_iob_split(FAR struct iob_s **iob,
+                                       uint32_t maxlen)
+{
+  FAR struct iob_s *head = *iob;
+  FAR struct iob_s *tail = head;
+  uint32_t pktlen = head->io_pktlen;
+  uint32_t len = head->io_len;
+
+  while (tail->io_flink != NULL &&
+         len + tail->io_flink->io_len <= maxlen)
+    {
+      tail = tail->io_flink;
+      len += tail->io_len;
+    }
+
+  *iob = tail->io_flink;
+  tail->io_flink = NULL;
+  head->io_pktlen = len;
+
+  if (*iob != NULL)
+    {
+      (*iob)->io_pktlen = pktlen - len;
+    }
+
+  return head;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1386,12 +1583,14 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       size_t chunk_len = len;
       ssize_t chunk_result;
 
-      net_lock();
-
-      /* Now that we have the network locked, we need to check the connection
-       * state again to ensure the connection is still valid.
+      /* The data is queued under the connection lock only, the network is
+       * just locked to notify the device.  Now that we have the connection
+       * locked, we need to check the connection state again to ensure the
+       * connection is still valid.
        */
 
+      conn_lock(&conn->sconn);
+
       if (!_SS_ISCONNECTED(conn->sconn.s_flags))
         {
           nerr("ERROR: No longer connected\n");
@@ -1399,75 +1598,17 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_lock;
         }
 
-      /* Allocate resources to receive a callback */
-
-      if (conn->sndcb == NULL)
+      ret = tcp_send_prepare(conn, nonblock, start, timeout);
+      if (ret < 0)
         {
-          conn->sndcb = tcp_callback_alloc(conn);
-
-          /* Test if the callback has been allocated */
-
-          if (conn->sndcb == NULL)
-            {
-              /* A buffer allocation error occurred */
-
-              nerr("ERROR: Failed to allocate callback\n");
-              ret = nonblock ? -EAGAIN : -ENOMEM;
-              goto errout_with_lock;
-            }
-        }
-
-      /* Set up the callback in the connection */
-
-      conn->sndcb->flags = (TCP_ACKDATA | TCP_REXMIT | TCP_POLL |
-                               TCP_DISCONN_EVENTS);
-      conn->sndcb->priv  = (FAR void *)conn;
-      conn->sndcb->event = psock_send_eventhandler;
-
-#if CONFIG_NET_SEND_BUFSIZE > 0
-      /* If the send buffer size exceeds the send limit,
-       * wait for the write buffer to be released
-       */
-
-      while (tcp_wrbuffer_inqueue_size(conn) >= conn->snd_bufs)
-        {
-          struct tcp_callback_s info;
-
-          if (nonblock)
-            {
-              ret = -EAGAIN;
-              goto errout_with_lock;
-            }
-
-          /* Push a cancellation point onto the stack.  This will be
-           * called if the thread is canceled.
-           */
-
-          info.tc_conn = conn;
-          info.tc_cb   = conn->sndcb;
-          info.tc_sem  = &conn->snd_sem;
-          tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
-
-          ret = net_sem_timedwait_uninterruptible(&conn->snd_sem,
-            tcp_send_gettimeout(start, timeout));
-          tls_cleanup_pop(tls_get_info(), 0);
-          if (ret < 0)
-            {
-              if (ret == -ETIMEDOUT)
-                {
-                  ret = -EAGAIN;
-                }
-
-              goto errout_with_lock;
-            }
+          goto errout_with_lock;
         }
-#endif /* CONFIG_NET_SEND_BUFSIZE */
 
       while (true)
         {
           struct iob_s *iob;
 
-          /* Allocate a write buffer.  Careful, the network will be
+          /* Allocate a write buffer.  Careful, the connection will be
            * momentarily unlocked here.
            */
 
@@ -1493,15 +1634,17 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                     TCP_WBPKTLEN(wrb));
               DEBUGASSERT(TCP_WBPKTLEN(wrb) > 0);
             }
-          else if (nonblock)
-            {
-              wrb = tcp_wrbuffer_tryalloc();
-              ninfo("new wrb %p (non blocking)\n", wrb);
-            }
           else
             {
-              wrb = tcp_wrbuffer_timedalloc(tcp_send_gettimeout(start,
-                                                                timeout));
+              wrb = tcp_wrbuffer_tryalloc();
+              if (wrb == NULL && !nonblock)
+                {
+                  conn_unlock(&conn->sconn);
+                  wrb = tcp_wrbuffer_timedalloc(
+                          tcp_send_gettimeout(start, timeout));
+                  conn_lock(&conn->sconn);
+                }
+
               ninfo("new wrb %p\n", wrb);
             }
 
@@ -1602,16 +1745,19 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
           /* Wait for at least one IOB getting available.
            *
-           * Note: net_ioballoc releases the network lock when blocking.
-           * It allows our write_q being drained in the meantime. Otherwise,
-           * we risk a deadlock with other threads competing on IOBs.
+           * Note: the connection is unlocked while blocking.  It allows our
+           * write_q being drained in the meantime. Otherwise, we risk a
+           * deadlock with other threads competing on IOBs.
            */
 
+          conn_unlock(&conn->sconn);
           iob = net_iobtimedalloc(true, tcp_send_gettimeout(start, timeout));
           if (iob != NULL)
             {
               iob_free_chain(iob);
             }
+
+          conn_lock(&conn->sconn);
         }
 
       /* Dump I/O buffer chain */
@@ -1627,8 +1773,12 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
             wrb, TCP_WBPKTLEN(wrb),
             conn->write_q.head, conn->write_q.tail);
 
-      /* Notify the device driver of the availability of TX data */
+      /* Notify the device driver of the availability of TX data.  This
+       * needs the network lock, but not the connection lock any more.
+       */
 
+      conn_net_lock(&conn->sconn);
+      conn_unlock(&conn->sconn);
       tcp_send_txnotify(psock, conn);
       net_unlock();
 
@@ -1676,7 +1826,7 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   return result;
 
 errout_with_lock:
-  net_unlock();
+  conn_unlock(&conn->sconn);
 
 errout:
   if (result > 0)
@@ -1687,6 +1837,124 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_tcp_sendiob
+ *
+ * Description:
+ *   Queue a caller-filled I/O buffer chain for transmission on a connected
+ *   TCP socket without copying it.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iob      On entry, the chain to send.  On return, the part of the
+ *            chain that was not queued (NULL if all of it was).
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On error, a negated
+ *   errno value is returned (see psock_tcp_send()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_tcp_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR struct tcp_wrbuffer_s *wrb;
+  unsigned int timeout;
+  uint32_t max_wrb_size;
+  ssize_t result = 0;
+  bool nonblock;
+  clock_t start;
+  int ret = OK;
+
+  if (psock == NULL || psock->s_type != SOCK_STREAM ||
+      psock->s_conn == NULL)
+    {
+      nerr("ERROR: Invalid socket\n");
+      return -EBADF;
+    }
+
+  conn     = psock->s_conn;
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+                            (flags & MSG_DONTWAIT) != 0;
+  start    = clock_systime_ticks();
+  timeout  = _SO_TIMEOUT(conn->sconn.s_sndtimeo);
+
+  conn_lock(&conn->sconn);
+
+  while (*iob != NULL)
+    {
+      if (!_SS_ISCONNECTED(conn->sconn.s_flags))
+        {
+          nerr("ERROR: Not connected\n");
+          ret = -ENOTCONN;
+          break;
+        }
+
+      ret = tcp_send_prepare(conn, nonblock, start, timeout);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      /* Only the write buffer container is allocated, the data stays in
+       * the caller's IOBs.  Allocating IOBs here could deadlock against
+       * the IOBs that the caller is holding.
+       */
+
+      wrb = tcp_wrbuffer_timedattach(*iob, 0);
+      if (wrb == NULL && !nonblock)
+        {
+          conn_unlock(&conn->sconn);
+          wrb = tcp_wrbuffer_timedattach(*iob, tcp_send_gettimeout(start,
+                                                                 timeout));
+          conn_lock(&conn->sconn);
+        }
+
+      if (wrb == NULL)
+        {
+          nerr("ERROR: Failed to allocate write buffer\n");
+          ret = (nonblock || timeout != UINT_MAX) ? -EAGAIN : -ENOMEM;
+          break;
+        }
+
+      /* Hand over at most a few segments worth of IOBs per write buffer */
+
+      max_wrb_size = tcp_max_wrb_size(conn);
+      wrb->wb_iob  = tcp_iob_split(iob, max_wrb_size);
+
+      TCP_WBSEQNO(wrb) = (unsigned)-1;
+      TCP_WBNRTX(wrb)  = 0;
+      TCP_WBDUMP("I/O buffer chain", wrb, TCP_WBPKTLEN(wrb), 0);
+
+      sq_addlast(&wrb->wb_node, &conn->write_q);
+      ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
+            wrb, TCP_WBPKTLEN(wrb),
+            conn->write_q.head, conn->write_q.tail);
+
+      result += TCP_WBPKTLEN(wrb);
+    }
+
+  /* Notify the device driver of the availability of TX data */
+
+  if (result > 0)
+    {
+      conn_net_lock(&conn->sconn);
+      conn_unlock(&conn->sconn);
+      tcp_send_txnotify(psock, conn);
+      net_unlock();
+    }
+  else
+    {
+      conn_unlock(&conn->sconn);
+    }
+
+  return result > 0 ? result : ret;
+}
+#endif /* CONFIG_NET_ZEROCOPY */
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
@@ -260,6 +260,27 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      case TCP_CONGESTION: /* The congestion control algorithm */
+        if (value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            net_lock();
+            ret = tcp_cc_setops(conn, value, value_len);
+            net_unlock();
+
+            if (ret < 0)
+              {
+                nerr("ERROR: Unknown congestion control: %.*s\n",
+                     (int)value_len, (FAR const char *)value);
+              }
+          }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
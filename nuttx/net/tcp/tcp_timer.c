@@ -152,6 +152,7 @@ static void tcp_timer_expiry(FAR void *arg)
       if (conn == arg)
         {
           conn->timeout = true;
+          tcp_txpending(conn);
           netdev_txnotify_dev(conn->dev);
           break;
         }
@@ -410,6 +411,8 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
   DEBUGASSERT(dev != NULL && conn != NULL && dev == conn->dev);
 
+  conn_lock(&conn->sconn);
+
   /* Set up for the callback.  We can't know in advance if the application
    * is going to send a IPv4 or an IPv6 packet, so this setup may not
    * actually be used.  Furthermore, the TCP logic is required to call
@@ -435,6 +438,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
     {
       /* Nothing to be done */
 
+      conn_unlock(&conn->sconn);
       return;
     }
 
@@ -537,6 +541,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                   /* Finally, we must free this TCP connection structure */
 
                   conn->crefs = 0;
+                  conn_unlock(&conn->sconn);
                   tcp_free(conn);
                   return;
                 }
@@ -633,22 +638,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                     tcp_rexmit(dev, conn, result);
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-                    /* If conn is TCP_INFR, it should enter to slow start */
-
-                    if (conn->flags & TCP_INFR)
-                      {
-                        conn->flags &= ~TCP_INFR;
-                      }
-
-                    /* update the max_cwnd */
-
-                    conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
-
-                    /* reset cwnd and ssthresh, refers to RFC5861. */
+                    /* Restart from slow start */
 
-                    conn->ssthresh =
-                                    MAX(conn->tx_unacked / 2, 2 * conn->mss);
-                    conn->cwnd = conn->mss;
+                    tcp_cc_timeout(conn);
 #endif
                     goto done;
 
@@ -820,6 +812,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
 done:
   tcp_update_timer(conn);
+  conn_unlock(&conn->sconn);
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -160,6 +160,41 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void)
   return tcp_wrbuffer_timedalloc(0);
 }
 
+/****************************************************************************
+ * Name: tcp_wrbuffer_timedattach
+ *
+ * Description:
+ *   Allocate a TCP write buffer like tcp_wrbuffer_timedalloc(), but
+ *   attach the caller's I/O buffer chain to it instead of allocating the
+ *   first IOB.
+ *
+ * Input Parameters:
+ *   iob       - The I/O buffer chain holding the data to send
+ *   timeout   - The relative time to wait until a timeout is declared.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+FAR struct tcp_wrbuffer_s *tcp_wrbuffer_timedattach(FAR struct iob_s *iob,
+                                                    unsigned int timeout)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+
+  DEBUGASSERT(iob != NULL);
+
+  wrb = NET_BUFPOOL_TIMEDALLOC(g_wrbuffer, timeout);
+  if (wrb != NULL)
+    {
+      wrb->wb_iob = iob;
+    }
+
+  return wrb;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_wrbuffer_release
  *
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
@@ -60,6 +61,15 @@
 #  endif
 #endif
 
+/* With write buffers, the sum of the payload is accumulated as the user
+ * data is copied in and udp_send() only sums the headers.
+ */
+
+#if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && \
+    defined(CONFIG_NET_UDP_CHECKSUMS) && !defined(CONFIG_NET_ARCH_CHKSUM)
+#  define NEED_UDP_WB_CHKSUM 1
+#endif
+
 /* Allocate a new UDP data callback */
 
 #define udp_callback_alloc(dev,conn) \
@@ -70,6 +80,7 @@
 /* Definitions for the UDP connection struct flag field */
 
 #define _UDP_FLAG_CONNECTMODE (1 << 0) /* Bit 0:  UDP connection-mode */
+#define _UDP_FLAG_SNDCHKSUM   (1 << 1) /* Bit 1:  sndchksum is valid */
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
 
@@ -110,6 +121,9 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  hash_node_t hnode;      /* Node in the local port hashtable */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -149,6 +163,10 @@ struct udp_conn_s
   FAR struct devif_callback_s *sndcb;
 #endif
 
+#ifdef NEED_UDP_WB_CHKSUM
+  uint16_t sndchksum;             /* Payload sum of the datagram in flight */
+#endif
+
 #if defined(CONFIG_NET_IGMP) || defined(CONFIG_NET_MLD)
   struct ip_mreqn mreq;
 #endif
@@ -174,6 +192,9 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+#ifdef NEED_UDP_WB_CHKSUM
+  uint16_t wb_chksum;              /* Sum of the payload */
+#endif
 };
 #endif
 
@@ -239,7 +260,10 @@ void udp_free(FAR struct udp_conn_s *conn);
  *
  * Description:
  *   Find a connection structure that is the appropriate
- *   connection to be used within the provided UDP/IP header
+ *   connection to be used within the provided UDP/IP header.  This returns
+ *   the next connection after 'conn' (or the first one if 'conn' is NULL)
+ *   that accepts the packet, so that a broadcast can be delivered to each
+ *   of them.
  *
  * Assumptions:
  *   Called from network stack logic with the network stack locked
@@ -250,6 +274,25 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
                                   FAR struct udp_conn_s *conn,
                                   FAR struct udp_hdr_s *udp);
 
+/****************************************************************************
+ * Name: udp_demux
+ *
+ * Description:
+ *   Find the one connection that a unicast UDP packet is delivered to: the
+ *   connection that accepts it with the most specific binding, a connected
+ *   socket before a bound address before the wildcard address.  If that
+ *   connection is in a SO_REUSEPORT group, a member of the group is picked
+ *   by the hash of the flow so that the datagrams of a flow always reach
+ *   the same socket.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+FAR struct udp_conn_s *udp_demux(FAR struct net_driver_s *dev,
+                                 FAR struct udp_hdr_s *udp);
+
 /****************************************************************************
  * Name: udp_nextconn
  *
@@ -282,6 +325,25 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Bind a UDP connection to a local port number, or unbind it if portno
+ *   is zero.  This also moves the connection to the bucket of the new port
+ *   in the local port hashtable if CONFIG_NET_UDP_CONN_HASH is selected.
+ *
+ * Input Parameters:
+ *   conn   - The UDP connection
+ *   portno - The local port number in network byte order, or zero
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno);
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -523,6 +585,28 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void);
 FAR struct udp_wrbuffer_s *udp_wrbuffer_timedalloc(unsigned int timeout);
 #endif /* CONFIG_NET_UDP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: udp_wrbuffer_timedattach
+ *
+ * Description:
+ *   Allocate a UDP write buffer like udp_wrbuffer_timedalloc(), but
+ *   attach the caller's I/O buffer chain to it instead of allocating the
+ *   first IOB.
+ *
+ * Input Parameters:
+ *   iob       - The I/O buffer chain holding the datagram
+ *   timeout   - The relative time to wait until a timeout is declared.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && defined(CONFIG_NET_ZEROCOPY)
+FAR struct udp_wrbuffer_s *udp_wrbuffer_timedattach(FAR struct iob_s *iob,
+                                                    unsigned int timeout);
+#endif
+
 /****************************************************************************
  * Name: udp_wrbuffer_tryalloc
  *
@@ -753,6 +837,30 @@ void udp_callback_cleanup(FAR void *arg);
 ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive the datagram at the head of the read-ahead buffer of a UDP
+ *   socket as an I/O buffer chain, waiting for one first if necessary.
+ *   The sender address is not returned.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DGRAM socket
+ *   iob      Location to return the I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the length of the datagram.  On error, -errno is
+ *   returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_udp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_sendto
  *
@@ -782,6 +890,30 @@ ssize_t psock_udp_sendto(FAR struct socket *psock,
                          FAR const void *buf, size_t len, int flags,
                          FAR const struct sockaddr *to, socklen_t tolen);
 
+/****************************************************************************
+ * Name: psock_udp_sendiob
+ *
+ * Description:
+ *   Queue a caller-filled I/O buffer chain as one datagram on a connected
+ *   UDP socket without copying it.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iob      On entry, the datagram to send.  On return, NULL if it was
+ *            queued, otherwise the chain is left to the caller.
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the length of the datagram.  On error, a negated
+ *   errno value is returned (see psock_udp_sendto()).
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ZEROCOPY) && defined(CONFIG_NET_UDP_WRITE_BUFFERS)
+ssize_t psock_udp_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: udp_pollsetup
  *
@@ -298,7 +298,8 @@ net_dataevent(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
  *   OK if packet has been processed, otherwise ERROR.
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   This function must be called with the network locked.  It takes the
+ *   connection lock around the handlers.
  *
  ****************************************************************************/
 
@@ -311,6 +312,12 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
 
   if (conn)
     {
+      /* The read-ahead and write queues are also accessed by send() and
+       * recv() under the connection lock only.
+       */
+
+      conn_lock(&conn->sconn);
+
       /* Perform the callback */
 
       flags = devif_conn_event(dev, flags, conn->sconn.list);
@@ -321,6 +328,8 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
 
           flags = net_dataevent(dev, conn, flags);
         }
+
+      conn_unlock(&conn->sconn);
     }
 
   return flags;
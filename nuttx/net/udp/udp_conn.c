@@ -82,6 +82,15 @@
 #  define CONFIG_NET_UDP_MAX_CONNS 0
 #endif
 
+/* The precedence of a connection that accepts a unicast packet.  The most
+ * specific binding wins: a connected peer before a bound local address
+ * before the wildcard address.
+ */
+
+#define UDP_SCORE_LADDR  1   /* Bound to the destination address */
+#define UDP_SCORE_RPORT  2   /* Connected to the source port */
+#define UDP_SCORE_RADDR  4   /* Connected to the source address */
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -97,10 +106,68 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The bound connections, hashed by local port */
+
+static DECLARE_HASHTABLE(g_udp_port_hash, CONFIG_NET_UDP_CONN_HASH_BITS);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_port_next
+ *
+ * Description:
+ *   Return the next connection after 'conn' (the first one if 'conn' is
+ *   NULL) that is bound to the local port 'portno'.  Only the bucket of
+ *   the port is searched if the connections are hashed.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *udp_port_next(FAR struct udp_conn_s *conn,
+                                            uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR hash_node_t *node;
+
+  if (conn == NULL)
+    {
+      node = dq_peek(&g_udp_port_hash[HASH(portno,
+                                   hashtable_bits(g_udp_port_hash))]);
+    }
+  else
+    {
+      node = dq_next(&conn->hnode);
+    }
+
+  for (; node != NULL; node = dq_next(node))
+    {
+      conn = container_of(node, struct udp_conn_s, hnode);
+      if (conn->lport == portno)
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#else
+  while ((conn = udp_nextconn(conn)) != NULL)
+    {
+      if (conn->lport == portno)
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -113,6 +180,7 @@ static dq_queue_t g_active_udp_connections;
  *   portno - The port to use in the lookup
  *   opt    - The option from another conn to match the conflict conn
  *              SO_REUSEADDR: If both sockets have this, they never conflict.
+ *              SO_REUSEPORT: If both sockets have this, they never conflict.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -126,18 +194,22 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   FAR struct udp_conn_s *conn = NULL;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
 #endif
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure bound to the port. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  while ((conn = udp_port_next(conn, portno)) != NULL)
     {
-      /* With SO_REUSEADDR set for both sockets, we do not need to check its
-       * address and port.
+      /* With SO_REUSEADDR (or SO_REUSEPORT) set for both sockets, we do not
+       * need to check its address and port.
        */
 
 #ifdef CONFIG_NET_SOCKOPTS
-      if (skip_reusable && _SO_GETOPT(conn->sconn.s_options, SO_REUSEADDR))
+      if ((skip_reusable &&
+           _SO_GETOPT(conn->sconn.s_options, SO_REUSEADDR)) ||
+          (skip_reuseport &&
+           _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT)))
         {
           continue;
         }
@@ -182,11 +254,14 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
 }
 
 /****************************************************************************
- * Name: udp_ipv4_active
+ * Name: udp_ipv4_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Check if a connection accepts the packet with the provided UDP header.
+ *
+ * Returned Value:
+ *   The precedence of the connection (UDP_SCORE_* bits), or -1 if it
+ *   does not accept the packet.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -194,142 +269,152 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static inline FAR struct udp_conn_s *
-udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
-                FAR struct udp_hdr_s *udp)
+static int udp_ipv4_match(FAR struct net_driver_s *dev,
+                          FAR struct udp_conn_s *conn,
+                          FAR struct udp_hdr_s *udp)
 {
 #ifdef CONFIG_NET_BROADCAST
   static const in_addr_t bcast = INADDR_BROADCAST;
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
+  int score;
+
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *   - The local port number is checked against the destination port
+   *     number in the received packet.
+   *   - If multiple network interfaces are supported, then the local
+   *     IP address is available and we will insist that the
+   *     destination IP matches the bound address (or the destination
+   *     IP address is a broadcast address). If a socket is bound to
+   *     INADDRY_ANY (laddr), then it should receive all packets
+   *     directed to the port.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *   - The remote port number is checked if the connection is bound
+   *     to a remote port.
+   *   - Finally, if the connection is bound to a remote IP address,
+   *     the source IP address of the packet is checked. Broadcast
+   *     addresses are also accepted.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVISIT: SO_BROADCAST flag is currently ignored.
+   */
 
-  conn = udp_nextconn(conn);
+  /* Check that there is a local port number and this matches
+   * the port number in the destination address.
+   */
 
-  while (conn)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *   - The local port number is checked against the destination port
-       *     number in the received packet.
-       *   - If multiple network interfaces are supported, then the local
-       *     IP address is available and we will insist that the
-       *     destination IP matches the bound address (or the destination
-       *     IP address is a broadcast address). If a socket is bound to
-       *     INADDRY_ANY (laddr), then it should receive all packets
-       *     directed to the port.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *   - The remote port number is checked if the connection is bound
-       *     to a remote port.
-       *   - Finally, if the connection is bound to a remote IP address,
-       *     the source IP address of the packet is checked. Broadcast
-       *     addresses are also accepted.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVISIT: SO_BROADCAST flag is currently ignored.
+  if (conn->lport != 0 && udp->destport == conn->lport &&
+
+      /* Local port accepts any address on this port or there
+       * is an exact match in destipaddr and the bound local
+       * address.  This catches the receipt of a broadcast when
+       * the socket is bound to INADDR_ANY.
        */
 
-      /* Check that there is a local port number and this matches
-       * the port number in the destination address.
+      (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
+       net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+    {
+      /* A socket bound to the destination address takes precedence over
+       * one bound to the wildcard address.
        */
 
-      if (conn->lport != 0 && udp->destport == conn->lport &&
+      score = net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ?
+              0 : UDP_SCORE_LADDR;
 
-          /* Local port accepts any address on this port or there
-           * is an exact match in destipaddr and the bound local
-           * address.  This catches the receipt of a broadcast when
-           * the socket is bound to INADDR_ANY.
-           */
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
 
-          (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
-
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              /* If (1) not connected to a remote address, or (2) a
-               * broadcast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a
+           * broadcast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
+              (net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
+               net_ipv4addr_hdrcmp(ip->destipaddr, &bcast) ||
 #endif
-                   net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
+               net_ipv4addr_hdrcmp(ip->srcipaddr, &conn->u.ipv4.raddr)))
+            {
+              /* Matching connection found.  The more of the remote
+               * address it is connected to, the higher its precedence.
+               */
+
+              if (conn->rport != 0)
                 {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
+                  score |= UDP_SCORE_RPORT;
+                }
 
-                  break;
+              if (!net_ipv4addr_cmp(conn->u.ipv4.raddr, INADDR_ANY))
+                {
+                  score |= UDP_SCORE_RADDR;
                 }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
 
-              break;
+              return score;
             }
         }
+      else
+        {
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
+           */
 
-      /* Look at the next active connection */
-
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+          return score;
+        }
     }
 
-  return conn;
+  return -1;
 }
 #endif /* CONFIG_NET_IPv4 */
 
 /****************************************************************************
- * Name: udp_ipv6_active
+ * Name: udp_ipv6_match
  *
  * Description:
- *   Find a connection structure that is the appropriate connection to be
- *   used within the provided UDP header
+ *   Check if a connection accepts the packet with the provided UDP header.
+ *
+ * Returned Value:
+ *   The precedence of the connection (UDP_SCORE_* bits), or -1 if it
+ *   does not accept the packet.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -337,133 +422,227 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv6
-static inline FAR struct udp_conn_s *
-udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
-                FAR struct udp_hdr_s *udp)
+static int udp_ipv6_match(FAR struct net_driver_s *dev,
+                          FAR struct udp_conn_s *conn,
+                          FAR struct udp_hdr_s *udp)
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
+  int score;
+
+  /* If the local UDP port is non-zero, the connection is considered
+   * to be used. If so, then the following checks are performed:
+   *
+   * 1. The destination address is verified against the bound address
+   *    of the connection.
+   *
+   *    - The local port number is checked against the destination port
+   *      number in the received packet.
+   *    - If multiple network interfaces are supported, then the local
+   *      IP address is available and we will insist that the
+   *      destination IP matches the bound address. If a socket is bound
+   *      to INADDR6_ANY (laddr), then it should receive all packets
+   *      directed to the port. REVISIT: Should also depend on
+   *      SO_BROADCAST.
+   *
+   * 2. If this is a connection mode UDP socket, then the source address
+   *    is verified against the connected remote address.
+   *
+   *    - The remote port number is checked if the connection is bound
+   *      to a remote port.
+   *    - Finally, if the connection is bound to a remote IP address,
+   *      the source IP address of the packet is checked.
+   *
+   * If all of the above are true then the newly received UDP packet
+   * is destined for this UDP connection.
+   *
+   * To send and receive multicast packets, the application should:
+   *
+   *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
+   *     or to a specific <multicast-address>
+   *   - setsockopt to SO_BROADCAST (for all-nodes address)
+   *
+   * For connection-less UDP sockets:
+   *
+   *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
+   *   - call recvfrom.
+   *
+   * For connection-mode UDP sockets:
+   *
+   *   - call connect() to connect the UDP socket to a specific remote
+   *     address, then
+   *   - Call send() with no address address information
+   *   - call recv() (from address information should not be needed)
+   *
+   * REVISIT: SO_BROADCAST flag is currently ignored.
+   */
 
-  conn = udp_nextconn(conn);
+  /* Check that there is a local port number and this matches
+   * the port number in the destination address.
+   */
 
-  while (conn != NULL)
-    {
-      /* If the local UDP port is non-zero, the connection is considered
-       * to be used. If so, then the following checks are performed:
-       *
-       * 1. The destination address is verified against the bound address
-       *    of the connection.
-       *
-       *    - The local port number is checked against the destination port
-       *      number in the received packet.
-       *    - If multiple network interfaces are supported, then the local
-       *      IP address is available and we will insist that the
-       *      destination IP matches the bound address. If a socket is bound
-       *      to INADDR6_ANY (laddr), then it should receive all packets
-       *      directed to the port. REVISIT: Should also depend on
-       *      SO_BROADCAST.
-       *
-       * 2. If this is a connection mode UDP socket, then the source address
-       *    is verified against the connected remote address.
-       *
-       *    - The remote port number is checked if the connection is bound
-       *      to a remote port.
-       *    - Finally, if the connection is bound to a remote IP address,
-       *      the source IP address of the packet is checked.
-       *
-       * If all of the above are true then the newly received UDP packet
-       * is destined for this UDP connection.
-       *
-       * To send and receive multicast packets, the application should:
-       *
-       *   - Bind socket to INADDR6_ANY (for the all-nodes multicast address)
-       *     or to a specific <multicast-address>
-       *   - setsockopt to SO_BROADCAST (for all-nodes address)
-       *
-       * For connection-less UDP sockets:
-       *
-       *   - call sendto with sendaddr.sin_addr.s_addr = <multicast-address>
-       *   - call recvfrom.
-       *
-       * For connection-mode UDP sockets:
-       *
-       *   - call connect() to connect the UDP socket to a specific remote
-       *     address, then
-       *   - Call send() with no address address information
-       *   - call recv() (from address information should not be needed)
-       *
-       * REVISIT: SO_BROADCAST flag is currently ignored.
+  if ((conn->lport != 0 && udp->destport == conn->lport &&
+
+      /* Check if the local port accepts any address on this port or
+       * that there is an exact match between the destipaddr and the
+       * bound local address.  This catches the case of the all nodes
+       * multicast when the socket is bound to the IPv6 unspecified
+       * address.
        */
 
-      /* Check that there is a local port number and this matches
-       * the port number in the destination address.
+      (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
+       net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+    {
+      /* A socket bound to the destination address takes precedence over
+       * one bound to the wildcard address.
        */
 
-      if ((conn->lport != 0 && udp->destport == conn->lport &&
+      score = net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ?
+              0 : UDP_SCORE_LADDR;
 
-          /* Check if the local port accepts any address on this port or
-           * that there is an exact match between the destipaddr and the
-           * bound local address.  This catches the case of the all nodes
-           * multicast when the socket is bound to the IPv6 unspecified
-           * address.
-           */
+      /* Check if the socket is connection mode.  In this case, only
+       * packets with source addresses from the connected remote peer
+       * will be accepted.
+       */
 
-          (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+      if (_UDP_ISCONNECTMODE(conn->flags))
         {
-          /* Check if the socket is connection mode.  In this case, only
-           * packets with source addresses from the connected remote peer
-           * will be accepted.
+          /* Check if the UDP connection is either (1) accepting packets
+           * from any port or (2) the packet srcport matches the local
+           * bound port number.
            */
 
-          if (_UDP_ISCONNECTMODE(conn->flags))
-            {
-              /* Check if the UDP connection is either (1) accepting packets
-               * from any port or (2) the packet srcport matches the local
-               * bound port number.
-               */
-
-              if ((conn->rport == 0 || udp->srcport == conn->rport) &&
+          if ((conn->rport == 0 || udp->srcport == conn->rport) &&
 
-              /* If (1) not connected to a remote address, or (2) a all-
-               * nodes multicast destipaddr was received, or (3) there is an
-               * exact match between the srcipaddr and the bound remote IP
-               * address, then accept the packet.
-               */
+          /* If (1) not connected to a remote address, or (2) a all-
+           * nodes multicast destipaddr was received, or (3) there is an
+           * exact match between the srcipaddr and the bound remote IP
+           * address, then accept the packet.
+           */
 
-                  (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
+              (net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr) ||
 #ifdef CONFIG_NET_BROADCAST
-                   net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
+               net_ipv6addr_hdrcmp(ip->destipaddr, g_ipv6_allnodes) ||
 #endif
-                   net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
+               net_ipv6addr_hdrcmp(ip->srcipaddr, conn->u.ipv6.raddr)))
+            {
+              /* Matching connection found.  The more of the remote
+               * address it is connected to, the higher its precedence.
+               */
+
+              if (conn->rport != 0)
                 {
-                  /* Matching connection found.. Break out of the loop and
-                   * return this reference to it.
-                   */
+                  score |= UDP_SCORE_RPORT;
+                }
 
-                  break;
+              if (!net_ipv6addr_cmp(conn->u.ipv6.raddr, g_ipv6_unspecaddr))
+                {
+                  score |= UDP_SCORE_RADDR;
                 }
-            }
-          else
-            {
-              /* This UDP socket is not connected.  We need to match only
-               * the destination address with the bound socket address.
-               * Break out out of the loop and return this reference to
-               * the matching connection structure.
-               */
 
-              break;
+              return score;
             }
         }
+      else
+        {
+          /* This UDP socket is not connected.  We need to match only
+           * the destination address with the bound socket address.
+           */
 
-      /* Look at the next active connection */
+          return score;
+        }
+    }
+
+  return -1;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: udp_match
+ *
+ * Description:
+ *   Check if a connection accepts the packet with the provided UDP header.
+ *
+ * Returned Value:
+ *   The precedence of the connection (UDP_SCORE_* bits), or -1 if it
+ *   does not accept the packet.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+static int udp_match(FAR struct net_driver_s *dev,
+                     FAR struct udp_conn_s *conn,
+                     FAR struct udp_hdr_s *udp)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      return udp_ipv6_match(dev, conn, udp);
     }
+#endif /* CONFIG_NET_IPv6 */
 
-  return conn;
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return udp_ipv4_match(dev, conn, udp);
+    }
+#endif /* CONFIG_NET_IPv4 */
 }
+
+/****************************************************************************
+ * Name: udp_flowhash
+ *
+ * Description:
+ *   Hash the source address and the port pair of the packet with the
+ *   provided UDP header into 16 bits.  This picks the member of a
+ *   SO_REUSEPORT group that receives the flow.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static uint32_t udp_flowhash(FAR struct net_driver_s *dev,
+                             FAR struct udp_hdr_s *udp)
+{
+  uint32_t key = ((uint32_t)udp->srcport << 16) | udp->destport;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ip = IPv6BUF;
+      int i;
+
+      for (i = 0; i < 8; i += 2)
+        {
+          key ^= ((uint32_t)ip->srcipaddr[i] << 16) | ip->srcipaddr[i + 1];
+        }
+    }
 #endif /* CONFIG_NET_IPv6 */
 
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ip = IPv4BUF;
+
+      key ^= net_ip4addr_conv32(ip->srcipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  return HASH(key, 16);
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -538,6 +717,38 @@ errout:
   return portno;
 }
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Bind a UDP connection to a local port number (network byte order), or
+ *   unbind it if portno is zero.
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      hashtable_delete(g_udp_port_hash, &conn->hnode, conn->lport);
+    }
+
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      hashtable_add(g_udp_port_hash, &conn->hnode, portno);
+    }
+
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_initialize
  *
@@ -589,6 +800,8 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       nxsem_init(&conn->sndsem, 0, 0);
 #endif
 
+      nxrmutex_init(&conn->sconn.s_lock);
+
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
       /* Initialize the write buffer lists */
 
@@ -623,12 +836,18 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   nxmutex_lock(&g_free_lock);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
   dq_rem(&conn->sconn.node, &g_active_udp_connections);
 
+  /* The read-ahead and write buffers are used by recv() and send() under
+   * the connection lock.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
 
   iob_free_chain(conn->readahead);
@@ -650,8 +869,11 @@ void udp_free(FAR struct udp_conn_s *conn)
 
 #endif
 
+  conn_unlock(&conn->sconn);
+
   /* Free the connection. */
 
+  nxrmutex_destroy(&conn->sconn.s_lock);
   NET_BUFPOOL_FREE(g_udp_connections, conn);
 
   nxmutex_unlock(&g_free_lock);
@@ -673,23 +895,101 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
                                   FAR struct udp_conn_s *conn,
                                   FAR struct udp_hdr_s *udp)
 {
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-  if (IFF_IS_IPv6(dev->d_flags))
+  if (udp->destport == 0)
+    {
+      return NULL;
+    }
+
+  while ((conn = udp_port_next(conn, udp->destport)) != NULL)
+    {
+      if (udp_match(dev, conn, udp) >= 0)
+        {
+          break;
+        }
+    }
+
+  return conn;
+}
+
+/****************************************************************************
+ * Name: udp_demux
+ *
+ * Description:
+ *   Find the one connection that a unicast UDP packet is delivered to: the
+ *   most specific binding that accepts it or, if that connection is in a
+ *   SO_REUSEPORT group, the member of the group selected by the flow hash.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct udp_conn_s *udp_demux(FAR struct net_driver_s *dev,
+                                 FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *best = NULL;
+  FAR struct udp_conn_s *conn = NULL;
+  int bestscore = -1;
+  int score;
+#ifdef CONFIG_NET_SOCKOPTS
+  uint32_t index;
+  uint32_t nreuse = 0;
 #endif
+
+  if (udp->destport == 0)
     {
-      return udp_ipv6_active(dev, conn, udp);
+      return NULL;
     }
-#endif /* CONFIG_NET_IPv6 */
 
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-  else
+  /* Find the connection of the highest precedence and, for a SO_REUSEPORT
+   * group, count the members of the same precedence.
+   */
+
+  while ((conn = udp_port_next(conn, udp->destport)) != NULL)
+    {
+      score = udp_match(dev, conn, udp);
+      if (score > bestscore)
+        {
+          best      = conn;
+          bestscore = score;
+#ifdef CONFIG_NET_SOCKOPTS
+          nreuse    = _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT);
+#endif
+        }
+#ifdef CONFIG_NET_SOCKOPTS
+      else if (score == bestscore && nreuse > 0 &&
+               _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          nreuse++;
+        }
 #endif
+    }
+
+#ifdef CONFIG_NET_SOCKOPTS
+  /* Spread the flows over the members of the group.  Scale the 16-bit
+   * hash instead of taking it modulo the group size: its low bits barely
+   * change between flows that differ only in the source port.
+   */
+
+  if (nreuse > 1)
     {
-      return udp_ipv4_active(dev, conn, udp);
+      index = (udp_flowhash(dev, udp) * nreuse) >> 16;
+      conn  = best;
+
+      while (index > 0 &&
+             (conn = udp_port_next(conn, udp->destport)) != NULL)
+        {
+          if (_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+              udp_match(dev, conn, udp) == bestscore)
+            {
+              best = conn;
+              index--;
+            }
+        }
     }
-#endif /* CONFIG_NET_IPv4 */
+#endif
+
+  return best;
 }
 
 /****************************************************************************
@@ -852,7 +1152,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         }
       else
         {
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
     }
@@ -877,7 +1177,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setport(conn, portno);
           ret         = OK;
         }
       else
@@ -929,7 +1229,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
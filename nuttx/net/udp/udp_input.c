@@ -213,6 +213,7 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 #if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_BROADCAST)
   FAR struct udp_conn_s *nextconn;
   FAR struct iob_s *iob;
+  bool bcast;
 #endif
   unsigned int udpiplen;
 #ifdef CONFIG_NET_UDP_CHECKSUMS
@@ -245,8 +246,10 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   dev->d_appdata = IPBUF(udpiplen);
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
+  /* Skip the verification if the device has done it */
+
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (chksum != 0 && !NETDEV_CSUM_VERIFIED(dev))
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -267,7 +270,7 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 #endif /* CONFIG_NET_IPv6 */
     }
 
-  if (chksum != 0)
+  if (chksum != 0 && !NETDEV_CSUM_VERIFIED(dev))
     {
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.udp.drop++;
@@ -286,7 +289,16 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
        * that, however.
        */
 
-      conn = udp_active(dev, NULL, udp);
+#if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_BROADCAST)
+      /* A broadcast/multicast packet goes to every listener on the port,
+       * a unicast packet only to the most specific one.
+       */
+
+      bcast = udp_is_broadcast(dev);
+      conn  = bcast ? udp_active(dev, NULL, udp) : udp_demux(dev, udp);
+#else
+      conn  = udp_demux(dev, udp);
+#endif
       if (conn)
         {
           /* We'll only get multiple conn when we support SO_REUSEADDR */
@@ -294,7 +306,7 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 #if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_BROADCAST)
           /* Check if the destination is a broadcast/multicast address */
 
-          if (udp_is_broadcast(dev))
+          if (bcast)
             {
               /* Do we have second connection that can hold this packet? */
 
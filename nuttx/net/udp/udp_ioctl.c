@@ -113,7 +113,9 @@ int udp_ioctl(FAR struct udp_conn_s *conn, int cmd, unsigned long arg)
   FAR struct iob_s *iob;
   int ret = OK;
 
-  net_lock();
+  /* The queues of the connection are protected by its lock */
+
+  conn_lock(&conn->sconn);
 
   switch (cmd)
     {
@@ -151,7 +153,7 @@ int udp_ioctl(FAR struct udp_conn_s *conn, int cmd, unsigned long arg)
         break;
     }
 
-  net_unlock();
+  conn_unlock(&conn->sconn);
 
   return ret;
 }
@@ -208,6 +208,12 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
   fds->priv = info;
 
+  /* The read-ahead and write queues are changed by recv() and send() under
+   * the connection lock only.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* Check for read data availability now */
 
   if (conn->readahead != NULL)
@@ -227,6 +233,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
+  conn_unlock(&conn->sconn);
 
 errout_with_lock:
   net_unlock();
@@ -71,15 +71,23 @@ int udp_readahead_notifier_setup(worker_t worker,
                                  FAR void *arg)
 {
   struct work_notifier_s info;
+  int ret;
 
   DEBUGASSERT(worker != NULL);
 
+  /* The check and the setup are atomic with respect to the signal,
+   * which is raised with the connection locked.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* If there is already buffered read-ahead data, then return zero without
    * setting up the notification.
    */
 
   if (conn->readahead != NULL)
     {
+      conn_unlock(&conn->sconn);
       return 0;
     }
 
@@ -91,7 +99,9 @@ int udp_readahead_notifier_setup(worker_t worker,
   info.arg       = arg;
   info.worker    = worker;
 
-  return work_notifier_setup(&info);
+  ret = work_notifier_setup(&info);
+  conn_unlock(&conn->sconn);
+  return ret;
 }
 
 /****************************************************************************
@@ -126,15 +136,23 @@ int udp_writebuffer_notifier_setup(worker_t worker,
 {
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   struct work_notifier_s info;
+  int ret;
 
   DEBUGASSERT(worker != NULL);
 
+  /* The check and the setup are atomic with respect to the signal,
+   * which is raised with the connection locked.
+   */
+
+  conn_lock(&conn->sconn);
+
   /* If there is already buffered read-ahead data, then return zero without
    * setting up the notification.
    */
 
   if (sq_empty(&conn->write_q))
     {
+      conn_unlock(&conn->sconn);
       return 0;
     }
 
@@ -146,7 +164,9 @@ int udp_writebuffer_notifier_setup(worker_t worker,
   info.arg       = arg;
   info.worker    = worker;
 
-  return work_notifier_setup(&info);
+  ret = work_notifier_setup(&info);
+  conn_unlock(&conn->sconn);
+  return ret;
 #else
   return 0;
 #endif
@@ -277,6 +277,139 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
     }
 }
 
+/****************************************************************************
+ * Name: udp_readahead_ready
+ *
+ * Description:
+ *   Check if udp_readahead() will return data for this receive, so that it
+ *   does not have to wait.
+ *
+ * Input Parameters:
+ *   conn - The UDP connection of interest
+ *   msg  - Receive info and buffer for receive data
+ *
+ * Returned Value:
+ *   True if the head of the read-ahead buffer holds a non-empty datagram
+ *   and there is room to receive it.
+ *
+ * Assumptions:
+ *   The connection is locked.
+ *
+ ****************************************************************************/
+
+static inline bool udp_readahead_ready(FAR struct udp_conn_s *conn,
+                                       FAR struct msghdr *msg)
+{
+  uint16_t datalen;
+
+  if (conn->readahead == NULL || msg->msg_iov->iov_len == 0)
+    {
+      return false;
+    }
+
+  iob_copyout((FAR uint8_t *)&datalen, conn->readahead, sizeof(datalen), 0);
+  return datalen > 0;
+}
+
+/****************************************************************************
+ * Name: udp_readahead_detach
+ *
+ * Description:
+ *   Detach the datagram at the head of the read-ahead buffer, without its
+ *   meta info, for psock_udp_recviob().
+ *
+ * Input Parameters:
+ *   conn - The UDP connection of interest
+ *   iob  - Location to return the I/O buffer chain of the datagram
+ *
+ * Returned Value:
+ *   The length of the datagram on success, a negated errno value if it
+ *   had to be copied and no IOB was available.
+ *
+ * Assumptions:
+ *   The connection is locked and its read-ahead buffer is not empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+static ssize_t udp_readahead_detach(FAR struct udp_conn_s *conn,
+                                    FAR struct iob_s **iob)
+{
+  FAR struct iob_s *head = conn->readahead;
+  FAR struct iob_s *tail;
+  unsigned int hdrlen;
+  unsigned int len;
+  uint16_t datalen;
+  uint8_t src_addr_size;
+  int ret;
+
+  /* Skip the meta info, see udp_readahead() for the layout */
+
+  iob_copyout((FAR uint8_t *)&datalen, head, sizeof(datalen), 0);
+  hdrlen = sizeof(datalen);
+#ifdef CONFIG_NETDEV_IFINDEX
+  hdrlen += sizeof(uint8_t);
+#endif
+  iob_copyout(&src_addr_size, head, sizeof(src_addr_size), hdrlen);
+  hdrlen += sizeof(src_addr_size) + src_addr_size;
+#ifdef CONFIG_NET_TIMESTAMP
+  hdrlen += sizeof(struct timespec);
+#endif
+
+  /* Each datagram is queued as the chain it was received in, so it ends
+   * at an IOB boundary unless the read-ahead buffer is packed.
+   */
+
+  len = 0;
+  for (tail = head; tail != NULL; tail = tail->io_flink)
+    {
+      len += tail->io_len;
+      if (len >= hdrlen + datalen)
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(tail != NULL);
+  if (len == hdrlen + datalen)
+    {
+      /* Unlink the datagram from the ones that follow */
+
+      conn->readahead = tail->io_flink;
+      if (conn->readahead != NULL)
+        {
+          conn->readahead->io_pktlen = head->io_pktlen - len;
+        }
+
+      tail->io_flink  = NULL;
+      head->io_pktlen = len;
+      *iob = iob_trimhead(head, hdrlen);
+    }
+  else
+    {
+      /* CONFIG_NET_RECV_PACK merged it with the next one, copy it out */
+
+      *iob = iob_tryalloc(false);
+      if (*iob == NULL)
+        {
+          return -EAGAIN;
+        }
+
+      ret = iob_clone_partial(head, datalen, hdrlen, *iob, 0, false, false);
+      if (ret < 0)
+        {
+          iob_free_chain(*iob);
+          *iob = NULL;
+          return -EAGAIN;
+        }
+
+      conn->readahead = iob_trimhead(head, hdrlen + datalen);
+    }
+
+  return datalen;
+}
+#endif /* CONFIG_NET_ZEROCOPY */
+
 /****************************************************************************
  * Name: udp_sender
  *
@@ -513,6 +646,53 @@ static uint16_t udp_eventhandler(FAR struct net_driver_s *dev,
   return flags;
 }
 
+/****************************************************************************
+ * Name: udp_recviob_eventhandler
+ *
+ * Description:
+ *   This function is called to wake up psock_udp_recviob().  Unlike
+ *   udp_eventhandler(), the new datagram is not consumed here:  UDP_NEWDATA
+ *   is left set so that udp_callback() queues it in the read-ahead buffer,
+ *   from where it is handed over to the caller.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver that generated the event.
+ *   pvpriv   An instance of struct udp_recvfrom_s cast to void*
+ *   flags    Set of events describing why the callback was invoked
+ *
+ * Returned Value:
+ *   The unmodified event flags
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+static uint16_t udp_recviob_eventhandler(FAR struct net_driver_s *dev,
+                                         FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct udp_recvfrom_s *pstate = pvpriv;
+
+  ninfo("flags: %04x\n", flags);
+
+  if (pstate != NULL)
+    {
+      if ((flags & NETDEV_DOWN) != 0)
+        {
+          nerr("ERROR: Network is down\n");
+          udp_terminate(pstate, -ENETUNREACH);
+        }
+      else if ((flags & UDP_NEWDATA) != 0)
+        {
+          udp_terminate(pstate, OK);
+        }
+    }
+
+  return flags;
+}
+#endif /* CONFIG_NET_ZEROCOPY */
+
 /****************************************************************************
  * Name: udp_recvfrom_initialize
  *
@@ -615,7 +795,7 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
  *   None
  *
  * Assumptions:
- *   conn is not NULL.
+ *   conn is locked.
  *
  ****************************************************************************/
 
@@ -632,6 +812,7 @@ static void udp_notify_recvcpu(FAR struct udp_conn_s *conn)
   cpu = this_cpu();
   if (cpu != conn->rcvcpu)
     {
+      conn_net_lock(&conn->sconn);
       if (conn->domain == PF_INET)
         {
           netdev_notify_recvcpu(conn->dev, cpu, conn->domain,
@@ -646,6 +827,7 @@ static void udp_notify_recvcpu(FAR struct udp_conn_s *conn)
         }
 
       conn->rcvcpu = cpu;
+      net_unlock();
     }
 }
 #else
@@ -681,6 +863,8 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
   FAR struct net_driver_s *dev;
   struct udp_callback_s info;
   struct udp_recvfrom_s state;
+  bool nonblock;
+  bool netlocked = false;
   ssize_t ret;
 
   /* Perform the UDP recvfrom() operation */
@@ -690,11 +874,26 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENOTSUP;
     }
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
+  /* Initialize the state structure.  This is done with the connection
+   * locked because we don't want anything to happen until we are ready.
    */
 
-  net_lock();
+  conn_lock(&conn->sconn);
+
+  /* A datagram already in the read-ahead buffer is copied under the
+   * connection lock only.  A receive that may have to wait needs the
+   * network lock for the callback and the wait, take it before anything is
+   * read.
+   */
+
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+  if (!nonblock && !udp_readahead_ready(conn, msg))
+    {
+      conn_net_lock(&conn->sconn);
+      netlocked = true;
+    }
+
   udp_recvfrom_initialize(conn, msg, &state, flags);
 
   /* Copy the read-ahead data from the packet */
@@ -711,7 +910,7 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Handle non-blocking UDP sockets */
 
-  if (_SS_ISNONBLOCK(conn->sconn.s_flags) || (flags & MSG_DONTWAIT) != 0)
+  if (nonblock)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -735,6 +934,8 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   else if (state.ir_recvlen <= 0)
     {
+      DEBUGASSERT(netlocked);
+
       /* Get the device that will handle the packet transfers.  This may be
        * NULL if the UDP socket is bound to INADDR_ANY.  In that case, no
        * NETDEV_DOWN notifications will be received.
@@ -763,6 +964,19 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
           info.sem = &state.ir_sem;
           tls_cleanup_push(tls_get_info(), udp_callback_cleanup, &info);
 
+          /* The handler runs under the connection lock */
+
+          conn_unlock(&conn->sconn);
+
+#ifdef CONFIG_NET_BUSY_POLL
+          /* Poll the device for a while before going to sleep, the
+           * default device for a socket bound to INADDR_ANY.
+           */
+
+          netdev_busypoll(dev != NULL ? dev : netdev_default(),
+                          conn->sconn.s_busypoll, &state.ir_sem);
+#endif
+
           /* Wait for either the receive to complete or for an error/timeout
            * to occur.  net_sem_timedwait will also terminate if a signal is
            * received.
@@ -771,6 +985,7 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
           ret = net_sem_timedwait(&state.ir_sem,
                               _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
           tls_cleanup_pop(tls_get_info(), 0);
+          conn_lock(&conn->sconn);
           if (ret == -ETIMEDOUT)
             {
               ret = -EAGAIN;
@@ -789,9 +1004,135 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   udp_notify_recvcpu(conn);
 
-  net_unlock();
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  conn_unlock(&conn->sconn);
+  udp_recvfrom_uninitialize(&state);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive the datagram at the head of the read-ahead buffer of a UDP
+ *   socket without copying it:  its I/O buffer chain is detached from the
+ *   connection and handed over to the caller.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DGRAM socket
+ *   iob      Location to return the received I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the length of the datagram.  On error, -errno is
+ *   returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_udp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  struct udp_callback_s info;
+  struct udp_recvfrom_s state;
+  bool nonblock;
+  bool netlocked = false;
+  ssize_t ret = OK;
+
+  conn_lock(&conn->sconn);
+
+  /* Only a receive that has to wait needs the network lock */
+
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+  if (!nonblock && conn->readahead == NULL)
+    {
+      conn_net_lock(&conn->sconn);
+      netlocked = true;
+    }
+
+  udp_recvfrom_initialize(conn, NULL, &state, flags);
+
+  if (conn->readahead == NULL)
+    {
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+        }
+      else
+        {
+          DEBUGASSERT(netlocked);
+
+          dev = udp_find_laddr_device(conn);
+
+          state.ir_cb = udp_callback_alloc(dev, conn);
+          if (state.ir_cb != NULL)
+            {
+              state.ir_cb->flags = (UDP_NEWDATA | NETDEV_DOWN);
+              state.ir_cb->priv  = (FAR void *)&state;
+              state.ir_cb->event = udp_recviob_eventhandler;
+
+              info.dev    = dev;
+              info.conn   = conn;
+              info.udp_cb = state.ir_cb;
+              info.sem    = &state.ir_sem;
+              tls_cleanup_push(tls_get_info(), udp_callback_cleanup, &info);
+
+              /* The handler runs under the connection lock */
+
+              conn_unlock(&conn->sconn);
+              ret = net_sem_timedwait(&state.ir_sem,
+                                      _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+              tls_cleanup_pop(tls_get_info(), 0);
+              conn_lock(&conn->sconn);
+              if (ret == -ETIMEDOUT)
+                {
+                  ret = -EAGAIN;
+                }
+
+              udp_callback_free(dev, conn, state.ir_cb);
+              if (ret >= 0)
+                {
+                  ret = state.ir_result;
+                }
+            }
+          else
+            {
+              ret = -EBUSY;
+            }
+        }
+    }
+
+  /* Hand the datagram at the head of the read-ahead buffer over */
+
+  if (ret >= 0 && conn->readahead != NULL)
+    {
+      ret = udp_readahead_detach(conn, iob);
+    }
+  else if (ret >= 0)
+    {
+      /* Woken up, but the datagram was dropped before it was queued */
+
+      ret = -EAGAIN;
+    }
+
+  udp_notify_recvcpu(conn);
+
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  conn_unlock(&conn->sconn);
   udp_recvfrom_uninitialize(&state);
   return ret;
 }
+#endif /* CONFIG_NET_ZEROCOPY */
 
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
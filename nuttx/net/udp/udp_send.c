@@ -121,6 +121,56 @@ static void udp_send_loopback(FAR struct net_driver_s *dev)
 }
 #endif
 
+#ifdef NEED_UDP_WB_CHKSUM
+/****************************************************************************
+ * Name: udp_wb_chksum
+ *
+ * Description:
+ *   Calculate the UDP checksum of a buffered datagram from the sum of its
+ *   payload, accumulated when it was copied into the write buffer, so
+ *   that only the pseudo-header and the UDP header have to be summed here.
+ *
+ ****************************************************************************/
+
+static uint16_t udp_wb_chksum(FAR struct net_driver_s *dev,
+                              FAR struct udp_conn_s *conn,
+                              FAR struct udp_hdr_s *udp)
+{
+  uint16_t sum;
+
+  conn->flags &= ~_UDP_FLAG_SNDCHKSUM;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (IFF_IS_IPv4(dev->d_flags))
+#endif
+    {
+      sum = ipv4_upperlayer_header_chksum(dev, IP_PROTO_UDP);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      sum = ipv6_upperlayer_header_chksum(dev, IP_PROTO_UDP, IPv6_HDRLEN);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  /* The UDP header has an even length, the payload sum follows it */
+
+  sum = chksum(sum, (FAR uint8_t *)udp, UDP_HDRLEN);
+  sum += conn->sndchksum;
+  if (sum < conn->sndchksum)
+    {
+      sum++; /* carry */
+    }
+
+  return (sum == 0) ? 0xffff : HTONS(sum);
+}
+#endif /* NEED_UDP_WB_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -250,6 +300,49 @@ void udp_send(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
 #ifdef CONFIG_NET_UDP_CHECKSUMS
       /* Calculate UDP checksum. */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+      dev->d_offload = 0;
+#endif
+
+#ifdef NEED_UDP_WB_CHKSUM
+      if ((conn->flags & _UDP_FLAG_SNDCHKSUM) != 0)
+        {
+          udp->udpchksum = ~udp_wb_chksum(dev, conn, udp);
+        }
+      else
+#endif
+#ifdef CONFIG_NETDEV_OFFLOAD
+      if (NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+        {
+          /* Leave the checksum to the device, which only needs the sum of
+           * the pseudo-header.
+           */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+          if (IFF_IS_IPv4(dev->d_flags))
+#endif
+            {
+              udp->udpchksum =
+                HTONS(ipv4_upperlayer_header_chksum(dev, IP_PROTO_UDP));
+            }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+          else
+#endif
+            {
+              udp->udpchksum =
+                HTONS(ipv6_upperlayer_header_chksum(dev, IP_PROTO_UDP,
+                                                    IPv6_HDRLEN));
+            }
+#endif /* CONFIG_NET_IPv6 */
+
+          dev->d_offload = NETDEV_OFFLOAD_CSUM;
+        }
+      else
+#endif
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
       if (IFF_IS_IPv4(dev->d_flags))
@@ -258,7 +258,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       if (!conn->lport)
         {
           nerr("ERROR: Failed to get a local port!\n");
@@ -457,6 +457,13 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
       wrb->wb_iob = NULL;
 
+#ifdef NEED_UDP_WB_CHKSUM
+      /* Hand the payload sum over to udp_send() */
+
+      conn->sndchksum = wrb->wb_chksum;
+      conn->flags    |= _UDP_FLAG_SNDCHKSUM;
+#endif
+
 #ifdef NEED_IPDOMAIN_SUPPORT
       /* If both IPv4 and IPv6 support are enabled, then we will need to
        * select which one to use when generating the outgoing packet.
@@ -513,6 +520,48 @@ static unsigned int udp_send_gettimeout(clock_t start, unsigned int timeout)
   return timeout;
 }
 
+/****************************************************************************
+ * Name: sendto_connected_dest
+ *
+ * Description:
+ *   Set the destination of a write buffer to the remote address of a
+ *   connected UDP socket.
+ *
+ ****************************************************************************/
+
+static void sendto_connected_dest(FAR struct udp_conn_s *conn,
+                                  FAR struct udp_wrbuffer_s *wrb)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      FAR struct sockaddr_in *addr4 =
+        (FAR struct sockaddr_in *)&wrb->wb_dest;
+
+      addr4->sin_family = AF_INET;
+      addr4->sin_port   = conn->rport;
+      net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
+      memset(addr4->sin_zero, 0, sizeof(addr4->sin_zero));
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      FAR struct sockaddr_in6 *addr6 =
+        (FAR struct sockaddr_in6 *)&wrb->wb_dest;
+
+      addr6->sin6_family = AF_INET6;
+      addr6->sin6_port   = conn->rport;
+      net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -551,6 +600,7 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
   unsigned int timeout;
   uint16_t udpiplen;
   bool nonblock;
+  bool netlocked = false;
   bool empty;
   int ret = OK;
   clock_t start;
@@ -689,7 +739,11 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
-      net_lock();
+      /* The datagram is buffered under the connection lock.  The network
+       * is only locked to set up a transfer for an idle write queue.
+       */
+
+      conn_lock(&conn->sconn);
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
       /* If the send buffer size exceeds the send limit,
@@ -704,8 +758,10 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
               goto errout_with_lock;
             }
 
+          conn_unlock(&conn->sconn);
           ret = net_sem_timedwait_uninterruptible(&conn->sndsem,
             udp_send_gettimeout(start, timeout));
+          conn_lock(&conn->sconn);
           if (ret < 0)
             {
               if (ret == -ETIMEDOUT)
@@ -718,8 +774,8 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
         }
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
-      /* Allocate a write buffer.  Careful, the network will be momentarily
-       * unlocked here.
+      /* Allocate a write buffer.  Careful, the connection will be
+       * momentarily unlocked here.
        */
 
 #ifdef CONFIG_NET_JUMBO_FRAME
@@ -729,14 +785,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       wrb = udp_wrbuffer_tryalloc(len + udpip_hdrsize(conn) +
                                   CONFIG_NET_LL_GUARDSIZE);
 #else
-      if (nonblock)
-        {
-          wrb = udp_wrbuffer_tryalloc();
-        }
-      else
+      wrb = udp_wrbuffer_tryalloc();
+      if (wrb == NULL && !nonblock)
         {
+          conn_unlock(&conn->sconn);
           wrb = udp_wrbuffer_timedalloc(udp_send_gettimeout(start,
                                                             timeout));
+          conn_lock(&conn->sconn);
         }
 #endif
 
@@ -767,43 +822,19 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
         {
           /* Yes.. get the connection address from the connection structure */
 
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-          if (conn->domain == PF_INET)
-#endif
-            {
-              FAR struct sockaddr_in *addr4 =
-                (FAR struct sockaddr_in *)&wrb->wb_dest;
-
-              addr4->sin_family = AF_INET;
-              addr4->sin_port   = conn->rport;
-              net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
-              memset(addr4->sin_zero, 0, sizeof(addr4->sin_zero));
-            }
-#endif /* CONFIG_NET_IPv4 */
-
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-          else
-#endif
-            {
-              FAR struct sockaddr_in6 *addr6 =
-                (FAR struct sockaddr_in6 *)&wrb->wb_dest;
-
-              addr6->sin6_family = AF_INET6;
-              addr6->sin6_port   = conn->rport;
-              net_ipv6addr_copy(addr6->sin6_addr.s6_addr,
-                                conn->u.ipv6.raddr);
-            }
-#endif /* CONFIG_NET_IPv6 */
+          sendto_connected_dest(conn, wrb);
         }
 
       /* Not connected.  Use the provided destination address */
 
       else
         {
+          /* Binding a local port needs the network lock */
+
           memcpy(&wrb->wb_dest, to, tolen);
+          conn_net_lock(&conn->sconn);
           udp_connect(conn, to);
+          net_unlock();
         }
 
       /* Skip l2/l3/l4 offset before copy */
@@ -819,26 +850,42 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
       if (nonblock)
         {
+#ifdef NEED_UDP_WB_CHKSUM
+          wrb->wb_chksum = 0;
+          ret = chksum_iob_copyin(wrb->wb_iob, buf, len, false,
+                                  &wrb->wb_chksum);
+#else
           ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
                               len, udpiplen, false);
+#endif
         }
       else
         {
           unsigned int count;
           int blresult;
 
-          /* iob_copyin might wait for buffers to be freed, but if
-           * network is locked this might never happen, since network
-           * driver is also locked, therefore we need to break the lock
+          /* iob_copyin might wait for buffers to be freed, which needs
+           * the write queue to drain, therefore we need to release the
+           * connection and, if the caller holds it, the network lock.
+           * The write buffer is not queued yet.
            */
 
+          conn_unlock(&conn->sconn);
           blresult = net_breaklock(&count);
+#ifdef NEED_UDP_WB_CHKSUM
+          wrb->wb_chksum = 0;
+          ret = chksum_iob_copyin(wrb->wb_iob, buf, len, true,
+                                  &wrb->wb_chksum);
+#else
           ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
                            len, udpiplen, false);
+#endif
           if (blresult >= 0)
             {
               net_restorelock(count);
             }
+
+          conn_lock(&conn->sconn);
         }
 
       if (ret < 0)
@@ -859,8 +906,20 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
        * device out-of-queued-order to optimize performance.  Sending
        * data to different networks from a single UDP socket is probably
        * not a very common use case, however.
+       *
+       * Setting up the transfer of a new head of the write queue needs the
+       * network lock.  Check again once it is held, the connection may
+       * have been unlocked while taking it.  A non-empty queue already has
+       * a transfer in progress and cannot drain while we hold the
+       * connection lock.
        */
 
+      if (sq_empty(&conn->write_q))
+        {
+          conn_net_lock(&conn->sconn);
+          netlocked = true;
+        }
+
       empty = sq_empty(&conn->write_q);
 
       sq_addlast(&wrb->wb_node, &conn->write_q);
@@ -876,6 +935,8 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
            * the write buffer queue.
            */
 
+          DEBUGASSERT(netlocked);
+
           ret = sendto_next_transfer(conn);
           if (ret < 0)
             {
@@ -884,7 +945,12 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
             }
         }
 
-      net_unlock();
+      if (netlocked)
+        {
+          net_unlock();
+        }
+
+      conn_unlock(&conn->sconn);
     }
 
   /* Return the number of bytes that will be sent */
@@ -895,9 +961,223 @@ errout_with_wrb:
   udp_wrbuffer_release(wrb);
 
 errout_with_lock:
-  net_unlock();
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  conn_unlock(&conn->sconn);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_udp_sendiob
+ *
+ * Description:
+ *   Queue a caller-filled I/O buffer chain as one datagram on a connected
+ *   UDP socket without copying it.  The headers are built in front of the
+ *   payload, in the first IOB of the chain if it has room for them and in
+ *   an IOB of their own otherwise.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iob      On entry, the datagram to send.  On return, NULL if it was
+ *            queued, otherwise the chain is left to the caller.
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the length of the datagram.  On error, a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+ssize_t psock_udp_sendiob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          int flags)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  FAR struct udp_wrbuffer_s *wrb;
+  FAR struct iob_s *head = *iob;
+  unsigned int udpiplen;
+  unsigned int timeout;
+  unsigned int len = head->io_pktlen;
+  bool nonblock;
+  bool netlocked = false;
+  bool empty;
+  int ret = OK;
+  clock_t start;
+
+  if (len > 65535)
+    {
+      return -EMSGSIZE;
+    }
+
+  /* There is no destination address, the socket must be connected */
+
+  if (!_SS_ISCONNECTED(conn->sconn.s_flags))
+    {
+      return -EDESTADDRREQ;
+    }
+
+#ifdef CONFIG_NET_ARP_SEND
+  if (psock->s_domain == PF_INET && arp_send(conn->u.ipv4.raddr) < 0)
+    {
+      nerr("ERROR: Not reachable\n");
+      return -ENETUNREACH;
+    }
+#endif
+
+#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
+  if (psock->s_domain == PF_INET6 &&
+      icmpv6_neighbor(NULL, conn->u.ipv6.raddr) < 0)
+    {
+      nerr("ERROR: Not reachable\n");
+      return -ENETUNREACH;
+    }
+#endif
+
+  nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
+                            (flags & MSG_DONTWAIT) != 0;
+  start    = clock_systime_ticks();
+  timeout  = _SO_TIMEOUT(conn->sconn.s_sndtimeo);
+  udpiplen = udpip_hdrsize(conn);
+
+  conn_lock(&conn->sconn);
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  while (udp_wrbuffer_inqueue_size(conn) + len > conn->sndbufs)
+    {
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          goto errout_with_lock;
+        }
+
+      conn_unlock(&conn->sconn);
+      ret = net_sem_timedwait_uninterruptible(&conn->sndsem,
+        udp_send_gettimeout(start, timeout));
+      conn_lock(&conn->sconn);
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
+            {
+              ret = -EAGAIN;
+            }
+
+          goto errout_with_lock;
+        }
+    }
+#endif /* CONFIG_NET_SEND_BUFSIZE */
+
+  /* Only the write buffer structure is allocated here, it cannot wait for
+   * the IOBs of the caller.
+   */
+
+  conn_unlock(&conn->sconn);
+  wrb = udp_wrbuffer_timedattach(*iob, nonblock ? 0 :
+                                 udp_send_gettimeout(start, timeout));
+  conn_lock(&conn->sconn);
+
+  if (wrb == NULL)
+    {
+      ret = (nonblock || timeout != UINT_MAX) ? -EAGAIN : -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  if (head->io_offset < CONFIG_NET_LL_GUARDSIZE + udpiplen)
+    {
+      head = iob_tryalloc(false);
+      if (head == NULL)
+        {
+          ret = -EAGAIN;
+          goto errout_with_wrb;
+        }
+
+      iob_reserve(head, CONFIG_NET_LL_GUARDSIZE + udpiplen);
+      head->io_flink  = *iob;
+      head->io_pktlen = len;
+    }
+
+  /* Skip l2/l3/l4 offset, like psock_udp_sendto() */
+
+  head->io_offset -= udpiplen;
+  head->io_len    += udpiplen;
+  head->io_pktlen += udpiplen;
+
+  wrb->wb_iob = head;
+  sendto_connected_dest(conn, wrb);
+#ifdef NEED_UDP_WB_CHKSUM
+  wrb->wb_chksum = chksum_iob(0, head, udpiplen);
+#endif
+
+  UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
+
+  /* Queue it like psock_udp_sendto(), an idle write queue needs the
+   * network lock to set up the transfer.
+   */
+
+  if (sq_empty(&conn->write_q))
+    {
+      conn_net_lock(&conn->sconn);
+      netlocked = true;
+    }
+
+  empty = sq_empty(&conn->write_q);
+  sq_addlast(&wrb->wb_node, &conn->write_q);
+
+  if (empty)
+    {
+      DEBUGASSERT(netlocked);
+
+      ret = sendto_next_transfer(conn);
+      if (ret < 0)
+        {
+          sq_remlast(&conn->write_q);
+
+          /* Give the chain back to the caller as it was */
+
+          if (head != *iob)
+            {
+              head->io_flink = NULL;
+              iob_free(head);
+            }
+          else
+            {
+              head->io_offset += udpiplen;
+              head->io_len    -= udpiplen;
+              head->io_pktlen -= udpiplen;
+            }
+
+          goto errout_with_wrb;
+        }
+    }
+
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  conn_unlock(&conn->sconn);
+
+  /* The stack owns the chain now */
+
+  *iob = NULL;
+  return len;
+
+errout_with_wrb:
+  wrb->wb_iob = NULL;
+  udp_wrbuffer_release(wrb);
+
+errout_with_lock:
+  if (netlocked)
+    {
+      net_unlock();
+    }
+
+  conn_unlock(&conn->sconn);
   return ret;
 }
+#endif /* CONFIG_NET_ZEROCOPY */
 
 /****************************************************************************
  * Name: psock_udp_cansend
@@ -159,6 +159,41 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_timedalloc(unsigned int timeout)
   return wrb;
 }
 
+/****************************************************************************
+ * Name: udp_wrbuffer_timedattach
+ *
+ * Description:
+ *   Allocate a UDP write buffer like udp_wrbuffer_timedalloc(), but
+ *   attach the caller's I/O buffer chain to it instead of allocating the
+ *   first IOB.
+ *
+ * Input Parameters:
+ *   iob       - The I/O buffer chain holding the datagram
+ *   timeout   - The relative time to wait until a timeout is declared.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+FAR struct udp_wrbuffer_s *udp_wrbuffer_timedattach(FAR struct iob_s *iob,
+                                                    unsigned int timeout)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+
+  DEBUGASSERT(iob != NULL);
+
+  wrb = NET_BUFPOOL_TIMEDALLOC(g_wrbuffer, timeout);
+  if (wrb != NULL)
+    {
+      wrb->wb_iob = iob;
+    }
+
+  return wrb;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_wrbuffer_tryalloc
  *
@@ -29,6 +29,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "utils/utils.h"
 
@@ -82,7 +83,8 @@ static void net_bufpool_init(FAR struct net_bufpool_s *pool)
  *
  * Description:
  *   Allocate a buffer from the pool.  If no buffer is available, then wait
- *   for the specified timeout.
+ *   for the specified timeout.  The free list has its own lock, so the
+ *   network does not need to be locked.
  *
  * Input Parameters:
  *   pool    - The pool from which to allocate the buffer
@@ -98,15 +100,20 @@ FAR void *net_bufpool_timedalloc(FAR struct net_bufpool_s *pool,
                                  unsigned int timeout)
 {
   FAR struct net_bufnode_s *node;
+  FAR struct net_bufnode_s *next;
+  irqstate_t flags;
   int ret;
   int i;
 
+  flags = spin_lock_irqsave(&pool->lock);
   if (pool->nodesize < 0)
     {
       net_bufpool_init(pool);
       DEBUGASSERT(pool->nodesize > 0);
     }
 
+  spin_unlock_irqrestore(&pool->lock, flags);
+
   if (timeout == 0)
     {
       ret = nxsem_trywait(&pool->sem);
@@ -123,25 +130,35 @@ FAR void *net_bufpool_timedalloc(FAR struct net_bufpool_s *pool,
 
   /* If we get here, then we didn't exceed maxalloc. */
 
-  if (pool->dynalloc > 0 && sq_peek(&pool->freebuffers) == NULL)
+  flags = spin_lock_irqsave(&pool->lock);
+  node  = (FAR struct net_bufnode_s *)sq_remfirst(&pool->freebuffers);
+  spin_unlock_irqrestore(&pool->lock, flags);
+
+  if (node == NULL && pool->dynalloc > 0)
     {
+      /* Allocate outside of the lock, keep the first of the new nodes */
+
       node = kmm_zalloc(pool->nodesize * pool->dynalloc);
       if (node == NULL)
         {
           return NULL;
         }
 
-      /* Now initialize each connection structure */
+      /* Put the remaining new nodes in the free list */
 
-      for (i = 0; i < pool->dynalloc; i++)
+      next  = node;
+      flags = spin_lock_irqsave(&pool->lock);
+      for (i = 1; i < pool->dynalloc; i++)
         {
-          sq_addlast(&node->node, &pool->freebuffers);
-          node = (FAR struct net_bufnode_s *)
-                                      ((FAR char *)node + pool->nodesize);
+          next = (FAR struct net_bufnode_s *)
+                                      ((FAR char *)next + pool->nodesize);
+          sq_addlast(&next->node, &pool->freebuffers);
         }
+
+      spin_unlock_irqrestore(&pool->lock, flags);
     }
 
-  return sq_remfirst(&pool->freebuffers);
+  return node;
 }
 
 /****************************************************************************
@@ -158,6 +175,8 @@ FAR void *net_bufpool_timedalloc(FAR struct net_bufpool_s *pool,
 
 void net_bufpool_free(FAR struct net_bufpool_s *pool, FAR void *node)
 {
+  irqstate_t flags;
+
   DEBUGASSERT(pool->nodesize > 0);
 
   if (pool->dynalloc == 1 &&
@@ -175,7 +194,10 @@ void net_bufpool_free(FAR struct net_bufpool_s *pool, FAR void *node)
        */
 
       memset(net_bufnode, 0, pool->nodesize);
+
+      flags = spin_lock_irqsave(&pool->lock);
       sq_addlast(&net_bufnode->node, &pool->freebuffers);
+      spin_unlock_irqrestore(&pool->lock, flags);
     }
 
   nxsem_post(&pool->sem);
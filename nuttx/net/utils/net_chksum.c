@@ -27,86 +27,286 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/mm/iob.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the pieces in which unaligned data is copied and then summed,
+ * small enough for the copy to still be in the L1 cache.  Must be even.
+ */
+
+#define CHKSUM_COPY_CHUNK  256
+
+/* The arch block routine works on multiples of this size */
+
+#define CHKSUM_BLOCK_SIZE  64
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
+
 /****************************************************************************
- * Name: checksum
+ * Name: chksum_add
  *
  * Description:
- *   Calculate the raw change sum over the memory region described by
- *   data and len.
+ *   One's complement addition of two 16-bit values.
+ *
+ ****************************************************************************/
+
+static inline_function uint16_t chksum_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
+/****************************************************************************
+ * Name: chksum_fold
+ *
+ * Description:
+ *   Fold a 64-bit accumulator of 16-bit words into a 16-bit one's
+ *   complement sum.
+ *
+ ****************************************************************************/
+
+static inline_function uint16_t chksum_fold(uint64_t acc)
+{
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)acc;
+}
+
+/****************************************************************************
+ * Name: chksum_partial
+ *
+ * Description:
+ *   Calculate the one's complement sum of the 16-bit big-endian words of
+ *   a buffer, a trailing odd byte being the high byte of the last word.
+ *   The data is optionally copied to 'dst' in the same pass.
+ *
+ *   The bulk of the data is summed as native-endian 32-bit words into a
+ *   64-bit accumulator, which cannot overflow for any 16-bit length, so
+ *   no carry has to be propagated in the loop.  The one's complement sum
+ *   is independent of the byte order (RFC 1071), it is only swapped to
+ *   big-endian after the fold.
  *
  * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to
- *          chksum().  This should be zero on the first time that check
- *          sum is called.
- *   data - Beginning of the data to include in the checksum.
+ *   dst  - Destination of the copy, or NULL to only sum the data.  Must
+ *          have the same alignment as 'src' modulo 4.
+ *   src  - Beginning of the data to include in the checksum.
  *   len  - Length of the data to include in the checksum.
- *   odd  - the flag of the Calculated data sum
  *
  * Returned Value:
- *   The updated checksum value.
+ *   The 16-bit sum in host byte order.
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
-                    uint16_t len, bool *odd)
+static inline_function uint16_t chksum_partial(FAR uint8_t *dst,
+                                               FAR const uint8_t *src,
+                                               size_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *words;
+  uint64_t acc = 0;
+  uint16_t lead = 0;
+  uint16_t sum;
+  bool swap = false;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (len == 0)
+    {
+      return 0;
+    }
 
-  if (*odd == true)
+  /* Starting on an odd address: take the first byte apart as the high
+   * byte of the first word and sum the rest, which is then shifted by one
+   * byte, with the bytes swapped.
+   */
+
+  if (((uintptr_t)src & 1) != 0)
     {
-      t = dataptr[0];
-      sum += t;
-      if (sum < t)
+      lead = (uint16_t)src[0] << 8;
+      if (dst != NULL)
         {
-          sum++; /* carry */
+          *dst++ = src[0];
         }
 
-      dataptr += 1;
+      src++;
+      len--;
+      swap = true;
     }
 
-  while (dataptr < last_byte)
+  /* Align to the 32-bit words */
+
+  if (((uintptr_t)src & 2) != 0 && len >= 2)
     {
-      /* At least two more bytes */
+      acc += *(FAR const uint16_t *)src;
+      if (dst != NULL)
+        {
+          *(FAR uint16_t *)dst = *(FAR const uint16_t *)src;
+          dst += 2;
+        }
+
+      src += 2;
+      len -= 2;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
+  words = (FAR const uint32_t *)src;
+
+#ifdef CONFIG_NET_ARCH_CHKSUM_BLOCK
+  if (dst == NULL && len >= CHKSUM_BLOCK_SIZE)
+    {
+      size_t nblock = len & ~(CHKSUM_BLOCK_SIZE - 1);
+
+      acc   += up_chksum_block(words, nblock);
+      words += nblock / 4;
+      len   -= nblock;
+    }
+#endif
+
+  if (dst != NULL)
+    {
+      FAR uint32_t *dwords = (FAR uint32_t *)dst;
+
+      for (; len >= 32; len -= 32, words += 8, dwords += 8)
+        {
+          uint32_t w0 = words[0];
+          uint32_t w1 = words[1];
+          uint32_t w2 = words[2];
+          uint32_t w3 = words[3];
+          uint32_t w4 = words[4];
+          uint32_t w5 = words[5];
+          uint32_t w6 = words[6];
+          uint32_t w7 = words[7];
+
+          dwords[0] = w0;
+          dwords[1] = w1;
+          dwords[2] = w2;
+          dwords[3] = w3;
+          dwords[4] = w4;
+          dwords[5] = w5;
+          dwords[6] = w6;
+          dwords[7] = w7;
+
+          acc += (uint64_t)w0 + w1 + w2 + w3;
+          acc += (uint64_t)w4 + w5 + w6 + w7;
+        }
+
+      for (; len >= 4; len -= 4)
+        {
+          *dwords++ = *words;
+          acc += *words++;
+        }
+
+      dst = (FAR uint8_t *)dwords;
+    }
+  else
+    {
+      for (; len >= 32; len -= 32, words += 8)
         {
-          sum++; /* carry */
+          acc += (uint64_t)words[0] + words[1] + words[2] + words[3];
+          acc += (uint64_t)words[4] + words[5] + words[6] + words[7];
         }
 
-      dataptr += 2;
+      for (; len >= 4; len -= 4)
+        {
+          acc += *words++;
+        }
     }
 
-  *odd = false;
+  /* Then the remaining 16-bit word and odd byte */
 
-  if (dataptr == last_byte)
+  src = (FAR const uint8_t *)words;
+  if (len >= 2)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      acc += *(FAR const uint16_t *)src;
+      if (dst != NULL)
         {
-          sum++; /* carry */
+          *(FAR uint16_t *)dst = *(FAR const uint16_t *)src;
+          dst += 2;
         }
 
-      *odd = true;
+      src += 2;
+      len -= 2;
     }
 
-  /* Return sum in host byte order. */
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint16_t)src[0] << 8;
+#else
+      acc += src[0];
+#endif
+      if (dst != NULL)
+        {
+          *dst = src[0];
+        }
+    }
 
-  return sum;
+  sum = NTOHS(chksum_fold(acc));
+  if (swap)
+    {
+      sum = (uint16_t)((sum << 8) | (sum >> 8));
+    }
+
+  return chksum_add(sum, lead);
+}
+
+/****************************************************************************
+ * Name: checksum
+ *
+ * Description:
+ *   Calculate the raw change sum over the memory region described by
+ *   data and len.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *   odd  - the flag of the Calculated data sum
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
+                    uint16_t len, bool *odd)
+{
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* Complete the word whose high byte ended the previous region */
+
+  if (*odd == true)
+    {
+      sum = chksum_add(sum, data[0]);
+      data++;
+      len--;
+    }
+
+  *odd = (len & 1) != 0;
+
+  return chksum_add(sum, chksum_partial(NULL, data, len));
 }
 
 /****************************************************************************
@@ -139,6 +339,67 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
   return checksum(sum, data, len, &odd);
 }
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy a buffer and calculate its raw change sum in the same pass, with
+ *   the same semantics as checksum().
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.
+ *   dst  - Destination of the copy.
+ *   src  - Beginning of the data to copy and include in the checksum.
+ *   len  - Length of the data.
+ *   odd  - The odd byte state carried over from a previous call.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dst,
+                     FAR const uint8_t *src, uint16_t len, FAR bool *odd)
+{
+  uint16_t ncopy;
+
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  if (*odd == true)
+    {
+      *dst++ = *src;
+      sum = chksum_add(sum, *src++);
+      len--;
+    }
+
+  *odd = (len & 1) != 0;
+
+  if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0)
+    {
+      return chksum_add(sum, chksum_partial(dst, src, len));
+    }
+
+  /* The words cannot be both loaded and stored aligned: copy in pieces
+   * and sum each piece while it is still in the cache.
+   */
+
+  while (len > 0)
+    {
+      ncopy = len > CHKSUM_COPY_CHUNK ? CHKSUM_COPY_CHUNK : len;
+      memcpy(dst, src, ncopy);
+      sum = chksum(sum, dst, ncopy);
+
+      dst += ncopy;
+      src += ncopy;
+      len -= ncopy;
+    }
+
+  return sum;
+}
+
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
 /****************************************************************************
@@ -188,6 +449,100 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 }
 #endif /* CONFIG_MM_IOB */
 
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Append data to the end of an iob chain, extending the chain as
+ *   necessary, and accumulate the raw change sum of the data as it is
+ *   copied.  The data is summed as if it started a new region: 'sum'
+ *   can be combined with the sum of an even-length prefix.
+ *
+ * Input Parameters:
+ *   iob       - The iob chain to append the data to.
+ *   src       - The data to copy.
+ *   len       - Length of the data.
+ *   can_block - Whether to wait for free iobs.
+ *   sum       - The sum of the data is accumulated into this location.
+ *
+ * Returned Value:
+ *   The number of bytes copied, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM) && defined(CONFIG_MM_IOB)
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, bool can_block, FAR uint16_t *sum)
+{
+  FAR struct iob_s *tail;
+  unsigned int offset = iob->io_pktlen;
+  unsigned int avail = 0;
+  unsigned int ncopy;
+  bool odd = false;
+  int ret;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  /* Extend the chain up front, so that the data is copied and summed in
+   * a single walk.
+   */
+
+  for (tail = iob; ; tail = tail->io_flink)
+    {
+      avail += IOB_BUFSIZE(tail) - tail->io_offset;
+      if (tail->io_flink == NULL)
+        {
+          break;
+        }
+    }
+
+  while (avail < offset + len)
+    {
+      tail->io_flink = can_block ? iob_alloc(false) : iob_tryalloc(false);
+      if (tail->io_flink == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      tail   = tail->io_flink;
+      avail += IOB_BUFSIZE(tail) - tail->io_offset;
+    }
+
+  ret = iob_update_pktlen(iob, offset + len, false);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Skip to the I/O buffer holding the end of the existing data */
+
+  while (offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  for (ret = len; len > 0; len -= ncopy, src += ncopy)
+    {
+      ncopy = iob->io_len - offset;
+      if (ncopy > len)
+        {
+          ncopy = len;
+        }
+
+      *sum   = chksum_copy(*sum, iob->io_data + iob->io_offset + offset,
+                           src, ncopy, &odd);
+      iob    = iob->io_flink;
+      offset = 0;
+    }
+
+  return ret;
+}
+#endif /* !CONFIG_NET_ARCH_CHKSUM && CONFIG_MM_IOB */
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -39,6 +39,8 @@
 #include <nuttx/sched.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
 
 #include "utils/utils.h"
 
@@ -52,6 +54,11 @@
  * Private Data
  ****************************************************************************/
 
+/* The global network lock.  It is taken before any device lock
+ * (net_driver_s::d_lock), which is taken before any connection lock
+ * (socket_conn_s::s_lock).
+ */
+
 static rmutex_t g_netlock = NXRMUTEX_INITIALIZER;
 
 /****************************************************************************
@@ -135,7 +142,43 @@ _net_timedwait(FAR sem_t *sem, bool interruptible, unsigned int timeout)
 
 int net_lock(void)
 {
+#ifdef CONFIG_NET_LOCK_STATISTICS
+  clock_t elapsed;
+  clock_t start;
+  int ret;
+
+  /* Uncontended (or recursive) acquisition: just count it */
+
+  ret = nxrmutex_trylock(&g_netlock);
+  if (ret >= 0)
+    {
+      g_netstats.lock.acquired++;
+      return ret;
+    }
+
+  /* Somebody else holds the lock, measure how long we wait for it.  The
+   * statistics are only updated once we own the lock.
+   */
+
+  start = perf_gettime();
+  ret   = nxrmutex_lock(&g_netlock);
+  if (ret >= 0)
+    {
+      elapsed = perf_gettime() - start;
+
+      g_netstats.lock.acquired++;
+      g_netstats.lock.contended++;
+      g_netstats.lock.waittime += elapsed;
+      if (elapsed > g_netstats.lock.maxwait)
+        {
+          g_netstats.lock.maxwait = elapsed;
+        }
+    }
+
+  return ret;
+#else
   return nxrmutex_lock(&g_netlock);
+#endif
 }
 
 /****************************************************************************
@@ -179,6 +222,116 @@ void net_unlock(void)
   nxrmutex_unlock(&g_netlock);
 }
 
+/****************************************************************************
+ * Name: conn_lock
+ *
+ * Description:
+ *   Take the lock of a TCP or UDP connection.
+ *
+ * Input Parameters:
+ *   sconn - The connection to be locked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_lock(FAR struct socket_conn_s *sconn)
+{
+  nxrmutex_lock(&sconn->s_lock);
+}
+
+/****************************************************************************
+ * Name: conn_unlock
+ *
+ * Description:
+ *   Release the lock of a TCP or UDP connection.
+ *
+ * Input Parameters:
+ *   sconn - The connection to be unlocked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_unlock(FAR struct socket_conn_s *sconn)
+{
+  nxrmutex_unlock(&sconn->s_lock);
+}
+
+/****************************************************************************
+ * Name: conn_net_lock
+ *
+ * Description:
+ *   Take the network lock while holding the lock of a connection.  If the
+ *   network lock is busy, the connection lock is dropped while waiting for
+ *   it, because its holder may be about to take the connection lock.
+ *
+ * Input Parameters:
+ *   sconn - The connection locked by the caller
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void conn_net_lock(FAR struct socket_conn_s *sconn)
+{
+  unsigned int count;
+  int ret;
+
+  if (net_trylock() >= 0)
+    {
+      return;
+    }
+
+  ret = nxrmutex_breaklock(&sconn->s_lock, &count);
+  net_lock();
+  if (ret >= 0)
+    {
+      nxrmutex_restorelock(&sconn->s_lock, count);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_lock
+ *
+ * Description:
+ *   Take the lock of a network device.
+ *
+ * Input Parameters:
+ *   dev - The device to be locked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_lock(FAR struct net_driver_s *dev)
+{
+  nxrmutex_lock(&dev->d_lock);
+}
+
+/****************************************************************************
+ * Name: netdev_unlock
+ *
+ * Description:
+ *   Release the lock of a network device.
+ *
+ * Input Parameters:
+ *   dev - The device to be unlocked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_unlock(FAR struct net_driver_s *dev)
+{
+  nxrmutex_unlock(&dev->d_lock);
+}
+
 /****************************************************************************
  * Name: net_breaklock
  *
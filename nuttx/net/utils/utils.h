@@ -32,6 +32,7 @@
 
 #include <stdlib.h>
 
+#include <nuttx/spinlock.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
@@ -97,7 +98,8 @@
       dynalloc, \
       -(int)(nodesize), \
       SEM_INITIALIZER(NET_BUFPOOL_MAX(prealloc, dynalloc, maxalloc)), \
-      { NULL, NULL } \
+      { NULL, NULL }, \
+      SP_UNLOCKED \
     };
 
 #define NET_BUFPOOL_TIMEDALLOC(p,t) net_bufpool_timedalloc(&p, t)
@@ -133,6 +135,7 @@ struct net_bufpool_s
   sem_t      sem;      /* The semaphore for waiting for free buffers */
 
   sq_queue_t freebuffers;
+  spinlock_t lock;     /* Protects freebuffers, the pool needs no net_lock */
 };
 
 /****************************************************************************
@@ -438,6 +441,24 @@ void net_chksum_adjust(FAR uint16_t *chksum,
                        FAR const uint16_t *optr, ssize_t olen,
                        FAR const uint16_t *nptr, ssize_t nlen);
 
+/****************************************************************************
+ * Name: chksum_iob_copyin
+ *
+ * Description:
+ *   Append data to the end of an iob chain, extending the chain as
+ *   necessary, and accumulate the raw change sum of the data into 'sum'
+ *   as it is copied.
+ *
+ * Returned Value:
+ *   The number of bytes copied, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+int chksum_iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
+                      unsigned int len, bool can_block, FAR uint16_t *sum);
+#endif
+
 /****************************************************************************
  * Name: tcp_chksum, tcp_ipv4_chksum, and tcp_ipv6_chksum
  *
@@ -92,7 +92,11 @@
  * task, is always the IDLE task.
  */
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+dq_queue_t g_readytorun[CONFIG_SMP_NCPUS];
+#else
 dq_queue_t g_readytorun;
+#endif
 
 /* In order to support SMP, the function of the g_readytorun list changes,
  * The g_readytorun is still used but in the SMP case it will contain only:
@@ -236,8 +240,14 @@ static void tasklist_initialize(void)
 
   /* TSTATE_TASK_READYTORUN */
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+  tlist[TSTATE_TASK_READYTORUN].list = g_readytorun;
+  tlist[TSTATE_TASK_READYTORUN].attr = TLIST_ATTR_PRIORITIZED |
+                                       TLIST_ATTR_INDEXED;
+#else
   tlist[TSTATE_TASK_READYTORUN].list = list_readytorun();
   tlist[TSTATE_TASK_READYTORUN].attr = TLIST_ATTR_PRIORITIZED;
+#endif
 
 #else
 
@@ -730,6 +740,13 @@ void nx_start(void)
 
   DEBUGVERIFY(nx_smp_start());
 
+#  if defined(CONFIG_SMP_PERCPU_RUNQUEUE) && \
+      CONFIG_SMP_LOADBALANCE_INTERVAL > 0
+  /* Start the periodic balancing of the per-CPU ready-to-run lists */
+
+  nxsched_balance_initialize();
+#  endif
+
 #endif /* CONFIG_SMP */
 
   /* Bring Up the System ****************************************************/
@@ -52,7 +52,12 @@
  * need to be prioritized).
  */
 
-#define list_readytorun()        (&g_readytorun)
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+#  define list_readytorun_cpu(cpu) (&g_readytorun[cpu])
+#else
+#  define list_readytorun()        (&g_readytorun)
+#  define list_readytorun_cpu(cpu) list_readytorun()
+#endif
 #ifndef CONFIG_SMP
 #define list_pendingtasks()      (&g_pendingtasks)
 #endif
@@ -165,7 +170,11 @@ enum task_deliver_e
  * task, is always the IDLE task.
  */
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+extern dq_queue_t g_readytorun[CONFIG_SMP_NCPUS];
+#else
 extern dq_queue_t g_readytorun;
+#endif
 
 #ifdef CONFIG_SMP
 /* In order to support SMP, the function of the g_readytorun list changes,
@@ -185,6 +194,11 @@ extern dq_queue_t g_readytorun;
  *    pthread_attr_setaffinity(), or
  *  - Temporarily through scheduling logic when a previously unassigned task
  *    is made to run.
+ *
+ * With CONFIG_SMP_PERCPU_RUNQUEUE there is one such list per CPU.  A task
+ * that is ready-to-run but not running is kept in the list of the CPU
+ * given by its tcb->cpu, and a CPU that looks for a task to run also
+ * takes (steals) tasks of higher priority from the lists of other CPUs.
  */
 
 extern FAR struct tcb_s *g_assignedtasks[CONFIG_SMP_NCPUS];
@@ -324,6 +338,18 @@ bool nxsched_merge_pending(void);
 bool nxsched_reprioritize_rtr(FAR struct tcb_s *tcb, int priority);
 #endif
 
+/* Insertion into and removal from the g_readytorun list (non-SMP) */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+bool nxsched_rtrlist_add(FAR struct tcb_s *tcb);
+void nxsched_rtrlist_remove(FAR struct tcb_s *tcb);
+#else
+#  define nxsched_rtrlist_add(tcb) \
+     nxsched_add_prioritized(tcb, list_readytorun())
+#  define nxsched_rtrlist_remove(tcb) \
+     dq_rem((FAR dq_entry_t *)(tcb), list_readytorun())
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -403,6 +429,12 @@ void nxsched_checkstackoverflow(FAR struct tcb_s *tcb);
 #ifdef CONFIG_SMP
 bool nxsched_switch_running(int cpu, bool switch_equal);
 void nxsched_process_delivered(int cpu);
+#  ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+FAR struct tcb_s *nxsched_peek_readytorun(int cpu, int priority);
+#    if CONFIG_SMP_LOADBALANCE_INTERVAL > 0
+void nxsched_balance_initialize(void);
+#    endif
+#  endif
 #else
 #  define nxsched_select_cpu(a)     (0)
 #endif
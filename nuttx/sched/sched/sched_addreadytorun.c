@@ -27,12 +27,112 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <strings.h>
 #include <assert.h>
 
 #include "irq/irq.h"
 #include "sched/queue.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Name:  nxsched_search_readytorun
+ *
+ * Description:
+ *   Search a ready-to-run list for the first task which is allowed to run
+ *   on 'cpu' and has a priority higher than 'priority'.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_search_readytorun(FAR dq_queue_t *list,
+                                                   int cpu, int priority)
+{
+  FAR struct tcb_s *btcb;
+
+  for (btcb = (FAR struct tcb_s *)dq_peek(list);
+       btcb && btcb->sched_priority > priority;
+       btcb = btcb->flink)
+    {
+      /* Check if the task found in ready-to-run list is allowed to run on
+       * this CPU. TCB_FLAG_CPU_LOCKED may be used to override affinity. If
+       * the flag is set, assume that btcb->cpu is valid, and it is the only
+       * CPU on which the btcb can run.
+       */
+
+      if (CPU_ISSET(cpu, &btcb->affinity) &&
+          ((btcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || btcb->cpu == cpu))
+        {
+          return btcb;
+        }
+    }
+
+  return NULL;
+}
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+/****************************************************************************
+ * Name:  nxsched_select_runqueue
+ *
+ * Description:
+ *   Select the CPU on which a task that is made ready-to-run is queued.
+ *   The CPU which the task last ran on and then the current CPU are
+ *   preferred if they are allowed and idle, since the task is likely still
+ *   cache-hot there and the decision does not require a look at every CPU.
+ *   Otherwise the CPU is chosen by nxsched_select_cpu().
+ *
+ * Returned Value:
+ *   The CPU whose ready-to-run list the task is added to.  *target is set
+ *   to that CPU if the task should run there at once, or to
+ *   CONFIG_SMP_NCPUS if no CPU is running a task of lower priority.
+ *
+ ****************************************************************************/
+
+static int nxsched_select_runqueue(FAR struct tcb_s *btcb,
+                                   FAR int *target)
+{
+  int cpu = btcb->cpu;
+
+  if (CPU_ISSET(cpu, &btcb->affinity) && is_idle_task(current_task(cpu)))
+    {
+      *target = cpu;
+      return cpu;
+    }
+
+  cpu = this_cpu();
+  if (CPU_ISSET(cpu, &btcb->affinity) && is_idle_task(current_task(cpu)))
+    {
+      *target = cpu;
+      return cpu;
+    }
+
+  cpu = nxsched_select_cpu(btcb->affinity);
+  *target = cpu;
+  if (cpu < CONFIG_SMP_NCPUS)
+    {
+      return cpu;
+    }
+
+  /* No CPU can take the task now, let it wait on the CPU it last ran on
+   * or on the first CPU it is allowed to run on.
+   */
+
+  cpu = btcb->cpu;
+  if (!CPU_ISSET(cpu, &btcb->affinity))
+    {
+      cpu = ffs(btcb->affinity) - 1;
+    }
+
+  return cpu;
+}
+#endif
+
+#endif /* CONFIG_SMP */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -91,7 +191,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* Otherwise, add the new task to the ready-to-run task list */
 
-  else if (nxsched_add_prioritized(btcb, list_readytorun()))
+  else if (nxsched_rtrlist_add(btcb))
     {
       /* The new btcb was added at the head of the ready-to-run list.  It
        * is now the new active task!
@@ -117,6 +217,62 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
 #else /* !CONFIG_SMP */
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+/****************************************************************************
+ * Name:  nxsched_peek_readytorun
+ *
+ * Description:
+ *   Find the highest priority task in the per-CPU ready-to-run lists
+ *   which is allowed to run on 'cpu' and has a priority higher than
+ *   'priority'.  The list of 'cpu' is searched first and the lists of the
+ *   other CPUs only for a task of an even higher priority.  An idle CPU
+ *   will so take any eligible task from another CPU, a busy CPU only one
+ *   that should preempt its own waiting tasks.  The head of every list is
+ *   read on each call.
+ *
+ * Input Parameters:
+ *   cpu      - The CPU that is looking for a task to run
+ *   priority - Only tasks of a higher priority are of interest
+ *
+ * Returned Value:
+ *   The TCB of the task, still in its ready-to-run list, or NULL.
+ *
+ * Assumptions:
+ * - The caller has established a critical section
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_peek_readytorun(int cpu, int priority)
+{
+  FAR struct tcb_s *btcb;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  btcb = nxsched_search_readytorun(list_readytorun_cpu(cpu), cpu,
+                                   priority);
+  if (btcb != NULL)
+    {
+      priority = btcb->sched_priority;
+    }
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i != cpu)
+        {
+          tcb = nxsched_search_readytorun(list_readytorun_cpu(i), cpu,
+                                          priority);
+          if (tcb != NULL)
+            {
+              btcb     = tcb;
+              priority = tcb->sched_priority;
+            }
+        }
+    }
+
+  return btcb;
+}
+#endif
+
 /****************************************************************************
  * Name:  nxsched_switch_running
  *
@@ -149,7 +305,6 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
   FAR struct tcb_s *rtcb = current_task(cpu);
   int sched_priority = rtcb->sched_priority;
   FAR struct tcb_s *btcb;
-  bool ret = false;
 
   DEBUGASSERT(cpu == this_cpu());
 
@@ -168,46 +323,38 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
    * switch the current task to that one.
    */
 
-  for (btcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
-       btcb && btcb->sched_priority > sched_priority;
-       btcb = btcb->flink)
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+  btcb = nxsched_peek_readytorun(cpu, sched_priority);
+#else
+  btcb = nxsched_search_readytorun(list_readytorun(), cpu, sched_priority);
+#endif
+  if (btcb == NULL)
     {
-      /* Check if the task found in ready-to-run list is allowed to run on
-       * this CPU. TCB_FLAG_CPU_LOCKED may be used to override affinity. If
-       * the flag is set, assume that btcb->cpu is valid, and it is the only
-       * CPU on which the btcb can run.
-       */
-
-      if (CPU_ISSET(cpu, &btcb->affinity) &&
-          ((btcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || btcb->cpu == cpu))
-        {
-          /* Found a task, remove it from ready-to-run list */
-
-          dq_rem((FAR struct dq_entry_s *)btcb, list_readytorun());
+      return false;
+    }
 
-          if (!is_idle_task(rtcb))
-            {
-              /* Put currently running task back to ready-to-run list */
+  /* Found a task, remove it from ready-to-run list */
 
-              rtcb->task_state = TSTATE_TASK_READYTORUN;
-              nxsched_add_prioritized(rtcb, list_readytorun());
-            }
-          else
-            {
-              rtcb->task_state = TSTATE_TASK_ASSIGNED;
-            }
+  dq_rem((FAR struct dq_entry_s *)btcb, list_readytorun_cpu(btcb->cpu));
 
-          g_assignedtasks[cpu] = btcb;
-          up_update_task(btcb);
+  if (!is_idle_task(rtcb))
+    {
+      /* Put currently running task back to ready-to-run list */
 
-          btcb->cpu = cpu;
-          btcb->task_state = TSTATE_TASK_RUNNING;
-          ret = true;
-          break;
-        }
+      rtcb->task_state = TSTATE_TASK_READYTORUN;
+      nxsched_add_prioritized(rtcb, list_readytorun_cpu(cpu));
+    }
+  else
+    {
+      rtcb->task_state = TSTATE_TASK_ASSIGNED;
     }
 
-  return ret;
+  g_assignedtasks[cpu] = btcb;
+  up_update_task(btcb);
+
+  btcb->cpu = cpu;
+  btcb->task_state = TSTATE_TASK_RUNNING;
+  return true;
 }
 
 /****************************************************************************
@@ -248,15 +395,32 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
 bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 {
   bool doswitch = false;
-  int target_cpu = btcb->flags & TCB_FLAG_CPU_LOCKED ? btcb->cpu :
+  int target_cpu;
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+  /* Queue the task locally if possible.  The task then waits in the list
+   * of the CPU given by btcb->cpu.
+   */
+
+  if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
+    {
+      target_cpu = btcb->cpu;
+    }
+  else
+    {
+      btcb->cpu = nxsched_select_runqueue(btcb, &target_cpu);
+    }
+#else
+  target_cpu = btcb->flags & TCB_FLAG_CPU_LOCKED ? btcb->cpu :
     nxsched_select_cpu(btcb->affinity);
+#endif
 
   /* Add the btcb to the ready to run list, and try to run it on the target
    * CPU
    */
 
   btcb->task_state = TSTATE_TASK_READYTORUN;
-  nxsched_add_prioritized(btcb, list_readytorun());
+  nxsched_add_prioritized(btcb, list_readytorun_cpu(btcb->cpu));
 
   if (target_cpu < CONFIG_SMP_NCPUS)
     {
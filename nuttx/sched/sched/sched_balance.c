@@ -0,0 +1,132 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+
+#if defined(CONFIG_SMP_PERCPU_RUNQUEUE) && \
+    CONFIG_SMP_LOADBALANCE_INTERVAL > 0
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wdog_s g_balance_wdog;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_balance_callback
+ *
+ * Description:
+ *   Check every CPU for a task of higher priority than its running task
+ *   that waits in the ready-to-run list of any CPU, and ask the CPU to
+ *   switch to it.  The CPU then takes the task with
+ *   nxsched_switch_running().
+ *
+ *   Tasks normally move between the lists when a CPU looks for its next
+ *   task.  This catches the CPUs that do not, such as an idle CPU whose
+ *   delivery request was dropped while another one was pending.
+ *
+ * Input Parameters:
+ *   arg - The watchdog, passed when the timer was started.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void nxsched_balance_callback(wdparm_t arg)
+{
+  FAR struct wdog_s *wdog = (FAR struct wdog_s *)arg;
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  bool doswitch = false;
+  int cpu;
+  int i;
+
+  /* We must be in a critical section in order to call up_switch_context()
+   * below.
+   */
+
+  flags = enter_critical_section();
+  cpu   = this_cpu();
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      tcb = current_task(i);
+      if (!nxsched_islocked_tcb(tcb) &&
+          nxsched_peek_readytorun(i, tcb->sched_priority) != NULL)
+        {
+          doswitch |= nxsched_deliver_task(cpu, i, SWITCH_HIGHER);
+        }
+    }
+
+  if (doswitch)
+    {
+      up_switch_context(this_task(), rtcb);
+    }
+
+  wd_start_next(wdog, CONFIG_SMP_LOADBALANCE_INTERVAL,
+                nxsched_balance_callback, arg);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_balance_initialize
+ *
+ * Description:
+ *   Start the periodic balancing of the per-CPU ready-to-run lists.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_balance_initialize(void)
+{
+  wd_start(&g_balance_wdog, CONFIG_SMP_LOADBALANCE_INTERVAL,
+           nxsched_balance_callback, (wdparm_t)&g_balance_wdog);
+}
+
+#endif /* CONFIG_SMP_PERCPU_RUNQUEUE && CONFIG_SMP_LOADBALANCE_INTERVAL > 0 */
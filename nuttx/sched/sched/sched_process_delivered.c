@@ -89,7 +89,8 @@ void nxsched_process_delivered(int cpu)
        * pass it forward.
        */
 
-      FAR struct tcb_s *tcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+      FAR struct tcb_s *tcb =
+        (FAR struct tcb_s *)dq_peek(list_readytorun_cpu(cpu));
       if (tcb)
         {
           int target_cpu = tcb->flags & TCB_FLAG_CPU_LOCKED ?
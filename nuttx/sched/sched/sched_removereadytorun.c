@@ -89,11 +89,18 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
       doswitch = true;
     }
 
-  /* Remove the TCB from the ready-to-run list.  In the non-SMP case, this
-   * is always the g_readytorun list.
+  /* Remove the TCB from the ready-to-run list, that is g_readytorun, or
+   * from the g_pendingtasks list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  if (TLIST_ISRUNNABLE(rtcb->task_state))
+    {
+      nxsched_rtrlist_remove(rtcb);
+    }
+  else
+    {
+      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+    }
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -0,0 +1,249 @@
+/****************************************************************************
+ * sched/sched/sched_rtrbitmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/queue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RTR_NPRIORITIES  (SCHED_PRIORITY_MAX + 1)
+#define RTR_NWORDS       ((RTR_NPRIORITIES + 31) / 32)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The g_readytorun list stays the one sorted list that the rest of the
+ * scheduler walks.  It is indexed by priority: the bitmap has a bit set
+ * for each priority of which there are tasks in the list, and g_rtrtail
+ * holds the last (most recently queued) of them.  Together they locate the
+ * insertion point of a task without a search of the list.
+ *
+ * The running task at the head of the list is not indexed.  Its priority
+ * may be changed in place (e.g. priority protection) as long as the list
+ * stays sorted, so only the tasks behind it are.
+ */
+
+static uint32_t g_rtrbitmap[RTR_NWORDS];
+static FAR struct tcb_s *g_rtrtail[RTR_NPRIORITIES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtr_next
+ *
+ * Description:
+ *   Return the lowest priority, at or above 'priority', of which there are
+ *   tasks in the index, or -1 if there are none.
+ *
+ ****************************************************************************/
+
+static inline_function int nxsched_rtr_next(int priority)
+{
+  int i = priority >> 5;
+  uint32_t bits = g_rtrbitmap[i] & (UINT32_MAX << (priority & 31));
+
+  while (bits == 0)
+    {
+      if (++i >= RTR_NWORDS)
+        {
+          return -1;
+        }
+
+      bits = g_rtrbitmap[i];
+    }
+
+  return (i << 5) + ffs((int)bits) - 1;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_index
+ *
+ * Description:
+ *   Add the first task behind the head of the list, that was the head
+ *   until now, to the index.
+ *
+ ****************************************************************************/
+
+static inline_function void nxsched_rtr_index(FAR struct tcb_s *tcb)
+{
+  int priority = tcb->sched_priority;
+  uint32_t bit = UINT32_C(1) << (priority & 31);
+
+  /* If there are other tasks of this priority, they are all behind it */
+
+  if ((g_rtrbitmap[priority >> 5] & bit) == 0)
+    {
+      g_rtrbitmap[priority >> 5] |= bit;
+      g_rtrtail[priority] = tcb;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_unindex
+ *
+ * Description:
+ *   Remove a task behind the head of the list from the index.  The task
+ *   must still be linked into the list.
+ *
+ ****************************************************************************/
+
+static inline_function void nxsched_rtr_unindex(FAR struct tcb_s *tcb)
+{
+  int priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (g_rtrtail[priority] != tcb)
+    {
+      return;
+    }
+
+  /* The task before it becomes the last one of the priority, unless it is
+   * of another priority or the head of the list.
+   */
+
+  prev = tcb->blink;
+  if (prev->blink != NULL && prev->sched_priority == priority)
+    {
+      g_rtrtail[priority] = prev;
+    }
+  else
+    {
+      g_rtrbitmap[priority >> 5] &= ~(UINT32_C(1) << (priority & 31));
+      g_rtrtail[priority] = NULL;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtrlist_add
+ *
+ * Description:
+ *   Add a task to the g_readytorun list, behind all tasks of the same or
+ *   higher priority, like nxsched_add_prioritized() but without searching
+ *   the list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task to add
+ *
+ * Returned Value:
+ *   true if the task was added at the head of the list.
+ *
+ * Assumptions:
+ * - The caller has established a critical section
+ *
+ ****************************************************************************/
+
+bool nxsched_rtrlist_add(FAR struct tcb_s *tcb)
+{
+  FAR dq_queue_t *list = list_readytorun();
+  FAR struct tcb_s *head = (FAR struct tcb_s *)list->head;
+  int priority = tcb->sched_priority;
+  int next;
+
+  DEBUGASSERT(priority >= SCHED_PRIORITY_MIN);
+
+  if (head == NULL || priority > head->sched_priority)
+    {
+      /* The task preempts the head, which then joins the index */
+
+      if (head != NULL)
+        {
+          nxsched_rtr_index(head);
+        }
+
+      dq_addfirst((FAR dq_entry_t *)tcb, list);
+      return true;
+    }
+
+  /* Queue the task behind the last task of the lowest priority at or above
+   * its own one, or else right behind the head.
+   */
+
+  next = nxsched_rtr_next(priority);
+  dq_addafter((FAR dq_entry_t *)(next < 0 ? head : g_rtrtail[next]),
+              (FAR dq_entry_t *)tcb, list);
+
+  g_rtrbitmap[priority >> 5] |= UINT32_C(1) << (priority & 31);
+  g_rtrtail[priority] = tcb;
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtrlist_remove
+ *
+ * Description:
+ *   Remove a task from the g_readytorun list.  If it is the head of the
+ *   list, the next task becomes the head and leaves the index.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ * - The caller has established a critical section
+ *
+ ****************************************************************************/
+
+void nxsched_rtrlist_remove(FAR struct tcb_s *tcb)
+{
+  FAR dq_queue_t *list = list_readytorun();
+
+  if (tcb->blink == NULL)
+    {
+      if (tcb->flink != NULL)
+        {
+          nxsched_rtr_unindex(tcb->flink);
+        }
+    }
+  else
+    {
+      nxsched_rtr_unindex(tcb);
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+#endif /* CONFIG_SCHED_READYTORUN_BITMAP */
@@ -80,7 +80,15 @@ int wd_cancel(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* The interval timer is left as it is, if it fires early, wd_timer()
+   * will just program the next event.
+   */
+
+  head = false;
+#else
   head = list_is_head(&g_wdactivelist, &wdog->node);
+#endif
 
   /* Now, remove the watchdog from the timer queue */
 
@@ -129,6 +129,35 @@ static inline_function void wd_expiration(clock_t ticks)
   g_wdtimernested++;
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Advance the wheel and run all watchdogs that became ready to run
+   * by now.  Check the time again once they have all run.
+   */
+
+  for (; ; )
+    {
+      wdog = wd_wheel_pop(ticks);
+      if (wdog == NULL)
+        {
+          ticks = clock_systime_ticks();
+          wdog = wd_wheel_pop(ticks);
+          if (wdog == NULL)
+            {
+              break;
+            }
+        }
+
+      func = wdog->func;
+      arg  = wdog->arg;
+
+      up_setpicbase(wdog->picbase);
+      spin_unlock_irqrestore(&g_wdspinlock, flags);
+
+      CALL_FUNC(func, arg);
+
+      flags = spin_lock_irqsave(&g_wdspinlock);
+    }
+#else
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
    */
@@ -172,6 +201,7 @@ static inline_function void wd_expiration(clock_t ticks)
 
       flags = spin_lock_irqsave(&g_wdspinlock);
     }
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Decrement the nested watchdog timer count */
@@ -203,6 +233,29 @@ static inline_function void wd_expiration(clock_t ticks)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+static inline_function
+bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
+               wdentry_t wdentry, wdparm_t arg)
+{
+  clock_t next;
+  bool head;
+
+  /* The timer needs to be reassessed only if the new watchdog expires
+   * before the next event of the wheel.
+   */
+
+  head = !wd_wheel_next(&next) || (sclock_t)(expired - next) < 0;
+
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  wd_wheel_insert(wdog);
+  return head;
+}
+#else
 static inline_function
 bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
@@ -242,6 +295,7 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
 
   return head == curr;
 }
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -307,7 +361,9 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifndef CONFIG_WDOG_TIMER_WHEEL
       reassess |= list_is_head(&g_wdactivelist, &wdog->node);
+#endif
       list_delete(&wdog->node);
     }
 
@@ -374,7 +430,11 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t wd_timer(clock_t ticks, bool noswitches)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t next;
+#else
   FAR struct wdog_s *wdog;
+#endif
   irqstate_t flags;
   sclock_t ret;
 
@@ -387,6 +447,19 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   flags = spin_lock_irqsave(&g_wdspinlock);
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Return the delay for the next event of the wheel, which may be a
+   * cascade rather than a watchdog expiration.
+   */
+
+  if (!wd_wheel_next(&next))
+    {
+      spin_unlock_irqrestore(&g_wdspinlock, flags);
+      return 0;
+    }
+
+  ret = next - ticks;
+#else
   /* Return the delay for the next watchdog to expire */
 
   if (list_is_empty(&g_wdactivelist))
@@ -401,6 +474,7 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
   ret = wdog->expired - ticks;
+#endif
 
   spin_unlock_irqrestore(&g_wdspinlock, flags);
 
@@ -0,0 +1,366 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each level of the wheel has 64 slots, level 'l' slot 'i' holds the
+ * watchdogs expiring in the i-th block of 64^l ticks of the current
+ * 64^(l+1) tick block.
+ */
+
+#define WD_WHEEL_BITS       6
+#define WD_WHEEL_SLOTS      (1 << WD_WHEEL_BITS)
+#define WD_WHEEL_MASK       (WD_WHEEL_SLOTS - 1)
+#define WD_WHEEL_LEVELS     CONFIG_WDOG_TIMER_WHEEL_LEVELS
+
+#define WD_WHEEL_SHIFT(l)   ((l) * WD_WHEEL_BITS)
+#define WD_WHEEL_INDEX(t,l) (((t) >> WD_WHEEL_SHIFT(l)) & WD_WHEEL_MASK)
+#define WD_WHEEL_BLOCK(l)   ((clock_t)1 << WD_WHEEL_SHIFT(l))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wd_wheel_s
+{
+  clock_t          base;       /* The last tick processed */
+  bool             init;       /* The lists have been initialized */
+
+  /* Bitmap of the slots of each level that may be non-empty.  Bits are
+   * cleared lazily, wd_cancel() only unlinks the watchdog.
+   */
+
+  uint64_t         bitmap[WD_WHEEL_LEVELS];
+  struct list_node slot[WD_WHEEL_LEVELS][WD_WHEEL_SLOTS];
+  struct list_node overflow;   /* Beyond the range of the top level */
+  struct list_node expired;    /* Expired, ready to run */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the lists of the wheel on first use and synchronize the
+ *   wheel with the current system time.
+ *
+ ****************************************************************************/
+
+static inline_function void wd_wheel_initialize(void)
+{
+  int level;
+  int i;
+
+  if (g_wdwheel.init)
+    {
+      return;
+    }
+
+  for (level = 0; level < WD_WHEEL_LEVELS; level++)
+    {
+      for (i = 0; i < WD_WHEEL_SLOTS; i++)
+        {
+          list_initialize(&g_wdwheel.slot[level][i]);
+        }
+    }
+
+  list_initialize(&g_wdwheel.overflow);
+  list_initialize(&g_wdwheel.expired);
+
+  g_wdwheel.base = clock_systime_ticks();
+  g_wdwheel.init = true;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_place
+ *
+ * Description:
+ *   Link the watchdog into the wheel relative to the current base: into
+ *   the lowest level at which its expiration time lies in the same block
+ *   as the base, or into the expired list if it is already due.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_place(FAR struct wdog_s *wdog)
+{
+  clock_t expired = wdog->expired;
+  clock_t base = g_wdwheel.base;
+  int level;
+  int idx;
+
+  if ((sclock_t)(expired - base) <= 0)
+    {
+      list_add_tail(&g_wdwheel.expired, &wdog->node);
+      return;
+    }
+
+  for (level = 0; level < WD_WHEEL_LEVELS; level++)
+    {
+      if ((expired >> WD_WHEEL_SHIFT(level + 1)) ==
+          (base >> WD_WHEEL_SHIFT(level + 1)))
+        {
+          idx = WD_WHEEL_INDEX(expired, level);
+          list_add_tail(&g_wdwheel.slot[level][idx], &wdog->node);
+          g_wdwheel.bitmap[level] |= UINT64_C(1) << idx;
+          return;
+        }
+    }
+
+  list_add_tail(&g_wdwheel.overflow, &wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-place all watchdogs of a list relative to the current base.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(FAR struct list_node *list)
+{
+  FAR struct list_node *last = list->prev;
+  FAR struct list_node *node;
+
+  if (list_is_empty(list))
+    {
+      return;
+    }
+
+  /* Watchdogs that are still out of range go back to the tail of the
+   * overflow list, so stop at its original tail.
+   */
+
+  do
+    {
+      node = list->next;
+      list_delete(node);
+      wd_wheel_place(list_entry(node, struct wdog_s, node));
+    }
+  while (node != last);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_process
+ *
+ * Description:
+ *   Advance the base to 'ticks', which must be the time of the next event
+ *   of the wheel, and cascade or expire every slot starting at that time.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_process(clock_t ticks)
+{
+  int level;
+  int idx;
+
+  g_wdwheel.base = ticks;
+
+  /* Cascade from the top down, so that a watchdog may fall through
+   * several levels at once.
+   */
+
+  if ((ticks & (WD_WHEEL_BLOCK(WD_WHEEL_LEVELS) - 1)) == 0)
+    {
+      wd_wheel_cascade(&g_wdwheel.overflow);
+    }
+
+  for (level = WD_WHEEL_LEVELS - 1; level >= 0; level--)
+    {
+      if ((ticks & (WD_WHEEL_BLOCK(level) - 1)) != 0)
+        {
+          continue;
+        }
+
+      idx = WD_WHEEL_INDEX(ticks, level);
+      g_wdwheel.bitmap[level] &= ~(UINT64_C(1) << idx);
+      wd_wheel_cascade(&g_wdwheel.slot[level][idx]);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog, with its expiration time already set, to the wheel.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  wd_wheel_initialize();
+  wd_wheel_place(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Get the time of the next event of the wheel.  That is either the
+ *   expiration of a watchdog or the point where a slot of a higher level
+ *   has to be cascaded, which is never later than the expiration of the
+ *   watchdogs in it.
+ *
+ * Input Parameters:
+ *   next - Location to return the absolute time of the next event
+ *
+ * Returned Value:
+ *   False if there are no active watchdogs.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_next(FAR clock_t *next)
+{
+  clock_t base;
+  uint64_t pending;
+  int level;
+  int idx;
+
+  wd_wheel_initialize();
+
+  base = g_wdwheel.base;
+  if (!list_is_empty(&g_wdwheel.expired))
+    {
+      *next = base;
+      return true;
+    }
+
+  /* All slots of a level lie within the current block of the next level,
+   * so the first non-empty slot of the lowest level is the next event.
+   */
+
+  for (level = 0; level < WD_WHEEL_LEVELS; level++)
+    {
+      idx = WD_WHEEL_INDEX(base, level);
+      pending = g_wdwheel.bitmap[level] & ~((UINT64_C(2) << idx) - 1);
+
+      while (pending != 0)
+        {
+          idx = ffsll(pending) - 1;
+          if (!list_is_empty(&g_wdwheel.slot[level][idx]))
+            {
+              *next = (base & ~(WD_WHEEL_BLOCK(level + 1) - 1)) |
+                      ((clock_t)idx << WD_WHEEL_SHIFT(level));
+              return true;
+            }
+
+          /* All watchdogs of the slot were cancelled */
+
+          pending &= ~(UINT64_C(1) << idx);
+          g_wdwheel.bitmap[level] &= ~(UINT64_C(1) << idx);
+        }
+    }
+
+  if (!list_is_empty(&g_wdwheel.overflow))
+    {
+      *next = (base & ~(WD_WHEEL_BLOCK(WD_WHEEL_LEVELS) - 1)) +
+              WD_WHEEL_BLOCK(WD_WHEEL_LEVELS);
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_pop
+ *
+ * Description:
+ *   Advance the wheel up to 'ticks' and remove the next expired watchdog.
+ *
+ * Input Parameters:
+ *   ticks - The current time in ticks
+ *
+ * Returned Value:
+ *   The expired watchdog, no longer active, or NULL if none has expired.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_pop(clock_t ticks)
+{
+  FAR struct wdog_s *wdog;
+  clock_t next;
+
+  while (list_is_empty(&g_wdwheel.expired))
+    {
+      if (!wd_wheel_next(&next) || (sclock_t)(next - ticks) > 0)
+        {
+          /* Nothing happens until 'ticks', just catch up */
+
+          if ((sclock_t)(ticks - g_wdwheel.base) > 0)
+            {
+              g_wdwheel.base = ticks;
+            }
+
+          return NULL;
+        }
+
+      wd_wheel_process(next);
+    }
+
+  wdog = list_first_entry(&g_wdwheel.expired, struct wdog_s, node);
+  list_delete(&wdog->node);
+  return wdog;
+}
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
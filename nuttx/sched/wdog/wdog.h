@@ -120,6 +120,28 @@ void wd_timer(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_insert, wd_wheel_next and wd_wheel_pop
+ *
+ * Description:
+ *   The hierarchical timer wheel that replaces g_wdactivelist when
+ *   CONFIG_WDOG_TIMER_WHEEL is selected.  wd_wheel_insert() adds a
+ *   watchdog with its expiration time set, wd_wheel_next() returns the
+ *   time of the next event of the wheel and wd_wheel_pop() advances the
+ *   wheel and removes the next expired watchdog.  An active watchdog is
+ *   removed from the wheel with list_delete(), like from the list.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+void wd_wheel_insert(FAR struct wdog_s *wdog);
+bool wd_wheel_next(FAR clock_t *next);
+FAR struct wdog_s *wd_wheel_pop(clock_t ticks);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,80 @@
+#!/bin/bash
+
+#****************************************************************************
+# tools/simnetem.sh
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+#****************************************************************************
+
+# Helper script to emulate a slow, lossy link between the host and the
+# NuttX simulator with netem, e.g. to compare the TCP congestion control
+# algorithms with apps/benchmarks/tcpcc.
+#
+# The delay is added to the packets from the host to the simulator, the
+# loss and the rate limit to the packets from the simulator to the host
+# (through an ifb device), so that a sender on the simulator sees the whole
+# round trip delay and loses data rather than ACKs.
+#
+# This script needs to be run as root.
+
+if [ $# != 2 ] && [ $# != 4 ] && [ $# != 5 ]; then
+  echo "Usage: $0 <interface> off"
+  echo "       $0 <interface> <delay> <loss> <rate> [ifb]"
+  echo "Example: $0 nuttx0 50ms 0.1% 100mbit"
+  exit 1
+fi
+
+IF_SIM=$1
+IF_IFB=${5:-ifb0}
+
+net_off() {
+  tc qdisc del dev $IF_SIM root 2>/dev/null
+  tc qdisc del dev $IF_SIM handle ffff: ingress 2>/dev/null
+  tc qdisc del dev $IF_IFB root 2>/dev/null
+}
+
+# remove all configs first to avoid double configure
+net_off
+
+if [ "$2" == "off" ]; then
+  exit 0
+fi
+
+DELAY=$2
+LOSS=$3
+RATE=$4
+
+# host to simulator: the delay of the path
+
+tc qdisc add dev $IF_SIM root netem delay $DELAY
+
+# simulator to host: loss and bottleneck rate, with a queue of about a
+# bandwidth-delay product so that a full queue shows up as delay first
+
+modprobe ifb
+ip link add $IF_IFB type ifb 2>/dev/null
+ip link set dev $IF_IFB up
+
+tc qdisc add dev $IF_SIM handle ffff: ingress
+tc filter add dev $IF_SIM parent ffff: u32 match u32 0 0 \
+  action mirred egress redirect dev $IF_IFB
+tc qdisc add dev $IF_IFB root netem loss $LOSS rate $RATE limit 1000
+
+tc qdisc show dev $IF_SIM
+tc qdisc show dev $IF_IFB